@@ -0,0 +1,58 @@
+# Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+# Author: Andreas Vogel
+# 
+# This file is part of UG4.
+# 
+# UG4 is free software: you can redistribute it and/or modify it under the
+# terms of the GNU Lesser General Public License version 3 (as published by the
+# Free Software Foundation) with the following additional attribution
+# requirements (according to LGPL/GPL v3 §7):
+# 
+# (1) The following notice must be displayed in the Appropriate Legal Notices
+# of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+# 
+# (2) The following notice must be displayed at a prominent place in the
+# terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+# 
+# (3) The following bibliography is recommended for citation and must be
+# preserved in all covered files:
+# "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+#   parallel geometric multigrid solver on hierarchically distributed grids.
+#   Computing and visualization in science 16, 4 (2013), 151-164"
+# "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+#   flexible software system for simulating pde based models on high performance
+#   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+
+# included from ug_includes.cmake
+# Optional compression libraries, used e.g. for compressed vtk output.
+if(USE_ZLIB)
+	find_package(ZLIB)
+	if(ZLIB_FOUND)
+		message(STATUS "Info: Using ZLIB (include: ${ZLIB_INCLUDE_DIRS}, lib: ${ZLIB_LIBRARIES})")
+		add_definitions(-DUG_ZLIB)
+		include_directories(${ZLIB_INCLUDE_DIRS})
+		set(linkLibraries ${linkLibraries} ${ZLIB_LIBRARIES})
+	else(ZLIB_FOUND)
+		message(STATUS "Info: ZLIB requested, but not found. ZLIB disabled.")
+		set(USE_ZLIB OFF)
+	endif(ZLIB_FOUND)
+endif(USE_ZLIB)
+
+if(USE_LZ4)
+	find_path(LZ4_INCLUDE_DIR lz4.h)
+	find_library(LZ4_LIBRARY NAMES lz4)
+	if(LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+		message(STATUS "Info: Using LZ4 (include: ${LZ4_INCLUDE_DIR}, lib: ${LZ4_LIBRARY})")
+		add_definitions(-DUG_LZ4)
+		include_directories(${LZ4_INCLUDE_DIR})
+		set(linkLibraries ${linkLibraries} ${LZ4_LIBRARY})
+	else(LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+		message(STATUS "Info: LZ4 requested, but not found. LZ4 disabled.")
+		set(USE_LZ4 OFF)
+	endif(LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+endif(USE_LZ4)
@@ -194,6 +194,8 @@ option(USE_AUTODIFF "Use Autodiff" OFF)
 option(USE_PYBIND11 "Use PYBIND11" OFF)
 option(USE_JSON "Use JSON" OFF)
 option(USE_XEUS "Use XEUS" OFF)
+option(USE_ZLIB "Use zlib (e.g. for compressed vtk output)" OFF)
+option(USE_LZ4 "Use lz4 (e.g. for compressed vtk output)" OFF)
 
 ################################################################################
 # set default values for pseudo-options
@@ -273,6 +275,8 @@ message(STATUS "Info: BLAS:              ${BLAS} (options are: ON, OFF)")
 message(STATUS "Info: INTERNAL_BOOST:    ${INTERNAL_BOOST} (options are: ON, OFF)")
 message(STATUS "Info: EMBEDDED_PLUGINS   ${EMBEDDED_PLUGINS} (options are: ON, OFF)")
 message(STATUS "Info: COMPILE_INFO       ${COMPILE_INFO} (options are: ON, OFF)")
+message(STATUS "Info: USE_ZLIB           ${USE_ZLIB} (options are: ON, OFF)")
+message(STATUS "Info: USE_LZ4            ${USE_LZ4} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUA2C          ${USE_LUA2C} (options are: ON, OFF)")
 message(STATUS "Info: USE_LUAJIT         ${USE_LUAJIT} (options are: ON, OFF)")
 message(STATUS "")
@@ -444,6 +448,8 @@ include(${UG_ROOT_CMAKE_PATH}/ug/pybind11.cmake)
 include(${UG_ROOT_CMAKE_PATH}/ug/autodiff.cmake)
 # XEUS
 include(${UG_ROOT_CMAKE_PATH}/ug/xeus.cmake)
+# ZLIB, LZ4
+include(${UG_ROOT_CMAKE_PATH}/ug/compression.cmake)
 
 ########################################
 # buildAlgebra
@@ -505,6 +511,9 @@ if(UNIX)
 	endif(NOT STATIC_BUILD)
 # for cekon pthread bug
 #    set(linkLibraries ${linkLibraries} pthread)
+#	background threads (e.g. asynchronous vtk output)
+	find_package(Threads)
+	set(linkLibraries ${linkLibraries} ${CMAKE_THREAD_LIBS_INIT})
 elseif(WIN32)
 	set(linkLibraries ${linkLibraries} Kernel32)
 endif(UNIX)
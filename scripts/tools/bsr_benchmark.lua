@@ -0,0 +1,88 @@
+-- Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+-- Author: Sebastian Reiter
+-- 
+-- This file is part of UG4.
+-- 
+-- UG4 is free software: you can redistribute it and/or modify it under the
+-- terms of the GNU Lesser General Public License version 3 (as published by the
+-- Free Software Foundation) with the following additional attribution
+-- requirements (according to LGPL/GPL v3 §7):
+-- 
+-- (1) The following notice must be displayed in the Appropriate Legal Notices
+-- of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (2) The following notice must be displayed at a prominent place in the
+-- terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (3) The following bibliography is recommended for citation and must be
+-- preserved in all covered files:
+-- "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+--   parallel geometric multigrid solver on hierarchically distributed grids.
+--   Computing and visualization in science 16, 4 (2013), 151-164"
+-- "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+--   flexible software system for simulating pde based models on high performance
+--   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+-- 
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU Lesser General Public License for more details.
+
+
+--[[!
+\addtogroup scripts_util
+\{
+\file bsr_benchmark.lua
+\brief compares the BSR block kernels with the SparseMatrix of the block algebra
+
+A system with numComp components is assembled in the block algebra of block
+size numComp (one ConvectionDiffusion disc per component). The couplings of the
+components are zero, but all blocks are stored and processed as dense blocks,
+so the timings are those of a coupled system. Then BenchmarkBSR times SpMV, Jacobi and Gauss-Seidel for the
+SparseMatrix and for its BSR copy (see BSRMatrix). The vectorized block kernels
+are only used if ug4 is compiled for AVX2 or AVX-512 (e.g. -march=native).
+
+Requires the ConvectionDiffusion plugin.
+
+Example:
+\code
+ugshell -ex tools/bsr_benchmark.lua -dim 3 -numComp 4 -numRefs 4
+\endcode
+\}
+]]--
+
+ug_load_script("ug_util.lua")
+
+local dim		= util.GetParamNumber("-dim", 2, "world dimension")
+local numComp	= util.GetParamNumber("-numComp", 3, "number of components (block size)")
+local numRefs	= util.GetParamNumber("-numRefs", 6, "number of global refinements")
+local numIter	= util.GetParamNumber("-numIter", 20, "number of applications per kernel")
+
+local gridName
+if dim == 2 then gridName = "grids/unit_square_01/unit_square_01_quads_8x8.ugx"
+else gridName = "grids/unit_square_01/unit_cube_01_hex_2x2x2.ugx" end
+gridName = util.GetParam("-grid", gridName, "filename of the grid")
+
+InitUG(dim, AlgebraType("CPU", numComp))
+
+local dom = util.CreateDomain(gridName, numRefs)
+
+local fct = {}
+for i = 1, numComp do fct[i] = "c"..i end
+local approxSpace = util.EasyCreateApproxSpace(dom, fct)
+
+local domainDisc = DomainDiscretization(approxSpace)
+for i = 1, numComp do
+	local elemDisc = ConvectionDiffusion(fct[i], "Inner", "fv1")
+	elemDisc:set_diffusion(1.0)
+	elemDisc:set_reaction_rate(1.0)
+	domainDisc:add(elemDisc)
+end
+
+local A = AssembledLinearOperator(domainDisc)
+local b = GridFunction(approxSpace)
+local t = GetClockS()
+domainDisc:assemble_linear(A, b)
+print("assembling (s): " .. GetClockS() - t)
+
+BenchmarkBSR(A, numIter)
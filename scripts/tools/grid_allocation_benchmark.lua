@@ -0,0 +1,107 @@
+-- Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+-- Author: Sebastian Reiter
+-- 
+-- This file is part of UG4.
+-- 
+-- UG4 is free software: you can redistribute it and/or modify it under the
+-- terms of the GNU Lesser General Public License version 3 (as published by the
+-- Free Software Foundation) with the following additional attribution
+-- requirements (according to LGPL/GPL v3 §7):
+-- 
+-- (1) The following notice must be displayed in the Appropriate Legal Notices
+-- of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (2) The following notice must be displayed at a prominent place in the
+-- terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (3) The following bibliography is recommended for citation and must be
+-- preserved in all covered files:
+-- "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+--   parallel geometric multigrid solver on hierarchically distributed grids.
+--   Computing and visualization in science 16, 4 (2013), 151-164"
+-- "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+--   flexible software system for simulating pde based models on high performance
+--   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+-- 
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU Lesser General Public License for more details.
+
+--[[!
+\addtogroup scripts_util
+\{
+\file grid_allocation_benchmark.lua
+\brief measures refinement and destruction times with and without pooled allocation
+
+The grid is loaded and refined globally numRefs times. Then the geometry is
+cleared through clear_geometry. In a second pass the grid is refined again and
+destroyed. Both passes are executed with pooled allocation of grid objects
+enabled and disabled (see Grid::enable_pooled_allocation).
+
+Example:
+\code
+ugshell -ex tools/grid_allocation_benchmark.lua -grid grids/unit_square_01/unit_square_01_quads_8x8.ugx -numRefs 7
+\endcode
+\}
+]]--
+
+ug_load_script("ug_util.lua")
+
+local gridName	= util.GetParam("-grid", "grids/unit_square_01/unit_square_01_quads_8x8.ugx",
+						"filename of the grid")
+local numRefs	= util.GetParamNumber("-numRefs", 6, "number of global refinements")
+local numRuns	= util.GetParamNumber("-numRuns", 3, "number of runs per configuration")
+
+local function RefinedGrid(pooled)
+	local mg = MultiGrid()
+	mg:enable_pooled_allocation(pooled)
+	if LoadGrid(mg, gridName) == false then
+		print("Can't load grid " .. gridName)
+		exit()
+	end
+
+	local refiner = GlobalMultiGridRefiner()
+	refiner:assign_grid(mg)
+	local t = GetClockS()
+	for i = 1, numRefs do
+		refiner:refine()
+	end
+	t = GetClockS() - t
+	refiner = nil
+	collectgarbage("collect")
+	return mg, t
+end
+
+local function Benchmark(pooled)
+	local tRefine, tClear, tDestroy = 0, 0, 0
+	local numElems, poolMem = 0, 0
+	for run = 1, numRuns do
+	--	refinement and clear_geometry
+		local mg, t = RefinedGrid(pooled)
+		tRefine = tRefine + t
+		numElems = mg:num_vertices() + mg:num_edges() + mg:num_faces() + mg:num_volumes()
+		poolMem = mg:pooled_memory()
+		t = GetClockS()
+		mg:clear_geometry()
+		tClear = tClear + GetClockS() - t
+
+	--	refinement and destruction
+		mg, t = RefinedGrid(pooled)
+		tRefine = tRefine + t
+		t = GetClockS()
+		mg = nil
+		collectgarbage("collect")
+		tDestroy = tDestroy + GetClockS() - t
+	end
+
+	print("pooled allocation: " .. tostring(pooled))
+	print("  elements:         " .. numElems)
+	print("  pool memory (MB): " .. poolMem / (1024*1024))
+	print("  refine (s):       " .. tRefine / (2*numRuns))
+	print("  clear_geometry (s): " .. tClear / numRuns)
+	print("  destruction (s):  " .. tDestroy / numRuns)
+end
+
+Benchmark(false)
+Benchmark(true)
@@ -0,0 +1,153 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/bsr_matrix_operator.h"
+#include "lib_algebra/operator/preconditioner/bsr_smoothers.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/error.cpp"
+#include "lib_algebra/algebra_common/permutation_util.cpp"
+
+// BSR test (compiled with -mavx2 -mfma, such that the vectorized kernels are
+// used where the cpu supports them): SpMV, y -= A*x, Jacobi and the forward,
+// backward and symmetric Gauss-Seidel of the BSR copy give the results of the
+// SparseMatrix versions for block sizes 2, 3, 5 and 6. The vectorized block
+// row kernel is also compared with the scalar one.
+
+using namespace ug;
+
+static unsigned int seed = 1;
+double rnd() {seed = seed * 1103515245u + 12345u; return (double)((seed >> 8) % 10000) / 10000.;}
+
+static const size_t numRows = 200;
+
+// random block matrix with 5 block entries per row and dominant diagonal blocks
+template <typename M>
+void create(M& A)
+{
+	typedef typename M::value_type block_type;
+	const int N = block_traits<block_type>::static_num_rows;
+	A.resize_and_clear(numRows, numRows);
+	for(size_t i = 0; i < numRows; ++i)
+		for(int k = 0; k < 5; ++k){
+			const size_t c = (k == 0) ? i : (size_t)(rnd() * numRows) % numRows;
+			block_type& b = A(i, c);
+			for(int r = 0; r < N; ++r)
+				for(int s = 0; s < N; ++s)
+					BlockRef(b, r, s) += rnd() - 0.5 + ((k == 0 && r == s) ? 8. * N : 0.);
+		}
+	A.defragment();
+}
+
+template <typename V>
+void set_random(V& v)
+{
+	for(size_t i = 0; i < v.size(); ++i)
+		for(size_t r = 0; r < GetSize(v[i]); ++r)
+			BlockRef(v[i], r) = rnd() - 0.5;
+}
+
+template <typename V>
+double rel_diff(const V& a, const V& b)
+{
+	V e(a.size());
+	e = a; e -= b;
+	return e.norm() / a.norm();
+}
+
+template <typename TAlgebra>
+double precond_diff(SmartPtr<MatrixOperator<typename TAlgebra::matrix_type,
+                    typename TAlgebra::vector_type> > spOp,
+                    IPreconditioner<TAlgebra>& p1, IPreconditioner<TAlgebra>& p2,
+                    const typename TAlgebra::vector_type& d)
+{
+	typename TAlgebra::vector_type c1(d.size()), c2(d.size());
+	p1.init(spOp); p2.init(spOp);
+	p1.apply(c1, d); p2.apply(c2, d);
+	return rel_diff(c1, c2);
+}
+
+// the block row kernel used by BSRMatrix<N> gives the result of the scalar one
+template <int N>
+double kernel_diff()
+{
+	const size_t num = 7;
+	std::vector<double> a(num*N*N), x(10*N), y1(N), y2(N);
+	std::vector<size_t> col(num);
+	for(size_t i = 0; i < a.size(); ++i) a[i] = rnd() - 0.5;
+	for(size_t i = 0; i < x.size(); ++i) x[i] = rnd() - 0.5;
+	for(size_t k = 0; k < num; ++k) col[k] = (k * 3) % 10;
+	for(int i = 0; i < N; ++i) y1[i] = y2[i] = rnd();
+	BSRBlockKernel<N>::row_mult(&y1[0], 0.5, -2.0, &a[0], &col[0], num, &x[0]);
+	BSRBlockKernel<N, false>::row_mult(&y2[0], 0.5, -2.0, &a[0], &col[0], num, &x[0]);
+	double d = 0;
+	for(int i = 0; i < N; ++i) d = std::max(d, std::fabs(y1[i] - y2[i]));
+	return d;
+}
+
+template <int N>
+bool check()
+{
+	typedef CPUBlockAlgebra<N> TAlgebra;
+	typedef typename TAlgebra::matrix_type M;
+	typedef typename TAlgebra::vector_type V;
+	typedef MatrixOperator<M, V> MOp;
+
+	SmartPtr<MOp> spOp = make_sp(new MOp);
+	create(spOp->get_matrix());
+	BSRMatrixOperator<TAlgebra> bsrOp(spOp);
+	bsrOp.init();
+
+	V x(numRows), d(numRows), y1(numRows), y2(numRows);
+	set_random(x); set_random(d);
+	const double tol = 1e-13;
+	double diff[7];
+
+	spOp->apply(y1, x); bsrOp.apply(y2, x);
+	diff[0] = rel_diff(y1, y2);
+
+	y1 = d; y2 = d;
+	spOp->apply_sub(y1, x); bsrOp.apply_sub(y2, x);
+	diff[1] = rel_diff(y1, y2);
+
+	Jacobi<TAlgebra> jac(0.7); BSRJacobi<TAlgebra> bsrJac(0.7);
+	diff[2] = precond_diff<TAlgebra>(spOp, jac, bsrJac, d);
+
+	GaussSeidel<TAlgebra> gs; BSRGaussSeidel<TAlgebra> bsrGs;
+	diff[3] = precond_diff<TAlgebra>(spOp, gs, bsrGs, d);
+
+	BackwardGaussSeidel<TAlgebra> bgs; BSRBackwardGaussSeidel<TAlgebra> bsrBgs;
+	diff[4] = precond_diff<TAlgebra>(spOp, bgs, bsrBgs, d);
+
+	SymmetricGaussSeidel<TAlgebra> sgs; BSRSymmetricGaussSeidel<TAlgebra> bsrSgs;
+	diff[5] = precond_diff<TAlgebra>(spOp, sgs, bsrSgs, d);
+
+	diff[6] = kernel_diff<N>();
+
+	const char* name[] = {"SpMV", "apply_sub", "Jacobi", "Gauss-Seidel",
+	                      "backward Gauss-Seidel", "symmetric Gauss-Seidel",
+	                      "kernel"};
+	bool bOk = true;
+	std::cout << "block size " << N << ":";
+	for(int k = 0; k < 7; ++k){
+		std::cout << (k ? ", " : " ") << name[k];
+		if(!(diff[k] < tol)){
+			std::cout << " FAIL (" << diff[k] << ")";
+			bOk = false;
+		}
+	}
+	std::cout << (bOk ? " ok" : "") << "\n";
+	return bOk;
+}
+
+int main()
+{
+	bool bOk = check<2>();
+	bOk &= check<3>();
+	bOk &= check<5>();
+	bOk &= check<6>();
+	return bOk ? 0 : 1;
+}
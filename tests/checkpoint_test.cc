@@ -0,0 +1,134 @@
+#include <iostream>
+#include <cstdio>
+#include <set>
+
+#include "ug.h"
+#include "lib_algebra/algebra_type.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/io/grid_function_checkpoint.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+// Checkpoint test (linked against libug4): a grid function with a P1 (u) and
+// a P2 function (v) on a refined unit square is saved, perturbed and loaded
+// again, which restores all values. A checkpoint containing only v restores
+// the values of v and keeps the perturbed values of u. CheckpointRecord::
+// same_key compares the location and id, but not the value.
+
+using namespace ug;
+
+typedef GridFunction<Domain2d, CPUAlgebra> function_type;
+
+// algebra indices of the DoFs of a function
+void fct_indices(std::set<size_t>& sInd, const function_type& u, size_t fct)
+{
+	ConstSmartPtr<DoFDistribution> dd = u.dd();
+	std::vector<DoFIndex> vInd;
+	for(DoFDistribution::traits<Vertex>::const_iterator iter = dd->begin<Vertex>();
+			iter != dd->end<Vertex>(); ++iter){
+		dd->inner_dof_indices(*iter, fct, vInd);
+		for(size_t k = 0; k < vInd.size(); ++k) sInd.insert(vInd[k][0]);
+	}
+	for(DoFDistribution::traits<Edge>::const_iterator iter = dd->begin<Edge>();
+			iter != dd->end<Edge>(); ++iter){
+		dd->inner_dof_indices(*iter, fct, vInd);
+		for(size_t k = 0; k < vInd.size(); ++k) sInd.insert(vInd[k][0]);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	UGInit(&argc, &argv);
+	int numErr = 0;
+
+	{
+		SmartPtr<Domain2d> spDom = make_sp(new Domain2d());
+		MultiGrid& mg = *spDom->grid();
+		MGSubsetHandler& sh = *spDom->subset_handler();
+		Domain2d::position_accessor_type& aaPos = spDom->position_accessor();
+
+		RegularVertex* v[4];
+		const number x[4] = {0, 1, 1, 0}, y[4] = {0, 0, 1, 1};
+		for(int i = 0; i < 4; ++i){
+			v[i] = *mg.create<RegularVertex>();
+			aaPos[v[i]] = MathVector<2>(x[i], y[i]);
+		}
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[1], v[2]));
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[2], v[3]));
+		sh.assign_subset(mg.begin<Vertex>(), mg.end<Vertex>(), 0);
+		sh.assign_subset(mg.begin<Edge>(), mg.end<Edge>(), 0);
+		sh.assign_subset(mg.begin<Face>(), mg.end<Face>(), 0);
+
+		GlobalMultiGridRefiner refiner(mg);
+		refiner.refine();
+		refiner.refine();
+
+		SmartPtr<ApproximationSpace<Domain2d> > spApprox
+			= make_sp(new ApproximationSpace<Domain2d>(spDom, AlgebraType("CPU", 1)));
+		spApprox->add("u", "Lagrange", 1);
+		spApprox->add("v", "Lagrange", 2);
+		spApprox->init_top_surface();
+
+		function_type u(spApprox);
+		for(size_t i = 0; i < u.size(); ++i) u[i] = std::sin(1.0 + i);
+		std::vector<number> orig(u.size());
+		for(size_t i = 0; i < u.size(); ++i) orig[i] = u[i];
+
+		std::set<size_t> sIndV;
+		fct_indices(sIndV, u, 1);
+		std::cout << "DoFs: " << u.size() << ", of v: " << sIndV.size() << std::endl;
+
+		SaveCheckpoint(u, "checkpoint_test_full.ckp");
+		SaveCheckpoint(u, "checkpoint_test_v.ckp", "v");
+
+	//	full roundtrip
+		for(size_t i = 0; i < u.size(); ++i) u[i] += 1.0;
+		LoadCheckpoint(u, "checkpoint_test_full.ckp");
+		size_t numRestored = 0;
+		for(size_t i = 0; i < u.size(); ++i)
+			if(u[i] == orig[i]) numRestored++;
+		std::cout << "full checkpoint: restored " << numRestored << " values" << std::endl;
+		if(numRestored != u.size()) numErr++;
+
+	//	partial checkpoint
+		for(size_t i = 0; i < u.size(); ++i) u[i] += 1.0;
+		LoadCheckpoint(u, "checkpoint_test_v.ckp");
+		size_t numV = 0, numKept = 0;
+		for(size_t i = 0; i < u.size(); ++i){
+			if(sIndV.count(i)){
+				if(u[i] == orig[i]) numV++;
+			}
+			else if(u[i] == orig[i] + 1.0) numKept++;
+		}
+		std::cout << "partial checkpoint: restored " << numV << " values of v, kept "
+				  << numKept << " values of u" << std::endl;
+		if(numV != sIndV.size() || numV + numKept != u.size()) numErr++;
+
+		std::remove("checkpoint_test_full.ckp");
+		std::remove("checkpoint_test_v.ckp");
+	}
+
+//	keys of checkpoint records
+	{
+		CheckpointRecord a, b;
+		a.x[0] = 0.5; a.x[1] = 0.25; a.x[2] = 0.0;
+		a.id = CheckpointRecord::make_id(1, EDGE, 0);
+		a.value = 1.0;
+		b = a; b.value = 2.0;
+		bool bOk = a.same_key(b) && !(a < b) && !(b < a);
+		b.id = CheckpointRecord::make_id(1, EDGE, 1);
+		bOk &= !a.same_key(b) && a < b;
+		b = a; b.id = CheckpointRecord::make_id(0, EDGE, 0);
+		bOk &= !a.same_key(b) && b.fct() == 0 && a.fct() == 1;
+		b = a; b.x[1] = 0.5;
+		bOk &= !a.same_key(b) && a < b;
+		std::cout << "same_key: " << (bOk ? "ok" : "FAILED") << std::endl;
+		if(!bOk) numErr++;
+	}
+
+	std::cout << (numErr == 0 ? "checkpoint: ok" : "checkpoint: FAILED") << std::endl;
+	UGFinalize();
+	return numErr;
+}
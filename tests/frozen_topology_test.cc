@@ -0,0 +1,112 @@
+#include <iostream>
+#include <cmath>
+
+#include "ug.h"
+#include "lib_algebra/algebra_type.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/frozen_topology.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+// FrozenTopology test (linked against libug4): the snapshot of the top
+// surface of a unit square (two triangles) must contain the elements and
+// their neighbors. After a global refinement the revision of the
+// DoFDistribution changes, update() must rebuild the snapshot, the refined
+// parents must no longer be found and the children must be found.
+
+using namespace ug;
+
+typedef FrozenTopology<Domain2d> topo_type;
+
+bool check_snapshot(const topo_type& topo, const Domain2d& dom)
+{
+	const Domain2d::position_accessor_type& aaPos = dom.position_accessor();
+	bool ok = true;
+	size_t numNeighbor = 0;
+	for(size_t e = 0; e < topo.num_elements(); ++e)
+	{
+		Face* elem = topo.element(e);
+		if(topo.index(elem) != (int)e) ok = false;
+		if(topo.num_corners(e) != elem->num_vertices()) ok = false;
+		for(size_t co = 0; co < topo.num_corners(e); ++co)
+			if(VecDistance(topo.corner_coords(e)[co], aaPos[elem->vertex(co)]) > 1e-14)
+				ok = false;
+		for(size_t s = 0; s < topo.num_sides(e); ++s)
+		{
+			const int f = topo.neighbors(e)[s];
+			if(f < 0) continue;
+			numNeighbor++;
+		//	the neighborhood is symmetric
+			bool found = false;
+			for(size_t t = 0; t < topo.num_sides(f); ++t)
+				if(topo.neighbors(f)[t] == (int)e) found = true;
+			if(!found) ok = false;
+		}
+	}
+	std::cout << "  elements: " << topo.num_elements()
+			  << ", vertices: " << topo.num_vertices()
+			  << ", inner sides: " << numNeighbor / 2 << std::endl;
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	UGInit(&argc, &argv);
+	int numErr = 0;
+
+	{
+		SmartPtr<Domain2d> spDom = make_sp(new Domain2d());
+		MultiGrid& mg = *spDom->grid();
+		MGSubsetHandler& sh = *spDom->subset_handler();
+		Domain2d::position_accessor_type& aaPos = spDom->position_accessor();
+
+		RegularVertex* v[4];
+		const number x[4] = {0, 1, 1, 0}, y[4] = {0, 0, 1, 1};
+		for(int i = 0; i < 4; ++i){
+			v[i] = *mg.create<RegularVertex>();
+			aaPos[v[i]] = MathVector<2>(x[i], y[i]);
+		}
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[1], v[2]));
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[2], v[3]));
+		sh.assign_subset(mg.begin<Vertex>(), mg.end<Vertex>(), 0);
+		sh.assign_subset(mg.begin<Edge>(), mg.end<Edge>(), 0);
+		sh.assign_subset(mg.begin<Face>(), mg.end<Face>(), 0);
+
+		SmartPtr<ApproximationSpace<Domain2d> > spApprox
+			= make_sp(new ApproximationSpace<Domain2d>(spDom, AlgebraType("CPU", 1)));
+		spApprox->add("u", "Lagrange", 1);
+		spApprox->init_top_surface();
+		ConstSmartPtr<DoFDistribution> spDD = spApprox->dof_distribution(GridLevel());
+
+		topo_type topo(spDom, spDD);
+		std::cout << "initial snapshot:" << std::endl;
+		if(!check_snapshot(topo, *spDom)) numErr++;
+		if(!topo.is_up_to_date() || topo.update()) numErr++;
+
+		Face* parent = topo.element(0);
+
+	//	refinement changes the revision of the DoFDistribution
+		GlobalMultiGridRefiner refiner(mg);
+		refiner.refine();
+		std::cout << "after refinement: up to date: "
+				  << (topo.is_up_to_date() ? "yes" : "no") << std::endl;
+		if(topo.is_up_to_date()) numErr++;
+		if(!topo.update()) numErr++;
+		std::cout << "rebuilt snapshot:" << std::endl;
+		if(!check_snapshot(topo, *spDom)) numErr++;
+		if(topo.index(parent) != -1) numErr++;
+		if(topo.index(mg.get_child_face(parent, 0)) < 0) numErr++;
+		if(!topo.is_up_to_date() || topo.update()) numErr++;
+
+	//	moving the mesh only needs the coordinates to be updated
+		for(VertexIterator iter = mg.begin<Vertex>(); iter != mg.end<Vertex>(); ++iter)
+			aaPos[*iter] *= 2.0;
+		topo.update_coordinates();
+		std::cout << "moved mesh:" << std::endl;
+		if(!check_snapshot(topo, *spDom)) numErr++;
+	}
+
+	std::cout << (numErr == 0 ? "frozen topology: ok" : "frozen topology: FAILED") << std::endl;
+	UGFinalize();
+	return numErr;
+}
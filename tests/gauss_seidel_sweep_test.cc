@@ -0,0 +1,84 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/error.cpp"
+#include "lib_algebra/algebra_common/permutation_util.cpp"
+
+// Gauss-Seidel sweep test: the multicolor and hybrid sweeps need (about) the
+// same number of iterations as the sequential sweep on a 2d 5-point matrix.
+// The exception is the symmetric multicolor sweep: the 5-point matrix has two
+// colours and the backward half repeats the last colour, so it converges like
+// the sequential forward sweep.
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+typedef MatrixOperator<M, V> MOp;
+
+static const size_t N = 30;
+
+// number of iterations to reduce the defect by 1e-6
+size_t iterations(SmartPtr<MOp> spOp, IPreconditioner<CPUAlgebra>& gs)
+{
+	ILinearIterator<V>& it = gs;
+	it.init(spOp);
+	V x(N*N), d(N*N), c(N*N);
+	for(size_t i = 0; i < N*N; ++i) d[i] = 1.;
+	const double d0 = d.norm();
+	size_t numIter = 0;
+	while(d.norm() > 1e-6 * d0 && numIter < 10000){
+		it.apply_update_defect(c, d);
+		x += c;
+		++numIter;
+	}
+	return numIter;
+}
+
+template <typename TGS>
+bool check(SmartPtr<MOp> spOp, const char* name, size_t numRef = 0)
+{
+	TGS gs;
+	const size_t numSeq = iterations(spOp, gs);
+	gs.set_sweep_type("multicolor");
+	const size_t numColor = iterations(spOp, gs);
+	gs.set_sweep_type("hybrid");
+	const size_t numHybrid = iterations(spOp, gs);
+
+	if(numRef == 0) numRef = numSeq;
+	const bool bOk = (numColor <= 1.1 * numRef) && (numHybrid <= 1.1 * numSeq);
+	std::cout << name << ": sequential " << numSeq << ", multicolor " << numColor
+			<< ", hybrid " << numHybrid << (bOk ? "" : " FAIL") << "\n";
+	return bOk;
+}
+
+int main()
+{
+	SmartPtr<MOp> spOp = make_sp(new MOp);
+	M& A = spOp->get_matrix();
+	A.resize_and_clear(N*N, N*N);
+	for(size_t j = 0; j < N; ++j)
+		for(size_t i = 0; i < N; ++i){
+			const size_t k = j*N + i;
+			A(k, k) = 4.;
+			if(i > 0) A(k, k-1) = -1.;
+			if(i+1 < N) A(k, k+1) = -1.;
+			if(j > 0) A(k, k-N) = -1.;
+			if(j+1 < N) A(k, k+N) = -1.;
+		}
+	A.defragment();
+
+	GaussSeidel<CPUAlgebra> gs;
+	const size_t numForward = iterations(spOp, gs);
+
+	bool bOk = check<GaussSeidel<CPUAlgebra> >(spOp, "GaussSeidel");
+	bOk &= check<BackwardGaussSeidel<CPUAlgebra> >(spOp, "BackwardGaussSeidel");
+	bOk &= check<SymmetricGaussSeidel<CPUAlgebra> >(spOp, "SymmetricGaussSeidel", numForward);
+	return bOk ? 0 : 1;
+}
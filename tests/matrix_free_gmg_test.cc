@@ -0,0 +1,212 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "ug.h"
+#include "lib_algebra/algebra_type.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/preconditioner/chebyshev.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/spatial_disc/domain_disc.h"
+#include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/spatial_disc/constraints/dirichlet_boundary/lagrange_dirichlet_boundary.h"
+#include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/multi_grid_solver/mg_solver.h"
+#include "lib_grid/refinement/global_multi_grid_refiner.h"
+
+// Matrix-free GMG test (linked against libug4): the geometric multigrid for
+// a P1 discretization of -laplace(u) = 1 on the unit square (homogeneous
+// Dirichlet boundary) converges identically (up to rounding) with assembled
+// and with matrix-free operators on the levels above the base level, for a
+// Jacobi and a Chebyshev smoother.
+
+using namespace ug;
+
+typedef Domain2d TDomain;
+typedef CPUAlgebra TAlgebra;
+typedef TAlgebra::vector_type vector_type;
+typedef GridFunction<TDomain, TAlgebra> function_type;
+
+///	P1 finite elements for -laplace(u) = 1 on triangles
+class LaplaceP1 : public IElemDisc<TDomain>
+{
+	public:
+		LaplaceP1(const char* fct, const char* subsets)
+			: IElemDisc<TDomain>(fct, subsets) {}
+
+		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid)
+		{
+			UG_COND_THROW(vLfeID.size() != 1 || vLfeID[0] != LFEID(LFEID::LAGRANGE, dim, 1),
+						  "LaplaceP1: P1 Lagrange elements needed.");
+		}
+
+		virtual void prep_elem_loop(const ReferenceObjectID roid, const int si)
+		{
+			UG_COND_THROW(roid != ROID_TRIANGLE, "LaplaceP1: triangles only.");
+		}
+
+		virtual void prep_elem(const LocalVector& u, GridObject* elem,
+		                       const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
+		{
+		//	gradients of the barycentric coordinates and the area
+			const MathVector<dim>* x = vCornerCoords;
+			const number det = (x[1][0] - x[0][0]) * (x[2][1] - x[0][1])
+							 - (x[2][0] - x[0][0]) * (x[1][1] - x[0][1]);
+			m_area = 0.5 * std::fabs(det);
+			for(int i = 0; i < 3; ++i){
+				const MathVector<dim>& a = x[(i+1) % 3];
+				const MathVector<dim>& b = x[(i+2) % 3];
+				m_grad[i][0] = (a[1] - b[1]) / det;
+				m_grad[i][1] = (b[0] - a[0]) / det;
+			}
+		}
+
+		virtual void fsh_elem_loop() {}
+
+		virtual void add_jac_A_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem,
+		                            const MathVector<dim> vCornerCoords[])
+		{
+			for(int i = 0; i < 3; ++i)
+				for(int j = 0; j < 3; ++j)
+					J(0, i, 0, j) += m_area * VecDot(m_grad[i], m_grad[j]);
+		}
+
+		virtual void add_jac_M_elem(LocalMatrix& J, const LocalVector& u, GridObject* elem,
+		                            const MathVector<dim> vCornerCoords[]) {}
+
+		virtual void add_def_A_elem(LocalVector& d, const LocalVector& u, GridObject* elem,
+		                            const MathVector<dim> vCornerCoords[])
+		{
+			for(int i = 0; i < 3; ++i)
+				for(int j = 0; j < 3; ++j)
+					d(0, i) += m_area * VecDot(m_grad[i], m_grad[j]) * u(0, j);
+		}
+
+		virtual void add_def_M_elem(LocalVector& d, const LocalVector& u, GridObject* elem,
+		                            const MathVector<dim> vCornerCoords[]) {}
+
+		virtual void add_rhs_elem(LocalVector& rhs, GridObject* elem,
+		                          const MathVector<dim> vCornerCoords[])
+		{
+			for(int i = 0; i < 3; ++i)
+				rhs(0, i) += m_area / 3.0;
+		}
+
+	protected:
+		number m_area;
+		MathVector<dim> m_grad[3];
+};
+
+// defect norms of numIter multigrid iterations
+std::vector<number> solve(SmartPtr<ApproximationSpace<TDomain> > spApprox,
+                          SmartPtr<DomainDiscretization<TDomain, TAlgebra> > spDisc,
+                          SmartPtr<ILinearIterator<vector_type> > spSmoother,
+                          int matrixFreeLev, size_t numIter)
+{
+	SmartPtr<AssembledLinearOperator<TAlgebra> > spA
+		= make_sp(new AssembledLinearOperator<TAlgebra>(spDisc));
+	function_type u(spApprox), b(spApprox);
+	u.set(0.0);
+	AssembleLinearOperatorRhsAndSolution(*spA, u, b);
+
+	AssembledMultiGridCycle<TDomain, TAlgebra> gmg(spApprox);
+	gmg.set_discretization(spDisc);
+	gmg.set_base_level(0);
+	gmg.set_smoother(spSmoother);
+	gmg.set_num_presmooth(2);
+	gmg.set_num_postsmooth(2);
+	gmg.set_matrix_free_level(matrixFreeLev);
+	gmg.init(spA, u);
+
+	function_type c(spApprox), d(spApprox);
+	for(size_t i = 0; i < d.size(); ++i) d[i] = b[i];
+	spA->apply_sub(d, u);
+	std::vector<number> vDefect(1, d.norm());
+	for(size_t iter = 0; iter < numIter; ++iter){
+		gmg.apply_update_defect(c, d);
+		u += c;
+		vDefect.push_back(d.norm());
+	}
+	return vDefect;
+}
+
+bool check(SmartPtr<ApproximationSpace<TDomain> > spApprox,
+           SmartPtr<DomainDiscretization<TDomain, TAlgebra> > spDisc,
+           SmartPtr<ILinearIterator<vector_type> > spSmoother, const char* name)
+{
+	const size_t numIter = 8;
+	std::vector<number> vAssembled = solve(spApprox, spDisc, spSmoother, -1, numIter);
+	std::vector<number> vMatrixFree = solve(spApprox, spDisc, spSmoother->clone(), 1, numIter);
+
+	double maxDiff = 0;
+	for(size_t i = 0; i <= numIter; ++i)
+		maxDiff = std::max(maxDiff, std::fabs(vAssembled[i] - vMatrixFree[i]) / vAssembled[i]);
+	const number rate = std::pow(vAssembled[numIter] / vAssembled[0], 1.0 / numIter);
+
+	const bool bOk = maxDiff < 1e-8 && rate < 0.5;
+	std::cout << name << ": convergence rate < 0.5 " << (rate < 0.5 ? "yes" : "no")
+			  << ", matrix-free defects identical up to rounding "
+			  << (maxDiff < 1e-8 ? "yes" : "no") << (bOk ? "" : " FAIL") << std::endl;
+	return bOk;
+}
+
+int main(int argc, char** argv)
+{
+	UGInit(&argc, &argv);
+	int numErr = 0;
+
+	{
+		SmartPtr<TDomain> spDom = make_sp(new TDomain());
+		MultiGrid& mg = *spDom->grid();
+		MGSubsetHandler& sh = *spDom->subset_handler();
+		TDomain::position_accessor_type& aaPos = spDom->position_accessor();
+
+		RegularVertex* v[4];
+		const number x[4] = {0, 1, 1, 0}, y[4] = {0, 0, 1, 1};
+		for(int i = 0; i < 4; ++i){
+			v[i] = *mg.create<RegularVertex>();
+			aaPos[v[i]] = MathVector<2>(x[i], y[i]);
+		}
+		for(int i = 0; i < 4; ++i)
+			sh.assign_subset(*mg.create<RegularEdge>(EdgeDescriptor(v[i], v[(i+1) % 4])), 1);
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[1], v[2]));
+		mg.create<Triangle>(TriangleDescriptor(v[0], v[2], v[3]));
+		sh.assign_subset(mg.begin<Vertex>(), mg.end<Vertex>(), 1);
+		for(EdgeIterator iter = mg.begin<Edge>(); iter != mg.end<Edge>(); ++iter)
+			if(sh.get_subset_index(*iter) == -1) sh.assign_subset(*iter, 0);
+		sh.assign_subset(mg.begin<Face>(), mg.end<Face>(), 0);
+		sh.subset_info(0).name = "Inner";
+		sh.subset_info(1).name = "Boundary";
+
+		GlobalMultiGridRefiner refiner(mg);
+		for(int i = 0; i < 5; ++i)
+			refiner.refine();
+
+		SmartPtr<ApproximationSpace<TDomain> > spApprox
+			= make_sp(new ApproximationSpace<TDomain>(spDom, AlgebraType("CPU", 1)));
+		spApprox->add("u", "Lagrange", 1);
+		spApprox->init_levels();
+		spApprox->init_top_surface();
+
+		SmartPtr<DomainDiscretization<TDomain, TAlgebra> > spDisc
+			= make_sp(new DomainDiscretization<TDomain, TAlgebra>(spApprox));
+		SmartPtr<IElemDisc<TDomain> > spElemDisc(new LaplaceP1("u", "Inner"));
+		spDisc->add(spElemDisc);
+		SmartPtr<DirichletBoundary<TDomain, TAlgebra> > spDirichlet
+			= make_sp(new DirichletBoundary<TDomain, TAlgebra>());
+		spDirichlet->add(0.0, "u", "Boundary");
+		spDisc->add(SmartPtr<IDomainConstraint<TDomain, TAlgebra> >(spDirichlet));
+
+		if(!check(spApprox, spDisc, make_sp(new Jacobi<TAlgebra>(0.6)), "Jacobi"))
+			numErr++;
+		if(!check(spApprox, spDisc, make_sp(new Chebyshev<TAlgebra>(2)), "Chebyshev"))
+			numErr++;
+	}
+
+	std::cout << (numErr == 0 ? "matrix-free gmg: ok" : "matrix-free gmg: FAILED") << std::endl;
+	UGFinalize();
+	return numErr;
+}
@@ -0,0 +1,128 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/preconditioner/mixed_precision.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+#include "lib_algebra/operator/preconditioner/ilu.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/error.cpp"
+#include "common/progress.cpp"
+#include "lib_algebra/algebra_common/permutation_util.cpp"
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp"
+
+// Mixed precision test: the FloatMatrixOperator applies the matrix with single
+// precision entries (relative difference to the double matrix < 1e-6). A
+// MixedPrecision preconditioner wrapping a single precision Jacobi,
+// Gauss-Seidel or ILU computes the correction of its double precision
+// counterpart up to float rounding, and needs the same number of iterations
+// to reduce the defect of a 2d 5-point matrix by 1e-10. Initialized with a
+// FloatMatrixOperator, it gives the same correction as with the double matrix.
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+typedef MatrixOperator<M, V> MOp;
+typedef CPUFloatAlgebra::vector_type FV;
+
+static const size_t N = 30;
+
+double rel_diff(const V& a, const V& b)
+{
+	V e(a.size());
+	e = a; e -= b;
+	return e.norm() / a.norm();
+}
+
+// number of iterations to reduce the defect by 1e-10
+size_t iterations(SmartPtr<ILinearOperator<V> > spOp, ILinearIterator<V>& it)
+{
+	it.init(spOp);
+	V x(N*N), d(N*N), c(N*N);
+	for(size_t i = 0; i < N*N; ++i) d[i] = 1.;
+	const double d0 = d.norm();
+	size_t numIter = 0;
+	while(d.norm() > 1e-10 * d0 && numIter < 10000){
+		it.apply_update_defect(c, d);
+		x += c;
+		++numIter;
+	}
+	return numIter;
+}
+
+bool check(SmartPtr<MOp> spOp, IPreconditioner<CPUAlgebra>& precond,
+           SmartPtr<ILinearIterator<FV> > spFloatPrecond, const char* name)
+{
+	MixedPrecision<CPUAlgebra> mixed(spFloatPrecond);
+
+//	one application
+	V d(N*N), c1(N*N), c2(N*N);
+	for(size_t i = 0; i < N*N; ++i) d[i] = std::sin((double)i);
+	precond.init(spOp); precond.apply(c1, d);
+	mixed.init(spOp); mixed.apply(c2, d);
+	const double diff = rel_diff(c1, c2);
+
+//	initialized with a single precision operator
+	SmartPtr<FloatMatrixOperator<CPUAlgebra> > spFloatOp
+		= make_sp(new FloatMatrixOperator<CPUAlgebra>);
+	spFloatOp->set_matrix(spOp->get_matrix());
+	V c3(N*N);
+	mixed.init(SmartPtr<ILinearOperator<V> >(spFloatOp)); mixed.apply(c3, d);
+	const double diffFloatOp = rel_diff(c2, c3);
+
+//	convergence as preconditioner
+	const size_t numDouble = iterations(spOp, precond);
+	const size_t numMixed = iterations(spOp, mixed);
+	const size_t numFloatOp = iterations(spFloatOp, mixed);
+
+	const bool bOk = (diff < 1e-6) && (diffFloatOp == 0.0)
+			&& (numMixed == numDouble) && (numFloatOp == numDouble);
+	std::cout << name << ": difference to double < 1e-6 " << (diff < 1e-6 ? "yes" : "no")
+			<< ", with float operator identical " << (diffFloatOp == 0.0 ? "yes" : "no")
+			<< ", iterations double " << numDouble << ", mixed " << numMixed
+			<< ", float operator " << numFloatOp << (bOk ? "" : " FAIL") << "\n";
+	return bOk;
+}
+
+int main()
+{
+	SmartPtr<MOp> spOp = make_sp(new MOp);
+	M& A = spOp->get_matrix();
+	A.resize_and_clear(N*N, N*N);
+	for(size_t j = 0; j < N; ++j)
+		for(size_t i = 0; i < N; ++i){
+			const size_t k = j*N + i;
+			A(k, k) = 4.1;
+			if(i > 0) A(k, k-1) = -1.;
+			if(i+1 < N) A(k, k+1) = -1.;
+			if(j > 0) A(k, k-N) = -1.;
+			if(j+1 < N) A(k, k+N) = -1.;
+		}
+	A.defragment();
+
+//	the float operator
+	FloatMatrixOperator<CPUAlgebra> floatOp;
+	floatOp.set_matrix(A);
+	V x(N*N), y1(N*N), y2(N*N);
+	for(size_t i = 0; i < N*N; ++i) x[i] = std::cos((double)i) / 3.;
+	spOp->apply(y1, x); floatOp.apply(y2, x);
+	bool bOk = rel_diff(y1, y2) < 1e-6;
+	y1 = x; y2 = x;
+	spOp->apply_sub(y1, x); floatOp.apply_sub(y2, x);
+	bOk &= rel_diff(y1, y2) < 1e-6;
+	std::cout << "FloatMatrixOperator: apply and apply_sub difference to double < 1e-6 "
+			<< (bOk ? "yes" : "no FAIL") << "\n";
+
+	Jacobi<CPUAlgebra> jac(0.8);
+	bOk &= check(spOp, jac, make_sp(new Jacobi<CPUFloatAlgebra>(0.8)), "Jacobi");
+	GaussSeidel<CPUAlgebra> gs;
+	bOk &= check(spOp, gs, make_sp(new GaussSeidel<CPUFloatAlgebra>()), "GaussSeidel");
+	ILU<CPUAlgebra> ilu;
+	bOk &= check(spOp, ilu, make_sp(new ILU<CPUFloatAlgebra>()), "ILU");
+	return bOk ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_impl.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+
+// OpenMP algebra test (compiled with -fopenmp -DUG_OPENMP): the threaded
+// SpMV, transposed SpMV and BLAS-1 operations give the same results as with a
+// single thread, for a banded and a matrix with random (far off-diagonal)
+// entries, square and rectangular.
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+
+static unsigned int seed = 1;
+double rnd() {seed = seed * 1103515245u + 12345u; return (double)((seed >> 8) % 10000) / 10000.;}
+
+void create(M& A, size_t numRows, size_t numCols, bool bBanded)
+{
+	A.resize_and_clear(numRows, numCols);
+	for(size_t i = 0; i < numRows; ++i)
+		for(int k = 0; k < 7; ++k){
+			size_t c;
+			if(bBanded) c = std::min(numCols - 1, (i * numCols) / numRows + k);
+			else c = (size_t)(rnd() * numCols) % numCols;
+			A(i, c) += rnd() - 0.5;
+		}
+	A.defragment();
+}
+
+double diff(const V& a, const V& b)
+{
+	double d = 0;
+	for(size_t i = 0; i < a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+	return d;
+}
+
+struct Result
+{
+	V y, z;
+	double dot, norm;
+};
+
+void compute(const M& A, const V& x, const V& w, Result& r)
+{
+	r.y.resize(A.num_rows()); r.z.resize(A.num_cols());
+	A.axpy(r.y, 0.0, r.y, 1.0, x);
+	for(size_t i = 0; i < r.z.size(); ++i) r.z[i] = 1.0;
+	A.axpy_transposed(r.z, 2.0, r.z, -1.0, w);
+	r.dot = r.y.dotprod(w);
+	r.norm = r.z.norm();
+}
+
+bool check(size_t numRows, size_t numCols, bool bBanded)
+{
+	M A; create(A, numRows, numCols, bBanded);
+	V x(numCols), w(numRows);
+	for(size_t i = 0; i < numCols; ++i) x[i] = rnd();
+	for(size_t i = 0; i < numRows; ++i) w[i] = rnd();
+
+	Result seq, thr;
+	SetNumOMPThreads(1);
+	compute(A, x, w, seq);
+	SetNumOMPThreads(4);
+	compute(A, x, w, thr);
+
+	const double tol = 1e-12;
+	const bool bOk = diff(seq.y, thr.y) < tol && diff(seq.z, thr.z) < tol
+			&& std::fabs(seq.dot - thr.dot) < tol * std::fabs(seq.dot) + tol
+			&& std::fabs(seq.norm - thr.norm) < tol * seq.norm;
+	std::cout << numRows << " x " << numCols << (bBanded ? " banded" : " random")
+			<< ": " << (bOk ? "ok" : "FAIL") << "\n";
+	return bOk;
+}
+
+int main()
+{
+	SetOMPMinLoopSize(16);
+	bool bOk = check(1000, 1000, true);
+	bOk &= check(1000, 1000, false);
+	bOk &= check(997, 1301, true);
+	bOk &= check(1301, 997, false);
+	bOk &= check(5, 3, false);
+	return bOk ? 0 : 1;
+}
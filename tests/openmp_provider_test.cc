@@ -0,0 +1,200 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "common/util/openmp_util.h"
+#include "lib_disc/quadrature/quadrature_provider.h"
+#include "lib_disc/local_finite_element/local_finite_element_provider.h"
+#include "lib_disc/reference_element/reference_mapping_provider.h"
+#include "lib_disc/spatial_disc/disc_util/geom_provider.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/error.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/math/misc/math_util.cpp"
+#include "common/math/misc/lineintersect_utils.cpp"
+#include "common/math/misc/eigenvalues.cpp"
+#include "common/math/math_vector_matrix/math_vector.cpp"
+
+#include "lib_disc/reference_element/reference_element.cpp"
+#include "lib_disc/reference_element/reference_mapping_provider.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_vertex.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_edge.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_triangle.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_quadrilateral.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_tetrahedron.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_prism.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_pyramid.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_hexahedron.cpp"
+#include "lib_disc/quadrature/gauss/gauss_quad_octahedron.cpp"
+#include "lib_disc/quadrature/gauss_legendre/gauss_legendre.cpp"
+#include "lib_disc/quadrature/gauss_jacobi/gauss_jacobi10.cpp"
+#include "lib_disc/quadrature/gauss_jacobi/gauss_jacobi20.cpp"
+#include "lib_disc/quadrature/gauss_tensor_prod/gauss_tensor_prod.cpp"
+#include "lib_disc/quadrature/newton_cotes/newton_cotes.cpp"
+#include "lib_disc/quadrature/quadrature_provider.cpp"
+#include "lib_disc/local_finite_element/local_finite_element_id.cpp"
+#include "lib_disc/local_finite_element/local_dof_set.cpp"
+#include "lib_disc/local_finite_element/lagrange/lagrange.cpp"
+#include "lib_disc/local_finite_element/lagrange/lagrange_local_dof.cpp"
+#include "lib_disc/local_finite_element/lagrange/lagrangep1.cpp"
+#include "lib_disc/local_finite_element/mini/mini.cpp"
+#include "lib_disc/local_finite_element/local_finite_element_provider.cpp"
+
+// OpenMP provider test (compiled with -fopenmp -DUG_OPENMP): several threads
+// concurrently request quadrature rules and shape function sets (of orders
+// below and above the ones prepared in advance or published lock-free) and
+// use the thread-local geometries and reference mappings. Every thread must
+// get correct rules and sets and keep its own geometry and mapping.
+
+using namespace ug;
+
+static const int numThreads = 8;
+
+bool check_quadrature_rules()
+{
+	int numErr = 0;
+	#pragma omp parallel num_threads(numThreads) reduction(+:numErr)
+	{
+		try{
+			for(int iter = 0; iter < 20; ++iter)
+				for(size_t order = 0; order <= 16; ++order)
+				{
+					const size_t o = (order + OMPThreadID()) % 17;
+					const QuadratureRule<2>& tri = QuadratureRuleProvider<2>::get(ROID_TRIANGLE, o);
+					const QuadratureRule<2>& quad = QuadratureRuleProvider<2>::get(ROID_QUADRILATERAL, o);
+					double volTri = 0, volQuad = 0;
+					for(size_t ip = 0; ip < tri.size(); ++ip) volTri += tri.weight(ip);
+					for(size_t ip = 0; ip < quad.size(); ++ip) volQuad += quad.weight(ip);
+					if(tri.order() < o || quad.order() < o
+						|| std::fabs(volTri - 0.5) > 1e-12 || std::fabs(volQuad - 1.0) > 1e-12)
+						numErr++;
+				}
+		}
+		catch(UGError& err) {numErr++;}
+	}
+	std::cout << "quadrature rules: " << (numErr == 0 ? "ok" : "FAIL") << "\n";
+	return numErr == 0;
+}
+
+bool check_shape_function_sets()
+{
+	int numErr = 0;
+	#pragma omp parallel num_threads(numThreads) reduction(+:numErr)
+	{
+		try{
+			MathVector<2> x(0.2, 0.3);
+			for(int iter = 0; iter < 20; ++iter)
+				for(int order = 1; order <= 10; ++order)
+				{
+					const int p = 1 + (order + OMPThreadID()) % 10;
+					const LocalShapeFunctionSet<2>& lsfs = LocalFiniteElementProvider::get<2>
+							(ROID_TRIANGLE, LFEID(LFEID::LAGRANGE, 2, p));
+					std::vector<number> vShape(lsfs.num_sh());
+					lsfs.shapes(&vShape[0], x);
+					double sum = 0;
+					for(size_t sh = 0; sh < vShape.size(); ++sh) sum += vShape[sh];
+					if(lsfs.num_sh() != (size_t)((p+1)*(p+2)/2) || std::fabs(sum - 1.0) > 1e-10)
+						numErr++;
+				}
+		}
+		catch(UGError& err) {numErr++;}
+	}
+	std::cout << "shape function sets: " << (numErr == 0 ? "ok" : "FAIL") << "\n";
+	return numErr == 0;
+}
+
+///	geometry with local data depending on the trial space and quadrature order
+struct TestGeometry
+{
+	static const bool staticLocalData = false;
+
+	TestGeometry() : nsh(0), nip(0) {}
+
+	void update_local(ReferenceObjectID roid, const LFEID& lfeID, size_t quadOrder)
+	{
+		nsh = LocalFiniteElementProvider::get<2>(roid, lfeID).num_sh();
+		nip = QuadratureRuleProvider<2>::get(roid, quadOrder).size();
+	}
+
+	size_t nsh, nip;
+};
+
+bool check_geometries()
+{
+	int numErr = 0;
+	std::vector<const TestGeometry*> vGeom(numThreads, NULL);
+	#pragma omp parallel num_threads(numThreads) reduction(+:numErr)
+	{
+	//	every thread sets up its geometry with its own trial space and order
+		const int tid = OMPThreadID();
+		const LFEID lfeID(LFEID::LAGRANGE, 2, 1 + tid % 3);
+		const size_t quadOrder = 1 + tid;
+		TestGeometry* pGeo = NULL;
+		try{
+			pGeo = &GeomProvider<TestGeometry>::get(LFEID(LFEID::LAGRANGE, 2, 1), 2);
+			for(int iter = 0; iter < 20; ++iter)
+				pGeo->update_local((iter % 2) ? ROID_QUADRILATERAL : ROID_TRIANGLE, lfeID, quadOrder);
+		}
+		catch(UGError& err) {numErr++;}
+		vGeom[tid] = pGeo;
+
+		#pragma omp barrier
+
+	//	the geometry must not have been changed by the other threads
+		const size_t nsh = (lfeID.order()+1)*(lfeID.order()+1);
+		const size_t nip = QuadratureRuleProvider<2>::get(ROID_QUADRILATERAL, quadOrder).size();
+		if(pGeo == NULL || pGeo->nsh != nsh || pGeo->nip != nip) numErr++;
+	}
+
+	std::sort(vGeom.begin(), vGeom.end());
+	if(std::unique(vGeom.begin(), vGeom.end()) != vGeom.end()) numErr++;
+
+	std::cout << "geometries: " << (numErr == 0 ? "ok" : "FAIL") << "\n";
+	return numErr == 0;
+}
+
+bool check_reference_mappings()
+{
+	int numErr = 0;
+	#pragma omp parallel num_threads(numThreads) reduction(+:numErr)
+	{
+	//	every thread maps the reference triangle to its own triangle
+		const double s = 1 + OMPThreadID();
+		MathVector<2> vCorner[3];
+		vCorner[0] = MathVector<2>(0, 0);
+		vCorner[1] = MathVector<2>(s, 0);
+		vCorner[2] = MathVector<2>(0, s);
+		const DimReferenceMapping<2, 2>* pMap = NULL;
+		try{
+			pMap = &ReferenceMappingProvider::get<2, 2>(ROID_TRIANGLE, vCorner);
+		}
+		catch(UGError& err) {numErr++;}
+
+		#pragma omp barrier
+
+	//	the mapping must not have been updated by the other threads
+		if(pMap != NULL){
+			MathVector<2> glob;
+			pMap->local_to_global(glob, MathVector<2>(0.5, 0.5));
+			if(std::fabs(glob[0] - 0.5*s) > 1e-12 || std::fabs(glob[1] - 0.5*s) > 1e-12)
+				numErr++;
+		}
+	}
+	std::cout << "reference mappings: " << (numErr == 0 ? "ok" : "FAIL") << "\n";
+	return numErr == 0;
+}
+
+int main()
+{
+	bool bOk = check_quadrature_rules();
+	bOk &= check_shape_function_sets();
+	bOk &= check_geometries();
+	bOk &= check_reference_mappings();
+	return bOk ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "lib_disc/local_finite_element/lagrange/lagrange.h"
+#include "lib_disc/local_finite_element/lagrange/lagrange_sum_factorization.h"
+
+// Sum factorization test (linked against libug4): on quadrilaterals and
+// hexahedra of order p = 1..4, the values and reference gradients
+// interpolated by LagrangeSumFactorization and the integrals against the
+// shape functions and their gradients agree with the direct evaluation of
+// the shape functions of FlexLagrangeLSFS at the integration points.
+
+using namespace ug;
+
+static unsigned int seed = 1;
+double rnd() {seed = seed * 1103515245u + 12345u; return (double)((seed >> 8) % 10000) / 10000. - 0.5;}
+
+template <typename TRefElem>
+bool check(size_t p)
+{
+	static const int dim = TRefElem::dim;
+	FlexLagrangeLSFS<TRefElem> lsfs(p);
+	LagrangeSumFactorization<dim> sf(p, 2*p);
+
+	const size_t nsh = sf.num_sh(), nip = sf.num_ip();
+	if(nsh != lsfs.num_sh()) return false;
+
+	std::vector<number> vCoeff(nsh), vValue(nip), vIPValue(nip), vRes(nsh, 0.0);
+	std::vector<MathVector<dim> > vGrad(nip), vIPGrad(nip);
+	for(size_t i = 0; i < nsh; ++i) vCoeff[i] = rnd();
+	for(size_t q = 0; q < nip; ++q){
+		vIPValue[q] = rnd();
+		for(int d = 0; d < dim; ++d) vIPGrad[q][d] = rnd();
+	}
+
+	sf.values(&vValue[0], &vCoeff[0]);
+	sf.grads(&vGrad[0], &vCoeff[0]);
+	sf.integrate(&vRes[0], &vIPValue[0], &vIPGrad[0]);
+
+	double errValue = 0, errGrad = 0, errRes = 0;
+	std::vector<number> vResRef(nsh, 0.0);
+	for(size_t q = 0; q < nip; ++q){
+		const MathVector<dim>& x = sf.ips()[q];
+		number value = 0;
+		MathVector<dim> grad(0.0), g;
+		for(size_t i = 0; i < nsh; ++i){
+			const number phi = lsfs.shape(i, x);
+			lsfs.grad(g, i, x);
+			value += vCoeff[i] * phi;
+			VecScaleAppend(grad, vCoeff[i], g);
+			vResRef[i] += sf.weights()[q] * (vIPValue[q] * phi + VecDot(vIPGrad[q], g));
+		}
+		errValue = std::max(errValue, std::fabs(value - vValue[q]));
+		errGrad = std::max(errGrad, VecDistance(grad, vGrad[q]));
+	}
+	for(size_t i = 0; i < nsh; ++i)
+		errRes = std::max(errRes, std::fabs(vRes[i] - vResRef[i]));
+
+	const double tol = 1e-12;
+	const bool bOk = errValue < tol && errGrad < tol && errRes < tol;
+	std::cout << "  p = " << p << ": " << nsh << " shape functions, " << nip
+			  << " integration points, values, gradients and integrals "
+			  << (bOk ? "agree" : "FAIL") << std::endl;
+	return bOk;
+}
+
+int main(int argc, char** argv)
+{
+	int numErr = 0;
+	std::cout << "quadrilateral:" << std::endl;
+	for(size_t p = 1; p <= 4; ++p)
+		if(!check<ReferenceQuadrilateral>(p)) numErr++;
+	std::cout << "hexahedron:" << std::endl;
+	for(size_t p = 1; p <= 4; ++p)
+		if(!check<ReferenceHexahedron>(p)) numErr++;
+
+	std::cout << (numErr == 0 ? "sum factorization: ok" : "sum factorization: FAILED") << std::endl;
+	return numErr;
+}
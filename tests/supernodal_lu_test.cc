@@ -0,0 +1,85 @@
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/linear_solver/lu.h"
+
+#include "common/log.cpp" // ?
+#include "common/debug_id.cpp" // ?
+#include "common/assert.cpp" // ?
+#include "common/util/crc32.cpp" // ?
+#include "common/util/ostream_buffer_splitter.cpp" // ?
+#include "common/util/string_util.cpp" // ?
+#include "common/error.cpp"
+#include "common/progress.cpp"
+#include "lib_algebra/algebra_common/permutation_util.cpp"
+#include "lib_algebra/ordering_strategies/algorithms/native_cuthill_mckee.cpp"
+#include "lib_algebra/operator/linear_solver/supernodal_lu.cpp"
+
+// supernodal LU test: the symbolic factorization is reused for a matrix
+// with unchanged pattern and only recomputed if the pattern changes
+
+using namespace ug;
+
+typedef CPUAlgebra::matrix_type M;
+typedef CPUAlgebra::vector_type V;
+typedef MatrixOperator<M, V> MOp;
+
+static const size_t N = 40;
+
+// 5-point stencil on a N x N grid, scaled by s on the diagonal
+void assemble(M& A, double s, bool extraEntry)
+{
+	A.resize_and_clear(N*N, N*N);
+	for(size_t j = 0; j < N; ++j)
+		for(size_t i = 0; i < N; ++i){
+			const size_t k = j*N + i;
+			A(k, k) = 4. * s;
+			if(i > 0) A(k, k-1) = -1.;
+			if(i+1 < N) A(k, k+1) = -1.;
+			if(j > 0) A(k, k-N) = -1.;
+			if(j+1 < N) A(k, k+N) = -1.;
+		}
+	if(extraEntry){
+		A(0, N*N-1) = -0.5;
+		A(N*N-1, 0) = -0.5;
+	}
+	A.defragment();
+}
+
+double error(MOp& op, LU<CPUAlgebra>& lu)
+{
+	M& A = op.get_matrix();
+	V x(N*N), b(N*N), y(N*N);
+	for(size_t i = 0; i < N*N; ++i) x[i] = 1. + (double)(i % 7);
+	A.apply(b, x);
+	lu.apply(y, b);
+	double err = 0;
+	for(size_t i = 0; i < N*N; ++i) err = std::max(err, std::fabs(y[i] - x[i]));
+	return err;
+}
+
+int main()
+{
+	SmartPtr<MOp> spOp = make_sp(new MOp);
+	LU<CPUAlgebra> lu;
+	lu.set_minimum_for_sparse(0);
+	lu.set_show_progress(false);
+
+	for(int it = 0; it < 3; ++it){
+		assemble(spOp->get_matrix(), 1. + 0.5 * it, false);
+		lu.init(spOp);
+		std::cout << "same pattern, factorization " << it
+			<< ": analyze calls " << lu.supernodal().num_analyze()
+			<< ", error " << (error(*spOp, lu) < 1e-10 ? "ok" : "FAIL") << "\n";
+	}
+
+	assemble(spOp->get_matrix(), 1., true);
+	lu.init(spOp);
+	std::cout << "changed pattern: analyze calls " << lu.supernodal().num_analyze()
+		<< ", error " << (error(*spOp, lu) < 1e-10 ? "ok" : "FAIL") << "\n";
+
+	lu.set_sort_sparse(false);
+	lu.init(spOp);
+	std::cout << "changed ordering: analyze calls " << lu.supernodal().num_analyze()
+		<< ", error " << (error(*spOp, lu) < 1e-10 ? "ok" : "FAIL") << "\n";
+
+	return lu.supernodal().num_analyze() == 3 ? 0 : 1;
+}
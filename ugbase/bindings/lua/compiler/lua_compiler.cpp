@@ -115,7 +115,7 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 		UG_DLOG(DID_LUACOMPILER, 5, GetFileLines((p+"LUACompiler_output.c").c_str(), 1, -1, true) << "\n");
 
 
-		string c1s=string("gcc -fpic -O3 -c ") + p + "LUACompiler_output.c -o " + p + "LUACompiler_output.o";
+		string c1s=string("gcc -fpic -O3 -fopenmp-simd -c ") + p + "LUACompiler_output.c -o " + p + "LUACompiler_output.o";
 		UG_DLOG(DID_LUACOMPILER, 2, "compiling line: " << c1s << "\n");
 		if(system(c1s.c_str()) != 0)
 		{
@@ -166,6 +166,8 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			return false;
 		}
 		m_f = (LUA2C_Function) GetLibraryProcedure(m_libHandle, functionName);
+		m_fBatch = (LUA2C_BatchFunction) GetLibraryProcedure(m_libHandle,
+		                                        (string(functionName) + "_batch").c_str());
 
 		if(m_f !=nullptr) { UG_DLOG(DID_LUACOMPILER, 1, "OK\n"); }
 		else { UG_DLOG(DID_LUACOMPILER, 1, "FAILED\n"); }
@@ -275,6 +277,19 @@ bool LUACompiler::call(double *ret, const double *in) const
 	}
 }
 
+bool LUACompiler::call_batch(double *ret, const double *in, size_t n, size_t inStride) const
+{
+	if(!bVM && m_fBatch != nullptr)
+	{
+		m_fBatch(ret, in, (int)n, (int)inStride);
+		return true;
+	}
+
+	for(size_t i = 0; i < n; ++i)
+		call(ret + i*m_iOut, in + i*inStride);
+	return true;
+}
+
 
 }
 }
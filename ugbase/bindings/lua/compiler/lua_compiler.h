@@ -51,6 +51,7 @@ class LUACompiler
 	
 private:
 	typedef int (*LUA2C_Function)(double *, const double *) ;
+	typedef void (*LUA2C_BatchFunction)(double *, const double *, int, int) ;
 	
 	DynLibHandle m_libHandle;
 	std::string m_pDyn;
@@ -59,12 +60,14 @@ private:
 public:
 	std::string m_name;
 	LUA2C_Function m_f;
+	LUA2C_BatchFunction m_fBatch;
 	int m_iIn, m_iOut;
 	bool bInitialized;
 	bool bVM;
 	LUACompiler()
 	{ 
 		m_f= nullptr;
+		m_fBatch = nullptr;
 		m_name = "uninitialized"; 
 		m_pDyn = ""; 
 		m_libHandle = nullptr;
@@ -98,6 +101,15 @@ public:
 	bool createC(const char *functionName, LuaFunctionHandle* pHandle = nullptr);
 	
 	bool call(double *ret, const double *in) const;
+
+	/// evaluates the function for n points
+	/**
+	 * The input values of point i start at in[i*inStride], the return
+	 * values of point i are written to ret[i*num_out()]. If the compiled
+	 * library provides a batched (loop-vectorized) version of the function
+	 * it is used, otherwise the function is called for every point.
+	 */
+	bool call_batch(double *ret, const double *in, size_t n, size_t inStride) const;
 	virtual ~LUACompiler();
 };
 
@@ -345,6 +345,16 @@ int LUAParserClass::createC(ostream &out)
 	out << "\t// code:\n";
 	for(size_t i=0; i<nodes.size(); i++)
 		createC(nodes[i], out, 1);
+	out << "}\n\n";
+
+	// batched version for several points (vectorized loop)
+	out << "void " << name << "_batch(";
+	out << "double *LUA2C_ret, const double *LUA2C_in, int LUA2C_n, int LUA2C_inStride)\n";
+	out << "{\n";
+	out << "\tint LUA2C_i;\n";
+	out << "#pragma omp simd\n";
+	out << "\tfor(LUA2C_i = 0; LUA2C_i < LUA2C_n; ++LUA2C_i)\n";
+	out << "\t\t" << name << "(LUA2C_ret + LUA2C_i*" << numOut << ", LUA2C_in + LUA2C_i*LUA2C_inStride);\n";
 	out << "}\n";
 	return LUAParserOK;
 }
@@ -134,6 +134,9 @@ void RegisterLuaUserDataType(Registry& reg, string type, string grp)
 		reg.add_class_<T, TBase>(name, grp)
 			.template add_constructor<void (*)(const char*)>("Callback")
 			.template add_constructor<void (*)(LuaFunctionHandle)>("handle")
+			.add_method("set_batch_callback", static_cast<void (T::*)(const char*)>(&T::set_batch_callback), "", "Callback",
+				"sets a callback evaluating all points of an element at once (tables of coordinates and values)")
+			.add_method("set_batch_callback", static_cast<void (T::*)(LuaFunctionHandle)>(&T::set_batch_callback), "", "handle")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, string("LuaUser").append(type), tag);
 	}
@@ -146,6 +149,9 @@ void RegisterLuaUserDataType(Registry& reg, string type, string grp)
 		reg.add_class_<T, TBase>(name, grp)
 			.template add_constructor<void (*)(const char*)>("Callback")
 			.template add_constructor<void (*)(LuaFunctionHandle)>("handle")
+			.add_method("set_batch_callback", static_cast<void (T::*)(const char*)>(&T::set_batch_callback), "", "Callback",
+				"sets a callback evaluating all points of an element at once (tables of coordinates and values)")
+			.add_method("set_batch_callback", static_cast<void (T::*)(LuaFunctionHandle)>(&T::set_batch_callback), "", "handle")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, string("LuaCondUser").append(type), tag);
 	}
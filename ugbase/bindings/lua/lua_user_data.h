@@ -36,6 +36,7 @@
 
 #include <stdarg.h>
 #include <string>
+#include <vector>
 #include "registry/registry.h"
 
 
@@ -135,6 +136,30 @@ class LuaUserData
 	///	evaluates the data at a given point and time
 		inline TRet evaluate(TData& D, const MathVector<dim>& x, number time, int si) const;
 
+	///	evaluates the data at several points
+	/**
+	 * If LUA2C is used, the compiled function is called for all points at
+	 * once (loop-vectorized). If a batch callback is set, it is called once
+	 * for all points. Otherwise the callback is called for every point.
+	 */
+		void evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+		                    number time, int si, const size_t nip) const;
+
+	///	sets a lua callback evaluating the data for several points at once
+	/**
+	 * The batch callback gets one table per coordinate direction holding
+	 * the coordinates of all points, the time and the subset index. It
+	 * returns one table per returned value (see batch_signature()), holding
+	 * the values for all points.
+	 */
+	///{
+		void set_batch_callback(const char* luaCallback);
+		void set_batch_callback(LuaFunctionHandle handle);
+	///}
+
+	///	returns string of required batch callback signature
+		static std::string batch_signature();
+
 	protected:
 	///	sets that LuaUserData is created by LuaUserDataFactory
 		void set_created_from_factory(bool bFromFactory) {m_bFromFactory = bFromFactory;}
@@ -145,6 +170,12 @@ class LuaUserData
 
 	///	reference to lua function
 		int m_callbackRef;
+
+	///	reference to lua function evaluating several points (LUA_NOREF if unused)
+		int m_batchCallbackRef;
+
+	///	buffers used for batched evaluation
+		mutable std::vector<double> m_vBatchIn, m_vBatchRet;
 		
 		#ifdef USE_LUA2C
     	/// LUACompiler type for compiled LUA code
@@ -90,7 +90,7 @@ std::string LuaUserData<TData,dim,TRet>::name()
 
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::LuaUserData(const char* luaCallback)
-	: m_callbackName(luaCallback), m_bFromFactory(false)
+	: m_callbackName(luaCallback), m_batchCallbackRef(LUA_NOREF), m_bFromFactory(false)
 {
 //	get lua state
 	m_L = ug::script::GetDefaultLuaState();
@@ -117,7 +117,8 @@ LuaUserData<TData,dim,TRet>::LuaUserData(const char* luaCallback)
 
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::LuaUserData(LuaFunctionHandle handle)
-	: m_callbackName("__anonymous__lua__function__"), m_bFromFactory(false)
+	: m_callbackName("__anonymous__lua__function__"), m_batchCallbackRef(LUA_NOREF),
+	  m_bFromFactory(false)
 {
 //	get lua state
 	m_L = ug::script::GetDefaultLuaState();
@@ -349,11 +350,171 @@ evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
 	}
 }
 
+template <typename TData, int dim, typename TRet>
+std::string LuaUserData<TData,dim,TRet>::batch_signature()
+{
+	std::stringstream ss;
+	ss << "function name(";
+	if(dim >= 1) ss << "vx";
+	if(dim >= 2) ss << ", vy";
+	if(dim >= 3) ss << ", vz";
+	ss << ", t, si)\n   ... \n   return ";
+	const int retSize = lua_traits<TData>::size + lua_traits<TRet>::size;
+	for(int i = 0; i < retSize; ++i){
+		if(i > 0) ss << ", ";
+		ss << "{...}";
+	}
+	ss << "\nend\n(one table per coordinate and per returned value,"
+	      " each holding the entries for all points";
+	if(lua_traits<TRet>::size != 0) ss << "; the first returned table holds the flags";
+	ss << ")";
+	return ss.str();
+}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::set_batch_callback(const char* luaCallback)
+{
+	lua_getglobal(m_L, luaCallback);
+	if(lua_isnil(m_L, -1)){
+		lua_pop(m_L, 1);
+		UG_THROW(name() << ": Specified lua batch callback "
+						"does not exist: " << luaCallback);
+	}
+
+	LuaFunctionHandle handle;
+	handle.ref = luaL_ref(m_L, LUA_REGISTRYINDEX);
+	set_batch_callback(handle);
+}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::set_batch_callback(LuaFunctionHandle handle)
+{
+	if(m_batchCallbackRef != LUA_NOREF)
+		luaL_unref(m_L, LUA_REGISTRYINDEX, m_batchCallbackRef);
+	m_batchCallbackRef = handle.ref;
+
+//	make a test run with one point
+	MathVector<dim> x; x = 0.0;
+	TData val;
+	try{
+		evaluate_batch(&val, &x, 0.0, 0, 1);
+	}
+	catch(UGError& err){
+		luaL_unref(m_L, LUA_REGISTRYINDEX, m_batchCallbackRef);
+		m_batchCallbackRef = LUA_NOREF;
+		UG_THROW(name() << ": Batch callback cannot be used: " << err.get_msg());
+	}
+}
+
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::
+evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+               number time, int si, const size_t nip) const
+{
+	PROFILE_CALLBACK()
+	if(nip == 0) return;
+	TRet* t = NULL;
+
+	#ifdef USE_LUA2C
+	if(useLuaCompiler && m_luaComp.is_valid())
+	{
+	//	store the points consecutively
+		const size_t inSize = dim+2, retSize = m_luaComp.num_out();
+		m_vBatchIn.resize(nip * inSize);
+		m_vBatchRet.resize(nip * retSize);
+		for(size_t ip = 0; ip < nip; ++ip)
+		{
+			double* in = &m_vBatchIn[ip * inSize];
+			for(int i = 0; i < dim; i++)
+				in[i] = vGlobIP[ip][i];
+			in[dim] = time;
+			in[dim+1] = si;
+		}
+
+		m_luaComp.call_batch(&m_vBatchRet[0], &m_vBatchIn[0], nip, inSize);
+
+		for(size_t ip = 0; ip < nip; ++ip)
+			lua_traits<TData>::read(vValue[ip], &m_vBatchRet[ip * retSize], t);
+		return;
+	}
+	#endif
+
+	if(m_batchCallbackRef == LUA_NOREF)
+	{
+		for(size_t ip = 0; ip < nip; ++ip)
+			evaluate(vValue[ip], vGlobIP[ip], time, si);
+		return;
+	}
+
+//	push the batch callback function on the stack
+	lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_batchCallbackRef);
+
+//	push one table per coordinate
+	for(int d = 0; d < dim; ++d)
+	{
+		lua_createtable(m_L, (int)nip, 0);
+		for(size_t ip = 0; ip < nip; ++ip)
+		{
+			lua_pushnumber(m_L, vGlobIP[ip][d]);
+			lua_rawseti(m_L, -2, (int)ip+1);
+		}
+	}
+
+//	push time and subset index on stack
+	lua_traits<number>::push(m_L, time);
+	lua_traits<int>::push(m_L, si);
+
+//	compute total return size
+	const int retSize = lua_traits<TData>::size + lua_traits<TRet>::size;
+
+//	call lua function
+	if(lua_pcall(m_L, dim + 2, retSize, 0) != 0)
+		UG_THROW(name() << "::evaluate_batch(...): Error while "
+						"running batch callback, lua message: "<< lua_tostring(m_L, -1)<<".\n"
+						"Use signature as follows:\n"
+						<< batch_signature());
+
+//	read the returned tables into the buffer (same layout as LUA2C)
+	m_vBatchRet.resize(nip * retSize);
+	const int base = lua_gettop(m_L) - retSize + 1;
+	try{
+		for(int k = 0; k < retSize; ++k)
+		{
+			if(!lua_istable(m_L, base + k))
+				UG_THROW("Returned value " << k+1 << " is not a table.");
+
+			for(size_t ip = 0; ip < nip; ++ip)
+			{
+				lua_rawgeti(m_L, base + k, (int)ip+1);
+				if(lua_isboolean(m_L, -1))
+					m_vBatchRet[ip * retSize + k] = lua_toboolean(m_L, -1) ? 1.0 : 0.0;
+				else
+					m_vBatchRet[ip * retSize + k] = ReturnValueToNumber(m_L, -1);
+				lua_pop(m_L, 1);
+			}
+		}
+	}
+	catch(UGError& err){
+		lua_pop(m_L, retSize);
+		UG_THROW(name() << "::evaluate_batch(...): Error while reading the "
+						"results of the batch callback: " << err.get_msg() << "\n"
+						"Use signature as follows:\n" << batch_signature());
+	}
+
+//	pop values
+	lua_pop(m_L, retSize);
+
+	for(size_t ip = 0; ip < nip; ++ip)
+		lua_traits<TData>::read(vValue[ip], &m_vBatchRet[ip * retSize], t);
+}
+
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::~LuaUserData()
 {
 //	free reference to callback
 	luaL_unref(m_L, LUA_REGISTRYINDEX, m_callbackRef);
+	if(m_batchCallbackRef != LUA_NOREF)
+		luaL_unref(m_L, LUA_REGISTRYINDEX, m_batchCallbackRef);
 
 	if(m_bFromFactory)
 		LuaUserDataFactory<TData,dim,TRet>::remove(m_callbackName);
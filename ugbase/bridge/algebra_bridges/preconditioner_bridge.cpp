@@ -47,6 +47,8 @@
 #include "lib_algebra/operator/preconditioner/ilut_scalar.h"
 #include "lib_algebra/operator/linear_solver/agglomerating_solver.h"
 #include "lib_algebra/operator/preconditioner/block_gauss_seidel.h"
+#include "lib_algebra/operator/preconditioner/bsr_smoothers.h"
+#include "lib_algebra/operator/bsr_matrix_operator.h"
 
 #include "lib_algebra/ordering_strategies/algorithms/IOrderingAlgorithm.h"
 
@@ -152,6 +154,27 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev-Jacobi Preconditioner")
+			.add_constructor()
+			.template add_constructor<void (*)(size_t)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree", "sets the degree of the polynomial (default: 3)")
+			.add_method("set_power_iterations", &T::set_power_iterations, "", "numIter",
+					"sets the number of power iterations used to estimate the largest eigenvalue of D^{-1}A (default: 10)")
+			.add_method("set_eigenvalue_range", &T::set_eigenvalue_range, "", "lower#upper",
+					"sets the smoothed interval relative to the largest eigenvalue (default: [0.1, 1.1])")
+			.add_method("set_max_eigenvalue", &T::set_max_eigenvalue, "", "lambda",
+					"sets the largest eigenvalue of D^{-1}A and disables the estimation")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "lambda", "",
+					"returns the largest eigenvalue of D^{-1}A (set or last estimated)")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -160,6 +183,10 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Base")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "makes the matrix and defect consistent at the proc. interfaces")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_sweep_type", &T::set_sweep_type, "", "type",
+					"sets the order in which the rows are relaxed: sequential, multicolor or hybrid")
+			.add_method("set_comm_comp_overlap", &T::set_comm_comp_overlap, "", "overlap",
+					"relaxes the interface rows first and exchanges the correction while the remaining rows are relaxed")
 			//.add_method("set_ordering_algorithm", &T::set_ordering_algorithm, "", "",
 			//			"sets an ordering algorithm")
 			.add_method("set_sor_relax", &T::set_sor_relax,
@@ -233,6 +260,10 @@ static void Algebra(Registry& reg, string grp)
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_triangular_solve", &T::set_triangular_solve, "", "type",
+						"sets the triangular solves: sequential (default), levels (level-scheduled, threaded) or jacobi (approximate)")
+			.add_method("set_num_jacobi_sweeps", &T::set_num_jacobi_sweeps, "", "numSweeps",
+						"number of jacobi sweeps of the approximate triangular solves")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILU", tag);
 	}
@@ -358,6 +389,172 @@ static void Algebra(Registry& reg, string grp)
 
 }; // end Functionality
 
+/**
+ * Registers the preconditioners and the operator using a BSR copy of the
+ * matrix. Only available for the algebras with fixed block size.
+ */
+template <typename TAlgebra>
+static void BSRAlgebra(Registry& reg, string grp)
+{
+	string suffix = GetAlgebraSuffix<TAlgebra>();
+	string tag = GetAlgebraTag<TAlgebra>();
+
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename TAlgebra::matrix_type matrix_type;
+
+//	BSRJacobi
+	{
+		typedef BSRJacobi<TAlgebra> T;
+		typedef Jacobi<TAlgebra> TBase;
+		string name = string("BSRJacobi").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Jacobi Preconditioner using BSR block kernels")
+			.add_constructor()
+			.template add_constructor<void (*)(number)>("DampingFactor")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BSRJacobi", tag);
+	}
+
+//	BSRGaussSeidel, BSRBackwardGaussSeidel, BSRSymmetricGaussSeidel
+	{
+		typedef BSRGaussSeidelBase<TAlgebra> T;
+		typedef GaussSeidelBase<TAlgebra> TBase;
+		string name = string("BSRGaussSeidelBase").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Base using BSR block kernels");
+		reg.add_class_to_group(name, "BSRGaussSeidelBase", tag);
+	}
+	{
+		typedef BSRGaussSeidel<TAlgebra> T;
+		typedef BSRGaussSeidelBase<TAlgebra> TBase;
+		string name = string("BSRGaussSeidel").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Preconditioner using BSR block kernels")
+			.add_constructor()
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BSRGaussSeidel", tag);
+	}
+	{
+		typedef BSRBackwardGaussSeidel<TAlgebra> T;
+		typedef BSRGaussSeidelBase<TAlgebra> TBase;
+		string name = string("BSRBackwardGaussSeidel").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Backward Gauss-Seidel Preconditioner using BSR block kernels")
+			.add_constructor()
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BSRBackwardGaussSeidel", tag);
+	}
+	{
+		typedef BSRSymmetricGaussSeidel<TAlgebra> T;
+		typedef BSRGaussSeidelBase<TAlgebra> TBase;
+		string name = string("BSRSymmetricGaussSeidel").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Symmetric Gauss-Seidel Preconditioner using BSR block kernels")
+			.add_constructor()
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BSRSymmetricGaussSeidel", tag);
+	}
+
+//	BSRMatrixOperator
+	{
+		typedef BSRMatrixOperator<TAlgebra> T;
+		typedef ILinearOperator<vector_type> TBase;
+		string name = string("BSRMatrixOperator").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Linear operator applying a BSR copy of a matrix")
+			.template add_constructor<void (*)(SmartPtr<MatrixOperator<matrix_type, vector_type> >)>("MatrixOperator")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "BSRMatrixOperator", tag);
+	}
+
+//	BenchmarkBSR
+	{
+		reg.add_function("BenchmarkBSR", &BenchmarkBSR<TAlgebra>, grp, "", "MatrixOperator#numIter",
+				"compares SpMV, Jacobi and Gauss-Seidel of the SparseMatrix with their BSR variants");
+	}
+}
+
+#ifdef UG_CPU_1
+/**
+ * Registers the single precision preconditioners that can be used inside of
+ * MixedPrecision. The float algebra is only used internally, therefore only
+ * the preconditioners and the interfaces needed to pass them are exported.
+ */
+static void FloatAlgebra(Registry& reg, string grp)
+{
+	typedef CPUFloatAlgebra TFloatAlgebra;
+	typedef TFloatAlgebra::vector_type float_vector_type;
+
+//	ILinearIteratorFloat
+	{
+		typedef ILinearIterator<float_vector_type> T;
+		string name = string("ILinearIteratorFloat");
+		reg.add_class_<T>(name, grp)
+			.add_method("set_damp", static_cast<void (T::*)(number)>(&T::set_damp), "", "damp", "set the damping to a number")
+			.add_method("config_string", &T::config_string, "strConfiguration", "", "string to display configuration of the linear iterator")
+			.add_method("name", &T::name);
+	}
+
+//	IPreconditionerFloat
+	{
+		typedef IPreconditioner<TFloatAlgebra> T;
+		typedef ILinearIterator<float_vector_type> TBase;
+		string name = string("IPreconditionerFloat");
+		reg.add_class_<T, TBase>(name, grp);
+	}
+
+//	JacobiFloat
+	{
+		typedef Jacobi<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("JacobiFloat");
+		reg.add_class_<T,TBase>(name, grp, "Jacobi Preconditioner (single precision)")
+			.add_constructor()
+			.add_constructor<void (*)(number)>("DampingFactor")
+			.set_construct_as_smart_pointer(true);
+	}
+
+//	GaussSeidelFloat
+	{
+		typedef GaussSeidel<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("GaussSeidelFloat");
+		reg.add_class_<T,TBase>(name, grp, "Gauss-Seidel Preconditioner (single precision)")
+			.add_constructor()
+			.add_method("set_sor_relax", &T::set_sor_relax,
+					"", "sor relaxation", "sets sor relaxation parameter")
+			.set_construct_as_smart_pointer(true);
+	}
+
+//	ILUFloat
+	{
+		typedef ILU<TFloatAlgebra> T;
+		typedef IPreconditioner<TFloatAlgebra> TBase;
+		string name = string("ILUFloat");
+		reg.add_class_<T,TBase>(name, grp, "Incomplete LU Decomposition (single precision)")
+			.add_constructor()
+			.add_method("set_beta", &T::set_beta, "", "beta")
+			.add_method("set_inversion_eps", &T::set_inversion_eps, "", "eps")
+			.add_method("set_triangular_solve", &T::set_triangular_solve, "", "type",
+						"sets the triangular solves: sequential (default), levels (level-scheduled, threaded) or jacobi (approximate)")
+			.add_method("set_num_jacobi_sweeps", &T::set_num_jacobi_sweeps, "", "numSweeps",
+						"number of jacobi sweeps of the approximate triangular solves")
+			.set_construct_as_smart_pointer(true);
+	}
+
+//	MixedPrecision
+	{
+		typedef CPUAlgebra TAlgebra;
+		typedef MixedPrecision<TAlgebra, TFloatAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string suffix = GetAlgebraSuffix<TAlgebra>();
+		string tag = GetAlgebraTag<TAlgebra>();
+		string name = string("MixedPrecision").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Applies a single precision preconditioner to a double precision system")
+			.add_constructor()
+			.add_constructor<void (*)(SmartPtr<ILinearIterator<float_vector_type> >)>("FloatPreconditioner")
+			.add_method("set_preconditioner", &T::set_preconditioner, "", "FloatPreconditioner",
+					"sets the single precision preconditioner")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MixedPrecision", tag);
+	}
+}
+#endif
+
 // end group precond_bridge
 /// \}
 
@@ -371,6 +568,27 @@ void RegisterBridge_Preconditioner(Registry& reg, string grp)
 
 	try{
 		RegisterAlgebraDependent<Functionality>(reg,grp);
+#ifdef UG_CPU_1
+		Preconditioner::FloatAlgebra(reg, grp);
+#endif
+#ifdef UG_CPU_1
+		Preconditioner::BSRAlgebra<CPUAlgebra>(reg, grp);
+#endif
+#ifdef UG_CPU_2
+		Preconditioner::BSRAlgebra<CPUBlockAlgebra<2> >(reg, grp);
+#endif
+#ifdef UG_CPU_3
+		Preconditioner::BSRAlgebra<CPUBlockAlgebra<3> >(reg, grp);
+#endif
+#ifdef UG_CPU_4
+		Preconditioner::BSRAlgebra<CPUBlockAlgebra<4> >(reg, grp);
+#endif
+#ifdef UG_CPU_5
+		Preconditioner::BSRAlgebra<CPUBlockAlgebra<5> >(reg, grp);
+#endif
+#ifdef UG_CPU_6
+		Preconditioner::BSRAlgebra<CPUBlockAlgebra<6> >(reg, grp);
+#endif
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
 }
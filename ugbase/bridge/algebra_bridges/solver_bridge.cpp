@@ -48,6 +48,8 @@
 #include "lib_algebra/operator/linear_solver/analyzing_solver.h"
 #include "lib_algebra/operator/linear_solver/cg.h"
 #include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_bicgstab.h"
 #include "lib_algebra/operator/linear_solver/gmres.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
 #include "lib_algebra/operator/linear_solver/agglomerating_solver.h"
@@ -234,6 +236,32 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "BiCGStab", tag);
 	}
 
+// 	Pipelined CG Solver
+	{
+		typedef PipelinedCG<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipelinedCG").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined Conjugate Gradient Solver (one non-blocking reduction per iteration)")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipelinedCG", tag);
+	}
+
+// 	Pipelined BiCGStab Solver
+	{
+		typedef PipelinedBiCGStab<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipelinedBiCGStab").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined BiCGStab Solver (two non-blocking reductions per iteration)")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipelinedBiCGStab", tag);
+	}
+
 // 	GMRES Solver
 	{
 		typedef GMRES<vector_type> T;
@@ -255,9 +283,10 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "LU-Decomposition exact solver")
 			.add_constructor()
 			.add_method("set_minimum_for_sparse", &T::set_minimum_for_sparse, "", "N")
-			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in in sparse LU. default true")
+			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a fill-reducing ordering in sparse LU (minimum degree for supernodal LU, cuthill-mckee for ILUT). default true")
 			.add_method("set_info", &T::set_info, "", "bInfo", "if true, sparse LU prints some fill-in info")
 			.add_method("set_show_progress", &T::set_show_progress, "", "onoff", "switches the progress indicator on/off")
+			.add_method("set_supernodal", &T::set_supernodal, "", "bSupernodal", "if true, sparse LU uses the supernodal factorization, else ILUT(0). default true")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "LU", tag);
 	}
@@ -57,6 +57,7 @@
 #include "lib_disc/time_disc/time_integrator_observers/lua_callback_observer.hpp"
 #include "lib_disc/time_disc/time_integrator_subject.hpp"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/matrix_free_operator.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/line_search.h"
 #include "lib_disc/operator/linear_operator/nested_iteration/nested_iteration.h"
@@ -265,6 +266,24 @@ static void Algebra(Registry& reg, string parentGroup)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AssembledLinearOperator", tag);
 	}
+
+//	MatrixFreeOperator
+	{
+		std::string grp = parentGroup; grp.append("/Discretization");
+		typedef MatrixFreeOperator<TAlgebra> T;
+		typedef ILinearOperator<vector_type> TBase;
+		string name = string("MatrixFreeOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, grp)
+			.template add_constructor<void (*)(SmartPtr<IAssemble<TAlgebra> >)>("Assembling Routine")
+			.template add_constructor<void (*)(SmartPtr<IAssemble<TAlgebra> >, const GridLevel&)>("AssemblingRoutine#GridLevel")
+			.add_method("set_discretization", &T::set_discretization)
+			.add_method("set_level", &T::set_level)
+			.add_method("set_force_regular_grid", &T::set_force_regular_grid)
+			.add_method("diagonal", &T::diagonal)
+			.add_method("level", &T::level)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeOperator", tag);
+	}
 	
 
 //	NewtonSolver
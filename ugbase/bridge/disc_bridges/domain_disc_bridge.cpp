@@ -46,6 +46,7 @@
 #include "lib_disc/spatial_disc/dom_disc_embb.h"
 #include "lib_disc/parallelization/domain_distribution.h"
 #include "lib_disc/function_spaces/grid_function.h"
+#include "lib_disc/spatial_disc/disc_util/geom_cache.h"
 
 
 using namespace std;
@@ -54,6 +55,13 @@ namespace ug{
 namespace bridge{
 namespace DomainDisc{
 
+///	enables the per-element geometry cache for the elements of a domain
+template <typename TDomain>
+static void EnableGeometryCache(SmartPtr<TDomain> dom)
+{
+	ElemGeomCache::enable(*dom->grid());
+}
+
 /**
  * \defgroup domaindisc_bridge Domain Discretization Bridge
  * \ingroup disc_bridge
@@ -111,6 +119,10 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.add_method("invalidate_error", &T::invalidate_error, "", "Marks error indicators as invalid, "
 				"which will prohibit refining and coarsening before a new call to calc_error.")
 			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error values are valid")
+			.add_method("set_frozen_topology", &T::set_frozen_topology, "", "bEnable",
+				"keeps a snapshot of the topology for the threaded element assembling")
+			.add_method("update_frozen_topology_coordinates", &T::update_frozen_topology_coordinates, "", "",
+				"copies the current vertex coordinates into the snapshots of the topology")
 			.add_method("ass_tuner", static_cast<SmartPtr<AssemblingTuner<TAlgebra> > (T::*) ()> (&T::ass_tuner), "assembling tuner", "", "get this domain discretization's assembling tuner")
 			.add_method("approximation_space", static_cast<SmartPtr<ApproximationSpace<TDomain> > (T::*) ()> (&T::approximation_space), "approximation space", "", "get this domain discretization's approximation space")
 			.add_method("approximation_space", static_cast<ConstSmartPtr<ApproximationSpace<TDomain> > (T::*) () const> (&T::approximation_space), "approximation space", "", "get this domain discretization's approximation space")
@@ -207,6 +219,12 @@ static void Domain(Registry& reg, string grp)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "MultipleSideAndElemErrEstData", tag);
 	}
+
+//	geometry cache
+	{
+		reg.add_function("EnableGeometryCache", &EnableGeometryCache<TDomain>, domDiscGrp,
+				"", "domain", "caches the element geometry data of the (static) domain between assemblings");
+	}
 }
 
 /**
@@ -250,6 +268,12 @@ static void Algebra(Registry& reg, string grp)
 				"whether matrix is constant in time", "")
 			.add_method("set_matrix_structure_is_const", &T::set_matrix_structure_is_const, "",
 				"whether matrix has constant in time structure", "")
+			.add_method("set_threaded_assembling", &T::set_threaded_assembling, "",
+				"bEnable", "enables the chunk-wise, threaded element assembling")
+			.add_method("set_assembling_chunk_size", &T::set_assembling_chunk_size, "",
+				"size", "number of elements per chunk in threaded element assembling")
+			.add_method("set_matrix_scatter_cache", &T::set_matrix_scatter_cache, "",
+				"bEnable", "caches the positions of local matrix entries in the global matrix while the DoF distribution is unchanged")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
@@ -267,6 +291,14 @@ static void Common(Registry& reg, string grp)
 {
 //	group string
 	string domDiscGrp = grp; domDiscGrp.append("/SpatialDisc");
+
+//	geometry cache
+	{
+		reg.add_function("DisableGeometryCache", &ElemGeomCache::disable, domDiscGrp,
+				"", "", "disables the element geometry cache");
+		reg.add_function("InvalidateGeometryCache", &ElemGeomCache::invalidate, domDiscGrp,
+				"", "", "drops the cached element geometry data (e.g. after moving vertices)");
+	}
 }
 
 }; // end Functionality
@@ -283,7 +315,7 @@ void RegisterBridge_DomainDisc(Registry& reg, string grp)
 	typedef DomainDisc::Functionality Functionality;
 
 	try{
-//		RegisterCommon<Functionality>(reg,grp);
+		RegisterCommon<Functionality>(reg,grp);
 //		RegisterDimensionDependent<Functionality>(reg,grp);
 		RegisterDomainDependent<Functionality>(reg,grp);
 		RegisterAlgebraDependent<Functionality>(reg,grp);
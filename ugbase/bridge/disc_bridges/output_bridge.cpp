@@ -47,6 +47,7 @@
 
 #include "lib_disc/io/vtkoutput.h"
 #include "lib_disc/io/vtk_export_ho.h"
+#include "lib_disc/io/grid_function_checkpoint.h"
 #include "common/profiler/profiler.h"
 
 #include "../util_overloaded.h"
@@ -241,6 +242,16 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_function("SaveVectorCSV",
 						 &SaveVectorCSV<function_type>, grp, "", "b#filename|save-dialog");
 	}
+
+//	checkpoints
+	{
+		reg.add_function("SaveCheckpoint", &SaveCheckpoint<function_type>, grp,
+				"", "u#filename|save-dialog#fcts#bAsync",
+				"saves (some functions of) a grid function to a single checkpoint file");
+		reg.add_function("LoadCheckpoint", &LoadCheckpoint<function_type>, grp,
+				"", "u#filename|load-dialog",
+				"loads the functions stored in a checkpoint file, also on a different number of processes");
+	}
 }
 
 /**
@@ -290,6 +301,11 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("set_write_grid", static_cast<void (T::*)(bool)>(&T::set_write_grid))
 			.add_method("set_write_subset_indices", static_cast<void (T::*)(bool)>(&T::set_write_subset_indices))
 			.add_method("set_write_proc_ranks", static_cast<void (T::*)(bool)>(&T::set_write_proc_ranks))
+			.add_method("set_appended", &T::set_appended, "", "bAppended", "write binary data as raw appended data instead of inline base64")
+			.add_method("set_compression", &T::set_compression, "", "compression", "compression of appended data: 'none', 'zlib' or 'lz4'")
+			.add_method("set_compression_level", &T::set_compression_level, "", "level", "compression level (-1: default)")
+			.add_method("set_async", &T::set_async, "", "bAsync", "compress and write the files in a background thread")
+			.add_method("set_aggregation", &T::set_aggregation, "", "numProcs", "number of processes whose pieces are written into one vtu file")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VTKOutput", tag);
 	}
@@ -305,6 +321,11 @@ static void Dimension(Registry& reg, string grp)
  */
 static void Common(Registry& reg, string grp)
 {
+	reg.add_function("WaitForCheckpoint", &WaitForCheckpoint, grp,
+			"", "", "waits until the last asynchronously written checkpoint is completed");
+	reg.add_function("VTKWaitForOutput", &VTKFileWriter::wait_for_async_output, grp,
+			"", "", "waits until all vtk files written in the background are completed");
+
 #ifdef UG_CPU_1
 // SaveMatrixToMTX
 	{
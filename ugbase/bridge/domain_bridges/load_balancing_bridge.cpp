@@ -47,6 +47,8 @@
 	#include "lib_grid/parallelization/load_balancer.h"
 	#include "lib_grid/parallelization/load_balancer_util.h"
 	#include "lib_grid/parallelization/partitioner_dynamic_bisection.h"
+	#include "lib_grid/parallelization/partitioner_sfc.h"
+	#include "lib_grid/parallelization/partitioner_multilevel_graph.h"
 	#include "lib_grid/parallelization/balance_weights_ref_marks.h"
 	#include "lib_grid/parallelization/partition_pre_processors/replace_coordinate.h"
 	#include "lib_grid/parallelization/partition_post_processors/smooth_partition_bounds.h"
@@ -197,6 +199,61 @@ static void RegisterDynamicBisectionPartitioner(
 	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
 }
 
+template <class TDomain, class TPartitioner>
+static void RegisterSFCPartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("set_curve",
+			&TPartitioner::set_curve, "", "curve",
+			"'hilbert' (default) or 'morton'")
+		.add_method("set_tolerance",
+			&TPartitioner::set_tolerance)
+		.add_method("tolerance",
+			&TPartitioner::tolerance)
+		.add_method("enable_repartitioning",
+			&TPartitioner::enable_repartitioning)
+		.add_method("repartitioning_enabled",
+			&TPartitioner::repartitioning_enabled)
+		.add_method("expected_migration_weight",
+			&TPartitioner::expected_migration_weight)
+		.add_method("num_migrating_elements",
+			&TPartitioner::num_migrating_elements)
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
+template <class TDomain, class TPartitioner>
+static void RegisterMultilevelGraphPartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("set_imbalance_tolerance",
+			&TPartitioner::set_imbalance_tolerance)
+		.add_method("imbalance_tolerance",
+			&TPartitioner::imbalance_tolerance)
+		.add_method("set_num_refinement_passes",
+			&TPartitioner::set_num_refinement_passes)
+		.add_method("edge_cut",
+			&TPartitioner::edge_cut)
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
 template <class TDomain, class elem_t>
 static void RegisterSmoothPartitionBounds(
 	Registry& reg,
@@ -332,6 +389,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_SFC1d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_MultilevelGraph1d",
+			grp,
+			"Partitioner_MultilevelGraph");
+
 
 		RegisterSmoothPartitionBounds<TDomain, Edge>(
 			reg,
@@ -358,6 +431,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_SFC2d",
+			grp,
+			"ManifoldPartitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_MultilevelGraph2d",
+			grp,
+			"ManifoldPartitioner_MultilevelGraph");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 2> > >(
@@ -366,6 +455,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Face, 2> > >(
+			reg,
+			"FacePartitioner_SFC2d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Face, 2> > >(
+			reg,
+			"FacePartitioner_MultilevelGraph2d",
+			grp,
+			"Partitioner_MultilevelGraph");
+
 		RegisterSmoothPartitionBounds<TDomain, Face>(
 			reg,
 			"SmoothPartitionBounds2d",
@@ -391,6 +496,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"HyperManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_SFC3d",
+			grp,
+			"HyperManifoldPartitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_MultilevelGraph3d",
+			grp,
+			"HyperManifoldPartitioner_MultilevelGraph");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 3> > >(
@@ -399,6 +520,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Face, 3> > >(
+			reg,
+			"FacePartitioner_SFC3d",
+			grp,
+			"ManifoldPartitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Face, 3> > >(
+			reg,
+			"FacePartitioner_MultilevelGraph3d",
+			grp,
+			"ManifoldPartitioner_MultilevelGraph");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Volume, 3> > >(
@@ -407,6 +544,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_SFC3d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelGraphPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_MultilevelGraph<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_MultilevelGraph3d",
+			grp,
+			"Partitioner_MultilevelGraph");
+
 		RegisterSmoothPartitionBounds<TDomain, Volume>(
 			reg,
 			"SmoothPartitionBounds3d",
@@ -35,6 +35,7 @@
 #include "lib_grid/multi_grid.h"
 #include "lib_grid/file_io/file_io.h"
 #include "lib_grid/file_io/file_io_ugx.h"
+#include "lib_grid/file_io/file_io_ugb.h"
 
 using namespace std;
 
@@ -129,7 +130,12 @@ void RegisterGridBridge_FileIO(Registry& reg, string parentGroup)
 		.add_function("SaveParallelGridLayout", &SaveParallelGridLayout,
 				grp, "", "mg#filename#offset")
 		.add_function("SaveSurfaceViewTransformed", &SaveSurfaceViewTransformed)
-		.add_function("SaveGridLevelToFile", &SaveGridLevelToFile);
+		.add_function("SaveGridLevelToFile", &SaveGridLevelToFile)
+		.add_function("ConvertUGXToUGB", &ConvertUGXToUGB, grp,
+				"success", "ugxFilename#ugbFilename#numPartitions",
+				"Converts a ugx file to a binary ugb file with the given number of partitions")
+		.add_function("GetNumUGBPartitions", &GetNumUGBPartitions, grp,
+				"numPartitions", "filename");
 }
 
 }//	end of namespace
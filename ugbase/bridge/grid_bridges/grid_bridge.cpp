@@ -99,6 +99,9 @@ void RegisterGridBridge_Grid(Registry& reg, string parentGroup)
 		.add_method("reserve_edges", &Grid::reserve<Edge>, "", "num")
 		.add_method("reserve_faces", &Grid::reserve<Face>, "", "num")
 		.add_method("reserve_volumes", &Grid::reserve<Volume>, "", "num")
+		.add_method("enable_pooled_allocation", &Grid::enable_pooled_allocation, "", "enable")
+		.add_method("pooled_allocation_enabled", &Grid::pooled_allocation_enabled)
+		.add_method("pooled_memory", &Grid::pooled_memory)
 		.set_construct_as_smart_pointer(true);
 
 //	MultiGrid
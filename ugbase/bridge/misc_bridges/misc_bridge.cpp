@@ -39,6 +39,7 @@
 #include "compile_info/compile_info.h"
 #include "common/util/crc32.h"
 #include "common/stopwatch.h"
+#include "common/util/openmp_util.h"
 #include "ug.h"
 
 #ifdef UG_FOR_LUA
@@ -277,6 +278,12 @@ bool IsDefinedUG_JSON() { return true; }
 bool IsDefinedUG_JSON() { return false; }
 #endif
 
+#ifdef UG_OPENMP
+bool IsDefinedUG_OPENMP() { return true; }
+#else
+bool IsDefinedUG_OPENMP() { return false; }
+#endif
+
 /// prints CMake build parameters in a quite compact (pairwise) form
 void PrintBuildConfiguration()
 {
@@ -374,7 +381,7 @@ void PrintBuildConfiguration()
 	UG_LOG(AppendSpacesToString(aux_str,40).append(""));
 
 	aux_str = "";
-	//aux_str.append("?:               ").append( (IsDefinedUG_?() ? "ON " : "OFF") );
+	aux_str.append("OPENMP:            ").append( (IsDefinedUG_OPENMP() ? "ON " : "OFF") );
 	UG_LOG(AppendSpacesToString(aux_str,40).append("\n"));
 	UG_LOG("--------------------------------------------------------------------------------\n");
 }
@@ -540,12 +547,20 @@ void RegisterBridge_Misc(Registry &reg, string parentGroup)
 		ADD_DEFINED_FUNC(UG_HYPRE);
 		ADD_DEFINED_FUNC(UG_HLIBPRO);
 		ADD_DEFINED_FUNC(UG_JSON);
+		ADD_DEFINED_FUNC(UG_OPENMP);
 
 		reg.add_function("PrintBuildConfiguration", &PrintBuildConfiguration, grp, "");
 		reg.add_function("PrintBuildConfigurationExtended", &PrintBuildConfigurationExtended, grp, "");
 		
 		
 
+		reg.add_function("SetNumOMPThreads", &SetNumOMPThreads, grp, "", "numThreads",
+						 "Sets the number of threads used by threaded kernels (only if compiled with OPENMP=ON).");
+		reg.add_function("NumOMPThreads", &NumOMPThreads, grp, "numThreads", "",
+						 "Returns the number of threads used by threaded kernels (1 if compiled without OpenMP).");
+		reg.add_function("SetOMPMinLoopSize", &SetOMPMinLoopSize, grp, "", "minLoopSize",
+						 "Loops with less iterations are not threaded.");
+
 		reg.add_function("GetSVNRevision", &GetSVNRevision, grp);
 		reg.add_function("GetGITRevision", &GetGITRevision, grp);
 		reg.add_function("GetCompileDate", &GetCompileDate, grp);
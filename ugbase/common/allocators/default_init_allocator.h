@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__DEFAULT_INIT_ALLOCATOR__
+#define __H__UG__COMMON__DEFAULT_INIT_ALLOCATOR__
+
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ug{
+
+///	Allocator which default-initializes (instead of value-initializes) elements
+/**	std::vector<T>::resize(n) value-initializes all new elements, i.e. it sets
+ * them to zero for built-in types. The zeroing is done by the calling thread,
+ * which thereby becomes the owner of all touched memory pages on NUMA systems.
+ *
+ * Used with this allocator, resize(n) leaves built-in types uninitialized, so
+ * that the memory is first touched by the thread which writes the first
+ * value into it. Class types are still constructed by their default
+ * constructor.
+ */
+template <typename T, typename TBase = std::allocator<T> >
+class DefaultInitAllocator : public TBase
+{
+	typedef std::allocator_traits<TBase> base_traits;
+
+	public:
+		template <typename U>
+		struct rebind
+		{
+			typedef DefaultInitAllocator<U,
+						typename base_traits::template rebind_alloc<U> > other;
+		};
+
+		DefaultInitAllocator() {}
+
+		template <typename U, typename UBase>
+		DefaultInitAllocator(const DefaultInitAllocator<U, UBase>& a)
+			: TBase(a) {}
+
+	///	default-initializes the element (no zeroing for built-in types)
+		template <typename U>
+		void construct(U* p)
+		{
+			::new(static_cast<void*>(p)) U;
+		}
+
+	///	forwards all other constructions to the base allocator
+		template <typename U, typename... TArgs>
+		void construct(U* p, TArgs&&... args)
+		{
+			base_traits::construct(static_cast<TBase&>(*this), p,
+			                       std::forward<TArgs>(args)...);
+		}
+};
+
+}//	end of namespace
+
+#endif
@@ -185,3 +185,80 @@ deallocate(void* p, std::size_t blockSize)
 	assert(m_firstAvailableBlock == (toRelease - m_pData) / blockSize);
 	++m_numAvailableBlocks;
 }
+
+
+////////////////////////////////////////////////////////////////////////
+//	ObjectArena
+ObjectArena::
+ObjectArena(std::size_t blockSize, std::size_t numBlocksPerChunk) :
+	m_blockSize(aligned_size(blockSize)),
+	m_numBlocksPerChunk(numBlocksPerChunk > 0 ? numBlocksPerChunk : 1),
+	m_pCur(0),
+	m_pCurEnd(0),
+	m_freeList(0),
+	m_numAllocated(0)
+{
+}
+
+ObjectArena::
+~ObjectArena()
+{
+	release_all();
+}
+
+std::size_t ObjectArena::
+aligned_size(std::size_t size)
+{
+//	blocks have to be able to hold a FreeBlock and have to be aligned for
+//	pointers and doubles.
+	const std::size_t align = sizeof(void*) > sizeof(double) ?
+								sizeof(void*) : sizeof(double);
+	if(size < sizeof(FreeBlock))
+		size = sizeof(FreeBlock);
+	return ((size + align - 1) / align) * align;
+}
+
+void* ObjectArena::
+allocate()
+{
+	++m_numAllocated;
+
+	if(m_freeList){
+		FreeBlock* p = m_freeList;
+		m_freeList = p->m_next;
+		return p;
+	}
+
+	if(m_pCur == m_pCurEnd){
+		unsigned char* chunk = new unsigned char[m_blockSize * m_numBlocksPerChunk];
+		m_chunks.push_back(chunk);
+		m_pCur = chunk;
+		m_pCurEnd = chunk + m_blockSize * m_numBlocksPerChunk;
+	}
+
+	void* p = m_pCur;
+	m_pCur += m_blockSize;
+	return p;
+}
+
+void ObjectArena::
+deallocate(void* p)
+{
+	assert(p);
+	assert(m_numAllocated > 0);
+	FreeBlock* b = static_cast<FreeBlock*>(p);
+	b->m_next = m_freeList;
+	m_freeList = b;
+	--m_numAllocated;
+}
+
+void ObjectArena::
+release_all()
+{
+	for(std::size_t i = 0; i < m_chunks.size(); ++i)
+		delete[] m_chunks[i];
+	m_chunks.clear();
+	m_pCur = m_pCurEnd = 0;
+	m_freeList = 0;
+	m_numAllocated = 0;
+}
@@ -92,6 +92,63 @@ class FixedAllocator
 		std::size_t m_numFreeBlocks;
 };
 
+/**	An arena for objects of the same size, which can release all its memory at once.
+ *	In contrast to FixedAllocator, the chunks of an ObjectArena are not limited
+ *	to 255 blocks and blocks are not searched in the chunks: released blocks
+ *	are kept in a free list, new blocks are taken from the end of the last chunk.
+ *	Allocation and deallocation thus have constant cost.
+ *
+ *	release_all frees all chunks at once. Make sure that no object allocated
+ *	through the arena is used afterwards (destructors are not called by the arena).
+ *
+ *	Instances can't be copied.
+ */
+class ObjectArena
+{
+	public:
+		ObjectArena(std::size_t blockSize, std::size_t numBlocksPerChunk = 1024);
+		~ObjectArena();
+
+	///	returns a block of block_size() bytes
+		void* allocate();
+
+	///	make sure that p was allocated by this arena.
+		void deallocate(void* p);
+
+	///	frees all chunks. All blocks allocated through the arena get invalid.
+		void release_all();
+
+	///	size of the blocks (requested size rounded up to the alignment)
+		std::size_t block_size() const		{return m_blockSize;}
+
+	///	number of blocks which are currently in use
+		std::size_t num_allocated() const	{return m_numAllocated;}
+
+	///	number of chunks (of numBlocksPerChunk blocks each)
+		std::size_t num_chunks() const		{return m_chunks.size();}
+
+	///	rounds the given size up to the size of the blocks used by an arena
+		static std::size_t aligned_size(std::size_t size);
+
+	private:
+		ObjectArena(const ObjectArena&);
+		ObjectArena& operator=(const ObjectArena&);
+
+		struct FreeBlock
+		{
+			FreeBlock* m_next;
+		};
+
+	private:
+		std::size_t m_blockSize;
+		std::size_t m_numBlocksPerChunk;
+		std::vector<unsigned char*> m_chunks;
+		unsigned char* m_pCur;
+		unsigned char* m_pCurEnd;
+		FreeBlock* m_freeList;
+		std::size_t m_numAllocated;
+};
+
 /**	A singleton that can be used to allocate small objects.*/
 template <std::size_t maxObjSize = 64, std::size_t maxChunkSize = 4096>
 class SmallObjectAllocator
@@ -124,6 +124,14 @@ capacity() const
 }
 
 
+template <class TKey, class TValue>
+size_t Hash<TKey, TValue>::
+size() const
+{
+	return m_numEntries;
+}
+
+
 template <class TKey, class TValue>
 void Hash<TKey, TValue>::
 clear()
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__UTIL__OPENMP_UTIL__
+#define __H__UG__COMMON__UTIL__OPENMP_UTIL__
+
+#include <cstddef>
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+/**	\file openmp_util.h
+ * Helpers for the optional shared-memory (OpenMP) parallelization.
+ *
+ * Threading is only compiled in if ug4 was configured with -DOPENMP=ON, which
+ * defines UG_OPENMP. Otherwise all macros below expand to nothing and all
+ * functions behave as if exactly one thread is available.
+ *
+ * Loops that shall run threaded are annotated with UG_OMP_PARALLEL_FOR(n),
+ * where n is the number of iterations. Loops with less than
+ * OMPMinLoopSize() iterations are executed by the calling thread only, so that
+ * the annotation may also be used for loops that are typically short. Loops
+ * with expensive iterations use UG_OMP_PARALLEL_FOR_IF(cond) instead, which
+ * runs threaded whenever cond is true.
+ *
+ * All threaded loops use a static schedule. Thus a row-loop over the same
+ * range always distributes the rows to the same threads, which is used to
+ * place data next to the thread that works on it (first touch).
+ *
+ * Singletons that are modified during use (e.g. the geometries of the
+ * GeomProvider) are declared UG_THREAD_LOCAL, which gives every thread its
+ * own instance if threading is enabled.
+ */
+
+#define UG_PRAGMA(x)	_Pragma(#x)
+
+#ifdef UG_OPENMP
+	#define UG_OMP_PARALLEL_FOR(n)	\
+		UG_PRAGMA(omp parallel for schedule(static) if(ug::UseOMPThreads(n)))
+	#define UG_OMP_PARALLEL_FOR_SUM(n, sum)	\
+		UG_PRAGMA(omp parallel for schedule(static) reduction(+:sum) if(ug::UseOMPThreads(n)))
+	#define UG_OMP_PARALLEL_FOR_MAX(n, m)	\
+		UG_PRAGMA(omp parallel for schedule(static) reduction(max:m) if(ug::UseOMPThreads(n)))
+	#define UG_OMP_PARALLEL_FOR_IF(cond)	\
+		UG_PRAGMA(omp parallel for schedule(static) if(cond))
+	#define UG_OMP_ATOMIC	UG_PRAGMA(omp atomic)
+	#define UG_THREAD_LOCAL	thread_local
+#else
+	#define UG_OMP_PARALLEL_FOR(n)
+	#define UG_OMP_PARALLEL_FOR_SUM(n, sum)
+	#define UG_OMP_PARALLEL_FOR_MAX(n, m)
+	#define UG_OMP_PARALLEL_FOR_IF(cond)
+	#define UG_OMP_ATOMIC
+	#define UG_THREAD_LOCAL
+#endif
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	minimal number of loop iterations for which a threaded loop is started
+inline size_t& OMPMinLoopSize()
+{
+	static size_t minLoopSize = 4096;
+	return minLoopSize;
+}
+
+///	sets the minimal number of loop iterations for which threads are used
+inline void SetOMPMinLoopSize(size_t n)	{OMPMinLoopSize() = n;}
+
+///	returns true if a loop with n iterations should be executed threaded
+inline bool UseOMPThreads(size_t n)
+{
+	return n >= OMPMinLoopSize();
+}
+
+///	returns the number of threads used in parallel regions (1 without OpenMP)
+inline int NumOMPThreads()
+{
+#ifdef UG_OPENMP
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
+///	sets the number of threads used in parallel regions (no-op without OpenMP)
+inline void SetNumOMPThreads(int numThreads)
+{
+#ifdef UG_OPENMP
+	if(numThreads > 0)
+		omp_set_num_threads(numThreads);
+#endif
+}
+
+///	returns the id of the calling thread in the current team (0 without OpenMP)
+inline int OMPThreadID()
+{
+#ifdef UG_OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+// end group ugbase_common_util
+/// \}
+
+}//	end of namespace
+
+#endif
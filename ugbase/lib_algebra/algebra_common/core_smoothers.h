@@ -34,6 +34,10 @@
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+#include "common/util/openmp_util.h"
+#include "matrix_coloring.h"
+
 namespace ug
 {
 
@@ -205,6 +209,315 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+///		Threaded Gauss-Seidel-Iterations
+/**
+ * The gauss-seidel steps above are strictly sequential. Below, two variants are
+ * implemented that can be executed by several threads (if ug4 is compiled with
+ * OpenMP):
+ *
+ * <ul>
+ * <li> Multicolor Gauss-Seidel ('gs_step_LL_multicolor', 'gs_step_UR_multicolor',
+ * 		'sgs_step_multicolor'): The rows are processed color by color, where rows
+ * 		of the same color are not coupled (see MatrixColoring). This is the
+ * 		gauss-seidel step for the matrix permuted to the color ordering, i.e. L
+ * 		consists of the entries A(i,j) with color(j) < color(i). The rows of one
+ * 		color are processed in parallel.
+ * <li> Hybrid block-Jacobi/Gauss-Seidel ('gs_step_LL_hybrid', 'gs_step_UR_hybrid',
+ * 		'sgs_step_hybrid'): The rows are split into consecutive blocks. On every
+ * 		block a gauss-seidel step is performed, couplings between the blocks are
+ * 		treated as in the jacobi method, i.e. ignored. The blocks are processed
+ * 		in parallel.
+ * </ul>
+ *
+ * Both variants perform a different iteration than the sequential step (the
+ * multicolor variant independent of the number of threads), which is usually
+ * of comparable smoothing quality.
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_LL_multicolor
+/** \brief Performs a forward multicolor gauss-seidel-step.
+ *
+ * \param A Matrix \f$A = D - L - U\f$ (L: entries with smaller color)
+ * \param c Vector. \f$ c = N * d = (D-L)^{-1} * d \f$
+ * \param d Vector d.
+ * \param coloring coloring of the graph of A
+ * \sa gs_step_UR_multicolor, sgs_step_multicolor
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL_multicolor(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                           const number relaxFactor, const MatrixColoring& coloring)
+{
+	typedef typename Matrix_type::value_type matrix_block;
+	typedef typename Matrix_type::const_row_iterator const_row_it;
+
+	for(size_t col = 0; col < coloring.num_colors(); ++col)
+	{
+		const size_t* vRow = coloring.rows(col);
+		const size_t numRows = coloring.num_rows(col);
+
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t k = 0; k < numRows; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = d[i];
+			const matrix_block* pA_ii = NULL;
+
+			const const_row_it rowEnd = A.end_row(i);
+			for(const_row_it it = A.begin_row(i); it != rowEnd; ++it)
+			{
+				const size_t j = it.index();
+				if(j == i) pA_ii = &it.value();
+				else if(coloring.color(j) < col)
+					// s -= it.value() * c[j];
+					MatMultAdd(s, 1.0, s, -1.0, it.value(), c[j]);
+			}
+
+			UG_ASSERT(pA_ii != NULL, "gs_step_LL_multicolor: no diagonal in row " << i);
+			// c[i] = relaxFactor * s/A(i,i)
+			InverseMatMult(c[i], relaxFactor, *pA_ii, s);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_UR_multicolor
+/** \brief Performs a backward multicolor gauss-seidel-step.
+ *
+ * \param A Matrix \f$A = D - L - U\f$ (U: entries with larger color)
+ * \param c will be \f$c = N * d = (D-U)^{-1} * d \f$
+ * \param d the vector d.
+ * \param coloring coloring of the graph of A
+ * \sa gs_step_LL_multicolor, sgs_step_multicolor
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR_multicolor(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                           const number relaxFactor, const MatrixColoring& coloring)
+{
+	typedef typename Matrix_type::value_type matrix_block;
+	typedef typename Matrix_type::const_row_iterator const_row_it;
+
+	for(size_t col = coloring.num_colors(); col-- != 0; )
+	{
+		const size_t* vRow = coloring.rows(col);
+		const size_t numRows = coloring.num_rows(col);
+
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t k = 0; k < numRows; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = d[i];
+			const matrix_block* pA_ii = NULL;
+
+			const const_row_it rowEnd = A.end_row(i);
+			for(const_row_it it = A.begin_row(i); it != rowEnd; ++it)
+			{
+				const size_t j = it.index();
+				if(j == i) pA_ii = &it.value();
+				else if(coloring.color(j) > col)
+					// s -= it.value() * c[j];
+					MatMultAdd(s, 1.0, s, -1.0, it.value(), c[j]);
+			}
+
+			UG_ASSERT(pA_ii != NULL, "gs_step_UR_multicolor: no diagonal in row " << i);
+			// c[i] = relaxFactor * s/A(i,i)
+			InverseMatMult(c[i], relaxFactor, *pA_ii, s);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	sgs_step_multicolor
+/**
+ * \brief Performs a symmetric multicolor gauss-seidel step.
+ *
+ * Note that for a two-colour (red-black) ordering, the backward sweep relaxes
+ * the last colour a second time without any change, so the symmetric step
+ * converges like a single forward step, but needs about twice the work.
+ *
+ * \param A Matrix \f$A = D - L - R\f$
+ * \param c will be \f$c = N * d = (D-U)^{-1} D (D-L)^{-1} d \f$
+ * \param d the vector d.
+ * \param coloring coloring of the graph of A
+ * \sa gs_step_LL_multicolor, gs_step_UR_multicolor
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step_multicolor(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                         const number relaxFactor, const MatrixColoring& coloring)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL_multicolor(A, c, d, relaxFactor, coloring);
+
+	// c2 = D c1
+	const size_t sz = c.size();
+	UG_OMP_PARALLEL_FOR(sz)
+	for(size_t i = 0; i < sz; i++)
+	{
+		typename Vector_type::value_type s = c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR_multicolor(A, c, c, relaxFactor, coloring);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_rows
+/** \brief Performs a gauss-seidel-step on the rows [rowBegin, rowEnd) in the given order.
+ * In contrast to gs_step_LL, all off-diagonal entries of a row are used. If c is zero
+ * on all rows that have not been processed before, a sequence of calls on disjoint
+ * row sets is a gauss-seidel-step for the ordering given by the sequence of rows.
+ *
+ * \param A Matrix
+ * \param c Vector, zero on all rows not processed yet
+ * \param d Vector d.
+ * \param rowBegin, rowEnd iterators over the rows
+ * \sa gs_step_LL, gs_step_UR
+ */
+template<typename Matrix_type, typename Vector_type, typename TRowIter>
+void gs_step_rows(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                  const number relaxFactor, TRowIter rowBegin, TRowIter rowEnd)
+{
+	typedef typename Matrix_type::value_type matrix_block;
+	typedef typename Matrix_type::const_row_iterator const_row_it;
+	typename Vector_type::value_type s;
+
+	for(; rowBegin != rowEnd; ++rowBegin)
+	{
+		const size_t i = *rowBegin;
+		s = d[i];
+
+		const matrix_block* pA_ii = NULL;
+		for(const_row_it it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			if(it.index() == i) {pA_ii = &it.value(); continue;}
+			// s -= it.value() * c[it.index()];
+			MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+		}
+
+		// c[i] = relaxFactor * s/A(i,i)
+		InverseMatMult(c[i], relaxFactor, pA_ii ? *pA_ii : matrix_block(0), s);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_LL_hybrid
+/** \brief Performs a forward gauss-seidel-step on consecutive blocks of rows.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c Vector. \f$ c = N * d \f$, N the block diagonal of \f$(D-L)^{-1}\f$
+ * \param d Vector d.
+ * \param vBlockBegin first row of each block, followed by the number of rows
+ * \sa gs_step_UR_hybrid, sgs_step_hybrid
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL_hybrid(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                       const number relaxFactor, const std::vector<size_t>& vBlockBegin)
+{
+	typedef typename Matrix_type::value_type matrix_block;
+	typedef typename Matrix_type::const_row_iterator const_row_it;
+
+	const int numBlocks = (int)vBlockBegin.size() - 1;
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static, 1) if(numBlocks > 1)
+#endif
+	for(int b = 0; b < numBlocks; ++b)
+	{
+		const size_t first = vBlockBegin[b];
+		typename Vector_type::value_type s;
+
+		for(size_t i = first; i < vBlockBegin[b+1]; ++i)
+		{
+			s = d[i];
+
+			//	loop over the lower left matrix entries of the block
+			const const_row_it rowEnd = A.end_row(i);
+			const_row_it it = A.begin_row(i);
+			for(; it != rowEnd && it.index() < i; ++it)
+				if(it.index() >= first)
+					// s -= it.value() * c[it.index()];
+					MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			// c[i] = relaxFactor * s/A(i,i)
+			const matrix_block& A_ii = it.index() == i ? it.value() : matrix_block(0);
+			InverseMatMult(c[i], relaxFactor, A_ii, s);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	gs_step_UR_hybrid
+/** \brief Performs a backward gauss-seidel-step on consecutive blocks of rows.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c will be \f$c = N * d \f$, N the block diagonal of \f$(D-U)^{-1}\f$
+ * \param d the vector d.
+ * \param vBlockBegin first row of each block, followed by the number of rows
+ * \sa gs_step_LL_hybrid, sgs_step_hybrid
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR_hybrid(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                       const number relaxFactor, const std::vector<size_t>& vBlockBegin)
+{
+	const int numBlocks = (int)vBlockBegin.size() - 1;
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static, 1) if(numBlocks > 1)
+#endif
+	for(int b = 0; b < numBlocks; ++b)
+	{
+		const size_t first = vBlockBegin[b];
+		const size_t end = vBlockBegin[b+1];
+		if(first == end) continue;
+		typename Vector_type::value_type s;
+
+		size_t i = end - 1;
+		do
+		{
+			s = d[i];
+			typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
+
+			typename Matrix_type::const_row_iterator it = diag; ++it;
+			for(; it != A.end_row(i) && it.index() < end; ++it)
+				// s -= it.value() * c[it.index()];
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			// c[i] = relaxFactor * s/A(i,i)
+			InverseMatMult(c[i], relaxFactor, diag.value(), s);
+		} while(i-- != first);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	sgs_step_hybrid
+/**
+ * \brief Performs a symmetric gauss-seidel step on consecutive blocks of rows.
+ * \param A Matrix \f$A = D - L - R\f$
+ * \param c will be \f$c = N * d\f$, N the block diagonal of \f$(D-U)^{-1} D (D-L)^{-1}\f$
+ * \param d the vector d.
+ * \param vBlockBegin first row of each block, followed by the number of rows
+ * \sa gs_step_LL_hybrid, gs_step_UR_hybrid
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step_hybrid(const Matrix_type &A, Vector_type &c, const Vector_type &d,
+                     const number relaxFactor, const std::vector<size_t>& vBlockBegin)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL_hybrid(A, c, d, relaxFactor, vBlockBegin);
+
+	// c2 = D c1
+	const size_t sz = c.size();
+	UG_OMP_PARALLEL_FOR(sz)
+	for(size_t i = 0; i < sz; i++)
+	{
+		typename Vector_type::value_type s = c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR_hybrid(A, c, c, relaxFactor, vBlockBegin);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MATRIX_COLORING__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MATRIX_COLORING__
+
+#include <vector>
+
+#include "common/common.h"
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	greedy coloring of the graph of a sparse matrix
+/**
+ * Rows i and j get different colors if A(i,j) or A(j,i) is stored. Rows of
+ * the same color are thus independent and can be relaxed in parallel by
+ * Gauss-Seidel type smoothers.
+ *
+ * A coloring is only valid for one matrix pattern. update() only recomputes
+ * the coloring if the pattern has changed, which is detected by the number
+ * of rows, the number of stored entries and a checksum of the column indices.
+ */
+class MatrixColoring
+{
+	public:
+		MatrixColoring() : m_numRows(0), m_numConn(0), m_checksum(0) {}
+
+	///	recomputes the coloring if the pattern of A has changed
+	/// \returns true if the coloring has been recomputed
+		template <typename TMatrix>
+		bool update(const TMatrix& A)
+		{
+			size_t numConn, checksum;
+			fingerprint(A, numConn, checksum);
+			if(!m_vColorBegin.empty() && A.num_rows() == m_numRows
+				&& numConn == m_numConn && checksum == m_checksum)
+				return false;
+
+			compute(A);
+			m_numRows = A.num_rows(); m_numConn = numConn; m_checksum = checksum;
+			return true;
+		}
+
+	///	removes the coloring
+		void clear()
+		{
+			m_vColor.clear(); m_vColorBegin.clear(); m_vRow.clear();
+			m_numRows = m_numConn = m_checksum = 0;
+		}
+
+	///	number of colors
+		size_t num_colors() const {return m_vColorBegin.empty() ? 0 : m_vColorBegin.size() - 1;}
+
+	///	color of row i
+		size_t color(size_t i) const {return m_vColor[i];}
+
+	///	number of rows of color c
+		size_t num_rows(size_t c) const {return m_vColorBegin[c+1] - m_vColorBegin[c];}
+
+	///	rows of color c (ascending)
+		const size_t* rows(size_t c) const {return &m_vRow[0] + m_vColorBegin[c];}
+
+	protected:
+	///	computes the number of connections and a checksum of the pattern
+		template <typename TMatrix>
+		static void fingerprint(const TMatrix& A, size_t& numConn, size_t& checksum)
+		{
+			numConn = 0; checksum = 0;
+			for(size_t i = 0; i < A.num_rows(); ++i)
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+				{
+					++numConn;
+					checksum = checksum * 31 + it.index();
+				}
+		}
+
+	///	computes the coloring
+		template <typename TMatrix>
+		void compute(const TMatrix& A)
+		{
+			const size_t n = A.num_rows();
+
+		//	symmetric adjacency graph (CSR)
+			std::vector<size_t> vAdjBegin(n+1, 0), vAdj;
+			for(size_t i = 0; i < n; ++i)
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+					if(it.index() != i){++vAdjBegin[i+1]; ++vAdjBegin[it.index()+1];}
+			for(size_t i = 0; i < n; ++i) vAdjBegin[i+1] += vAdjBegin[i];
+			vAdj.resize(vAdjBegin[n]);
+			std::vector<size_t> vPos(vAdjBegin.begin(), vAdjBegin.end() - 1);
+			for(size_t i = 0; i < n; ++i)
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+					if(it.index() != i){
+						vAdj[vPos[i]++] = it.index();
+						vAdj[vPos[it.index()]++] = i;
+					}
+
+		//	greedy coloring: smallest color not used by a colored neighbor
+			const size_t uncolored = (size_t)-1;
+			m_vColor.assign(n, uncolored);
+			std::vector<size_t> vMark;
+			size_t numColor = 0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				for(size_t k = vAdjBegin[i]; k < vAdjBegin[i+1]; ++k)
+				{
+					const size_t cn = m_vColor[vAdj[k]];
+					if(cn != uncolored) vMark[cn] = i;
+				}
+
+				size_t c = 0;
+				while(c < numColor && vMark[c] == i) ++c;
+				if(c == numColor){++numColor; vMark.push_back(uncolored);}
+				m_vColor[i] = c;
+			}
+
+		//	rows sorted by color
+			m_vColorBegin.assign(numColor + 1, 0);
+			for(size_t i = 0; i < n; ++i) ++m_vColorBegin[m_vColor[i]+1];
+			for(size_t c = 0; c < numColor; ++c) m_vColorBegin[c+1] += m_vColorBegin[c];
+			m_vRow.resize(n);
+			vPos.assign(m_vColorBegin.begin(), m_vColorBegin.end() - 1);
+			for(size_t i = 0; i < n; ++i)
+				m_vRow[vPos[m_vColor[i]]++] = i;
+		}
+
+	protected:
+	///	color per row
+		std::vector<size_t> m_vColor;
+
+	///	rows sorted by color and first position per color
+		std::vector<size_t> m_vRow;
+		std::vector<size_t> m_vColorBegin;
+
+	///	fingerprint of the colored pattern
+		size_t m_numRows, m_numConn, m_checksum;
+};
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MATRIX_COLORING__ */
@@ -31,6 +31,7 @@
  */
 
 #include "../operations_vec.h"
+#include "common/util/openmp_util.h"
 namespace ug
 {
 // MATRIX_USE_ROW_FUNCTIONS
@@ -43,7 +44,9 @@ struct mat_operations_class<vector_t, matrix_t, MATRIX_USE_ROW_FUNCTIONS>
 	static inline bool MatMult(vector_t &dest,
 			const number &beta1, const matrix_t &A1, const vector_t &w1)
 	{
-		for(size_t i=0; i<dest.size(); i++)
+		const size_t n = dest.size();
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i=0; i<n; i++)
 		{
 			dest[i] = 0.0;
 			A1.mat_mult_add_row(i, dest[i], beta1, w1);
@@ -56,7 +59,9 @@ struct mat_operations_class<vector_t, matrix_t, MATRIX_USE_ROW_FUNCTIONS>
 			const number &alpha1, const vector_t &v1,
 			const number &beta1, const matrix_t &A1, const vector_t &w1)
 	{
-		for(size_t i=0; i<dest.size(); i++)
+		const size_t n = dest.size();
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i=0; i<n; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			A1.mat_mult_add_row(i, dest[i], beta1, w1);
@@ -70,7 +75,9 @@ struct mat_operations_class<vector_t, matrix_t, MATRIX_USE_ROW_FUNCTIONS>
 			const number &alpha2, const vector_t &v2,
 			const number &beta1, const matrix_t &A1, const vector_t &w1)
 	{
-		for(size_t i=0; i<dest.size(); i++)
+		const size_t n = dest.size();
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i=0; i<n; i++)
 		{
 			VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
 			A1.cast().mat_mult_add_row(i, dest[i], beta1, w1);
@@ -84,7 +91,9 @@ struct mat_operations_class<vector_t, matrix_t, MATRIX_USE_ROW_FUNCTIONS>
 			const number &beta1, const matrix_t &A1, const vector_t &w1,
 			const number &beta2, const matrix_t &A2, const vector_t &w2)
 	{
-		for(size_t i=0; i<dest.size(); i++)
+		const size_t n = dest.size();
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i=0; i<n; i++)
 		{
 			dest[i] = 0.0;
 			A1.cast().mat_mult_add_row(i, dest[i], beta1, w1);
@@ -100,7 +109,9 @@ struct mat_operations_class<vector_t, matrix_t, MATRIX_USE_ROW_FUNCTIONS>
 			const number &beta1, const matrix_t &A1, const vector_t &w1,
 			const number &beta2, const matrix_t &A2, const vector_t &w2)
 	{
-		for(size_t i=0; i<dest.size(); i++)
+		const size_t n = dest.size();
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i=0; i<n; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			A1.cast().mat_mult_add_row(i, dest[i], beta1, w1);
@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Martin Rupp
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__CPU_ALGEBRA__BSR_MATRIX__
+#define __H__UG__CPU_ALGEBRA__BSR_MATRIX__
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "common/common.h"
+#include "common/static_assert.h"
+#include "common/util/openmp_util.h"
+#include "lib_algebra/small_algebra/small_algebra.h"
+
+//	the vectorized block kernels are used if ug4 is compiled for a cpu
+//	supporting AVX-512 or AVX2/FMA (e.g. with -march=native)
+#if defined(__AVX512F__)
+	#define UG_BSR_AVX512
+	#define UG_BSR_SIMD 1
+	#include <immintrin.h>
+#elif defined(__AVX2__) && defined(__FMA__)
+	#define UG_BSR_AVX2
+	#define UG_BSR_SIMD 1
+	#include <immintrin.h>
+#else
+	#define UG_BSR_SIMD 0
+#endif
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	returns the instruction set used by the BSR block kernels
+inline const char* BSRInstructionSet()
+{
+#if defined(UG_BSR_AVX512)
+	return "AVX-512";
+#elif defined(UG_BSR_AVX2)
+	return "AVX2";
+#else
+	return "scalar";
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	BSRBlockKernel
+/**
+ * Kernels on dense N x N blocks stored column-major (a(r,c) = a[c*N + r]) and
+ * vectors of N doubles. The main kernel computes the product of one block row
+ * with a vector,
+ * 		\f$ y = \alpha y + \beta \sum_k A_k x_{col_k} \f$,
+ * where the N entries of the result are kept in registers for the whole row.
+ *
+ * The scalar version is used for N = 1, for N > 8 and if ug4 is not compiled for
+ * AVX2 or AVX-512. In the vectorized versions, the columns of a block are
+ * loaded as one (AVX-512) or up to two (AVX2) registers, masked to the N
+ * entries of the column, and multiplied with the broadcasted entry of x.
+ *
+ * \tparam	N		block size
+ */
+template <int N, bool bSIMD = (UG_BSR_SIMD && N >= 2 && N <= 8)>
+struct BSRBlockKernel
+{
+///	y = alpha*y + beta * sum_k A_k x_{col[k]} (y is not read if alpha == 0)
+	static inline void row_mult(double* y, double alpha, double beta,
+	                            const double* a, const size_t* col, size_t num,
+	                            const double* x)
+	{
+		double s[N];
+		for(int i = 0; i < N; ++i) s[i] = 0.0;
+
+		for(size_t k = 0; k < num; ++k, a += N*N)
+		{
+			const double* xk = x + col[k]*N;
+			for(int j = 0; j < N; ++j)
+			{
+				const double xj = xk[j];
+				for(int i = 0; i < N; ++i)
+					s[i] += a[j*N + i] * xj;
+			}
+		}
+
+		if(alpha == 0.0)
+			for(int i = 0; i < N; ++i) y[i] = beta * s[i];
+		else
+			for(int i = 0; i < N; ++i) y[i] = alpha * y[i] + beta * s[i];
+	}
+};
+
+#if defined(UG_BSR_AVX512)
+template <int N>
+struct BSRBlockKernel<N, true>
+{
+	static inline void row_mult(double* y, double alpha, double beta,
+	                            const double* a, const size_t* col, size_t num,
+	                            const double* x)
+	{
+		const __mmask8 m = (__mmask8)((1u << N) - 1);
+		__m512d s = _mm512_setzero_pd();
+
+		for(size_t k = 0; k < num; ++k, a += N*N)
+		{
+			const double* xk = x + col[k]*N;
+			for(int j = 0; j < N; ++j)
+				s = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, a + j*N),
+				                    _mm512_set1_pd(xk[j]), s);
+		}
+
+		s = _mm512_mul_pd(_mm512_set1_pd(beta), s);
+		if(alpha != 0.0)
+			s = _mm512_fmadd_pd(_mm512_set1_pd(alpha), _mm512_maskz_loadu_pd(m, y), s);
+		_mm512_mask_storeu_pd(y, m, s);
+	}
+};
+#elif defined(UG_BSR_AVX2)
+template <int N>
+struct BSRBlockKernel<N, true>
+{
+///	number of entries in the first and second register
+	enum {N0 = (N < 4) ? N : 4, N1 = (N > 4) ? N - 4 : 0};
+
+	static inline __m256i mask(int n)
+	{
+		return _mm256_setr_epi64x(n > 0 ? -1 : 0, n > 1 ? -1 : 0,
+		                          n > 2 ? -1 : 0, n > 3 ? -1 : 0);
+	}
+
+	static inline __m256d load(const double* p, int n, __m256i m)
+	{
+		return (n == 4) ? _mm256_loadu_pd(p) : _mm256_maskload_pd(p, m);
+	}
+
+	static inline void store(double* p, int n, __m256i m, __m256d v)
+	{
+		if(n == 4) _mm256_storeu_pd(p, v);
+		else _mm256_maskstore_pd(p, m, v);
+	}
+
+	static inline void row_mult(double* y, double alpha, double beta,
+	                            const double* a, const size_t* col, size_t num,
+	                            const double* x)
+	{
+		const __m256i m0 = mask(N0), m1 = mask(N1);
+		__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+
+		for(size_t k = 0; k < num; ++k, a += N*N)
+		{
+			const double* xk = x + col[k]*N;
+			for(int j = 0; j < N; ++j)
+			{
+				const __m256d xj = _mm256_broadcast_sd(xk + j);
+				s0 = _mm256_fmadd_pd(load(a + j*N, N0, m0), xj, s0);
+				if(N1 > 0)
+					s1 = _mm256_fmadd_pd(load(a + j*N + 4, N1, m1), xj, s1);
+			}
+		}
+
+		const __m256d vBeta = _mm256_set1_pd(beta);
+		s0 = _mm256_mul_pd(vBeta, s0);
+		if(N1 > 0) s1 = _mm256_mul_pd(vBeta, s1);
+		if(alpha != 0.0)
+		{
+			const __m256d vAlpha = _mm256_set1_pd(alpha);
+			s0 = _mm256_fmadd_pd(vAlpha, load(y, N0, m0), s0);
+			if(N1 > 0) s1 = _mm256_fmadd_pd(vAlpha, load(y + 4, N1, m1), s1);
+		}
+		store(y, N0, m0, s0);
+		if(N1 > 0) store(y + 4, N1, m1, s1);
+	}
+};
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	BSRMatrix
+/**
+ * Block compressed sparse row (BSR) copy of a SparseMatrix with fixed N x N
+ * blocks (or scalar entries for N = 1). The blocks of SparseMatrix<DenseMatrix<
+ * FixedArray2<double,N,N> > > are processed entry by entry by the generic
+ * small_algebra templates. Here, all blocks are stored contiguously in one
+ * array (column-major within the block) and the rows are processed by the
+ * BSRBlockKernel, which keeps the result block in registers and is vectorized
+ * if ug4 is compiled for AVX2 or AVX-512.
+ *
+ * The copy is created by init() and is not updated if the original matrix
+ * changes. The block columns of a row are stored in ascending order.
+ * For the Jacobi and Gauss-Seidel steps the inverses of the diagonal blocks
+ * have to be computed by invert_diagonal() before.
+ *
+ * The vectors passed to the methods must store their blocks contiguously,
+ * i.e. Vector<double> or Vector<DenseVector<FixedArray1<double, N> > >.
+ *
+ * \tparam	N		block size
+ */
+template <int N>
+class BSRMatrix
+{
+	public:
+	///	block size
+		enum {blockSize = N};
+
+	///	kernel used for the block rows
+		typedef BSRBlockKernel<N> kernel_type;
+
+	public:
+	///	constructor
+		BSRMatrix() : m_numRows(0), m_bDiagInv(false) {}
+
+	///	creates the BSR copy of a matrix
+		template <typename TSparseMatrix>
+		void init(const TSparseMatrix& A)
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			typedef typename TSparseMatrix::value_type block_type;
+			typedef typename TSparseMatrix::const_row_iterator const_row_it;
+			UG_STATIC_ASSERT((int)block_traits<block_type>::static_num_rows == N, block_size_does_not_match);
+			THROW_IF_NOT_EQUAL(A.num_rows(), A.num_cols());
+
+			const size_t n = A.num_rows();
+			m_numRows = n;
+			m_bDiagInv = false;
+			m_vRowStart.resize(n + 1);
+			m_vDiag.resize(n);
+
+			m_vRowStart[0] = 0;
+			for(size_t i = 0; i < n; ++i)
+			{
+				size_t num = 0;
+				for(const_row_it it = A.begin_row(i); it != A.end_row(i); ++it) ++num;
+				m_vRowStart[i+1] = m_vRowStart[i] + num;
+			}
+
+			m_vCol.resize(m_vRowStart[n]);
+			m_vVal.resize(m_vRowStart[n] * N*N);
+
+			std::vector<std::pair<size_t, const block_type*> > vRow;
+			for(size_t i = 0; i < n; ++i)
+			{
+			//	collect the row in ascending column order
+				vRow.clear();
+				for(const_row_it it = A.begin_row(i); it != A.end_row(i); ++it)
+					vRow.push_back(std::make_pair(it.index(), &it.value()));
+				std::sort(vRow.begin(), vRow.end(), CompareCol());
+
+				m_vDiag[i] = m_vRowStart[i+1];
+				for(size_t k = 0; k < vRow.size(); ++k)
+				{
+					const size_t pos = m_vRowStart[i] + k;
+					m_vCol[pos] = vRow[k].first;
+					if(vRow[k].first == i) m_vDiag[i] = pos;
+
+					double* a = &m_vVal[pos*N*N];
+					const block_type& b = *vRow[k].second;
+					for(int c = 0; c < N; ++c)
+						for(int r = 0; r < N; ++r)
+							a[c*N + r] = BlockRef(b, r, c);
+				}
+			}
+		}
+
+	///	computes the inverses of the diagonal blocks (needed for jacobi and gauss-seidel)
+		void invert_diagonal()
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			m_vDiagInv.resize(m_numRows * N*N);
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				double* inv = &m_vDiagInv[i*N*N];
+				if(m_vDiag[i] == m_vRowStart[i+1])
+					UG_THROW("BSRMatrix: Row " << i << " has no diagonal block.");
+				std::copy(&m_vVal[m_vDiag[i]*N*N], &m_vVal[m_vDiag[i]*N*N] + N*N, inv);
+				if(!invert_block(inv))
+					UG_THROW("BSRMatrix: Diagonal block of row " << i << " is singular.");
+			}
+			m_bDiagInv = true;
+		}
+
+	///	returns the number of (block) rows
+		size_t num_rows() const {return m_numRows;}
+
+	///	returns the number of stored blocks
+		size_t num_blocks() const {return m_vCol.size();}
+
+	///	calculates y = A*x
+		template <typename TVector>
+		void apply(TVector& y, const TVector& x) const
+		{
+			mult_add(y, 0.0, 1.0, x);
+		}
+
+	///	calculates y -= A*x
+		template <typename TVector>
+		void apply_sub(TVector& y, const TVector& x) const
+		{
+			mult_add(y, 1.0, -1.0, x);
+		}
+
+	///	calculates y = alpha*y + beta*A*x
+		template <typename TVector>
+		void mult_add(TVector& y, number alpha, number beta, const TVector& x) const
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			THROW_IF_NOT_EQUAL_3(y.size(), x.size(), m_numRows);
+			double* py = data(y);
+			const double* px = data(x);
+			const size_t n = m_numRows;
+
+			UG_OMP_PARALLEL_FOR(n)
+			for(size_t i = 0; i < n; ++i)
+			{
+				const size_t start = m_vRowStart[i];
+				kernel_type::row_mult(py + i*N, alpha, beta, &m_vVal[0] + start*N*N,
+				                      &m_vCol[0] + start, m_vRowStart[i+1] - start, px);
+			}
+		}
+
+	///	calculates c = damp * D^{-1} d
+		template <typename TVector>
+		void jacobi(TVector& c, const TVector& d, number damp) const
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			check_diag_inv(c, d);
+			double* pc = data(c);
+			const double* pd = data(d);
+			const size_t n = m_numRows;
+
+			UG_OMP_PARALLEL_FOR(n)
+			for(size_t i = 0; i < n; ++i)
+				block_mult(pc + i*N, damp, &m_vDiagInv[i*N*N], pd + i*N);
+		}
+
+	///	forward gauss-seidel step, c = relax * (D-L)^{-1} d (see gs_step_LL)
+		template <typename TVector>
+		void gs_forward(TVector& c, const TVector& d, number relax) const
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			check_diag_inv(c, d);
+			double* pc = data(c);
+			const double* pd = data(d);
+
+			double s[N];
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				const size_t start = m_vRowStart[i];
+				std::copy(pd + i*N, pd + (i+1)*N, s);
+				kernel_type::row_mult(s, 1.0, -1.0, &m_vVal[0] + start*N*N,
+				                      &m_vCol[0] + start, m_vDiag[i] - start, pc);
+				block_mult(pc + i*N, relax, &m_vDiagInv[i*N*N], s);
+			}
+		}
+
+	///	backward gauss-seidel step, c = relax * (D-U)^{-1} d (see gs_step_UR)
+		template <typename TVector>
+		void gs_backward(TVector& c, const TVector& d, number relax) const
+		{
+			PROFILE_FUNC_GROUP("algebra");
+			check_diag_inv(c, d);
+			double* pc = data(c);
+			const double* pd = data(d);
+
+			double s[N];
+			for(size_t i = m_numRows; i-- != 0; )
+			{
+				const size_t start = m_vDiag[i] + 1;
+				std::copy(pd + i*N, pd + (i+1)*N, s);
+				kernel_type::row_mult(s, 1.0, -1.0, &m_vVal[0] + start*N*N,
+				                      &m_vCol[0] + start, m_vRowStart[i+1] - start, pc);
+				block_mult(pc + i*N, relax, &m_vDiagInv[i*N*N], s);
+			}
+		}
+
+	///	symmetric gauss-seidel step, c = relax * (D-U)^{-1} D relax * (D-L)^{-1} d (see sgs_step)
+		template <typename TVector>
+		void sgs(TVector& c, const TVector& d, number relax) const
+		{
+			gs_forward(c, d, relax);
+
+			double* pc = data(c);
+			double s[N];
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				std::copy(pc + i*N, pc + (i+1)*N, s);
+				block_mult(pc + i*N, 1.0, &m_vVal[m_vDiag[i]*N*N], s);
+			}
+
+			gs_backward(c, c, relax);
+		}
+
+	///	inverts a column-major N x N block by gauss-jordan elimination (returns false if singular)
+		static bool invert_block(double* a)
+		{
+			double inv[N*N];
+			for(int k = 0; k < N*N; ++k) inv[k] = 0.0;
+			for(int k = 0; k < N; ++k) inv[k*N + k] = 1.0;
+
+			for(int c = 0; c < N; ++c)
+			{
+			//	pivot search in column c
+				int p = c;
+				for(int r = c + 1; r < N; ++r)
+					if(std::fabs(a[c*N + r]) > std::fabs(a[c*N + p])) p = r;
+				if(a[c*N + p] == 0.0) return false;
+
+				if(p != c)
+					for(int j = 0; j < N; ++j)
+					{
+						std::swap(a[j*N + p], a[j*N + c]);
+						std::swap(inv[j*N + p], inv[j*N + c]);
+					}
+
+				const double f = 1.0 / a[c*N + c];
+				for(int j = 0; j < N; ++j) {a[j*N + c] *= f; inv[j*N + c] *= f;}
+
+				for(int r = 0; r < N; ++r)
+				{
+					if(r == c) continue;
+					const double g = a[c*N + r];
+					if(g == 0.0) continue;
+					for(int j = 0; j < N; ++j)
+					{
+						a[j*N + r] -= g * a[j*N + c];
+						inv[j*N + r] -= g * inv[j*N + c];
+					}
+				}
+			}
+
+			std::copy(inv, inv + N*N, a);
+			return true;
+		}
+
+	///	y = beta * A x for a single block
+		static inline void block_mult(double* y, double beta, const double* a, const double* x)
+		{
+			static const size_t zero = 0;
+			kernel_type::row_mult(y, 0.0, beta, a, &zero, 1, x);
+		}
+
+	///	returns a pointer to the contiguous values of a vector
+		template <typename TVector>
+		static double* data(TVector& v)
+		{
+			UG_STATIC_ASSERT(sizeof(typename TVector::value_type) == N*sizeof(double), vector_blocks_must_be_contiguous);
+			return v.size() ? &BlockRef(v[0], 0) : NULL;
+		}
+
+	///	returns a pointer to the contiguous values of a vector
+		template <typename TVector>
+		static const double* data(const TVector& v)
+		{
+			UG_STATIC_ASSERT(sizeof(typename TVector::value_type) == N*sizeof(double), vector_blocks_must_be_contiguous);
+			return v.size() ? &BlockRef(v[0], 0) : NULL;
+		}
+
+	protected:
+		struct CompareCol
+		{
+			template <typename T>
+			bool operator()(const T& a, const T& b) const {return a.first < b.first;}
+		};
+
+		template <typename TVector>
+		void check_diag_inv(const TVector& c, const TVector& d) const
+		{
+			UG_COND_THROW(!m_bDiagInv, "BSRMatrix: Diagonal not inverted.");
+			THROW_IF_NOT_EQUAL_3(c.size(), d.size(), m_numRows);
+		}
+
+	protected:
+	///	number of (block) rows
+		size_t m_numRows;
+
+	///	first block of every row (size num_rows() + 1)
+		std::vector<size_t> m_vRowStart;
+
+	///	block column of every block
+		std::vector<size_t> m_vCol;
+
+	///	position of the diagonal block in every row (m_vRowStart[i+1] if missing)
+		std::vector<size_t> m_vDiag;
+
+	///	values of the blocks (N*N per block, column-major)
+		std::vector<double> m_vVal;
+
+	///	inverted diagonal blocks (N*N per row, column-major)
+		std::vector<double> m_vDiagInv;
+		bool m_bDiagInv;
+};
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__BSR_MATRIX__ */
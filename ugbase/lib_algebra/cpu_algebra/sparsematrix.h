@@ -39,6 +39,8 @@
 #include <iostream>
 #include <algorithm>
 #include "common/util/ostream_util.h"
+#include "common/util/openmp_util.h"
+#include "common/allocators/default_init_allocator.h"
 
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
@@ -434,7 +436,11 @@ public:
 #ifdef CHECK_ROW_ITERATORS
 		  _row(row),
 #endif
-		  i(_i) {A.add_iterator(row);}
+		  i(_i) {
+#ifdef CHECK_ROW_ITERATORS
+			  A.add_iterator(_row);
+#endif
+		  }
         const_row_iterator(const const_row_iterator &other) : A(other.A),
 #ifdef CHECK_ROW_ITERATORS
 		  _row(other._row),
@@ -442,8 +448,6 @@ public:
 		  i(other.i) {
 #ifdef CHECK_ROW_ITERATORS
 			  A.add_iterator(_row);
-#else
-			  A.add_iterator(-1);
 #endif
 		  }
         const_row_iterator(const_row_iterator&& other) : A(other.A),
@@ -453,8 +457,6 @@ public:
 			  i(other.i) {
 #ifdef CHECK_ROW_ITERATORS
 			  A.add_iterator(_row);
-#else
-			  A.add_iterator(-1);
 #endif
 		  }
 		  const_row_iterator& operator=(const_row_iterator const&) = delete;
@@ -462,8 +464,6 @@ public:
         ~const_row_iterator() {
 #ifdef CHECK_ROW_ITERATORS
 			  A.remove_iterator(_row);
-#else
-			  A.remove_iterator(-1);
 #endif
 		  }
         const const_row_iterator *operator ->() const { return this; }
@@ -584,6 +584,34 @@ public:
 		return row_iterator(*this, r, j);
 	}
 
+	/**
+	 * \param r index of the row
+	 * \param c index of the column
+	 * \return position of the connection A(r,c) in the value array, -1 if not existing
+	 * \note the position stays valid as long as the structure of the matrix
+	 * is not changed (no connections added, no defragmentation of a
+	 * fragmented matrix).
+	 */
+	int get_position(size_t r, size_t c) const
+	{
+		check_rc(r, c);
+		return get_index_const(r, c);
+	}
+
+	/**
+	 * \param pos position of a connection (see get_position)
+	 * \return the value of the connection
+	 */
+	value_type &value_at(size_t pos)
+	{
+		UG_ASSERT((int)pos < maxValues, "position " << pos << " out of bounds");
+		return values[pos];
+	}
+	const value_type &value_at(size_t pos) const
+	{
+		UG_ASSERT((int)pos < maxValues, "position " << pos << " out of bounds");
+		return values[pos];
+	}
 
 	void defragment()
     {
@@ -611,9 +639,9 @@ public:
 		numRows = num_rows();
 		numCols = num_cols();
 		defragment();
-		argValues = values;
+		argValues.assign(values.begin(), values.end());
 		argRowStart = rowStart;
-		argColInd = cols;
+		argColInd.assign(cols.begin(), cols.end());
 	}
 
 	/**
@@ -647,7 +675,7 @@ public:
 	void get_values(std::vector<value_type> &argValues) const
 	{
 		defragment();
-		argValues = values;
+		argValues.assign(values.begin(), values.end());
 	}
 
 
@@ -679,23 +707,35 @@ public:
 private:
 	// private functions
 
+	//	The iterator counters are updated atomically, since const_row_iterators
+	//	may be used concurrently by several threads. In release builds, only
+	//	row_iterators are counted (const_row_iterators do not modify the matrix).
 	void add_iterator(size_t row) const
 	{
 #ifdef CHECK_ROW_ITERATORS
+		UG_OMP_ATOMIC
 		nrOfRowIterators[row]++;
 #endif
+		UG_OMP_ATOMIC
 		iIterators++;
 	}
 	void remove_iterator(size_t row) const
 	{
 #ifdef CHECK_ROW_ITERATORS
+		UG_OMP_ATOMIC
 		nrOfRowIterators[row]--;
 		UG_ASSERT(nrOfRowIterators[row] >= 0, row);
 #endif
+		UG_OMP_ATOMIC
 		iIterators--;
 		UG_ASSERT(iIterators >= 0, row);
 
 	}
+	//! calculates dest += beta1*A^T*w1 (threaded by blocks of rows and entries of dest)
+	template<typename vector_t>
+	void add_transposed_rows(vector_t &dest,
+			const number &beta1, const vector_t &w1) const;
+
 	inline void check_row(size_t row, int i) const
 	{
 		UG_ASSERT(i < rowEnd[row] && i >= rowStart[row], "row iterator row " << row << " pos " << i << " out of bounds [" << rowStart[row] << ", " << rowEnd[row] << "]");
@@ -734,15 +774,20 @@ public: // bug
 #endif
 
 protected:
+	//	cols and values are not zeroed on allocation, so that they are first
+	//	touched by the threads working on the corresponding rows (NUMA).
+	typedef std::vector<int, DefaultInitAllocator<int> > cols_vector_type;
+	typedef std::vector<value_type, DefaultInitAllocator<value_type> > values_vector_type;
+
     std::vector<int> rowStart;
     std::vector<int> rowEnd;
     std::vector<int> rowMax;
-    std::vector<int> cols;
+    cols_vector_type cols;
     size_t fragmented;
     size_t nnz;
     bool bNeedsValues;
 
-    std::vector<value_type> values;
+    values_vector_type values;
     int maxValues;
     int m_numCols;
     mutable int iIterators;
@@ -40,6 +40,7 @@
 
 #include "lib_algebra/common/operations_vec.h"
 #include "common/profiler/profiler.h"
+#include "common/util/openmp_util.h"
 #include "sparsematrix.h"
 #include <vector>
 #include <algorithm>
@@ -77,8 +78,8 @@ void SparseMatrix<T>::clear_and_free()
 	m_numCols = 0;
 	nnz = 0;
 
-	std::vector<int>().swap(cols);
-	std::vector<value_type>().swap(values);
+	cols_vector_type().swap(cols);
+	values_vector_type().swap(values);
 	maxValues = 0;
 
 #ifdef CHECK_ROW_ITERATORS
@@ -273,7 +274,9 @@ template<typename vector_t>
 void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
-	for(size_t i=0; i < num_rows(); i++)
+	const size_t numRows = num_rows();
+	UG_OMP_PARALLEL_FOR(numRows)
+	for(size_t i=0; i < numRows; i++)
 	{
 		size_t rowIt=rowStart[i];
 		size_t itEnd=rowEnd[i];
@@ -297,9 +300,11 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy);
 	check_fragmentation();
+	const size_t numRows = num_rows();
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t i=0; i < numRows; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -317,20 +322,25 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+			UG_OMP_PARALLEL_FOR(numRows)
+			for(size_t i=0; i < numRows; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+		{
+			UG_OMP_PARALLEL_FOR(numRows)
+			for(size_t i=0; i < numRows; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
+		}
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t i=0; i < numRows; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -347,6 +357,7 @@ void SparseMatrix<T>::axpy_transposed(vector_t &dest,
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy_transposed);
 	check_fragmentation();
+	const size_t numDest = dest.size();
 	if(&dest == &v1) {
 		if(alpha1 == 0.0)
 			dest.set(0.0);
@@ -356,33 +367,103 @@ void SparseMatrix<T>::axpy_transposed(vector_t &dest,
 	else if(alpha1 == 0.0)
 		dest.set(0.0);
 	else
-		VecScaleAssign(dest, alpha1, v1);
+	{
+		UG_OMP_PARALLEL_FOR(numDest)
+		for(size_t i=0; i < numDest; i++)
+			VecScaleAssign(dest[i], alpha1, v1[i]);
+	}
 
+	add_transposed_rows(dest, beta1, w1);
+}
+
+
+template<typename T>
+template<typename vector_t>
+void SparseMatrix<T>::apply_transposed_ignore_zero_rows(vector_t &dest,
+		const number &beta1, const vector_t &w1) const
+{
 	for(size_t i=0; i<num_rows(); i++)
 	{
-
 		size_t itEnd=rowEnd[i];
 		for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
-			// dest[conn.index()] += beta1 * conn.value() * w1[i];
-			if(values[rowIt] != 0.0)
-				MatMultTransposedAdd(dest[cols[rowIt]], 1.0, dest[cols[rowIt]], beta1, values[rowIt], w1[i]);
+			dest[cols[rowIt]] = 0.0;
 	}
+
+	add_transposed_rows(dest, beta1, w1);
 }
 
 
+// calculate dest += beta1*A^T*w1 (A = this matrix)
 template<typename T>
 template<typename vector_t>
-void SparseMatrix<T>::apply_transposed_ignore_zero_rows(vector_t &dest,
+void SparseMatrix<T>::add_transposed_rows(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
-	for(size_t i=0; i<num_rows(); i++)
+	const size_t numRows = num_rows();
+
+#ifdef UG_OPENMP
+//	The rows of A scatter into arbitrary entries of dest. When threaded, the
+//	rows and the entries of dest are split into the same number of
+//	consecutive blocks. Each thread adds the entries of its rows that fall
+//	into its own block of dest directly and records the other ones (position
+//	in A and row). These are added by the thread owning the target block
+//	afterwards. For matrices with a small bandwidth only few entries are
+//	recorded, the extra memory is proportional to their number. The blocks are
+//	computed from the number of threads actually executing the region.
+	if(NumOMPThreads() > 1 && UseOMPThreads(numRows))
 	{
-		row_iterator itEnd = end_row(i);
-		for(const_row_iterator conn = begin_row(i); conn != itEnd; ++conn)
-			dest[conn.index()] = 0.0;
+		const size_t numDest = dest.size();
+		typedef std::vector<std::pair<int, size_t> > foreign_list;
+		std::vector<foreign_list> vForeign;
+
+		#pragma omp parallel num_threads(NumOMPThreads())
+		{
+			const int numThreads = omp_get_num_threads();
+			const int tid = omp_get_thread_num();
+
+			#pragma omp single
+			vForeign.resize(numThreads * numThreads);
+
+			const size_t firstRow = (numRows * tid) / numThreads;
+			const size_t endRow = (numRows * (tid+1)) / numThreads;
+			const size_t destBegin = (numDest * tid) / numThreads;
+			const size_t destEnd = (numDest * (tid+1)) / numThreads;
+
+			for(size_t i=firstRow; i<endRow; i++)
+			{
+				size_t itEnd=rowEnd[i];
+				for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
+				{
+					if(values[rowIt] == 0.0) continue;
+					const size_t c = cols[rowIt];
+					if(c >= destBegin && c < destEnd)
+						MatMultTransposedAdd(dest[c], 1.0, dest[c], beta1, values[rowIt], w1[i]);
+					else
+					{
+						const int owner = (int)(((c+1) * numThreads - 1) / numDest);
+						vForeign[tid * numThreads + owner].push_back(std::make_pair((int)rowIt, i));
+					}
+				}
+			}
+
+			#pragma omp barrier
+
+			for(int t=0; t < numThreads; t++)
+			{
+				const foreign_list& list = vForeign[t * numThreads + tid];
+				for(size_t k=0; k < list.size(); k++)
+				{
+					const int rowIt = list[k].first;
+					const size_t c = cols[rowIt];
+					MatMultTransposedAdd(dest[c], 1.0, dest[c], beta1, values[rowIt], w1[list[k].second]);
+				}
+			}
+		}
+		return;
 	}
+#endif
 
-	for(size_t i=0; i<num_rows(); i++)
+	for(size_t i=0; i<numRows; i++)
 	{
 		size_t itEnd=rowEnd[i];
 		for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
@@ -719,16 +800,34 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 		return;
 	}
 
-	std::vector<value_type> v(newSize);
-	std::vector<int> c(newSize);
-	size_t j=0;
-	for(size_t r=0; r<num_rows(); r++)
+	const size_t numRows = num_rows();
+
+//	compute the new row starts
+	std::vector<int> newRowStart(numRows+1, 0);
+	UG_OMP_PARALLEL_FOR(numRows)
+	for(size_t r=0; r<numRows; r++)
 	{
-		if(rowStart[r] == -1)
-			rowStart[r] = rowEnd[r] = rowMax[r] = j;
-		else
+		if(rowStart[r] == -1) continue;
+		int n = 0;
+		for(int k=rowStart[r]; k<rowEnd[r]; k++)
+			if(cols[k] < (int)maxCol)
+				n++;
+		newRowStart[r+1] = n;
+	}
+	for(size_t r=0; r<numRows; r++)
+		newRowStart[r+1] += newRowStart[r];
+
+//	copy the rows. The new arrays are not initialized, so the pages are first
+//	touched here, by the same threads which process these rows in axpy.
+	values_vector_type v;
+	if(bNeedsValues) v.resize(newSize);
+	cols_vector_type c(newSize);
+	UG_OMP_PARALLEL_FOR(numRows)
+	for(size_t r=0; r<numRows; r++)
+	{
+		int j = newRowStart[r];
+		if(rowStart[r] != -1)
 		{
-			size_t start=j;
 			for(int k=rowStart[r]; k<rowEnd[r]; k++)
 			{
 				if(cols[k] < (int)maxCol)
@@ -738,13 +837,13 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 					j++;
 				}
 			}
-			rowStart[r] = start;
-			rowEnd[r] = rowMax[r] = j;
 		}
+		rowStart[r] = newRowStart[r];
+		rowEnd[r] = rowMax[r] = newRowStart[r+1];
 	}
 	rowStart[num_rows()] = rowEnd[num_rows()-1];
 	fragmented = 0;
-	maxValues = j;
+	maxValues = newRowStart[numRows];
 	if(bNeedsValues) values.swap(v);
 	cols.swap(c);
 }
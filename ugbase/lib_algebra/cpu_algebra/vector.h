@@ -38,6 +38,7 @@
 #include "../common/template_expressions.h"
 #include "../common/operations.h"
 #include "common/util/smart_pointer.h"
+#include "common/util/openmp_util.h"
 #include <vector>
 //#include "../vector_interface/ivector.h"
 
@@ -169,7 +170,8 @@ public:
 
 	inline void operator *= (const number &a)
 	{
-		for(size_t i=0; i<size(); i++) values[i] *= a;
+		UG_OMP_PARALLEL_FOR(m_size)
+		for(size_t i=0; i<m_size; i++) values[i] *= a;
 	}
 
 	//! return sqrt(sum values[i]^2) (euclidian norm)
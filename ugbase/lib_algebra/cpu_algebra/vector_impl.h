@@ -39,6 +39,7 @@
 #include "algebra_misc.h"
 #include "common/math/ugmath.h"
 #include "vector.h" // for urand
+#include "common/util/openmp_util.h"
 
 #define prefetchReadWrite(a)
 
@@ -74,6 +75,7 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 	UG_ASSERT(m_size == w.m_size,  *this << " has not same size as " << w);
 
 	double sum=0;
+	UG_OMP_PARALLEL_FOR_SUM(m_size, sum)
 	for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
 	return sum;
 }
@@ -82,6 +84,7 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
+	UG_OMP_PARALLEL_FOR(m_size)
 	for(size_t i=0; i<m_size; i++)
 		values[i] = d;
 	return d;
@@ -100,6 +103,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator = (const vector_type &v)
 {
 	resize(v.size());
+	UG_OMP_PARALLEL_FOR(m_size)
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v[i];
 }
@@ -108,6 +112,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator += (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+	UG_OMP_PARALLEL_FOR(m_size)
 	for(size_t i=0; i<m_size; i++)
 		values[i] += v[i];
 }
@@ -116,6 +121,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator -= (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+	UG_OMP_PARALLEL_FOR(m_size)
 	for(size_t i=0; i<m_size; i++)
 		values[i] -= v[i];
 }
@@ -197,8 +203,10 @@ void Vector<value_type>::reserve_exactly(size_t newCapacity, bool bCopyValues)
 	// we cannot use memcpy here bcs of variable blocks.
 	if(values != NULL && bCopyValues)
 	{
+		UG_OMP_PARALLEL_FOR(m_size)
 		for(size_t i=0; i<m_size; i++)
 			std::swap(new_values[i], values[i]);
+		UG_OMP_PARALLEL_FOR(newCapacity-m_size)
 		for(size_t i=m_size; i<newCapacity; i++)
 			new_values[i] = 0.0;
 	}
@@ -245,6 +253,7 @@ void Vector<value_type>::create(const Vector &v)
 	m_capacity = m_size;
 
 	// we cannot use memcpy here bcs of variable blocks.
+	UG_OMP_PARALLEL_FOR(m_size)
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v.values[i];
 }
@@ -323,7 +332,8 @@ template<typename value_type>
 inline double Vector<value_type>::norm() const
 {
 	double d=0;
-	for(size_t i=0; i<size(); ++i)
+	UG_OMP_PARALLEL_FOR_SUM(m_size, d)
+	for(size_t i=0; i<m_size; ++i)
 		d+=BlockNorm2(values[i]);
 	return sqrt(d);
 }
@@ -332,11 +342,107 @@ template<typename value_type>
 inline double Vector<value_type>::maxnorm() const
 {
 	double d=0;
-	for(size_t i=0; i<size(); ++i)
+	UG_OMP_PARALLEL_FOR_MAX(m_size, d)
+	for(size_t i=0; i<m_size; ++i)
 		d = std::max(d, BlockMaxNorm(values[i]));
 	return d;
 }
 
+// BLAS-1 operations for Vector. These overload the generic versions of
+// operations_vec.h and are threaded if ug4 is compiled with OpenMP.
+
+//! calculates dest = alpha1*v1
+template<typename value_type>
+inline void VecScaleAssign(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1)
+{
+	const size_t n = dest.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i=0; i<n; i++)
+		VecScaleAssign(dest[i], alpha1, v1[i]);
+}
+
+//! sets dest = v1 entrywise
+template<typename value_type>
+inline void VecAssign(Vector<value_type> &dest, const Vector<value_type> &v1)
+{
+	const size_t n = dest.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i=0; i<n; i++)
+		dest[i] = v1[i];
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+		double alpha2, const Vector<value_type> &v2)
+{
+	const size_t n = dest.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3
+template<typename value_type>
+inline void VecScaleAdd(Vector<value_type> &dest, double alpha1, const Vector<value_type> &v1,
+		double alpha2, const Vector<value_type> &v2, double alpha3, const Vector<value_type> &v3)
+{
+	const size_t n = dest.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i], alpha3, v3[i]);
+}
+
+//! calculates s += scal<a, b>
+template<typename value_type>
+inline void VecProdAdd(const Vector<value_type> &a, const Vector<value_type> &b, double &s)
+{
+	const size_t n = a.size();
+	double sum = 0;
+	UG_OMP_PARALLEL_FOR_SUM(n, sum)
+	for(size_t i=0; i<n; i++)
+		VecProdAdd(a[i], b[i], sum);
+	s += sum;
+}
+
+//! calculates s += scal<a, b>
+template<typename value_type>
+inline void VecProd(const Vector<value_type> &a, const Vector<value_type> &b, double &s)
+{
+	VecProdAdd(a, b, s);
+}
+
+//! returns scal<a, b>
+template<typename value_type>
+inline double VecProd(const Vector<value_type> &a, const Vector<value_type> &b)
+{
+	double sum=0;
+	VecProdAdd(a, b, sum);
+	return sum;
+}
+
+//! calculates s += norm_2^2(a)
+template<typename value_type>
+inline void VecNormSquaredAdd(const Vector<value_type> &a, double &s)
+{
+	const size_t n = a.size();
+	double sum = 0;
+	UG_OMP_PARALLEL_FOR_SUM(n, sum)
+	for(size_t i=0; i<n; i++)
+		VecNormSquaredAdd(a[i], sum);
+	s += sum;
+}
+
+//! returns norm_2^2(a)
+template<typename value_type>
+inline double VecNormSquared(const Vector<value_type> &a)
+{
+	double sum=0;
+	VecNormSquaredAdd(a, sum);
+	return sum;
+}
+
+
 template<typename TValueType>
 void CloneVector(Vector<TValueType> &dest, const Vector<TValueType>& src)
 {
@@ -90,6 +90,26 @@ struct CPUAlgebra
 	}
 };
 
+/// single precision variant of the CPUAlgebra
+/**
+ * Matrices and vectors store float values. The algebra is not registered as an
+ * algebra type of its own. It is used internally to store and apply
+ * preconditioners in single precision (see MixedPrecision), while the outer
+ * iteration uses the double precision algebra.
+ */
+struct CPUFloatAlgebra
+{
+#ifdef UG_PARALLEL
+		typedef ParallelMatrix<SparseMatrix<float> > matrix_type;
+		typedef ParallelVector<Vector<float> > vector_type;
+#else
+		typedef SparseMatrix<float> matrix_type;
+		typedef Vector<float> vector_type;
+#endif
+
+	static const int blockSize = 1;
+};
+
 // end group cpu_algebra
 /// \}
 
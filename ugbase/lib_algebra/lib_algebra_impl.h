@@ -54,6 +54,8 @@
 #include "lib_algebra/operator/linear_solver/linear_solver.h"
 #include "lib_algebra/operator/linear_solver/cg.h"
 #include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/linear_solver/pipelined_cg.h"
+#include "lib_algebra/operator/linear_solver/pipelined_bicgstab.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
 #ifdef UG_PARALLEL
 #include "lib_algebra/operator/linear_solver/feti.h"
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__LIB_ALGEBRA__OPERATOR__BSR_MATRIX_OPERATOR__
+#define __H__LIB_ALGEBRA__OPERATOR__BSR_MATRIX_OPERATOR__
+
+#include <iomanip>
+#include <sstream>
+
+#include "common/stopwatch.h"
+#include "lib_algebra/cpu_algebra/bsr_matrix.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_algebra/operator/preconditioner/bsr_smoothers.h"
+
+namespace ug{
+
+///////////////////////////////////////////////////////////////////////////////
+// BSR matrix based linear operator
+///////////////////////////////////////////////////////////////////////////////
+
+/// linear operator applying a BSR copy of a matrix
+/**
+ * The matrix of the passed MatrixOperator is copied into a BSRMatrix on init().
+ * apply and apply_sub are computed by the BSR block kernels and have the same
+ * parallel storage type rules as ParallelMatrix::apply and matmul_minus.
+ * Changes of the original matrix take effect only after calling init() again.
+ *
+ * Only usable for the CPU algebras with fixed block size.
+ *
+ * \tparam	TAlgebra	Algebra type
+ */
+template <typename TAlgebra>
+class BSRMatrixOperator : public ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef MatrixOperator<matrix_type, vector_type> matrix_operator_type;
+
+	///	block size
+		enum {N = block_traits<typename matrix_type::value_type>::static_num_rows};
+
+	///	BSR matrix type
+		typedef BSRMatrix<N> bsr_matrix_type;
+
+	public:
+	///	constructor
+		BSRMatrixOperator(SmartPtr<matrix_operator_type> spOp) : m_spOp(spOp) {}
+
+	// 	Init Operator J(u)
+		virtual void init(const vector_type& u) {init();}
+
+	// 	Init Operator L
+		virtual void init()
+		{
+			UG_COND_THROW(m_spOp.invalid(), "BSRMatrixOperator: No matrix operator set.");
+			m_bsr.init(*m_spOp);
+		}
+
+	// 	Apply Operator f = L*u
+		virtual void apply(vector_type& f, const vector_type& u)
+		{
+#ifdef UG_PARALLEL
+			const ParallelStorageType type = GetMultType(*m_spOp, u);
+#endif
+			m_bsr.apply(f, u);
+#ifdef UG_PARALLEL
+			f.set_storage_type(type);
+#endif
+		}
+
+	// 	Apply Operator, i.e. f = f - L*u;
+		virtual void apply_sub(vector_type& f, const vector_type& u)
+		{
+#ifdef UG_PARALLEL
+			if(!(m_spOp->has_storage_type(PST_ADDITIVE) && u.has_storage_type(PST_CONSISTENT)
+					&& f.has_storage_type(PST_ADDITIVE)))
+				UG_THROW("BSRMatrixOperator::apply_sub (b -= A*x): Wrong storage type of "
+						"Matrix/Vector: A must be PST_ADDITIVE, x PST_CONSISTENT and b PST_ADDITIVE.");
+#endif
+			m_bsr.apply_sub(f, u);
+#ifdef UG_PARALLEL
+			f.set_storage_type(PST_ADDITIVE);
+#endif
+		}
+
+	///	returns the BSR copy of the matrix
+		const bsr_matrix_type& bsr_matrix() const {return m_bsr;}
+
+	protected:
+	///	operator holding the original matrix
+		SmartPtr<matrix_operator_type> m_spOp;
+
+	///	BSR copy of the matrix
+		bsr_matrix_type m_bsr;
+};
+
+
+/// compares the BSR kernels with the SparseMatrix of the current block layout
+/**
+ * Performs numIter applications of the matrix (y = A*x), of the Jacobi and of
+ * the Gauss-Seidel preconditioner, once with the SparseMatrix of the operator
+ * (MatrixOperator, Jacobi, GaussSeidel) and once with its BSR copy
+ * (BSRMatrixOperator, BSRJacobi, BSRGaussSeidel). The average times, the
+ * speedup and the norm of the difference of the results are printed.
+ *
+ * \param[in]	spOp		matrix operator (e.g. an assembled system)
+ * \param[in]	numIter		number of applications per kernel
+ */
+template <typename TAlgebra>
+void BenchmarkBSR(SmartPtr<MatrixOperator<typename TAlgebra::matrix_type,
+                  typename TAlgebra::vector_type> > spOp, size_t numIter)
+{
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef BSRMatrixOperator<TAlgebra> bsr_operator_type;
+
+	UG_COND_THROW(spOp.invalid(), "BenchmarkBSR: No matrix operator passed.");
+	if(numIter == 0) numIter = 1;
+	const size_t n = spOp->num_rows();
+
+//	vectors
+	vector_type x, d, y1, y2;
+	x.resize(n); d.resize(n); y1.resize(n); y2.resize(n);
+#ifdef UG_PARALLEL
+	x.set_layouts(spOp->layouts()); d.set_layouts(spOp->layouts());
+	y1.set_layouts(spOp->layouts()); y2.set_layouts(spOp->layouts());
+#endif
+	x.set_random(-1.0, 1.0);
+	d.set_random(-1.0, 1.0);
+#ifdef UG_PARALLEL
+	d.change_storage_type(PST_ADDITIVE);
+#endif
+
+	SmartPtr<bsr_operator_type> spBSR = make_sp(new bsr_operator_type(spOp));
+	double tInit = get_clock_s();
+	spBSR->init();
+	tInit = get_clock_s() - tInit;
+
+	std::stringstream ss;
+	ss << "BSR benchmark: " << n << " rows, " << spBSR->bsr_matrix().num_blocks()
+	   << " blocks of size " << (int)bsr_operator_type::N << ", kernels: "
+	   << BSRInstructionSet() << ", " << numIter << " iterations\n"
+	   << "  BSR copy of the matrix: " << tInit << " s\n"
+	   << std::setw(16) << "" << std::setw(16) << "SparseMatrix [s]"
+	   << std::setw(12) << "BSR [s]" << std::setw(10) << "speedup"
+	   << std::setw(14) << "difference" << "\n";
+
+	for(int kernel = 0; kernel < 3; ++kernel)
+	{
+		double t[2];
+		for(int bsr = 0; bsr < 2; ++bsr)
+		{
+			vector_type& y = bsr ? y2 : y1;
+			SmartPtr<IPreconditioner<TAlgebra> > spPrecond;
+			if(kernel == 1)
+			{
+				if(bsr) spPrecond = make_sp(new BSRJacobi<TAlgebra>(1.0));
+				else spPrecond = make_sp(new Jacobi<TAlgebra>(1.0));
+			}
+			else if(kernel == 2)
+			{
+				if(bsr) spPrecond = make_sp(new BSRGaussSeidel<TAlgebra>());
+				else spPrecond = make_sp(new GaussSeidel<TAlgebra>());
+			}
+			if(spPrecond.valid()) spPrecond->init(spOp);
+
+			t[bsr] = get_clock_s();
+			for(size_t iter = 0; iter < numIter; ++iter)
+			{
+				if(spPrecond.valid()) spPrecond->apply(y, d);
+				else if(bsr) spBSR->apply(y, x);
+				else spOp->apply(y, x);
+			}
+			t[bsr] = (get_clock_s() - t[bsr]) / numIter;
+		}
+
+		y1 -= y2;
+		const char* name[] = {"SpMV", "Jacobi", "Gauss-Seidel"};
+		ss << std::setw(16) << name[kernel] << std::setw(16) << t[0]
+		   << std::setw(12) << t[1] << std::setw(10) << (t[1] > 0 ? t[0] / t[1] : 0.0)
+		   << std::setw(14) << y1.norm() << "\n";
+	}
+
+	UG_LOG(ss.str());
+}
+
+} // end namespace ug
+
+#endif /* __H__LIB_ALGEBRA__OPERATOR__BSR_MATRIX_OPERATOR__ */
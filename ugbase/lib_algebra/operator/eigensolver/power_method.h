@@ -99,13 +99,15 @@ class PowerMethod
 		std::vector<bool> m_vbDirichlet;
 		int m_numDirichletRows;
 
+	//	Verbosity
+		bool m_bVerbose;
+
 	public:
 	//	Number of iterations
 		size_t m_iteration;
 
 		PowerMethod()
 		{
-			UG_LOG("Initializing PowerMethod." << std::endl);
 			m_spLinOpA = SPNULL;
 			m_spLinOpB = SPNULL;
 			m_spMatOpA = SPNULL;
@@ -116,6 +118,7 @@ class PowerMethod
 			m_dMaxEigenvalue = 0.0;
 			m_dMinEigenvalue = 0.0;
 			m_numDirichletRows = 0;
+			m_bVerbose = true;
 		}
 
 		void set_solver(SmartPtr<ILinearOperatorInverse<vector_type> > solver)
@@ -127,8 +130,12 @@ class PowerMethod
 		{
 			m_spLinOpA = loA;
 
-		// 	get dirichlet nodes
+		// 	get dirichlet nodes (only available for matrix based operators)
+			m_vbDirichlet.clear();
 			m_spMatOpA = m_spLinOpA.template cast_dynamic<MatrixOperator<matrix_type, vector_type> >();
+			if(m_spMatOpA.invalid())
+				return;
+
 			matrix_type& A = m_spMatOpA->get_matrix();
 			m_vbDirichlet.resize(A.num_rows());
 
@@ -162,6 +169,12 @@ class PowerMethod
 			m_dPrecision = precision;
 		}
 
+	///	enables/disables the output of the convergence information
+		void set_verbose(bool verbose)
+		{
+			m_bVerbose = verbose;
+		}
+
 		int calculate_max_eigenvalue()
 		{
 			PROFILE_FUNC_GROUP("PowerMethod");
@@ -188,7 +201,7 @@ class PowerMethod
 					m_spEigenvector = m_spResidual->clone();
 
 			//	reset Dirichlet rows to 0
-				for(size_t i = 0; i < m_spEigenvector->size(); i++)
+				for(size_t i = 0; i < m_vbDirichlet.size(); i++)
 				{
 					if(m_vbDirichlet[i])
 					{
@@ -213,11 +226,12 @@ class PowerMethod
 
 				if(m_spResidual->norm() <= m_dPrecision)
 				{
-					UG_LOG("PowerMethod::calculate_max_eigenvalue() converged after " << m_iteration << " iterations." << std::endl);
+					if(m_bVerbose)
+						UG_LOG("PowerMethod::calculate_max_eigenvalue() converged after " << m_iteration << " iterations." << std::endl);
 					break;
 				}
 
-				if(m_iteration == m_maxIterations-1)
+				if(m_bVerbose && m_iteration == m_maxIterations-1)
 					UG_LOG("PowerMethod::calculate_max_eigenvalue() reached precision of " << m_spResidual->norm() << " after " << m_maxIterations << " iterations." << std::endl);
 			}
 
@@ -260,7 +274,7 @@ class PowerMethod
 				m_spSolver->apply(*m_spEigenvector, *m_spResidual);
 
 			//	reset Dirichlet rows to 0
-				for(size_t i = 0; i < m_spEigenvector->size(); i++)
+				for(size_t i = 0; i < m_vbDirichlet.size(); i++)
 				{
 					if(m_vbDirichlet[i])
 					{
@@ -285,11 +299,12 @@ class PowerMethod
 
 				if(m_spResidual->norm() <= m_dPrecision)
 				{
-					UG_LOG("PowerMethod::calculate_min_eigenvalue() converged after " << m_iteration << " iterations." << std::endl);
+					if(m_bVerbose)
+						UG_LOG("PowerMethod::calculate_min_eigenvalue() converged after " << m_iteration << " iterations." << std::endl);
 					break;
 				}
 
-				if(m_iteration == m_maxIterations-1)
+				if(m_bVerbose && m_iteration == m_maxIterations-1)
 					UG_LOG("PowerMethod::calculate_min_eigenvalue() reached precision of " << m_spResidual->norm() << " after " << m_maxIterations << " iterations." << std::endl);
 			}
 
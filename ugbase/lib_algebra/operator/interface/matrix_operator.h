@@ -35,9 +35,51 @@
 
 #include "linear_operator.h"
 #include "lib_algebra/common/operations_mat/matrix_algebra_types.h"
+#ifdef UG_PARALLEL
+#include "lib_algebra/parallelization/parallel_storage_type.h"
+#endif
 
 namespace ug{
 
+///	computes f = A*u
+template <typename M, typename Y, typename X>
+inline void MatrixOperatorApply(const M& A, Y& f, const X& u)
+{
+	A.apply(f, u);
+}
+
+///	computes f = f - A*u
+template <typename M, typename Y, typename X>
+inline void MatrixOperatorApplySub(const M& A, Y& f, const X& u)
+{
+	A.matmul_minus(f, u);
+}
+
+#ifdef UG_PARALLEL
+template <typename TMatrix> class ParallelMatrix;
+
+/**	For parallel matrices and a non-consistent u, a copy of u is changed to
+ * consistent storage while the rows not coupling to the process interface are
+ * computed. u itself is not changed.*/
+template <typename TMatrix, typename X>
+inline void MatrixOperatorApply(const ParallelMatrix<TMatrix>& A, X& f, const X& u)
+{
+	if(u.has_storage_type(PST_CONSISTENT) || !A.has_storage_type(PST_ADDITIVE))
+		A.apply(f, u);
+	else
+		A.apply_overlapped(f, *u.clone());
+}
+
+template <typename TMatrix, typename X>
+inline void MatrixOperatorApplySub(const ParallelMatrix<TMatrix>& A, X& f, const X& u)
+{
+	if(u.has_storage_type(PST_CONSISTENT) || !A.has_storage_type(PST_ADDITIVE)
+		|| !f.has_storage_type(PST_ADDITIVE))
+		A.matmul_minus(f, u);
+	else
+		A.matmul_minus_overlapped(f, *u.clone());
+}
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 // Matrix based linear operator
@@ -65,10 +107,16 @@ class MatrixOperator :	public virtual ILinearOperator<X,Y>,
 		virtual void init() {}
 
 	// 	Apply Operator f = L*u (e.g. d = J(u)*c in iterative scheme)
-		virtual void apply(Y& f, const X& u) {matrix_type::apply(f,u);}
+		virtual void apply(Y& f, const X& u)
+		{
+			MatrixOperatorApply(static_cast<const matrix_type&>(*this), f, u);
+		}
 
 	// 	Apply Operator, i.e. f = f - L*u;
-		virtual void apply_sub(Y& f, const X& u) {matrix_type::matmul_minus(f,u);}
+		virtual void apply_sub(Y& f, const X& u)
+		{
+			MatrixOperatorApplySub(static_cast<const matrix_type&>(*this), f, u);
+		}
 
 	// 	Access to matrix
 		virtual M& get_matrix() {return *this;};
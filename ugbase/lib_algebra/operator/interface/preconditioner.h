@@ -357,6 +357,7 @@ class IPreconditioner :
 				return;
 			}
 			m_bOtherApproxOperator = true;
+			m_bInit = true;
 		}
 
 	/// virtual destructor
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__
+
+#include <vector>
+
+#include "common/common.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+	#include "pcl/pcl.h"
+#endif
+
+namespace ug{
+
+///	computes several dot products with one (non-blocking) global reduction
+/**
+ * The process-local parts of all dot products of a Krylov iteration are
+ * collected and summed up over all processes by a single MPI_Iallreduce.
+ * Between start() and wait() other work (e.g. the application of the
+ * operator or of the preconditioner) can be done while the reduction is
+ * in progress.
+ *
+ * No storage type conversion is performed: the passed vectors must have
+ * matching parallel storage types, i.e. additive (unique) and consistent or
+ * unique and unique.
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class FusedVecProd
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Vector type of the process-local part
+		typedef typename TVector::vector_type local_vector_type;
+
+	public:
+	///	constructor
+		FusedVecProd() : m_bStarted(false)
+		{
+		#ifdef UG_PARALLEL
+			m_request = MPI_REQUEST_NULL;
+		#endif
+		}
+
+	///	destructor (completes a pending reduction)
+		~FusedVecProd() {if(m_bStarted) wait();}
+
+	///	removes all dot products
+		void clear()
+		{
+			UG_COND_THROW(m_bStarted, "FusedVecProd: Cannot clear during reduction.");
+			m_vLocal.clear();
+		}
+
+	///	adds the process-local part of (a,b) and returns its position
+		size_t add(vector_type& a, vector_type& b)
+		{
+			UG_COND_THROW(m_bStarted, "FusedVecProd: Cannot add during reduction.");
+		#ifdef UG_PARALLEL
+			UG_ASSERT((a.has_storage_type(PST_ADDITIVE) && b.has_storage_type(PST_CONSISTENT))
+				|| (a.has_storage_type(PST_CONSISTENT) && b.has_storage_type(PST_ADDITIVE))
+				|| (a.has_storage_type(PST_UNIQUE) && b.has_storage_type(PST_UNIQUE)),
+				"FusedVecProd: Storage types do not allow a dot product without communication.");
+		#endif
+			m_vLocal.push_back(static_cast<local_vector_type&>(a).dotprod(b));
+			return m_vLocal.size() - 1;
+		}
+
+	///	starts the global sum of all added dot products
+	/**
+	 * \param[in]	v		a vector of the iteration (provides the communicator)
+	 */
+		void start(const vector_type& v)
+		{
+			UG_COND_THROW(m_bStarted, "FusedVecProd: Reduction already started.");
+			m_vGlobal.resize(m_vLocal.size());
+			m_bStarted = true;
+			if(m_vLocal.empty()) return;
+
+		#ifdef UG_PARALLEL
+			const pcl::ProcessCommunicator& pc = v.layouts()->proc_comm();
+			if(!pc.empty()){
+				pc.iallreduce(&m_vLocal[0], &m_vGlobal[0], (int)m_vLocal.size(),
+				              PCL_DT_DOUBLE, PCL_RO_SUM, m_request);
+				return;
+			}
+		#endif
+			m_vGlobal = m_vLocal;
+		}
+
+	///	waits for the global sum to be completed
+		void wait()
+		{
+			UG_COND_THROW(!m_bStarted, "FusedVecProd: Reduction not started.");
+		#ifdef UG_PARALLEL
+			if(m_request != MPI_REQUEST_NULL)
+				pcl::MPI_Wait(&m_request);
+		#endif
+			m_bStarted = false;
+		}
+
+	///	returns the global value of the i'th dot product (after wait())
+		number operator[](size_t i) const
+		{
+			UG_ASSERT(!m_bStarted, "FusedVecProd: Reduction not completed.");
+			return m_vGlobal[i];
+		}
+
+	protected:
+	///	process-local parts
+		std::vector<double> m_vLocal;
+
+	///	global values
+		std::vector<double> m_vGlobal;
+
+	///	flag if reduction is in progress
+		bool m_bStarted;
+
+	#ifdef UG_PARALLEL
+	///	request of the non-blocking reduction
+		MPI_Request m_request;
+	#endif
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__ */
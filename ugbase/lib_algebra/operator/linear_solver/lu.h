@@ -42,6 +42,8 @@
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
 #include "../preconditioner/ilut_scalar.h"
+#include "supernodal_lu.h"
+#include "lib_algebra/algebra_common/sparsematrix_util.h"
 #include "../interface/preconditioned_linear_operator_inverse.h"
 #include "linear_solver.h"
 
@@ -75,7 +77,8 @@ class LU
 
 	public:
 	///	constructor
-		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true)
+		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true),
+			m_bSupernodal(true)
 		{
 #ifdef LAPACK_AVAILABLE
 			m_iMinimumForSparse = 4000;
@@ -102,12 +105,21 @@ class LU
 		{
 			m_bInfo = b;
 		}
+
+	///	if true, the supernodal sparse LU is used, otherwise ILUT with threshold 0
+		void set_supernodal(bool b)
+		{
+			m_bSupernodal = b;
+		}
 		
 		void set_show_progress(bool b)
 		{
 			m_bShowProgress = b;
 		}
 
+	///	returns the supernodal factorization
+		const SupernodalLU& supernodal() const {return m_supernodal;}
+
 		virtual const char* name() const {return "LU";}
 
 	private:
@@ -190,6 +202,18 @@ class LU
 				print_info(A);
 				UG_LOG("\n");
 			}
+
+			if(m_bSupernodal)
+			{
+			//	the symbolic factorization is reused if the pattern did not change
+				GetDoubleSparseFromBlockSparse(m_scalarMat, A);
+				m_supernodal.set_ordering(m_bSortSparse ? SupernodalLU::ORDERING_MINIMUM_DEGREE
+				                                        : SupernodalLU::ORDERING_NONE);
+				m_supernodal.set_info(m_bInfo);
+				m_supernodal.init(m_scalarMat);
+				return true;
+			}
+
 			ilut_scalar = make_sp(new ILUTScalarPreconditioner<algebra_type>(0.0));
 			ilut_scalar->set_sort(m_bSortSparse);
 			ilut_scalar->set_info(m_bInfo);
@@ -227,7 +251,25 @@ class LU
 		bool solve_sparse(vector_type &x, const vector_type &b)
 		{
 			PROFILE_FUNC();
-			ilut_scalar->solve(x, b);
+			if(!m_bSupernodal)
+			{
+				ilut_scalar->solve(x, b);
+				return true;
+			}
+
+			m_b.resize(m_size);
+			for(size_t i=0, k=0; i<b.size(); i++)
+			{
+				for(size_t j=0; j<GetSize(b[i]); j++)
+					m_b[k++] = BlockRef(b[i],j);
+			}
+			m_supernodal.solve(m_u, m_b);
+
+			for(size_t i=0, k=0; i<x.size(); i++)
+			{
+				for(size_t j=0; j<GetSize(x[i]); j++)
+					BlockRef(x[i],j) = m_u[k++];
+			}
 			return true;
 		}
 
@@ -386,6 +428,7 @@ class LU
 			ss << " Minimum Entries for Sparse LU: " << m_iMinimumForSparse;
 			if(m_iMinimumForSparse==0)
 				ss << " (= always Sparse LU)";
+			ss << "\n Sparse LU: " << (m_bSupernodal ? "Supernodal LU" : "ILUT(0)");
 			return ss.str();
 		}
 
@@ -409,8 +452,10 @@ class LU
 
 		bool m_bDense;
 		SmartPtr<ILUTScalarPreconditioner<algebra_type> > ilut_scalar;
+		SupernodalLU m_supernodal;
+		CPUAlgebra::matrix_type m_scalarMat;
 		size_t m_iMinimumForSparse;
-		bool m_bSortSparse, m_bInfo, m_bShowProgress;
+		bool m_bSortSparse, m_bInfo, m_bShowProgress, m_bSupernodal;
 };
 
 } // end namespace ug
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/interface/linear_solver_profiling.h"
+#include "fused_vec_prod.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+#include "common/util/string_util.h"
+
+namespace ug{
+
+///	the pipelined BiCGStab method as a solver for linear operators
+/**
+ * This class implements the (right-)preconditioned pipelined BiCGStab -
+ * method for the solution of linear operator problems like A*x = b.
+ *
+ * The standard BiCGStab method needs six blocking global reductions per
+ * iteration (four dot products and two defect norms). Here, the dot products
+ * are fused into two non-blocking reductions per iteration, each of them
+ * overlapped with an application of the preconditioner and the operator. The
+ * defect norm needed by the convergence check is computed from the fused dot
+ * products and needs no additional reduction.
+ *
+ * The vectors are updated by recurrences. Therefore the method needs more
+ * memory than the standard BiCGStab method and may attain a slightly lower
+ * final accuracy. The preconditioner must be linear.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Cools, Vanroose, "The communication-hiding pipelined BiCGStab method for
+ *   the parallel solution of large unsymmetric linear systems", Parallel
+ *   Computing 65 (2017), Alg. 3
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedBiCGStab
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipelinedBiCGStab() : base_type() {}
+
+		PipelinedBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond ) {}
+
+		PipelinedBiCGStab( SmartPtr<ILinearIterator<vector_type> > spPrecond,
+		                   SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type(spPrecond, spConvCheck) {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedBiCGStab";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			LS_PROFILE_BEGIN(LS_ApplyReturnDefect);
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Inadequate storage format of Vectors.");
+			#endif
+
+		// 	build defect:  r := b - A*x
+			linear_operator()->apply_sub(b, x);
+			vector_type& r = b;
+
+		// 	create vectors (the unique ones, i.e. operator images, ...
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spQ = r.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spY = r.clone_without_values(); vector_type& y = *spY;
+			SmartPtr<vector_type> spT = r.clone_without_values(); vector_type& t = *spT;
+			SmartPtr<vector_type> spV = r.clone_without_values(); vector_type& v = *spV;
+
+		//	... and the consistent ones, i.e. preconditioned vectors and shadow residual)
+			SmartPtr<vector_type> spR0 = x.clone_without_values(); vector_type& r0 = *spR0;
+			SmartPtr<vector_type> spRh = x.clone_without_values(); vector_type& rh = *spRh;
+			SmartPtr<vector_type> spWh = x.clone_without_values(); vector_type& wh = *spWh;
+			SmartPtr<vector_type> spPh = x.clone_without_values(); vector_type& ph = *spPh;
+			SmartPtr<vector_type> spSh = x.clone_without_values(); vector_type& sh = *spSh;
+			SmartPtr<vector_type> spZh = x.clone_without_values(); vector_type& zh = *spZh;
+			SmartPtr<vector_type> spQh = x.clone_without_values(); vector_type& qh = *spQh;
+			s.set(0.0); z.set(0.0); v.set(0.0); ph.set(0.0); sh.set(0.0); zh.set(0.0);
+
+		//	prepare convergence check
+			prepare_conv_check();
+
+		//	compute start defect norm (makes r unique)
+			convergence_check()->start(r);
+
+			write_debugXR(x, r, convergence_check()->step(), 'i');
+
+			if(convergence_check()->iteration_ended())
+				return convergence_check()->post();
+
+		//	shadow residual r0 := r (consistent)
+			r0 = r;
+			#ifdef UG_PARALLEL
+			if(!r0.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedBiCGStab: Cannot convert r0 to consistent vector.");
+			#endif
+
+		//	rh := M^-1 r, w := A*rh, wh := M^-1 w, t := A*wh
+			if(!apply_precond(rh, r, convergence_check()->step(), 'i')) return false;
+			apply_operator(w, rh);
+			if(!apply_precond(wh, w, convergence_check()->step(), 'i')) return false;
+			apply_operator(t, wh);
+
+		//	rho = (r0,r), alpha = rho / (r0,w)
+			FusedVecProd<vector_type> prods;
+			prods.add(r0, r); prods.add(r0, w);
+			prods.start(r); prods.wait();
+
+			number rho = prods[0], alpha = prods[1], beta = 0.0, omega = 1.0;
+			if(alpha == 0.0){
+				UG_LOG("PipelinedBiCGStab: Method breakdown: (r0,w) = "<<alpha<<
+				       " is an invalid value. Aborting iteration.\n");
+				return false;
+			}
+			alpha = rho / alpha;
+
+		// 	Iteration loop
+			while(true)
+			{
+			//	update search directions
+			//	ph := rh + beta*(ph - omega*sh), s := w + beta*(s - omega*z)
+			//	sh := wh + beta*(sh - omega*zh), z := t + beta*(z - omega*v)
+				VecScaleAdd(ph, 1.0, rh, beta, ph, -beta*omega, sh);
+				VecScaleAdd(s, 1.0, w, beta, s, -beta*omega, z);
+				VecScaleAdd(sh, 1.0, wh, beta, sh, -beta*omega, zh);
+				VecScaleAdd(z, 1.0, t, beta, z, -beta*omega, v);
+
+			//	q := r - alpha*s, qh := rh - alpha*sh, y := w - alpha*z
+				VecScaleAdd(q, 1.0, r, -alpha, s);
+				VecScaleAdd(qh, 1.0, rh, -alpha, sh);
+				VecScaleAdd(y, 1.0, w, -alpha, z);
+
+			//	start reduction of (q,y), (y,y), (q,q)
+				prods.clear();
+				const size_t iQY = prods.add(q, y);
+				const size_t iYY = prods.add(y, y);
+				const size_t iQQ = prods.add(q, q);
+				prods.start(r);
+
+			//	while reducing: zh := M^-1 z, v := A*zh
+				if(!apply_precond(zh, z, convergence_check()->step(), 'a'))
+				{
+					prods.wait(); return false;
+				}
+				apply_operator(v, zh);
+
+				prods.wait();
+				const number qy = prods[iQY], yy = prods[iYY], qq = prods[iQQ];
+
+			//	check yy
+				if(yy == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown (y,y) = "<<yy<<" is an "
+							"invalid value. Aborting iteration.\n");
+					return false;
+				}
+
+			// 	omega = (q,y)/(y,y)
+				omega = qy / yy;
+
+			// 	x := x + alpha*ph + omega*qh
+				VecScaleAdd(x, 1.0, x, alpha, ph, omega, qh);
+
+			//	r := q - omega*y, rh := qh - omega*(wh - alpha*zh),
+			//	w := y - omega*(t - alpha*v)
+				VecScaleAdd(r, 1.0, q, -omega, y);
+				VecScaleAdd(rh, 1.0, qh, -omega, wh, omega*alpha, zh);
+				VecScaleAdd(w, 1.0, y, -omega, t, omega*alpha, v);
+
+			// 	check convergence, using ||r||^2 = (q,q) - 2*omega*(q,y) + omega^2*(y,y)
+				convergence_check()->update_defect(
+						sqrt(std::max(qq - 2*omega*qy + omega*omega*yy, 0.0)));
+
+				write_debugXR(x, r, convergence_check()->step(), 'b');
+
+				if(convergence_check()->iteration_ended()) break;
+
+			//	check omega
+				if(omega == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with omega = "<<omega<<
+					       ". Aborting iteration.\n");
+					return false;
+				}
+
+			//	start reduction of (r0,r), (r0,w), (r0,s), (r0,z)
+				prods.clear();
+				const size_t iR = prods.add(r0, r);
+				const size_t iW = prods.add(r0, w);
+				const size_t iS = prods.add(r0, s);
+				const size_t iZ = prods.add(r0, z);
+				prods.start(r);
+
+			//	while reducing: wh := M^-1 w, t := A*wh
+				if(!apply_precond(wh, w, convergence_check()->step(), 'b'))
+				{
+					prods.wait(); return false;
+				}
+				apply_operator(t, wh);
+
+				prods.wait();
+
+			//	check that rho valid
+				if(rho == 0.0)
+				{
+					UG_LOG("PipelinedBiCGStab: Method breakdown with rho = "<<rho<<
+						   ". Aborting iteration.\n");
+					return false;
+				}
+
+			//	beta = (alpha/omega) * (r0,r_new)/(r0,r_old)
+				const number rhoNew = prods[iR];
+				beta = (alpha/omega) * (rhoNew/rho);
+				rho = rhoNew;
+
+			//	alpha = (r0,r) / ((r0,w) + beta*(r0,s) - beta*omega*(r0,z))
+				const number denom = prods[iW] + beta*prods[iS] - beta*omega*prods[iZ];
+				if(denom == 0.0){
+					UG_LOG("PipelinedBiCGStab: Method breakdown: (r0,A*p) = "<<denom<<
+					       " is an invalid value. Aborting iteration.\n");
+					return false;
+				}
+				alpha = rho / denom;
+			}
+
+		//	print ending output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	applies c := M^-1 * d and makes c consistent
+		bool apply_precond(vector_type& c, vector_type& d, int loopCnt, char phase)
+		{
+			if(preconditioner().valid())
+			{
+				enter_precond_debug_section(loopCnt, phase);
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("PipelinedBiCGStab: Cannot apply preconditioner. Aborting.\n");
+					this->leave_vector_debug_writer_section();
+					return false;
+				}
+				this->leave_vector_debug_writer_section();
+			}
+			else
+			{
+				c = d;
+
+			// 	make c consistent
+				#ifdef UG_PARALLEL
+				if(!c.change_storage_type(PST_CONSISTENT))
+					UG_THROW("PipelinedBiCGStab: Cannot convert c to consistent vector.");
+				#endif
+			}
+			return true;
+		}
+
+	///	applies c := A*d and makes c unique
+		void apply_operator(vector_type& c, vector_type& d)
+		{
+			linear_operator()->apply(c, d);
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipelinedBiCGStab: Cannot convert c to unique vector.");
+			#endif
+		}
+
+	///	prepares the output of the convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt, char phase)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			std::string ext = GetStringPrintf("-%c_iter%03d", phase, loopCnt);
+			write_debug(r, std::string("PipelinedBiCGStab_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipelinedBiCGStab_Solution") + ext + ".vec");
+		}
+
+	/// debugger section for the preconditioner
+		void enter_precond_debug_section(int loopCnt, char phase)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			std::string ext = GetStringPrintf("-%c_iter%03d", phase, loopCnt);
+			this->enter_vector_debug_writer_section(std::string("PipelinedBiCGStab_Precond") + ext);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_BICGSTAB__ */
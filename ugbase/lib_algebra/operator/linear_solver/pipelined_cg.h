@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "common/profiler/profiler.h"
+#include "fused_vec_prod.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the preconditioned pipelined CG - method for the
+ * solution of linear operator problems like A*x = b. Compared to the standard
+ * CG method, all dot products of an iteration (including the defect norm used
+ * by the convergence check) are computed by one single global reduction,
+ * that is started non-blocking and overlapped with the application of the
+ * preconditioner and the operator. This reduces the number of global
+ * synchronizations per iteration from three to one and hides its latency.
+ *
+ * The vectors are updated by recurrences. Therefore the method needs more
+ * memory (four additional vectors) and may attain a slightly lower final
+ * accuracy than the standard CG method. The preconditioner must be linear.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014),
+ *   Alg. 3
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipelinedCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipelinedCG() : base_type() {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipelinedCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipelinedCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipelinedCG_apply_return_defect, "PipelinedCG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		// 	create help vectors (u, m, p, q are consistent, w, n, s, z additive)
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			p.set(0.0); q.set(0.0); s.set(0.0); z.set(0.0);
+
+			write_debugXR(x, r, convergence_check()->step());
+
+		//	compute start defect
+			prepare_conv_check();
+			convergence_check()->start(r);
+			if(convergence_check()->iteration_ended())
+				return convergence_check()->post();
+
+		// 	u := M^-1 r, w := A*u
+			if(!apply_precond(u, r, convergence_check()->step())) return false;
+			linear_operator()->apply(w, u);
+
+			FusedVecProd<vector_type> prods;
+			number gammaOld = 1.0, alphaOld = 1.0;
+			bool bFirst = true;
+
+		// 	Iteration loop
+			while(true)
+			{
+			//	make r unique, such that ||r||^2 = (r,r) is a local dot product
+				#ifdef UG_PARALLEL
+				if(!r.change_storage_type(PST_UNIQUE))
+					UG_THROW("PipelinedCG::apply_return_defect: "
+									"Cannot convert r to unique vector.");
+				#endif
+
+			//	start reduction of gamma = (r,u), delta = (w,u) and (r,r)
+				prods.clear();
+				const size_t iGamma = prods.add(r, u);
+				const size_t iDelta = prods.add(w, u);
+				const size_t iNorm = prods.add(r, r);
+				prods.start(r);
+
+			//	while reducing: m := M^-1 w, n := A*m
+				if(!apply_precond(m, w, convergence_check()->step()))
+				{
+					prods.wait(); return false;
+				}
+				linear_operator()->apply(n, m);
+
+				prods.wait();
+
+			// 	Check convergence
+				if(!bFirst)
+				{
+					convergence_check()->update_defect(sqrt(std::max(prods[iNorm], 0.0)));
+					if(convergence_check()->iteration_ended()) break;
+				}
+
+			//	compute alpha and beta
+				const number gamma = prods[iGamma];
+				const number delta = prods[iDelta];
+				number beta = 0.0, denom = delta;
+				if(!bFirst)
+				{
+					beta = gamma / gammaOld;
+					denom = delta - beta * gamma / alphaOld;
+				}
+
+			//	check denominator
+				if(denom == 0.0)
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': (p,Ap)=" <<
+					       denom << " is not admitted. Aborting solver.\n");
+					return false;
+				}
+				const number alpha = gamma / denom;
+
+			// 	update directions: z := n + beta*z, q := m + beta*q,
+			//	s := w + beta*s, p := u + beta*p
+				VecScaleAdd(z, 1.0, n, beta, z);
+				VecScaleAdd(q, 1.0, m, beta, q);
+				VecScaleAdd(s, 1.0, w, beta, s);
+				VecScaleAdd(p, 1.0, u, beta, p);
+
+			// 	update x := x + alpha*p, r := r - alpha*s,
+			//	u := u - alpha*q, w := w - alpha*z
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+				write_debugXR(x, r, convergence_check()->step()+1);
+
+			// 	remember values
+				gammaOld = gamma; alphaOld = alpha;
+				bFirst = false;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	applies c := M^-1 * d and makes c consistent
+		bool apply_precond(vector_type& c, vector_type& d, int loopCnt)
+		{
+			if(preconditioner().valid())
+			{
+				enter_precond_debug_section(loopCnt);
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipelinedCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					this->leave_vector_debug_writer_section();
+					return false;
+				}
+				this->leave_vector_debug_writer_section();
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipelinedCG::apply_return_defect: "
+								"Cannot convert preconditioned vector to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+
+	/// debugger output: solution and residual
+		void write_debugXR(vector_type &x, vector_type &r, int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			write_debug(r, std::string("PipelinedCG_Residual") + ext + ".vec");
+			write_debug(x, std::string("PipelinedCG_Solution") + ext + ".vec");
+		}
+
+	/// debugger section for the preconditioner
+		void enter_precond_debug_section(int loopCnt)
+		{
+			if(!this->vector_debug_writer_valid()) return;
+			char ext[20]; snprintf(ext, 20, "_iter%03d", loopCnt);
+			this->enter_vector_debug_writer_section(std::string("PipelinedCG_Precond_") + ext);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPELINED_CG__ */
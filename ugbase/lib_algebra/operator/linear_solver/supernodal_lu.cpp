@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/minimum_degree_ordering.hpp>
+
+#include "supernodal_lu.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+SupernodalLU::SupernodalLU()
+	: m_n(0), m_orderingType(ORDERING_MINIMUM_DEGREE),
+	  m_bAnalyzed(false), m_bInfo(false), m_numAnalyze(0)
+{}
+
+void SupernodalLU::init(const matrix_type& A)
+{
+	if(!pattern_matches(A))
+		analyze(A);
+	factorize(A);
+}
+
+bool SupernodalLU::pattern_matches(const matrix_type& A) const
+{
+	if(!m_bAnalyzed) return false;
+	if(A.num_rows() != m_n || A.num_cols() != m_n) return false;
+
+	const int nnz = (int)m_vPatCol.size();
+	int k = 0;
+	for(size_t r = 0; r < m_n; ++r)
+	{
+		if(m_vPatRowStart[r] != k) return false;
+		for(matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it, ++k)
+			if(k >= nnz || m_vPatCol[k] != (int)it.index()) return false;
+	}
+	return k == nnz;
+}
+
+void SupernodalLU::compute_ordering(const std::vector<int>& vAdjStart,
+                                    const std::vector<int>& vAdj)
+{
+	const int n = (int)m_n;
+	m_vPerm.resize(n);
+	m_vIPerm.resize(n);
+
+	if(m_orderingType == ORDERING_NONE || vAdj.empty())
+	{
+		for(int i = 0; i < n; ++i) m_vPerm[i] = m_vIPerm[i] = i;
+		return;
+	}
+
+	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS> G_t;
+	G_t g(n);
+	for(int i = 0; i < n; ++i)
+		for(int k = vAdjStart[i]; k < vAdjStart[i+1]; ++k)
+			boost::add_edge(i, vAdj[k], g);
+
+	std::vector<int> vDegree(n, 0), vSupernodeSize(n, 1);
+	boost::property_map<G_t, boost::vertex_index_t>::type id = boost::get(boost::vertex_index, g);
+
+//	boost returns old -> new in 'inverse_perm' and new -> old in 'perm'
+	boost::minimum_degree_ordering(g,
+		boost::make_iterator_property_map(&vDegree[0], id, vDegree[0]),
+		&m_vIPerm[0], &m_vPerm[0],
+		boost::make_iterator_property_map(&vSupernodeSize[0], id, vSupernodeSize[0]),
+		0, id);
+}
+
+void SupernodalLU::analyze(const matrix_type& A)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(A.num_rows() != A.num_cols(), "SupernodalLU: Matrix must be square.");
+	m_bAnalyzed = false;
+	m_n = A.num_rows();
+	const int n = (int)m_n;
+
+//	remember the pattern
+	m_vPatRowStart.resize(n+1);
+	m_vPatCol.clear();
+	for(int r = 0; r < n; ++r)
+	{
+		m_vPatRowStart[r] = (int)m_vPatCol.size();
+		for(matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it)
+			m_vPatCol.push_back((int)it.index());
+	}
+	m_vPatRowStart[n] = (int)m_vPatCol.size();
+
+//	symmetric pattern of A+A^T without the diagonal
+	std::vector<int> vAdjStart(n+1, 0), vAdj;
+	{
+		std::vector<int> vCnt(n, 0);
+		for(int r = 0; r < n; ++r)
+			for(int k = m_vPatRowStart[r]; k < m_vPatRowStart[r+1]; ++k)
+				if(m_vPatCol[k] != r) {vCnt[r]++; vCnt[m_vPatCol[k]]++;}
+		for(int r = 0; r < n; ++r) vAdjStart[r+1] = vAdjStart[r] + vCnt[r];
+		vAdj.resize(vAdjStart[n]);
+		std::vector<int> vPos(vAdjStart.begin(), vAdjStart.end()-1);
+		for(int r = 0; r < n; ++r)
+			for(int k = m_vPatRowStart[r]; k < m_vPatRowStart[r+1]; ++k)
+			{
+				const int c = m_vPatCol[k];
+				if(c == r) continue;
+				vAdj[vPos[r]++] = c;
+				vAdj[vPos[c]++] = r;
+			}
+
+	//	sort and remove duplicates
+		int cnt = 0;
+		for(int r = 0; r < n; ++r)
+		{
+			std::vector<int>::iterator b = vAdj.begin() + vAdjStart[r];
+			std::vector<int>::iterator e = vAdj.begin() + vAdjStart[r+1];
+			std::sort(b, e);
+			e = std::unique(b, e);
+			vAdjStart[r] = cnt;
+			for(std::vector<int>::iterator it = b; it != e; ++it) vAdj[cnt++] = *it;
+		}
+		vAdjStart[n] = cnt;
+		vAdj.resize(cnt);
+	}
+
+//	fill-reducing ordering
+	compute_ordering(vAdjStart, vAdj);
+
+//	elimination tree of the permuted pattern (using path compression)
+	std::vector<int> vParent(n, -1);
+	{
+		std::vector<int> vAncestor(n, -1);
+		for(int k = 0; k < n; ++k)
+		{
+			const int kOld = m_vPerm[k];
+			for(int a = vAdjStart[kOld]; a < vAdjStart[kOld+1]; ++a)
+			{
+				int i = m_vIPerm[vAdj[a]];
+				if(i >= k) continue;
+				while(vAncestor[i] != -1 && vAncestor[i] != k)
+				{
+					const int next = vAncestor[i];
+					vAncestor[i] = k;
+					i = next;
+				}
+				if(vAncestor[i] == -1) {vAncestor[i] = k; vParent[i] = k;}
+			}
+		}
+	}
+
+//	post-order the elimination tree, such that supernodes are contiguous
+	{
+		std::vector<int> vHead(n, -1), vNext(n, -1), vStack, vPost(n);
+		for(int j = n-1; j >= 0; --j)
+			if(vParent[j] != -1) {vNext[j] = vHead[vParent[j]]; vHead[vParent[j]] = j;}
+
+		int cnt = 0;
+		for(int root = 0; root < n; ++root)
+		{
+			if(vParent[root] != -1) continue;
+			vStack.push_back(root);
+			while(!vStack.empty())
+			{
+				const int p = vStack.back();
+				const int child = vHead[p];
+				if(child == -1) {vStack.pop_back(); vPost[p] = cnt++;}
+				else {vHead[p] = vNext[child]; vStack.push_back(child);}
+			}
+		}
+
+		std::vector<int> vPerm(n), vParentNew(n);
+		for(int k = 0; k < n; ++k)
+		{
+			vPerm[vPost[k]] = m_vPerm[k];
+			vParentNew[vPost[k]] = (vParent[k] == -1) ? -1 : vPost[vParent[k]];
+		}
+		m_vPerm.swap(vPerm);
+		vParent.swap(vParentNew);
+		for(int k = 0; k < n; ++k) m_vIPerm[m_vPerm[k]] = k;
+	}
+
+//	column structure of L and fundamental supernodes
+	m_vSnodeStart.clear(); m_vColSnode.resize(n);
+	m_vRowStart.assign(1, 0); m_vRowIndex.clear();
+	{
+		std::vector<int> vChildHead(n, -1), vChildNext(n, -1), vNumChild(n, 0);
+		for(int j = n-1; j >= 0; --j)
+			if(vParent[j] != -1)
+			{
+				vChildNext[j] = vChildHead[vParent[j]];
+				vChildHead[vParent[j]] = j;
+				vNumChild[vParent[j]]++;
+			}
+
+		std::vector<std::vector<int> > vvStruct(n);
+		std::vector<int> vMark(n, -1), vLastStruct;
+		size_t lastSize = 0;
+		for(int j = 0; j < n; ++j)
+		{
+			std::vector<int>& vStruct = vvStruct[j];
+			vMark[j] = j;
+
+		//	entries of A below the diagonal
+			const int jOld = m_vPerm[j];
+			for(int a = vAdjStart[jOld]; a < vAdjStart[jOld+1]; ++a)
+			{
+				const int i = m_vIPerm[vAdj[a]];
+				if(i > j && vMark[i] != j) {vMark[i] = j; vStruct.push_back(i);}
+			}
+
+		//	merge the structure of the children
+			for(int c = vChildHead[j]; c != -1; c = vChildNext[c])
+			{
+				const std::vector<int>& vChild = vvStruct[c];
+				for(size_t k = 0; k < vChild.size(); ++k)
+				{
+					const int i = vChild[k];
+					if(i > j && vMark[i] != j) {vMark[i] = j; vStruct.push_back(i);}
+				}
+				if(c != j-1) std::vector<int>().swap(vvStruct[c]);
+			}
+			std::sort(vStruct.begin(), vStruct.end());
+
+		//	column j continues the supernode of column j-1, if the structure
+		//	of j-1 is the structure of j plus j itself
+			if(j > 0 && vParent[j-1] == j && vNumChild[j] == 1
+				&& lastSize == vStruct.size() + 1)
+			{
+				m_vColSnode[j] = m_vColSnode[j-1];
+			}
+			else
+			{
+				if(j > 0)
+				{
+					m_vRowIndex.insert(m_vRowIndex.end(), vLastStruct.begin(), vLastStruct.end());
+					m_vRowStart.push_back((int)m_vRowIndex.size());
+				}
+				m_vColSnode[j] = (int)m_vSnodeStart.size();
+				m_vSnodeStart.push_back(j);
+			}
+
+			if(j > 0 && vParent[j-1] == j) std::vector<int>().swap(vvStruct[j-1]);
+			vLastStruct = vStruct;
+			lastSize = vStruct.size();
+		}
+
+	//	close the last supernode
+		if(n > 0)
+		{
+			m_vRowIndex.insert(m_vRowIndex.end(), vLastStruct.begin(), vLastStruct.end());
+			m_vRowStart.push_back((int)m_vRowIndex.size());
+		}
+		m_vSnodeStart.push_back(n);
+	}
+
+//	offsets of the panels
+	const int numSnode = (int)num_supernodes();
+	m_vLOffset.resize(numSnode+1);
+	m_vUOffset.resize(numSnode+1);
+	m_vLOffset[0] = m_vUOffset[0] = 0;
+	for(int J = 0; J < numSnode; ++J)
+	{
+		const size_t ncol = snode_size(J), nb = snode_num_below(J);
+		m_vLOffset[J+1] = m_vLOffset[J] + (ncol + nb) * ncol;
+		m_vUOffset[J+1] = m_vUOffset[J] + ncol * nb;
+	}
+
+//	position of the entries of A in the factor
+	m_vEntryPos.resize(m_vPatCol.size());
+	for(int r = 0; r < n; ++r)
+		for(int k = m_vPatRowStart[r]; k < m_vPatRowStart[r+1]; ++k)
+		{
+			const int i = m_vIPerm[r], j = m_vIPerm[m_vPatCol[k]];
+
+			if(i >= j)
+			{
+			//	lower part: column j
+				const int J = m_vColSnode[j], f = m_vSnodeStart[J];
+				const int ncol = snode_size(J), m = ncol + snode_num_below(J);
+				int row = i - f;
+				if(i >= m_vSnodeStart[J+1])
+				{
+					const int* b = &m_vRowIndex[0] + m_vRowStart[J];
+					const int* e = &m_vRowIndex[0] + m_vRowStart[J+1];
+					row = ncol + (int)(std::lower_bound(b, e, i) - b);
+				}
+				m_vEntryPos[k] = (long)(m_vLOffset[J] + (size_t)(j - f) * m + row);
+			}
+			else
+			{
+			//	upper part: row i
+				const int I = m_vColSnode[i], f = m_vSnodeStart[I];
+				const int ncol = snode_size(I), m = ncol + snode_num_below(I);
+				if(j < m_vSnodeStart[I+1])
+					m_vEntryPos[k] = (long)(m_vLOffset[I] + (size_t)(j - f) * m + (i - f));
+				else
+				{
+					const int* b = &m_vRowIndex[0] + m_vRowStart[I];
+					const int* e = &m_vRowIndex[0] + m_vRowStart[I+1];
+					const size_t col = std::lower_bound(b, e, j) - b;
+					m_vEntryPos[k] = -(long)(m_vUOffset[I] + col * ncol + (i - f)) - 1;
+				}
+			}
+		}
+
+	m_vLValue.resize(m_vLOffset[numSnode]);
+	m_vUValue.resize(m_vUOffset[numSnode]);
+	m_vPivot.resize(n);
+	m_bAnalyzed = true;
+	++m_numAnalyze;
+
+	if(m_bInfo)
+	{
+		UG_LOG("  SupernodalLU: " << n << " unknowns, " << m_vPatCol.size()
+		       << " entries in A, " << num_factor_entries() << " entries in factor, "
+		       << numSnode << " supernodes.\n");
+	}
+}
+
+void SupernodalLU::factorize(const matrix_type& A)
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(!m_bAnalyzed, "SupernodalLU: analyze must be called before factorize.");
+	UG_COND_THROW(A.num_rows() != m_n, "SupernodalLU: Matrix size changed since analyze.");
+
+//	scatter values of A into the factor
+	std::fill(m_vLValue.begin(), m_vLValue.end(), 0.0);
+	std::fill(m_vUValue.begin(), m_vUValue.end(), 0.0);
+	int k = 0;
+	for(size_t r = 0; r < m_n; ++r)
+		for(matrix_type::const_row_iterator it = A.begin_row(r); it != A.end_row(r); ++it, ++k)
+		{
+			const long pos = m_vEntryPos[k];
+			if(pos >= 0) m_vLValue[pos] += it.value();
+			else m_vUValue[-(pos+1)] += it.value();
+		}
+
+	std::vector<double> vS;
+	std::vector<int> vRelPos(m_n, -1);
+
+	const int numSnode = (int)num_supernodes();
+	for(int J = 0; J < numSnode; ++J)
+	{
+		const int f = m_vSnodeStart[J], ncol = snode_size(J);
+		const int nb = snode_num_below(J), m = ncol + nb;
+		double* L = &m_vLValue[0] + m_vLOffset[J];
+		double* U = nb > 0 ? &m_vUValue[0] + m_vUOffset[J] : NULL;
+		const int* R = nb > 0 ? &m_vRowIndex[0] + m_vRowStart[J] : NULL;
+
+	//	LU of the panel with pivoting within the diagonal block
+		for(int c = 0; c < ncol; ++c)
+		{
+			double* Lc = L + c*m;
+			int p = c;
+			for(int r = c+1; r < ncol; ++r)
+				if(std::fabs(Lc[r]) > std::fabs(Lc[p])) p = r;
+
+			if(Lc[p] == 0.0)
+				UG_THROW("SupernodalLU: Matrix is singular (zero pivot in row "
+				         << m_vPerm[f+c] << ").");
+
+			m_vPivot[f+c] = p;
+			if(p != c)
+			{
+				for(int c2 = 0; c2 < ncol; ++c2) std::swap(L[c2*m + c], L[c2*m + p]);
+				for(int b = 0; b < nb; ++b) std::swap(U[b*ncol + c], U[b*ncol + p]);
+			}
+
+			const double invPivot = 1.0 / Lc[c];
+			for(int r = c+1; r < m; ++r) Lc[r] *= invPivot;
+
+			for(int c2 = c+1; c2 < ncol; ++c2)
+			{
+				double* Lc2 = L + c2*m;
+				const double s = Lc2[c];
+				if(s == 0.0) continue;
+				for(int r = c+1; r < m; ++r) Lc2[r] -= Lc[r] * s;
+			}
+		}
+
+		if(nb == 0) continue;
+
+	//	U12 := L11^{-1} U12
+		for(int b = 0; b < nb; ++b)
+		{
+			double* Ub = U + b*ncol;
+			for(int c = 0; c < ncol; ++c)
+			{
+				const double s = Ub[c];
+				if(s == 0.0) continue;
+				const double* Lc = L + c*m;
+				for(int r = c+1; r < ncol; ++r) Ub[r] -= Lc[r] * s;
+			}
+		}
+
+	//	Schur complement update S := L21 * U12 (column-major, nb x nb)
+		vS.assign((size_t)nb * nb, 0.0);
+		for(int b = 0; b < nb; ++b)
+		{
+			double* Sb = &vS[(size_t)b*nb];
+			const double* Ub = U + b*ncol;
+			for(int c = 0; c < ncol; ++c)
+			{
+				const double s = Ub[c];
+				if(s == 0.0) continue;
+				const double* L21c = L + c*m + ncol;
+				for(int a = 0; a < nb; ++a) Sb[a] += L21c[a] * s;
+			}
+		}
+
+	//	subtract S from the target supernodes, grouped by consecutive rows
+	//	of the structure that belong to the same supernode
+		for(int g0 = 0; g0 < nb; )
+		{
+			const int K = m_vColSnode[R[g0]];
+			const int fK = m_vSnodeStart[K], lK = m_vSnodeStart[K+1];
+			const int ncolK = snode_size(K), nbK = snode_num_below(K), mK = ncolK + nbK;
+			double* LK = &m_vLValue[0] + m_vLOffset[K];
+			double* UK = nbK > 0 ? &m_vUValue[0] + m_vUOffset[K] : NULL;
+			const int* RK = nbK > 0 ? &m_vRowIndex[0] + m_vRowStart[K] : NULL;
+			for(int t = 0; t < nbK; ++t) vRelPos[RK[t]] = t;
+
+			int g1 = g0;
+			while(g1 < nb && R[g1] < lK) ++g1;
+
+		//	lower part: columns of the group, rows below
+			for(int b = g0; b < g1; ++b)
+			{
+				double* LKc = LK + (size_t)(R[b] - fK) * mK;
+				const double* Sb = &vS[(size_t)b*nb];
+				for(int a = b; a < nb; ++a)
+				{
+					const int i = R[a];
+					const int row = (i < lK) ? i - fK : ncolK + vRelPos[i];
+					LKc[row] -= Sb[a];
+				}
+			}
+
+		//	upper part: rows of the group, columns to the right
+			for(int a = g0; a < g1; ++a)
+			{
+				const int row = R[a] - fK;
+				for(int b = a+1; b < nb; ++b)
+				{
+					const int j = R[b];
+					const double s = vS[(size_t)b*nb + a];
+					if(j < lK) LK[(size_t)(j - fK) * mK + row] -= s;
+					else UK[(size_t)vRelPos[j] * ncolK + row] -= s;
+				}
+			}
+
+			g0 = g1;
+		}
+	}
+}
+
+void SupernodalLU::solve(vector_type& x, const vector_type& b) const
+{
+	PROFILE_FUNC_GROUP("algebra lu");
+	UG_COND_THROW(!m_bAnalyzed, "SupernodalLU: Factorization missing.");
+	UG_COND_THROW(b.size() != m_n, "SupernodalLU: Vector size does not match.");
+
+	const int n = (int)m_n;
+	m_vWork.resize(n);
+	double* w = n > 0 ? &m_vWork[0] : NULL;
+	for(int j = 0; j < n; ++j) w[j] = b[m_vPerm[j]];
+
+	const int numSnode = (int)num_supernodes();
+
+//	forward substitution
+	for(int J = 0; J < numSnode; ++J)
+	{
+		const int f = m_vSnodeStart[J], ncol = snode_size(J);
+		const int nb = snode_num_below(J), m = ncol + nb;
+		const double* L = &m_vLValue[0] + m_vLOffset[J];
+		const int* R = nb > 0 ? &m_vRowIndex[0] + m_vRowStart[J] : NULL;
+		double* wJ = w + f;
+
+		for(int c = 0; c < ncol; ++c)
+			if(m_vPivot[f+c] != c) std::swap(wJ[c], wJ[m_vPivot[f+c]]);
+
+		for(int c = 0; c < ncol; ++c)
+		{
+			const double s = wJ[c];
+			if(s == 0.0) continue;
+			const double* Lc = L + c*m;
+			for(int r = c+1; r < ncol; ++r) wJ[r] -= Lc[r] * s;
+			for(int a = 0; a < nb; ++a) w[R[a]] -= Lc[ncol + a] * s;
+		}
+	}
+
+//	backward substitution
+	for(int J = numSnode-1; J >= 0; --J)
+	{
+		const int f = m_vSnodeStart[J], ncol = snode_size(J);
+		const int nb = snode_num_below(J), m = ncol + nb;
+		const double* L = &m_vLValue[0] + m_vLOffset[J];
+		const double* U = nb > 0 ? &m_vUValue[0] + m_vUOffset[J] : NULL;
+		const int* R = nb > 0 ? &m_vRowIndex[0] + m_vRowStart[J] : NULL;
+		double* wJ = w + f;
+
+		for(int b = 0; b < nb; ++b)
+		{
+			const double s = w[R[b]];
+			if(s == 0.0) continue;
+			const double* Ub = U + b*ncol;
+			for(int r = 0; r < ncol; ++r) wJ[r] -= Ub[r] * s;
+		}
+
+		for(int c = ncol-1; c >= 0; --c)
+		{
+			const double* Lc = L + c*m;
+			wJ[c] /= Lc[c];
+			const double s = wJ[c];
+			for(int r = 0; r < c; ++r) wJ[r] -= Lc[r] * s;
+		}
+	}
+
+	x.resize(n);
+	for(int j = 0; j < n; ++j) x[m_vPerm[j]] = w[j];
+}
+
+} // end namespace ug
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU__
+
+#include <vector>
+
+#include "common/common.h"
+#include "lib_algebra/cpu_algebra_types.h"
+
+namespace ug{
+
+///	sparse direct LU solver based on supernodes
+/**
+ * This class computes a sparse LU decomposition P*A*P^T = L*U of a scalar
+ * matrix. The factorization is split into two phases:
+ *
+ * - analyze(): A fill-reducing ordering (minimum degree on the pattern of
+ *   A+A^T) is computed and post-ordered along the elimination tree. Columns
+ *   with identical structure in L are grouped into (fundamental) supernodes
+ *   and the row structure of every supernode is computed. Also a map from the
+ *   entries of A to their position in the factor is set up.
+ * - factorize(): The values of A are scattered into the factor and the
+ *   supernodes are factorized right-looking: every supernode is stored as a
+ *   dense panel and the updates of the Schur complement are computed by dense
+ *   block kernels.
+ *
+ * The symbolic part only depends on the sparsity pattern of A and is cached,
+ * i.e. init() only recomputes the numeric factorization, if the pattern of
+ * the matrix has not changed.
+ *
+ * The factorization uses the symmetric pattern of A+A^T. Pivoting is only
+ * performed within the diagonal block of a supernode, so the matrix should
+ * be (close to) diagonally dominant or symmetric positive definite, as it is
+ * the case for coarse grid matrices.
+ */
+class SupernodalLU
+{
+	public:
+	///	Matrix type
+		typedef CPUAlgebra::matrix_type matrix_type;
+
+	///	Vector type
+		typedef CPUAlgebra::vector_type vector_type;
+
+	///	Ordering used for the symbolic factorization
+		enum OrderingType
+		{
+			ORDERING_NONE = 0,
+			ORDERING_MINIMUM_DEGREE = 1
+		};
+
+	public:
+	///	constructor
+		SupernodalLU();
+
+	///	sets the fill-reducing ordering (the symbolic factorization is only discarded if it changes)
+		void set_ordering(OrderingType type)
+		{
+			if(type != m_orderingType) m_bAnalyzed = false;
+			m_orderingType = type;
+		}
+
+	///	enables output of factorization statistics
+		void set_info(bool b) {m_bInfo = b;}
+
+	///	computes the symbolic (if pattern changed) and the numeric factorization
+		void init(const matrix_type& A);
+
+	///	computes the symbolic factorization
+		void analyze(const matrix_type& A);
+
+	///	computes the numeric factorization (analyze must have been called)
+		void factorize(const matrix_type& A);
+
+	///	returns if the cached symbolic factorization can be used for A
+		bool pattern_matches(const matrix_type& A) const;
+
+	///	solves A*x = b
+		void solve(vector_type& x, const vector_type& b) const;
+
+	///	returns the number of unknowns
+		size_t num_rows() const {return m_n;}
+
+	///	returns the number of supernodes
+		size_t num_supernodes() const {return m_vSnodeStart.empty() ? 0 : m_vSnodeStart.size() - 1;}
+
+	///	returns the number of stored entries of L and U
+		size_t num_factor_entries() const {return m_vLValue.size() + m_vUValue.size();}
+
+	///	returns how often the symbolic factorization has been computed
+		size_t num_analyze() const {return m_numAnalyze;}
+
+	protected:
+	///	computes the fill-reducing ordering from the symmetric pattern
+		void compute_ordering(const std::vector<int>& vAdjStart, const std::vector<int>& vAdj);
+
+	///	number of columns in supernode
+		int snode_size(int J) const {return m_vSnodeStart[J+1] - m_vSnodeStart[J];}
+
+	///	number of rows below the diagonal block of supernode
+		int snode_num_below(int J) const {return m_vRowStart[J+1] - m_vRowStart[J];}
+
+	protected:
+	///	size of matrix
+		size_t m_n;
+
+	///	ordering type
+		OrderingType m_orderingType;
+
+	///	flags
+		bool m_bAnalyzed, m_bInfo;
+
+	///	number of symbolic factorizations
+		size_t m_numAnalyze;
+
+	///	sparsity pattern of the analyzed matrix
+		std::vector<int> m_vPatRowStart, m_vPatCol;
+
+	///	permutation (new -> old) and inverse permutation (old -> new)
+		std::vector<int> m_vPerm, m_vIPerm;
+
+	///	first column of supernodes (size: numSnode+1) and supernode of column
+		std::vector<int> m_vSnodeStart, m_vColSnode;
+
+	///	row structure below the diagonal block of the supernodes
+		std::vector<int> m_vRowStart, m_vRowIndex;
+
+	///	offsets of the supernodal panels in L and U
+		std::vector<size_t> m_vLOffset, m_vUOffset;
+
+	///	position of the entries of A in the factor (>= 0: L, < 0: -(pos+1) in U)
+		std::vector<long> m_vEntryPos;
+
+	///	values of the factor (L-panels with diagonal blocks, U-panels)
+		std::vector<double> m_vLValue, m_vUValue;
+
+	///	local pivots within the diagonal blocks
+		std::vector<int> m_vPivot;
+
+	///	work vector for solve
+		mutable std::vector<double> m_vWork;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__SUPERNODAL_LU__ */
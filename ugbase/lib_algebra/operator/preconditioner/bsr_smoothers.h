@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__BSR_SMOOTHERS__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__BSR_SMOOTHERS__
+
+#include <vector>
+
+#include "lib_algebra/cpu_algebra/bsr_matrix.h"
+#include "lib_algebra/operator/preconditioner/jacobi.h"
+#include "lib_algebra/operator/preconditioner/gauss_seidel.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+/// Jacobi preconditioner using cached inverted diagonal blocks and the BSR block kernels
+/**
+ * Computes the same correction as Jacobi (with block smoothing), but stores the
+ * damped inverses of the diagonal blocks as dense column-major blocks and
+ * applies them by the (vectorized) BSRBlockKernel instead of solving with the
+ * LU decomposition of every block.
+ *
+ * Only usable for the CPU algebras with fixed block size.
+ *
+ * \tparam	TAlgebra	Algebra type
+ */
+template <typename TAlgebra>
+class BSRJacobi : public Jacobi<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Base type
+		typedef Jacobi<TAlgebra> base_type;
+
+	///	block size
+		enum {N = block_traits<typename matrix_type::value_type>::static_num_rows};
+
+	///	BSR matrix type (providing the block kernels)
+		typedef BSRMatrix<N> bsr_matrix_type;
+
+	protected:
+		using base_type::damping;
+		using base_type::m_bBlock;
+
+	public:
+	///	default constructor
+		BSRJacobi() : base_type() {}
+
+	///	constructor setting the damping parameter
+		BSRJacobi(number damp) : base_type(damp) {}
+
+	/// clone constructor
+		BSRJacobi(const BSRJacobi<TAlgebra> &parent) : base_type(parent) {}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new BSRJacobi<algebra_type>(*this));
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "BSR Jacobi";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(BSRJacobi_preprocess, "algebra Jacobi");
+
+			matrix_type &mat = *pOp;
+			const size_t size = mat.num_rows();
+			if(size != mat.num_cols())
+			{
+				UG_LOG("Square Matrix needed for Jacobi Iteration.\n");
+				return false;
+			}
+
+#ifdef UG_PARALLEL
+		//	consistent diagonal
+			ParallelVector<Vector< typename matrix_type::value_type > > diag;
+			diag.resize(size);
+			diag.set_layouts(mat.layouts());
+			for(size_t i = 0; i < diag.size(); ++i)
+				diag[i] = mat(i, i);
+			diag.set_storage_type(PST_ADDITIVE);
+			diag.change_storage_type(PST_CONSISTENT);
+#endif
+
+		//	get damping in constant case to damp at once
+			number damp = 1.0;
+			if(damping()->constant_damping())
+				damp = damping()->damping();
+
+		// 	invert diagonal blocks and multiply by damping
+			m_vDiagInv.resize(size * N*N);
+			for(size_t i = 0; i < size; ++i)
+			{
+#ifdef UG_PARALLEL
+				const typename matrix_type::value_type &d = diag[i];
+#else
+				const typename matrix_type::value_type &d = mat(i,i);
+#endif
+				double* inv = &m_vDiagInv[i*N*N];
+				for(int c = 0; c < N; ++c)
+					for(int r = 0; r < N; ++r)
+						inv[c*N + r] = (m_bBlock || r == c) ? BlockRef(d, r, c) : 0.0;
+
+				if(!bsr_matrix_type::invert_block(inv))
+					UG_THROW(name() << ": Diagonal block of row " << i << " is singular.");
+
+				for(int k = 0; k < N*N; ++k)
+					inv[k] *= damp;
+			}
+
+			return true;
+		}
+
+	///	c = damp * D^{-1} d for the given rows
+		template <typename TIterator>
+		void apply_diag_inv(vector_type& c, const vector_type& d, TIterator it, TIterator end)
+		{
+			double* pc = bsr_matrix_type::data(c);
+			const double* pd = bsr_matrix_type::data(d);
+			for(; it != end; ++it)
+				bsr_matrix_type::block_mult(pc + *it*N, 1.0, &m_vDiagInv[*it*N*N], pd + *it*N);
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(BSRJacobi_step, "algebra Jacobi");
+			THROW_IF_NOT_EQUAL_3(c.size(), d.size(), m_vDiagInv.size() / (N*N));
+
+#ifdef UG_PARALLEL
+		//	the values at the interface indices are computed first, such that
+		//	the exchange making the correction consistent can run while the
+		//	remaining values are computed
+			if(!c.layouts()->overlap_enabled())
+			{
+				const VectorExchangePlan& plan = c.layouts()->exchange_plan();
+				const std::vector<size_t>& vInterface = plan.interface_indices();
+				apply_diag_inv(c, d, vInterface.begin(), vInterface.end());
+
+				c.set_storage_type(PST_ADDITIVE);
+				if(!c.begin_change_storage_type(PST_CONSISTENT))
+				{
+					UG_LOG("ERROR in '" << name() << "::apply': "
+							"Cannot change parallel status of correction to consistent.\n");
+					return false;
+				}
+
+				double* pc = bsr_matrix_type::data(c);
+				const double* pd = bsr_matrix_type::data(d);
+				const size_t n = c.size();
+				UG_OMP_PARALLEL_FOR(n)
+				for(size_t i = 0; i < n; ++i)
+					if(!plan.is_interface(i))
+						bsr_matrix_type::block_mult(pc + i*N, 1.0, &m_vDiagInv[i*N*N], pd + i*N);
+
+				c.end_change_storage_type();
+				return true;
+			}
+#endif
+
+		// 	c = damp * D^{-1} * d (the damping is included in the inverse diagonal)
+			double* pc = bsr_matrix_type::data(c);
+			const double* pd = bsr_matrix_type::data(d);
+			const size_t n = c.size();
+			UG_OMP_PARALLEL_FOR(n)
+			for(size_t i = 0; i < n; ++i)
+				bsr_matrix_type::block_mult(pc + i*N, 1.0, &m_vDiagInv[i*N*N], pd + i*N);
+
+#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+			if(!c.change_storage_type(PST_CONSISTENT))
+			{
+				UG_LOG("ERROR in '" << name() << "::apply': "
+						"Cannot change parallel status of correction to consistent.\n");
+				return false;
+			}
+#endif
+			return true;
+		}
+
+	protected:
+	///	damped inverses of the diagonal blocks (N*N per row, column-major)
+		std::vector<double> m_vDiagInv;
+};
+
+/// base class of the gauss-seidel preconditioners using a BSR copy of the matrix
+/**
+ * The matrix prepared by GaussSeidelBase (i.e. the original matrix or, in
+ * parallel, the modified copy) is copied into a BSRMatrix, whose diagonal
+ * blocks are inverted once. The sequential sweeps are then computed by the
+ * BSR block kernels. For the multicolor and hybrid sweep types and if the
+ * exchange of the correction is overlapped with the sweep, the steps of
+ * GaussSeidelBase are used.
+ *
+ * Only usable for the CPU algebras with fixed block size.
+ *
+ * \tparam	TAlgebra	Algebra type
+ */
+template <typename TAlgebra>
+class BSRGaussSeidelBase : public GaussSeidelBase<TAlgebra>
+{
+	public:
+		typedef TAlgebra algebra_type;
+		typedef typename TAlgebra::vector_type vector_type;
+		typedef typename TAlgebra::matrix_type matrix_type;
+		typedef GaussSeidelBase<TAlgebra> base_type;
+
+	///	block size
+		enum {N = block_traits<typename matrix_type::value_type>::static_num_rows};
+
+	///	BSR matrix type
+		typedef BSRMatrix<N> bsr_matrix_type;
+
+	public:
+	/// constructor
+		BSRGaussSeidelBase() : base_type() {}
+
+	/// clone constructor
+		BSRGaussSeidelBase(const BSRGaussSeidelBase<TAlgebra> &parent) : base_type(parent) {}
+
+	protected:
+	//	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			if(!base_type::preprocess(pOp)) return false;
+
+			PROFILE_BEGIN_GROUP(BSRGaussSeidel_preprocess, "algebra gaussseidel");
+			const matrix_type* pA = &(*pOp);
+#ifdef UG_PARALLEL
+			if(pcl::NumProcs() > 1) pA = &this->m_A;
+#endif
+			m_bsr.init(*pA);
+			m_bsr.invert_diagonal();
+			return true;
+		}
+
+	///	returns if the step can be computed on the BSR matrix
+		bool bsr_step_possible(const matrix_type& A, const vector_type& c) const
+		{
+			return this->m_sweepType == base_type::GS_SEQUENTIAL
+					&& !(this->m_bCommCompOverlap && &c == this->m_pExchangeVec)
+					&& A.num_rows() == m_bsr.num_rows();
+		}
+
+	protected:
+	///	BSR copy of the matrix
+		bsr_matrix_type m_bsr;
+};
+
+/// forward Gauss-Seidel preconditioner using the BSR block kernels (see GaussSeidel)
+template <typename TAlgebra>
+class BSRGaussSeidel : public BSRGaussSeidelBase<TAlgebra>
+{
+	typedef TAlgebra algebra_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef BSRGaussSeidelBase<TAlgebra> base_type;
+
+	public:
+	//	Name of preconditioner
+		virtual const char* name() const {return "BSR Gauss-Seidel";}
+
+	/// constructor
+		BSRGaussSeidel() : base_type() {}
+
+	/// clone constructor
+		BSRGaussSeidel(const BSRGaussSeidel<TAlgebra> &parent) : base_type(parent) {}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new BSRGaussSeidel<algebra_type>(*this));
+		}
+
+	//	Stepping routine
+		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::bsr_step_possible(A, c)) base_type::m_bsr.gs_forward(c, d, relax);
+			else base_type::forward_step(A, c, d, relax);
+		}
+};
+
+/// backward Gauss-Seidel preconditioner using the BSR block kernels (see BackwardGaussSeidel)
+template <typename TAlgebra>
+class BSRBackwardGaussSeidel : public BSRGaussSeidelBase<TAlgebra>
+{
+	typedef TAlgebra algebra_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef BSRGaussSeidelBase<TAlgebra> base_type;
+
+	public:
+	//	Name of preconditioner
+		virtual const char* name() const {return "BSR Backward Gauss-Seidel";}
+
+	/// constructor
+		BSRBackwardGaussSeidel() : base_type() {}
+
+	/// clone constructor
+		BSRBackwardGaussSeidel(const BSRBackwardGaussSeidel<TAlgebra> &parent) : base_type(parent) {}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new BSRBackwardGaussSeidel<algebra_type>(*this));
+		}
+
+	//	Stepping routine
+		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::bsr_step_possible(A, c)) base_type::m_bsr.gs_backward(c, d, relax);
+			else base_type::backward_step(A, c, d, relax);
+		}
+};
+
+/// symmetric Gauss-Seidel preconditioner using the BSR block kernels (see SymmetricGaussSeidel)
+template <typename TAlgebra>
+class BSRSymmetricGaussSeidel : public BSRGaussSeidelBase<TAlgebra>
+{
+	typedef TAlgebra algebra_type;
+	typedef typename TAlgebra::vector_type vector_type;
+	typedef typename TAlgebra::matrix_type matrix_type;
+	typedef BSRGaussSeidelBase<TAlgebra> base_type;
+
+	public:
+	//	Name of preconditioner
+		virtual const char* name() const {return "BSR Symmetric Gauss-Seidel";}
+
+	/// constructor
+		BSRSymmetricGaussSeidel() : base_type() {}
+
+	/// clone constructor
+		BSRSymmetricGaussSeidel(const BSRSymmetricGaussSeidel<TAlgebra> &parent) : base_type(parent) {}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new BSRSymmetricGaussSeidel<algebra_type>(*this));
+		}
+
+	//	Stepping routine
+		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(base_type::bsr_step_possible(A, c)) base_type::m_bsr.sgs(c, d, relax);
+			else base_type::symmetric_step(A, c, d, relax);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__BSR_SMOOTHERS__ */
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include <sstream>
+#include <vector>
+
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/eigensolver/power_method.h"
+#include "lib_algebra/small_algebra/additional_math.h"
+#include "lib_algebra/cpu_algebra/vector.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+///		Chebyshev-Jacobi-Iteration
+/**
+ * The Chebyshev iteration accelerates the Jacobi iteration by a polynomial
+ * of degree k, that is chosen such that the error components belonging to
+ * the eigenvalues of \f$ D^{-1} A \f$ in the interval \f$ [a, b] \f$ are
+ * damped optimally. Starting from \f$ c = 0 \f$, the correction is computed
+ * by the three-term recurrence
+ *
+ * 	\f$ \theta = (b+a)/2, \quad \delta = (b-a)/2, \quad \sigma = \theta / \delta \f$,
+ *
+ * 	\f$ r_0 = d, \quad p_0 = \frac{1}{\theta} D^{-1} r_0, \quad \rho_0 = 1 / \sigma \f$,
+ *
+ * 	\f$ r_{i} = r_{i-1} - A p_{i-1}, \quad
+ * 	    \rho_{i} = 1 / (2 \sigma - \rho_{i-1}), \quad
+ * 	    p_{i} = \rho_{i} \rho_{i-1} p_{i-1} + \frac{2 \rho_{i}}{\delta} D^{-1} r_{i} \f$,
+ *
+ * 	\f$ c = p_0 + \ldots + p_{k-1} \f$.
+ *
+ * Only products with A and the diagonal are needed. Therefore, the iteration
+ * needs no ordering of the unknowns, behaves the same in serial and parallel
+ * and can be used with matrix-free operators, where only the diagonal is
+ * available as a matrix (see MatrixFreeOperator). In this case, the products
+ * with A are computed by the defect operator.
+ *
+ * The interval is chosen relative to the largest eigenvalue of \f$ D^{-1} A \f$,
+ * i.e. \f$ a = \alpha \lambda_{max}, b = \beta \lambda_{max} \f$ with
+ * \f$ \alpha = 0.1, \beta = 1.1 \f$ by default, such that the upper part of the
+ * spectrum is smoothed. If not set explicitly, \f$ \lambda_{max} \f$ is
+ * estimated by some iterations of the PowerMethod once the operator is known.
+ *
+ *	References:
+ * <ul>
+ * <li> Y. Saad. Iterative Methods for Sparse Linear Systems, 2nd ed., Alg. 12.1
+ * <li> M. Adams, M. Brezina, J. Hu, R. Tuminaro. Parallel multigrid smoothing:
+ *      polynomial versus Gauss-Seidel. J. Comput. Phys. 188 (2003), 593-610
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::approx_operator;
+		using base_type::m_spDefectOperator;
+
+	public:
+	///	default constructor
+		Chebyshev() {set_defaults();}
+
+	///	constructor setting the degree of the polynomial
+		Chebyshev(size_t degree) {set_defaults(); set_degree(degree);}
+
+	/// clone constructor
+		Chebyshev(const Chebyshev<TAlgebra> &parent)
+			: base_type(parent)
+		{
+			set_defaults();
+			m_degree = parent.m_degree;
+			m_numPowerIter = parent.m_numPowerIter;
+			m_lowerFactor = parent.m_lowerFactor;
+			m_upperFactor = parent.m_upperFactor;
+			m_bFixedEigenvalue = parent.m_bFixedEigenvalue;
+			m_maxEigenvalue = parent.m_maxEigenvalue;
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {};
+
+	///	sets the degree of the polynomial (i.e. the number of products with A per step)
+		void set_degree(size_t degree)
+		{
+			UG_COND_THROW(degree == 0, "Chebyshev: Degree must be at least 1.");
+			m_degree = degree;
+		}
+
+	///	sets the number of power iterations used to estimate the largest eigenvalue
+		void set_power_iterations(size_t numIter)
+		{
+			UG_COND_THROW(numIter == 0, "Chebyshev: At least one power iteration needed.");
+			m_numPowerIter = numIter;
+		}
+
+	///	sets the smoothed interval [lower, upper] relative to the largest eigenvalue
+		void set_eigenvalue_range(number lower, number upper)
+		{
+			UG_COND_THROW(lower <= 0.0 || lower >= upper,
+			              "Chebyshev: Invalid eigenvalue range ["<<lower<<", "<<upper<<"].");
+			m_lowerFactor = lower;
+			m_upperFactor = upper;
+		}
+
+	///	sets the largest eigenvalue of D^{-1} A, disabling the estimation
+		void set_max_eigenvalue(number lambda)
+		{
+			UG_COND_THROW(lambda <= 0.0, "Chebyshev: Largest eigenvalue must be positive.");
+			m_maxEigenvalue = lambda;
+			m_bFixedEigenvalue = true;
+			m_bEigenvalueValid = true;
+		}
+
+	///	returns the largest eigenvalue of D^{-1} A (set or last estimated)
+		number max_eigenvalue() const {return m_maxEigenvalue;}
+
+		virtual std::string config_string() const
+		{
+			std::stringstream ss;
+			ss << "Chebyshev(degree = " << m_degree << ", range = ["
+			   << m_lowerFactor << ", " << m_upperFactor << "] * lambda_max";
+			if(m_bFixedEigenvalue) ss << ", lambda_max = " << m_maxEigenvalue;
+			else ss << ", power iterations = " << m_numPowerIter;
+			ss << ")";
+			return ss.str();
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+			matrix_type &mat = *pOp;
+			const size_t size = mat.num_rows();
+			if(size != mat.num_cols())
+			{
+				UG_LOG("Square Matrix needed for Chebyshev Iteration.\n");
+				return false;
+			}
+
+			m_diagInv.resize(size);
+#ifdef UG_PARALLEL
+		//	temporary vector for the diagonal
+			ParallelVector<Vector< typename matrix_type::value_type > > diag;
+			diag.resize(size);
+			diag.set_layouts(mat.layouts());
+
+			for(size_t i = 0; i < diag.size(); ++i)
+				diag[i] = mat(i, i);
+
+		//	make diagonal consistent
+			diag.set_storage_type(PST_ADDITIVE);
+			diag.change_storage_type(PST_CONSISTENT);
+
+			if(diag.size() > 0)
+				if(CheckVectorInvertible(diag) == false)
+					return false;
+#endif
+
+			for(size_t i = 0; i < size; ++i)
+			{
+#ifdef UG_PARALLEL
+				GetInverse(m_diagInv[i], diag[i]);
+#else
+				GetInverse(m_diagInv[i], mat(i,i));
+#endif
+			}
+
+		//	the operator has changed, the eigenvalue must be estimated again.
+		//	This is postponed to the first step, since the defect operator
+		//	may be set after the approximation (e.g. for matrix-free operators)
+			if(!m_bFixedEigenvalue)
+				m_bEigenvalueValid = false;
+
+			return true;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+			UG_COND_THROW(m_spDefectOperator.invalid(), "Chebyshev: Operator not set.");
+
+			if(!m_bEigenvalueValid || m_pEstimatedOp != m_spDefectOperator.get())
+				estimate_max_eigenvalue(d);
+
+			const number a = m_lowerFactor * m_maxEigenvalue;
+			const number b = m_upperFactor * m_maxEigenvalue;
+			const number theta = 0.5 * (b + a);
+			const number delta = 0.5 * (b - a);
+			const number sigma = theta / delta;
+			number rho = 1.0 / sigma;
+
+		//	r = d, p = 1/theta D^{-1} r, c = p
+			SmartPtr<vector_type> spR = d.clone();
+			SmartPtr<vector_type> spZ = d.clone_without_values();
+			SmartPtr<vector_type> spP = d.clone_without_values();
+			vector_type& r = *spR; vector_type& z = *spZ; vector_type& p = *spP;
+
+			apply_diag_inverse(z, r);
+			VecScaleAssign(p, 1.0 / theta, z);
+			VecAssign(c, p);
+
+			for(size_t k = 1; k < m_degree; ++k)
+			{
+			//	r = r - A p
+				m_spDefectOperator->apply_sub(r, p);
+
+			//	p = rho_new * rho * p + 2 rho_new / delta D^{-1} r
+				apply_diag_inverse(z, r);
+				const number rhoNew = 1.0 / (2.0 * sigma - rho);
+				VecScaleAdd(p, rhoNew * rho, p, 2.0 * rhoNew / delta, z);
+				rho = rhoNew;
+
+			//	c = c + p
+				VecScaleAdd(c, 1.0, c, 1.0, p);
+			}
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	computes z = D^{-1} r, the result is consistent
+		void apply_diag_inverse(vector_type& z, const vector_type& r)
+		{
+			for(size_t i = 0; i < m_diagInv.size(); ++i)
+				MatMult(z[i], 1.0, m_diagInv[i], r[i]);
+
+#ifdef UG_PARALLEL
+			z.set_storage_type(PST_ADDITIVE);
+			if(!z.change_storage_type(PST_CONSISTENT))
+				UG_THROW("Chebyshev: Cannot change parallel storage type of "
+						"scaled defect to consistent.");
+#endif
+		}
+
+	///	linear operator D^{-1} A used for the estimation of the eigenvalue
+		class ScaledOperator : public ILinearOperator<vector_type>
+		{
+			public:
+				ScaledOperator(Chebyshev<TAlgebra>* pCheb) : m_pCheb(pCheb) {}
+
+				virtual void init(const vector_type& u) {}
+				virtual void init() {}
+
+			///	f = D^{-1} A u, f is additive
+				virtual void apply(vector_type& f, const vector_type& u)
+				{
+					m_pCheb->m_spDefectOperator->apply(f, u);
+
+					typename vector_type::value_type tmp;
+					for(size_t i = 0; i < m_pCheb->m_diagInv.size(); ++i)
+					{
+						tmp = f[i];
+						MatMult(f[i], 1.0, m_pCheb->m_diagInv[i], tmp);
+					}
+				}
+
+			///	f = f - D^{-1} A u
+				virtual void apply_sub(vector_type& f, const vector_type& u)
+				{
+					SmartPtr<vector_type> spTmp = f.clone_without_values();
+					apply(*spTmp, u);
+					VecScaleAdd(f, 1.0, f, -1.0, *spTmp);
+				}
+
+			protected:
+				Chebyshev<TAlgebra>* m_pCheb;
+		};
+
+	///	estimates the largest eigenvalue of D^{-1} A by the PowerMethod
+		void estimate_max_eigenvalue(const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_estimate, "algebra Chebyshev");
+
+			if(m_spPowerMethod.invalid())
+			{
+				m_spPowerMethod = make_sp(new PowerMethod<TAlgebra>());
+				m_spPowerMethod->set_verbose(false);
+			}
+
+		//	a random start vector contains all eigenmodes
+			SmartPtr<vector_type> spStart = d.clone_without_values();
+			spStart->set_random(-1.0, 1.0);
+
+			m_spPowerMethod->set_linear_operator_A(make_sp(new ScaledOperator(this)));
+			m_spPowerMethod->set_start_vector(spStart);
+			m_spPowerMethod->set_max_iterations(m_numPowerIter);
+			m_spPowerMethod->set_precision(0.0);
+			m_spPowerMethod->calculate_max_eigenvalue();
+
+			m_maxEigenvalue = m_spPowerMethod->get_max_eigenvalue();
+			UG_COND_THROW(!(m_maxEigenvalue > 0.0), "Chebyshev: Estimated largest "
+					"eigenvalue "<<m_maxEigenvalue<<" is not positive. The "
+					"operator must be symmetric positive definite.");
+
+			m_pEstimatedOp = m_spDefectOperator.get();
+			m_bEigenvalueValid = true;
+		}
+
+		void set_defaults()
+		{
+			m_degree = 3;
+			m_numPowerIter = 10;
+			m_lowerFactor = 0.1;
+			m_upperFactor = 1.1;
+			m_maxEigenvalue = 0.0;
+			m_bFixedEigenvalue = false;
+			m_bEigenvalueValid = false;
+			m_pEstimatedOp = NULL;
+		}
+
+	protected:
+	///	type of block-inverse
+		typedef typename block_traits<typename matrix_type::value_type>::inverse_type inverse_type;
+
+	///	storage of the inverse diagonal (consistent in parallel)
+		std::vector<inverse_type> m_diagInv;
+
+	///	degree of the polynomial
+		size_t m_degree;
+
+	///	number of power iterations for the estimation of the eigenvalue
+		size_t m_numPowerIter;
+
+	///	smoothed interval relative to the largest eigenvalue
+		number m_lowerFactor, m_upperFactor;
+
+	///	largest eigenvalue of D^{-1} A
+		number m_maxEigenvalue;
+		bool m_bFixedEigenvalue;
+		bool m_bEigenvalueValid;
+
+	///	operator, the eigenvalue has been estimated for
+		const ILinearOperator<vector_type>* m_pEstimatedOp;
+
+	///	eigensolver used for the estimation
+		SmartPtr<PowerMethod<TAlgebra> > m_spPowerMethod;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__ */
@@ -33,6 +33,8 @@
 #ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__GAUSS_SEIDEL__
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__GAUSS_SEIDEL__
 
+#include <string>
+
 #include "lib_algebra/operator/interface/preconditioner.h"
 #include "lib_algebra/algebra_common/core_smoothers.h"
 #include "lib_algebra/algebra_common/sparsematrix_util.h"
@@ -75,19 +77,33 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		using base_type::debug_writer;
 		using base_type::write_debug;
 
+	///	order in which the rows are relaxed
+		enum SweepType
+		{
+			GS_SEQUENTIAL,	///< row by row (default)
+			GS_MULTICOLOR,	///< color by color, rows of one color in parallel
+			GS_HYBRID		///< gauss-seidel on row blocks, jacobi between blocks
+		};
+
 	public:
 	//	Constructor
 		GaussSeidelBase() :
 			m_relax(1.0),
 			m_bConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_sweepType(GS_SEQUENTIAL),
+			m_bCommCompOverlap(false),
+			m_pExchangeVec(NULL) {};
 
 	/// clone constructor
 		GaussSeidelBase( const GaussSeidelBase<TAlgebra> &parent )
 			: base_type(parent),
 			  m_bConsistentInterfaces(parent.m_bConsistentInterfaces),
 			  m_useOverlap(parent.m_useOverlap),
-			  m_spOrderingAlgo(parent.m_spOrderingAlgo)
+			  m_spOrderingAlgo(parent.m_spOrderingAlgo),
+			  m_sweepType(parent.m_sweepType),
+			  m_bCommCompOverlap(parent.m_bCommCompOverlap),
+			  m_pExchangeVec(NULL)
 		{
 			set_sor_relax(parent.m_relax);
 		}
@@ -100,6 +116,37 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable) {m_useOverlap = enable;}
 
+	///	sets the order in which the rows are relaxed
+	/**
+	 * - "sequential": row by row (default)
+	 * - "multicolor": the rows are colored such that rows of the same color
+	 * 		are not coupled. The colors are processed one after another, the
+	 * 		rows of one color in parallel. The coloring is kept as long as the
+	 * 		matrix pattern does not change.
+	 * - "hybrid": the rows are split into one block per thread. Gauss-Seidel
+	 * 		is applied within the blocks, jacobi between the blocks.
+	 *
+	 * \sa gs_step_LL_multicolor, gs_step_LL_hybrid
+	 */
+		void set_sweep_type(const std::string& type)
+		{
+			if(type == "sequential") m_sweepType = GS_SEQUENTIAL;
+			else if(type == "multicolor") m_sweepType = GS_MULTICOLOR;
+			else if(type == "hybrid") m_sweepType = GS_HYBRID;
+			else UG_THROW(name() << ": Unknown sweep type '" << type
+			              << "'. Use 'sequential', 'multicolor' or 'hybrid'.");
+		}
+
+	///	overlaps the communication of the correction with the sweep (disabled by default)
+	/**
+	 * The rows of the master and slave interfaces are relaxed first. The
+	 * exchange making the correction consistent is started then and runs
+	 * while the remaining rows are relaxed. Note that this changes the order
+	 * of the rows in the sweep. Only used for the sequential forward and
+	 * backward sweep without overlap.
+	 */
+		void set_comm_comp_overlap(bool bOverlap) {m_bCommCompOverlap = bOverlap;}
+
 	/// 	sets an ordering algorithm
 		void set_ordering_algorithm(SmartPtr<ordering_algo_type> ordering_algo){
 			m_spOrderingAlgo = ordering_algo;
@@ -151,9 +198,100 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
 
+			init_sweep(*pA);
+
 			return true;
 		}
 
+	///	computes the coloring resp. the row blocks of the sweep type
+		void init_sweep(const matrix_type& A)
+		{
+			if(m_sweepType == GS_MULTICOLOR){
+				PROFILE_BEGIN_GROUP(GaussSeidel_coloring, "algebra gaussseidel");
+				m_coloring.update(A);
+			}
+			else if(m_sweepType == GS_HYBRID){
+				const size_t n = A.num_rows();
+				const size_t numBlocks = std::max<size_t>(1, std::min<size_t>(NumOMPThreads(), n));
+				m_vBlockBegin.resize(numBlocks + 1);
+				for(size_t b = 0; b <= numBlocks; ++b)
+					m_vBlockBegin[b] = (b * n) / numBlocks;
+			}
+
+			m_vInterfaceRow.clear();
+			m_vInteriorRow.clear();
+#ifdef UG_PARALLEL
+			if(m_bCommCompOverlap && !m_useOverlap && pcl::NumProcs() > 1){
+				const VectorExchangePlan& plan = A.layouts()->exchange_plan();
+				for(size_t i = 0; i < A.num_rows(); ++i){
+					if(plan.is_interface(i)) m_vInterfaceRow.push_back(i);
+					else m_vInteriorRow.push_back(i);
+				}
+			}
+#endif
+		}
+
+	///	forward or backward step starting the exchange of the correction after the interface rows
+		bool overlapped_step(const matrix_type &A, vector_type &c, const vector_type &d,
+		                     const number relax, bool bBackward)
+		{
+#ifdef UG_PARALLEL
+			if(&c != m_pExchangeVec || m_sweepType != GS_SEQUENTIAL
+				|| m_vInterfaceRow.size() + m_vInteriorRow.size() != A.num_rows())
+				return false;
+
+		//	rows not processed yet must be zero
+			c.set(0.0);
+			if(bBackward)
+				gs_step_rows(A, c, d, relax, m_vInterfaceRow.rbegin(), m_vInterfaceRow.rend());
+			else
+				gs_step_rows(A, c, d, relax, m_vInterfaceRow.begin(), m_vInterfaceRow.end());
+
+			c.set_storage_type(PST_UNIQUE);
+			c.begin_change_storage_type(PST_CONSISTENT);
+
+			if(bBackward)
+				gs_step_rows(A, c, d, relax, m_vInteriorRow.rbegin(), m_vInteriorRow.rend());
+			else
+				gs_step_rows(A, c, d, relax, m_vInteriorRow.begin(), m_vInteriorRow.end());
+			return true;
+#else
+			return false;
+#endif
+		}
+
+	///	forward step using the sweep type
+		void forward_step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(overlapped_step(A, c, d, relax, false)) return;
+			switch(m_sweepType){
+				case GS_MULTICOLOR: gs_step_LL_multicolor(A, c, d, relax, m_coloring); break;
+				case GS_HYBRID: gs_step_LL_hybrid(A, c, d, relax, m_vBlockBegin); break;
+				default: gs_step_LL(A, c, d, relax);
+			}
+		}
+
+	///	backward step using the sweep type
+		void backward_step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			if(overlapped_step(A, c, d, relax, true)) return;
+			switch(m_sweepType){
+				case GS_MULTICOLOR: gs_step_UR_multicolor(A, c, d, relax, m_coloring); break;
+				case GS_HYBRID: gs_step_UR_hybrid(A, c, d, relax, m_vBlockBegin); break;
+				default: gs_step_UR(A, c, d, relax);
+			}
+		}
+
+	///	symmetric step using the sweep type
+		void symmetric_step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			switch(m_sweepType){
+				case GS_MULTICOLOR: sgs_step_multicolor(A, c, d, relax, m_coloring); break;
+				case GS_HYBRID: sgs_step_hybrid(A, c, d, relax, m_vBlockBegin); break;
+				default: sgs_step(A, c, d, relax);
+			}
+		}
+
 	//	Postprocess routine
 		virtual bool postprocess() {return true;}
 
@@ -189,7 +327,9 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					spDtmp->change_storage_type(PST_CONSISTENT);
 
 					THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
+					m_pExchangeVec = &c;
 					step(m_A, c, *spDtmp, m_relax);
+					m_pExchangeVec = NULL;
 
 					// declare c unique to enforce that only master correction is used
 					// when it is made consistent below
@@ -207,12 +347,18 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					spDtmp->change_storage_type(PST_UNIQUE);
 
 					THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
+					m_pExchangeVec = &c;
 					step(m_A, c, *spDtmp, m_relax);
+					m_pExchangeVec = NULL;
 					c.set_storage_type(PST_UNIQUE);
 				}
 
-				// make correction consistent
-				c.change_storage_type(PST_CONSISTENT);
+				// make correction consistent (the exchange may have been
+				// started during the sweep already)
+				if(c.storage_type_change_pending())
+					c.end_change_storage_type();
+				else
+					c.change_storage_type(PST_CONSISTENT);
 
 				return true;
 			}
@@ -248,6 +394,19 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 	/// for ordering algorithms
 		SmartPtr<ordering_algo_type> m_spOrderingAlgo;
+
+	///	sweep type, coloring (multicolor) and row blocks (hybrid)
+		SweepType m_sweepType;
+		MatrixColoring m_coloring;
+		std::vector<size_t> m_vBlockBegin;
+
+	///	communication/computation overlap: interface and remaining rows
+		bool m_bCommCompOverlap;
+		std::vector<size_t> m_vInterfaceRow;
+		std::vector<size_t> m_vInteriorRow;
+
+	///	correction whose exchange may be started during the sweep
+		vector_type* m_pExchangeVec;
 #ifdef NOT_YET
 		ordering_container_type m_ordering, m_old_ordering;
 		std::vector<size_t> m_newIndex, m_oldIndex;
@@ -296,7 +455,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			base_type::forward_step(A, c, d, relax);
 		}
 };
 
@@ -341,7 +500,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			base_type::backward_step(A, c, d, relax);
 		}
 };
 
@@ -375,7 +534,7 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			base_type::symmetric_step(A, c, d, relax);
 		}
 };
 
@@ -35,7 +35,10 @@
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__ILU__
 
 #include <limits>
+#include <string>
+#include <vector>
 #include "common/error.h"
+#include "common/util/openmp_util.h"
 #ifndef NDEBUG
 #include "common/stopwatch.h"
 #endif
@@ -250,16 +253,12 @@ bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b)
 	return true;
 }
 
-// solve x = U^-1 * b
-// Returns true on success, or false on issues that lead to some changes in the solution
-// (the solution is computed unless no exceptions are thrown)
+// solves the last row of x = U^-1 * b
+// Returns false if the diagonal entry is near-zero compared to the rhs
 template<typename Matrix_type, typename Vector_type>
-bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
-			  const number eps = 1e-8)
+bool invert_U_last_row(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                       const number eps)
 {
-	PROFILE_FUNC_GROUP("algebra ILU");
-	typedef typename Matrix_type::const_row_iterator const_row_iterator;
-
 	typename Vector_type::value_type s;
 
 	bool result = true;
@@ -297,6 +296,23 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 			InverseMatMult(x[i], 1.0, A(i,i), s);
 		}
 	}
+
+	return result;
+}
+
+// solve x = U^-1 * b
+// Returns true on success, or false on issues that lead to some changes in the solution
+// (the solution is computed unless no exceptions are thrown)
+template<typename Matrix_type, typename Vector_type>
+bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const number eps = 1e-8)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	typename Vector_type::value_type s;
+
+	bool result = invert_U_last_row(A, x, b, eps);
 	if(x.size() <= 1) return result;
 
 	// handle all other rows
@@ -318,6 +334,205 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 	return result;
 }
 
+///	rows of a triangular matrix grouped by their dependency levels
+/**
+ * A row of the lower (upper) triangular part belongs to level k if the
+ * largest level of the rows it depends on, i.e. of the columns j < i (j > i)
+ * stored in row i, is k-1. Rows of the same level are independent and can be
+ * solved in parallel, the levels have to be processed one after another.
+ */
+struct TriangularSolveLevels
+{
+	///	number of levels
+		size_t num_levels() const {return vLevelBegin.empty() ? 0 : vLevelBegin.size() - 1;}
+
+	///	removes all levels
+		void clear() {vLevelBegin.clear(); vRow.clear();}
+
+	///	first position of each level in vRow, followed by the number of rows
+		std::vector<size_t> vLevelBegin;
+
+	///	rows sorted by level (ascending within a level)
+		std::vector<size_t> vRow;
+};
+
+///	computes the dependency levels of the lower (bLower) or upper triangular part of A
+template<typename Matrix_type>
+void ComputeTriangularSolveLevels(const Matrix_type &A, TriangularSolveLevels& levels,
+                                  bool bLower)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	const size_t n = A.num_rows();
+	std::vector<size_t> vLevel(n, 0);
+	size_t numLevels = 0;
+	for(size_t k = 0; k < n; ++k)
+	{
+		const size_t i = bLower ? k : n-1-k;
+		size_t level = 0;
+		for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+		{
+			const size_t j = it.index();
+			if((bLower && j < i) || (!bLower && j > i))
+				level = std::max(level, vLevel[j] + 1);
+		}
+		vLevel[i] = level;
+		numLevels = std::max(numLevels, level + 1);
+	}
+
+	levels.vLevelBegin.assign(numLevels + 1, 0);
+	for(size_t i = 0; i < n; ++i) ++levels.vLevelBegin[vLevel[i] + 1];
+	for(size_t l = 0; l < numLevels; ++l) levels.vLevelBegin[l+1] += levels.vLevelBegin[l];
+	std::vector<size_t> vPos(levels.vLevelBegin.begin(), levels.vLevelBegin.end() - 1);
+	levels.vRow.resize(n);
+	for(size_t i = 0; i < n; ++i)
+		levels.vRow[vPos[vLevel[i]]++] = i;
+}
+
+// solve x = L^-1 b level by level (rows of a level in parallel)
+// Returns true on success
+template<typename Matrix_type, typename Vector_type>
+bool invert_L_levels(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                     const TriangularSolveLevels& levels)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	UG_COND_THROW(levels.vRow.size() != x.size(), "invert_L_levels: Levels computed for "
+			<<levels.vRow.size()<<" rows, but vector has size "<<x.size());
+
+	for(size_t l = 0; l < levels.num_levels(); ++l)
+	{
+		const size_t* vRow = &levels.vRow[0] + levels.vLevelBegin[l];
+		const size_t numRows = levels.vLevelBegin[l+1] - levels.vLevelBegin[l];
+
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t k = 0; k < numRows; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() >= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			x[i] = s;
+		}
+	}
+
+	return true;
+}
+
+// solve x = U^-1 * b level by level (rows of a level in parallel)
+// Returns true on success, or false on issues that lead to some changes in the solution
+// (the solution is computed unless no exceptions are thrown)
+template<typename Matrix_type, typename Vector_type>
+bool invert_U_levels(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                     const TriangularSolveLevels& levels, const number eps = 1e-8)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+	UG_COND_THROW(levels.vRow.size() != x.size(), "invert_U_levels: Levels computed for "
+			<<levels.vRow.size()<<" rows, but vector has size "<<x.size());
+
+	// the last row has no dependencies and is thus solved first
+	bool result = invert_U_last_row(A, x, b, eps);
+	const size_t last = x.size() - 1;
+
+	for(size_t l = 0; l < levels.num_levels(); ++l)
+	{
+		const size_t* vRow = &levels.vRow[0] + levels.vLevelBegin[l];
+		const size_t numRows = levels.vLevelBegin[l+1] - levels.vLevelBegin[l];
+
+		UG_OMP_PARALLEL_FOR(numRows)
+		for(size_t k = 0; k < numRows; ++k)
+		{
+			const size_t i = vRow[k];
+			if(i == last) continue;
+
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() <= i) continue;
+				// s -= it.value() * x[it.index()];
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			// x[i] = s/A(i,i);
+			InverseMatMult(x[i], 1.0, A(i,i), s);
+		}
+	}
+
+	return result;
+}
+
+// approximates x = L^-1 b by jacobi sweeps x = b - (L-I) x, starting with x = b
+// The result is exact if numSweeps is at least the number of levels of L minus one.
+template<typename Matrix_type, typename Vector_type>
+bool invert_L_jacobi(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                     Vector_type& tmp, size_t numSweeps)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	const size_t n = x.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i = 0; i < n; ++i) x[i] = b[i];
+
+	for(size_t sweep = 0; sweep < numSweeps; ++sweep)
+	{
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i = 0; i < n; ++i) tmp[i] = x[i];
+
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i = 0; i < n; ++i)
+		{
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() >= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), tmp[it.index()]);
+			}
+			x[i] = s;
+		}
+	}
+
+	return true;
+}
+
+// approximates x = U^-1 b by jacobi sweeps x = D^-1 (b - (U-D) x), starting with x = D^-1 b
+// The result is exact if numSweeps is at least the number of levels of U minus one.
+template<typename Matrix_type, typename Vector_type>
+bool invert_U_jacobi(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                     Vector_type& tmp, size_t numSweeps)
+{
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	const size_t n = x.size();
+	UG_OMP_PARALLEL_FOR(n)
+	for(size_t i = 0; i < n; ++i) InverseMatMult(x[i], 1.0, A(i,i), b[i]);
+
+	for(size_t sweep = 0; sweep < numSweeps; ++sweep)
+	{
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i = 0; i < n; ++i) tmp[i] = x[i];
+
+		UG_OMP_PARALLEL_FOR(n)
+		for(size_t i = 0; i < n; ++i)
+		{
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() <= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), tmp[it.index()]);
+			}
+			InverseMatMult(x[i], 1.0, A(i,i), s);
+		}
+	}
+
+	return true;
+}
+
 ///	ILU / ILU(beta) preconditioner
 template <typename TAlgebra>
 class ILU : public IPreconditioner<TAlgebra>
@@ -348,6 +563,14 @@ class ILU : public IPreconditioner<TAlgebra>
 		using base_type::write_debug;
 		using base_type::print_debugger_message;
 
+	///	method used for the triangular solves
+		enum TriangularSolveType
+		{
+			TRI_SEQUENTIAL,	///< row by row (default)
+			TRI_LEVELS,		///< level scheduled, rows of a level in parallel
+			TRI_JACOBI		///< approximated by jacobi sweeps
+		};
+
 	public:
 	//	Constructor
 		ILU (double beta=0.0) :
@@ -359,7 +582,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_useOverlap(false),
 			m_spOrderingAlgo(SPNULL),
 			m_bSortIsIdentity(false),
-			m_u(nullptr)
+			m_u(nullptr),
+			m_triSolve(TRI_SEQUENTIAL),
+			m_numJacobiSweeps(3)
 		{};
 
 	/// clone constructor
@@ -373,7 +598,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_useOverlap(parent.m_useOverlap),
 			m_spOrderingAlgo(parent.m_spOrderingAlgo),
 			m_bSortIsIdentity(false),
-			m_u(nullptr)
+			m_u(nullptr),
+			m_triSolve(parent.m_triSolve),
+			m_numJacobiSweeps(parent.m_numJacobiSweeps)
 		{}
 
 	///	Clone
@@ -425,6 +652,27 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable)				{m_useOverlap = enable;}
 
+	///	sets the method used for the triangular solves
+	/**
+	 * - "sequential": forward and backward substitution row by row (default)
+	 * - "levels": the rows are grouped into dependency levels in preprocess.
+	 * 		The levels are processed one after another, the rows of a level in
+	 * 		parallel. The result equals the sequential substitution.
+	 * - "jacobi": the substitutions are approximated by a fixed number of
+	 * 		jacobi sweeps (see set_num_jacobi_sweeps), which are fully parallel.
+	 */
+		void set_triangular_solve(const std::string& type)
+		{
+			if(type == "sequential") m_triSolve = TRI_SEQUENTIAL;
+			else if(type == "levels") m_triSolve = TRI_LEVELS;
+			else if(type == "jacobi") m_triSolve = TRI_JACOBI;
+			else UG_THROW("ILU: Unknown triangular solve '" << type
+			              << "'. Use 'sequential', 'levels' or 'jacobi'.");
+		}
+
+	///	sets the number of jacobi sweeps for the approximate triangular solves
+		void set_num_jacobi_sweeps(size_t numSweeps)	{m_numJacobiSweeps = numSweeps;}
+
 	protected:
 	//	Name of preconditioner
 		virtual const char* name() const {return "ILU";}
@@ -575,6 +823,11 @@ class ILU : public IPreconditioner<TAlgebra>
 			else FactorizeILU(m_ILU);
 			m_ILU.defragment();
 
+		//	dependency levels for the triangular solves
+			m_levelsL.clear(); m_levelsU.clear();
+			if(m_triSolve != TRI_SEQUENTIAL)
+				prepare_triangular_solve();
+
 		//	Debug output of matrices
 			#ifdef UG_PARALLEL
 			write_overlap_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
@@ -587,15 +840,50 @@ class ILU : public IPreconditioner<TAlgebra>
 		}
 
 
+	///	computes the data needed by the selected triangular solve, if missing
+	/**	The levels are computed lazily, since the triangular solve may be
+	 *	changed after the factorization.*/
+		void prepare_triangular_solve()
+		{
+			if(m_triSolve == TRI_LEVELS && m_levelsL.vRow.size() != m_ILU.num_rows()){
+				ComputeTriangularSolveLevels(m_ILU, m_levelsL, true);
+				ComputeTriangularSolveLevels(m_ILU, m_levelsU, false);
+			}
+			else if(m_triSolve == TRI_JACOBI)
+				m_jacobiTmp.resize(m_ILU.num_rows());
+		}
+
+	///	solves x = L^-1 b with the selected triangular solve
+		bool solve_L(vector_type &x, const vector_type &b)
+		{
+			prepare_triangular_solve();
+			switch(m_triSolve){
+				case TRI_LEVELS: return invert_L_levels(m_ILU, x, b, m_levelsL);
+				case TRI_JACOBI: return invert_L_jacobi(m_ILU, x, b, m_jacobiTmp, m_numJacobiSweeps);
+				default: return invert_L(m_ILU, x, b);
+			}
+		}
+
+	///	solves x = U^-1 b with the selected triangular solve
+		bool solve_U(vector_type &x, const vector_type &b)
+		{
+			prepare_triangular_solve();
+			switch(m_triSolve){
+				case TRI_LEVELS: return invert_U_levels(m_ILU, x, b, m_levelsU, m_invEps);
+				case TRI_JACOBI: return invert_U_jacobi(m_ILU, x, b, m_jacobiTmp, m_numJacobiSweeps);
+				default: return invert_U(m_ILU, x, b, m_invEps);
+			}
+		}
+
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
 		{
 
 			if(m_spOrderingAlgo.invalid() || m_bSortIsIdentity)
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				if(! invert_L(m_ILU, tmp, d)) // h := L^-1 d
+				if(! solve_L(tmp, d)) // h := L^-1 d
 					print_debugger_message("ILU: There were issues at inverting L\n");
-				if(! invert_U(m_ILU, c, tmp, m_invEps)) // c := U^-1 h = (LU)^-1 d
+				if(! solve_U(c, tmp)) // c := U^-1 h = (LU)^-1 d
 					print_debugger_message("ILU: There were issues at inverting U\n");
 			}
 ///*
@@ -603,9 +891,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_ordering);
-				if(! invert_L(m_ILU, c, tmp)) // c = L^{-1} d
+				if(! solve_L(c, tmp)) // c = L^{-1} d
 					print_debugger_message("ILU: There were issues at inverting L (after permutation)\n");
-				if(! invert_U(m_ILU, tmp, c, m_invEps)) // tmp = (LU)^{-1} d
+				if(! solve_U(tmp, c)) // tmp = (LU)^{-1} d
 					print_debugger_message("ILU: There were issues at inverting U (after permutation)\n");
 				SetVectorAsPermutation(c, tmp, m_old_ordering);
 			}
@@ -734,6 +1022,12 @@ class ILU : public IPreconditioner<TAlgebra>
 		bool m_bSortIsIdentity;
 
 		const vector_type* m_u;
+
+	///	triangular solve method, dependency levels and jacobi settings
+		TriangularSolveType m_triSolve;
+		TriangularSolveLevels m_levelsL, m_levelsU;
+		size_t m_numJacobiSweeps;
+		vector_type m_jacobiTmp;
 };
 
 } // end namespace ug
@@ -223,6 +223,40 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		{
 			PROFILE_BEGIN_GROUP(Jacobi_step, "algebra Jacobi");
 
+#ifdef UG_PARALLEL
+		//	the values at the interface indices are computed first, such that
+		//	the exchange making the correction consistent can run while the
+		//	remaining values are computed
+			if(!c.layouts()->overlap_enabled())
+			{
+				const VectorExchangePlan& plan = c.layouts()->exchange_plan();
+				const std::vector<size_t>& vInterface = plan.interface_indices();
+				for(size_t k = 0; k < vInterface.size(); ++k)
+				{
+					const size_t i = vInterface[k];
+					MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				}
+
+			// 	the computed correction is additive
+				c.set_storage_type(PST_ADDITIVE);
+
+			//	we make it consistent
+				if(!c.begin_change_storage_type(PST_CONSISTENT))
+				{
+					UG_LOG("ERROR in 'JacobiPreconditioner::apply': "
+							"Cannot change parallel status of correction to consistent.\n");
+					return false;
+				}
+
+				for(size_t i = 0; i < m_diagInv.size(); ++i)
+					if(!plan.is_interface(i))
+						MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+
+				c.end_change_storage_type();
+				return true;
+			}
+#endif
+
 		// 	multiply defect with diagonal, c = damp * D^{-1} * d
 		//	note, that the damping is already included in the inverse diagonal
 			for(size_t i = 0; i < m_diagInv.size(); ++i)
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+
+#include <vector>
+
+#include "common/common.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+
+namespace ug{
+
+///	copies a matrix into a single precision matrix
+template <typename TFloatMatrix, typename TMatrix>
+void ConvertToFloatMatrix(TFloatMatrix& fA, const TMatrix& A)
+{
+	typedef typename TMatrix::const_row_iterator const_row_it;
+	typedef typename TFloatMatrix::connection float_connection;
+
+	fA.resize_and_clear(A.num_rows(), A.num_cols());
+	std::vector<float_connection> vCon;
+	for(size_t i = 0; i < A.num_rows(); ++i)
+	{
+		vCon.clear();
+		for(const_row_it it = A.begin_row(i); it != A.end_row(i); ++it)
+			vCon.push_back(float_connection(it.index(), (float) it.value()));
+		if(!vCon.empty())
+			fA.set_matrix_row(i, &vCon[0], vCon.size());
+	}
+	fA.defragment();
+
+#ifdef UG_PARALLEL
+	fA.set_layouts(A.layouts());
+	fA.set_storage_type(A.get_storage_mask());
+#endif
+}
+
+///	Linear operator storing its matrix in single precision
+/**
+ * The operator is applied to double precision vectors, i.e. only the matrix
+ * entries are stored in single precision, while the products are summed up
+ * in double precision. It is used for the level operators of a multigrid
+ * method, that shall not keep a double precision copy of the level matrix.
+ * The single precision matrix can be passed directly to a MixedPrecision
+ * preconditioner.
+ *
+ * 	param	TAlgebra		(double precision) algebra of the vectors
+ * 	param	TFloatAlgebra	(single precision) algebra of the matrix
+ */
+template <typename TAlgebra, typename TFloatAlgebra = CPUFloatAlgebra>
+class FloatMatrixOperator : public ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Single precision matrix type
+		typedef typename TFloatAlgebra::matrix_type float_matrix_type;
+
+	///	Single precision matrix operator
+		typedef MatrixOperator<float_matrix_type, typename TFloatAlgebra::vector_type> float_operator_type;
+
+	public:
+	///	constructor
+		FloatMatrixOperator() : m_spFloatOp(new float_operator_type) {}
+
+	///	copies a double precision matrix into the operator
+		void set_matrix(const matrix_type& A)
+		{
+			ConvertToFloatMatrix(m_spFloatOp->get_matrix(), A);
+		}
+
+	///	single precision matrix operator
+		SmartPtr<float_operator_type> float_operator() {return m_spFloatOp;}
+
+	///	number of rows
+		size_t num_rows() const {return m_spFloatOp->num_rows();}
+
+	// 	Init Operator J(u)
+		virtual void init(const vector_type& u) {}
+
+	// 	Init Operator L
+		virtual void init() {}
+
+	// 	Apply Operator f = L*u
+		virtual void apply(vector_type& f, const vector_type& u)
+		{
+			MatrixOperatorApply(static_cast<const float_matrix_type&>(*m_spFloatOp), f, u);
+		}
+
+	// 	Apply Operator, i.e. f = f - L*u;
+		virtual void apply_sub(vector_type& f, const vector_type& u)
+		{
+			MatrixOperatorApplySub(static_cast<const float_matrix_type&>(*m_spFloatOp), f, u);
+		}
+
+	protected:
+	///	single precision matrix
+		SmartPtr<float_operator_type> m_spFloatOp;
+};
+
+///	creates a single precision level operator for a matrix
+/**
+ * Only the scalar CPUAlgebra has a single precision variant. For all other
+ * algebras, an exception is thrown.
+ */
+template <typename TAlgebra>
+SmartPtr<ILinearOperator<typename TAlgebra::vector_type> >
+CreateFloatMatrixOperator(const typename TAlgebra::matrix_type& A)
+{
+	UG_THROW("CreateFloatMatrixOperator: Single precision operators are only "
+			"available for the scalar CPU algebra.");
+}
+
+template <>
+inline SmartPtr<ILinearOperator<CPUAlgebra::vector_type> >
+CreateFloatMatrixOperator<CPUAlgebra>(const CPUAlgebra::matrix_type& A)
+{
+	SmartPtr<FloatMatrixOperator<CPUAlgebra> > spOp(new FloatMatrixOperator<CPUAlgebra>);
+	spOp->set_matrix(A);
+	return spOp;
+}
+
+///	Applies a single precision preconditioner within a double precision iteration
+/**
+ * The matrix passed in init is converted to single precision and the wrapped
+ * preconditioner (e.g. ILU, Jacobi or Gauss-Seidel for the CPUFloatAlgebra)
+ * is initialized with the converted matrix. Thus, the preconditioner stores
+ * its data (factorization, inverse diagonal, ...) in single precision and its
+ * application works on single precision values, halving the memory traffic.
+ *
+ * In each step, the (double) defect is converted to single precision, the
+ * preconditioner is applied and the resulting correction is converted back to
+ * double. The outer iteration (e.g. a Krylov method) remains in double
+ * precision.
+ *
+ * If initialized with a FloatMatrixOperator (e.g. by a multigrid method with
+ * single precision levels), its single precision matrix is used directly and
+ * no double precision matrix is needed. The operator is then also used for
+ * the defect updates.
+ *
+ * Note, that the single precision correction is only accurate up to about
+ * 1e-7 relative to the defect. This is usually sufficient for a
+ * preconditioner, but the outer iteration should be a Krylov method (or an
+ * iterative refinement) in double precision.
+ *
+ * \tparam	TAlgebra		(double precision) algebra of the iteration
+ * \tparam	TFloatAlgebra	(single precision) algebra of the preconditioner
+ */
+template <typename TAlgebra, typename TFloatAlgebra = CPUFloatAlgebra>
+class MixedPrecision : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Single precision vector type
+		typedef typename TFloatAlgebra::vector_type float_vector_type;
+
+	///	Single precision matrix type
+		typedef typename TFloatAlgebra::matrix_type float_matrix_type;
+
+	///	Single precision preconditioner
+		typedef ILinearIterator<float_vector_type> float_iterator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	///	Single precision operator type
+		typedef FloatMatrixOperator<TAlgebra, TFloatAlgebra> float_operator_type;
+
+	protected:
+		using base_type::m_bInit;
+		using base_type::m_spDefectOperator;
+		using base_type::damping;
+
+	public:
+	///	default constructor
+		MixedPrecision() {}
+
+	///	constructor setting the single precision preconditioner
+		MixedPrecision(SmartPtr<float_iterator_type> spPrecond)
+			: m_spPrecond(spPrecond) {}
+
+	/// clone constructor
+		MixedPrecision(const MixedPrecision<TAlgebra, TFloatAlgebra> &parent)
+			: base_type(parent)
+		{
+			SmartPtr<float_iterator_type> spPrecond = parent.m_spPrecond;
+			if(spPrecond.valid())
+				m_spPrecond = spPrecond->clone();
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new MixedPrecision<TAlgebra, TFloatAlgebra>(*this));
+		}
+
+	///	sets the single precision preconditioner
+		void set_preconditioner(SmartPtr<float_iterator_type> spPrecond)
+		{
+			m_spPrecond = spPrecond;
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			return m_spPrecond.valid() && m_spPrecond->supports_parallel();
+		}
+
+		using base_type::init;
+
+	///	initializes the preconditioner for an operator
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > J, const vector_type& u)
+		{
+			return init(J);
+		}
+
+	///	initializes the preconditioner for an operator
+	/**
+	 * If the operator is a FloatMatrixOperator, its single precision matrix is
+	 * used. Otherwise, the operator must be matrix based and the matrix is
+	 * converted to single precision.
+	 */
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > L)
+		{
+			m_spFloatLevelOp = L.template cast_dynamic<float_operator_type>();
+			if(m_spFloatLevelOp.invalid())
+				return base_type::init(L);
+
+			UG_COND_THROW(m_spPrecond.invalid(), name() << ": No preconditioner set.");
+			m_spDefectOperator = L;
+			m_spFloatOp = m_spFloatLevelOp->float_operator();
+			m_bInit = m_spPrecond->init(m_spFloatOp);
+			return m_bInit;
+		}
+
+	///	compute new correction c = B*d
+		virtual bool apply(vector_type& c, const vector_type& d)
+		{
+			if(m_spFloatLevelOp.invalid())
+				return base_type::apply(c, d);
+
+			if(!m_bInit)
+			{
+				UG_LOG("ERROR in '"<<name()<<"::apply': Iterator not initialized.\n");
+				return false;
+			}
+			THROW_IF_NOT_EQUAL_3(c.size(), d.size(), m_spFloatLevelOp->num_rows());
+
+			if(!apply_float(c, d))
+				return false;
+
+			const number kappa = damping()->damping(c, d, m_spFloatLevelOp);
+			if(kappa != 1.0) c *= kappa;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW(name() << "::apply': Cannot change "
+						"parallel storage type of correction to consistent.");
+			#endif
+			return true;
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "MixedPrecision";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(MixedPrecision_preprocess, "algebra MixedPrecision");
+			UG_COND_THROW(m_spPrecond.invalid(), name() << ": No preconditioner set.");
+
+			m_spFloatOp = make_sp(new MatrixOperator<float_matrix_type, float_vector_type>());
+			ConvertToFloatMatrix(m_spFloatOp->get_matrix(), *pOp);
+
+			return m_spPrecond->init(m_spFloatOp);
+		}
+
+	///	Stepping routine
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                  vector_type& c, const vector_type& d)
+		{
+			return apply_float(c, d);
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	///	converts the defect, applies the preconditioner and converts the correction
+		bool apply_float(vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(MixedPrecision_step, "algebra MixedPrecision");
+
+			const size_t n = d.size();
+			m_d.resize(n, false);
+			m_c.resize(n, false);
+#ifdef UG_PARALLEL
+			m_d.set_layouts(d.layouts());
+			m_c.set_layouts(c.layouts());
+			m_d.set_storage_type(d.get_storage_mask());
+#endif
+			for(size_t i = 0; i < n; ++i)
+				m_d[i] = (float) d[i];
+
+			if(!m_spPrecond->apply(m_c, m_d))
+				return false;
+
+			for(size_t i = 0; i < n; ++i)
+				c[i] = m_c[i];
+#ifdef UG_PARALLEL
+			c.set_storage_type(m_c.get_storage_mask());
+#endif
+			return true;
+		}
+
+	protected:
+	///	single precision preconditioner
+		SmartPtr<float_iterator_type> m_spPrecond;
+
+	///	single precision matrix
+		SmartPtr<MatrixOperator<float_matrix_type, float_vector_type> > m_spFloatOp;
+
+	///	single precision operator, if initialized with one
+		SmartPtr<float_operator_type> m_spFloatLevelOp;
+
+	///	single precision defect and correction
+		float_vector_type m_d, m_c;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__ */
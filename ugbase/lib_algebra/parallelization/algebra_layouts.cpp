@@ -42,6 +42,22 @@
 namespace ug
 {
 
+size_t HorizontalAlgebraLayouts::new_revision()
+{
+	static size_t revisionCounter = 0;
+	return ++revisionCounter;
+}
+
+VectorExchangePlan& HorizontalAlgebraLayouts::exchange_plan() const
+{
+//	a new plan is created instead of reinitializing the old one, since
+//	copies of the layouts may share the plan
+	if(m_spExchangePlan.invalid() || m_spExchangePlan->revision() != m_revision)
+		m_spExchangePlan = make_sp(new VectorExchangePlan(masterLayout,
+		                                                  slaveLayout, m_revision));
+	return *m_spExchangePlan;
+}
+
 
 std::ostream &operator << (std::ostream &out, const HorizontalAlgebraLayouts &layouts)
 {
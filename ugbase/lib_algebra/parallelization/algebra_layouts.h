@@ -36,6 +36,8 @@
 #ifdef UG_PARALLEL
 #include "pcl/pcl_base.h"
 #include "lib_algebra/parallelization/parallel_index_layout.h"
+#include "lib_algebra/parallelization/vector_exchange_plan.h"
+#include "common/util/smart_pointer.h"
 #endif
 
 namespace ug{
@@ -47,12 +49,14 @@ namespace ug{
 class HorizontalAlgebraLayouts
 {
 	public:
-		HorizontalAlgebraLayouts() : m_overlapEnabled(false) 	{}
+		HorizontalAlgebraLayouts()
+			: m_overlapEnabled(false), m_revision(new_revision())	{}
 
 	///	clears the struct
 		void clear()
 		{
 			masterLayout.clear();			slaveLayout.clear();
+			m_revision = new_revision();
 		}
 
 	public:
@@ -83,8 +87,31 @@ class HorizontalAlgebraLayouts
 	///	Tells whether overlap interfaces should be considered
 		bool overlap_enabled() const		{return m_overlapEnabled;}
 
+	///	returns the exchange plan for the master and slave layout
+	/**
+	 * The plan is cached and rebuilt, if the revision of the layouts has
+	 * changed since it has been created. As for comm(), a non-const plan is
+	 * returned, since the plan holds the communication buffers.
+	 */
+		VectorExchangePlan& exchange_plan() const;
+
+	///	returns the revision of the layouts
+	/**
+	 * The revision changes whenever the layouts are cleared or
+	 * layouts_changed() is called. Revisions are unique among all layouts.
+	 */
+		size_t revision() const		{return m_revision;}
+
+	///	marks the master and slave layout as modified
+	/**
+	 * Must be called after the layouts returned by the non-const master() or
+	 * slave() have been modified, so that the exchange plan is rebuilt.
+	 */
+		void layouts_changed()		{m_revision = new_revision();}
+
 	public:
 	/// returns the horizontal slave/master index layout
+	/// (call layouts_changed() after modifying the master or slave layout)
 	/// \{
 		IndexLayout& master()			{return masterLayout;}
 		IndexLayout& master_overlap() 	{return masterOverlapLayout;}
@@ -114,6 +141,15 @@ class HorizontalAlgebraLayouts
 		pcl::InterfaceCommunicator<IndexLayout> communicator;
 
 		bool m_overlapEnabled;
+
+		///	returns a new (globally unique) revision
+		static size_t new_revision();
+
+		///	revision of the layouts
+		size_t m_revision;
+
+		///	cached exchange plan
+		mutable SmartPtr<VectorExchangePlan> m_spExchangePlan;
 };
 
 ///	Extends the HorizontalAlgebraLayouts by vertical layouts.
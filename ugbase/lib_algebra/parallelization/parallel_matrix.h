@@ -78,12 +78,14 @@ class ParallelMatrix : public TMatrix
 	public:
 	///	Default Constructor
 		ParallelMatrix()
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts),
+			  m_overlapRevision(0), m_overlapNNZ(0)
 		{}
 
 	///	Constructor setting the layouts
 		ParallelMatrix(SmartPtr<AlgebraLayouts> layouts)
-			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts)
+			: TMatrix(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts),
+			  m_overlapRevision(0), m_overlapNNZ(0)
 		{}
 
 		/////////////////////////
@@ -128,6 +130,25 @@ class ParallelMatrix : public TMatrix
 		template<typename TPVector>
 		bool apply(TPVector &res, const TPVector &x) const;
 
+	/// calculate res = A x for an additive matrix and a non-consistent x
+	/**
+	 * x is changed to consistent storage. The exchange of the interface
+	 * values is overlapped with the computation: it is started first, then
+	 * all rows not coupling to an interface index are computed, and the
+	 * remaining rows are computed after the exchange has completed. For
+	 * a consistent x (or a consistent matrix), apply is used.
+	 *
+	 * The split into interior and interface rows is cached for the revision
+	 * of the layouts, the number of rows and the number of connections.
+	 */
+		template<typename TPVector>
+		bool apply_overlapped(TPVector &res, TPVector &x) const;
+
+	/// calculate res -= A x for an additive matrix and a non-consistent x
+	/**	x is changed to consistent storage, see apply_overlapped. */
+		template<typename TPVector>
+		bool matmul_minus_overlapped(TPVector &res, TPVector &x) const;
+
 	/// calculate res = A.T x
 		template<typename TPVector>
 		bool apply_transposed(TPVector &res, const TPVector &x) const;
@@ -140,11 +161,24 @@ class ParallelMatrix : public TMatrix
 		this_type &operator =(const this_type &M);
 
 	private:
+	/// computes res = A x (res -= A x if bSub) while x is made consistent
+		template<typename TPVector>
+		bool mat_mult_overlapped(TPVector &res, TPVector &x, bool bSub) const;
+
+	///	sorts the rows into interior and interface rows (if not cached)
+		void update_overlap_rows(const VectorExchangePlan& plan) const;
+
 	/// type of storage  (i.e. consistent, additiv, additiv unique)
 		uint m_type;
 
 	/// algebra layouts and communicators
 		ConstSmartPtr<AlgebraLayouts> m_spAlgebraLayouts;
+
+	///	rows not coupling / coupling to an interface index
+		mutable std::vector<size_t> m_vInteriorRow, m_vInterfaceRow;
+
+	///	revision of the layouts and number of connections of the row split
+		mutable size_t m_overlapRevision, m_overlapNNZ;
 };
 
 //	predaclaration.
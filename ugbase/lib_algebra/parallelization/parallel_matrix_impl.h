@@ -34,6 +34,7 @@
 #define __H__LIB_ALGEBRA__PARALLELIZATION__PARALLEL_MATRIX_IMPL__
 
 #include "parallel_matrix.h"
+#include "common/util/openmp_util.h"
 
 namespace ug
 {
@@ -48,6 +49,7 @@ ParallelMatrix<TMatrix>::operator =(const typename ParallelMatrix<TMatrix>::this
 //	copy storage type and layouts
 	this->set_storage_type(M.get_storage_mask());
 	this->set_layouts(M.layouts());
+	m_overlapRevision = 0;
 
 //	we're done
 	return *this;
@@ -117,6 +119,115 @@ apply(TPVector &res, const TPVector &x) const
 	return true;
 }
 
+// calculate res = A x, overlapping the exchange of x
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+apply_overlapped(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	if(x.has_storage_type(PST_CONSISTENT) || !has_storage_type(PST_ADDITIVE))
+		return apply(res, x);
+
+	return mat_mult_overlapped(res, x, false);
+}
+
+// calculate res -= A x, overlapping the exchange of x
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+matmul_minus_overlapped(TPVector &res, TPVector &x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	if(x.has_storage_type(PST_CONSISTENT) || !has_storage_type(PST_ADDITIVE)
+		|| !res.has_storage_type(PST_ADDITIVE))
+		return matmul_minus(res, x);
+
+	return mat_mult_overlapped(res, x, true);
+}
+
+// sorts the rows into interior rows and rows coupling to an interface index
+template <typename TMatrix>
+void
+ParallelMatrix<TMatrix>::
+update_overlap_rows(const VectorExchangePlan& plan) const
+{
+	const size_t numRows = this->num_rows();
+	const size_t nnz = this->total_num_connections();
+	if(m_overlapRevision == plan.revision() && m_overlapNNZ == nnz
+		&& m_vInteriorRow.size() + m_vInterfaceRow.size() == numRows)
+		return;
+
+	m_vInteriorRow.clear();
+	m_vInterfaceRow.clear();
+	for(size_t i = 0; i < numRows; ++i)
+	{
+		bool bInterior = true;
+		for(typename TMatrix::const_row_iterator it = this->begin_row(i);
+			it != this->end_row(i); ++it)
+			if(plan.is_interface(it.index())) {bInterior = false; break;}
+
+		if(bInterior) m_vInteriorRow.push_back(i);
+		else m_vInterfaceRow.push_back(i);
+	}
+
+	m_overlapRevision = plan.revision();
+	m_overlapNNZ = nnz;
+}
+
+// computes res = A x (or res -= A x if bSub) while changing x to consistent
+template <typename TMatrix>
+template<typename TPVector>
+bool
+ParallelMatrix<TMatrix>::
+mat_mult_overlapped(TPVector &res, TPVector &x, bool bSub) const
+{
+//	start the exchange (the change may also have been completed directly)
+	x.begin_change_storage_type(PST_CONSISTENT);
+	if(!x.storage_type_change_pending())
+		return bSub ? matmul_minus(res, x) : apply(res, x);
+
+	update_overlap_rows(x.layouts()->exchange_plan());
+	const number alpha = bSub ? -1.0 : 1.0;
+
+//	The interior rows are computed while the values are exchanged: the first
+//	half while the slave values are added to the masters, the second half
+//	while the sums are copied to the slaves.
+	const size_t* vInterior = m_vInteriorRow.empty() ? NULL : &m_vInteriorRow[0];
+	const size_t numInterior = m_vInteriorRow.size();
+	for(int half = 0; half < 2; ++half)
+	{
+		const size_t first = half * (numInterior / 2);
+		const size_t end = half ? numInterior : numInterior / 2;
+		UG_OMP_PARALLEL_FOR(end - first)
+		for(size_t k = first; k < end; ++k)
+		{
+			const size_t i = vInterior[k];
+			if(!bSub) res[i] = 0.0;
+			TMatrix::mat_mult_add_row(i, res[i], alpha, x);
+		}
+
+		if(half == 0) x.progress_change_storage_type();
+	}
+
+//	complete the exchange and compute the interface rows
+	x.end_change_storage_type();
+	const size_t* vInterface = m_vInterfaceRow.empty() ? NULL : &m_vInterfaceRow[0];
+	const size_t numInterface = m_vInterfaceRow.size();
+	UG_OMP_PARALLEL_FOR(numInterface)
+	for(size_t k = 0; k < numInterface; ++k)
+	{
+		const size_t i = vInterface[k];
+		if(!bSub) res[i] = 0.0;
+		TMatrix::mat_mult_add_row(i, res[i], alpha, x);
+	}
+
+	res.set_storage_type(PST_ADDITIVE);
+	return true;
+}
+
 // calculate res = A.T x
 template <typename TMatrix>
 template<typename TPVector>
@@ -76,17 +76,20 @@ class ParallelVector : public TVector
 	public:
 	///	Default constructor
 		ParallelVector()
-			: TVector(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts)
+			: TVector(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts),
+			  m_pendingType(PST_UNDEFINED), m_bPendingCopy(false)
 		{}
 
 	/// Resizing constructor
 		ParallelVector(size_t length)
-			: TVector(length), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts)
+			: TVector(length), m_type(PST_UNDEFINED), m_spAlgebraLayouts(new AlgebraLayouts),
+			  m_pendingType(PST_UNDEFINED), m_bPendingCopy(false)
 		{}
 
 	///	Constructor setting the Layouts
 		ParallelVector(ConstSmartPtr<AlgebraLayouts> layouts)
-			: TVector(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts)
+			: TVector(), m_type(PST_UNDEFINED), m_spAlgebraLayouts(layouts),
+			  m_pendingType(PST_UNDEFINED), m_bPendingCopy(false)
 		{}
 
 		/////////////////////////
@@ -114,6 +117,39 @@ class ParallelVector : public TVector
 	/// changes to the requested storage type if possible
 		bool change_storage_type(ParallelStorageType type);
 
+	///	starts changing to the requested storage type
+	/**
+	 * Split-phase version of change_storage_type: The communication is started
+	 * and completed by end_change_storage_type(). In between, the values at
+	 * all indices that are not part of the master or slave layout may be
+	 * computed, and the values at the interface indices may be read (the
+	 * exchange plan of the layouts tells the interface indices). The values
+	 * at the interface indices must not be modified.
+	 *
+	 * The storage type is set at end_change_storage_type(). If the change
+	 * can not be split (e.g. overlap is enabled or the entries have variable
+	 * size), the storage type is changed directly.
+	 *
+	 * Only one vector per layouts can have a pending change.
+	 */
+		bool begin_change_storage_type(ParallelStorageType type);
+
+	///	advances a pending change from additive to consistent storage
+	/**
+	 * The change from additive to consistent storage needs two exchanges: the
+	 * slave values are added to the masters and the sums are copied back to
+	 * the slaves. This method completes the first and starts the second one,
+	 * so that both can be overlapped with computation. For all other pending
+	 * changes, it does nothing.
+	 */
+		void progress_change_storage_type();
+
+	///	completes the change started by begin_change_storage_type
+		void end_change_storage_type();
+
+	///	returns if a storage type change has been started but not completed
+		bool storage_type_change_pending() const {return m_pendingType != PST_UNDEFINED;}
+
 	/// returns if the current storage type has a given representation
 	/**	type may be any or-combination of constants enumerated in ug::ParallelStorageType.*/
 		bool has_storage_type(uint type) const
@@ -195,6 +231,12 @@ class ParallelVector : public TVector
 
 	/// algebra layouts and communicators
 		ConstSmartPtr<AlgebraLayouts> m_spAlgebraLayouts;
+
+	///	storage type of a pending change (or PST_UNDEFINED)
+		uint m_pendingType;
+
+	///	true if the copy to the slaves of a pending additive to consistent change has been started
+		bool m_bPendingCopy;
 };
 
 } // end namespace ug
@@ -127,26 +127,41 @@ change_storage_type(ParallelStorageType type)
 	// if already in that type
 	if(has_storage_type(type)) return true;
 
+	UG_COND_THROW(storage_type_change_pending(), "ParallelVector::"
+				"change_storage_type: Another change is pending.");
+
 	// check layouts
 	if(layouts().invalid())
 		UG_THROW("ParallelVector::change_storage_type: No "
 					"layouts given but trying to change type.")
 
+	//	vectors with entries of static size are exchanged via the cached plan
+	const bool bPlan = VectorExchangePlan::applicable<TVector>();
+
 	// else switch to that type
 	switch(type)
 	{
 		case PST_CONSISTENT:
 			if(has_storage_type(PST_UNIQUE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTUnique2Consistent);
-				UniqueToConsistent(this, layouts()->master(), layouts()->slave(),
-				                   &layouts()->comm());
+				if(bPlan)
+					layouts()->exchange_plan().copy_master_to_slave(*this);
+				else
+					UniqueToConsistent(this, layouts()->master(), layouts()->slave(),
+					                   &layouts()->comm());
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTUnique2Consistent
 			}
 			else if(has_storage_type(PST_ADDITIVE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Consistent);
-				AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
-				                     &layouts()->comm());
+				if(bPlan){
+					VectorExchangePlan& plan = layouts()->exchange_plan();
+					plan.add_slave_to_master(*this, false);
+					plan.copy_master_to_slave(*this);
+				}
+				else
+					AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
+					                     &layouts()->comm());
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTAdditive2Consistent
 			}
@@ -188,6 +203,9 @@ change_storage_type(ParallelStorageType type)
 				           	   layouts()->master_overlap(), &layouts()->comm());
 					ConsistentToUnique(this, layouts()->slave());
 				}
+				else if(bPlan){
+					layouts()->exchange_plan().add_slave_to_master(*this, true);
+				}
 				else{
 					AdditiveToUnique(this, layouts()->master(), layouts()->slave(),
 					                 &layouts()->comm());
@@ -217,6 +235,90 @@ change_storage_type(ParallelStorageType type)
 	return true;
 }
 
+template <typename TVector>
+bool
+ParallelVector<TVector>::
+begin_change_storage_type(ParallelStorageType type)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	UG_COND_THROW(storage_type_change_pending(), "ParallelVector::"
+				"begin_change_storage_type: Another change is pending.");
+
+	if(has_storage_type(PST_UNDEFINED))
+		UG_THROW("ParallelVector::begin_change_storage_type: Trying to change"
+				" storage type of a vector that has type PST_UNDEFINED.");
+
+	if(has_storage_type(type)) return true;
+
+	if(layouts().invalid())
+		UG_THROW("ParallelVector::begin_change_storage_type: No "
+					"layouts given but trying to change type.")
+
+//	changes without communication or with overlap are not split
+	if(!VectorExchangePlan::applicable<TVector>() || layouts()->overlap_enabled()
+		|| has_storage_type(PST_CONSISTENT) || type == PST_ADDITIVE)
+		return change_storage_type(type);
+
+	VectorExchangePlan& plan = layouts()->exchange_plan();
+	switch(type)
+	{
+		case PST_CONSISTENT:
+			if(has_storage_type(PST_UNIQUE))
+				plan.begin_copy_master_to_slave(*this);
+			else
+				plan.begin_add_slave_to_master(*this, false);
+			break;
+
+		case PST_UNIQUE:
+			plan.begin_add_slave_to_master(*this, true);
+			break;
+
+		default: return false;
+	}
+
+	m_pendingType = type;
+	return true;
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+progress_change_storage_type()
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	if(m_pendingType != PST_CONSISTENT || has_storage_type(PST_UNIQUE)
+		|| m_bPendingCopy)
+		return;
+
+	VectorExchangePlan& plan = layouts()->exchange_plan();
+	plan.end_add_slave_to_master(*this);
+	plan.begin_copy_master_to_slave(*this);
+	m_bPendingCopy = true;
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+end_change_storage_type()
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	if(!storage_type_change_pending()) return;
+
+	VectorExchangePlan& plan = layouts()->exchange_plan();
+	if(m_pendingType == PST_CONSISTENT){
+		progress_change_storage_type();
+		plan.end_copy_master_to_slave(*this);
+		m_bPendingCopy = false;
+		set_storage_type(PST_CONSISTENT);
+	}
+	else{
+		plan.end_add_slave_to_master(*this);
+		add_storage_type(PST_UNIQUE);
+	}
+
+	m_pendingType = PST_UNDEFINED;
+}
+
 template <typename TVector>
 void
 ParallelVector<TVector>::
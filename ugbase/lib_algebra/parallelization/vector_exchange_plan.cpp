@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include "vector_exchange_plan.h"
+#include "pcl/pcl_comm_world.h"
+
+namespace ug{
+
+///	tags of the messages (distinct from the default tag of the InterfaceCommunicator).
+///	The tags are offset by the entry size, such that the messages of exchanges
+///	of vectors with different value types cannot be mixed up.
+static const int TAG_SLAVE_TO_MASTER = 749346;
+static const int TAG_MASTER_TO_SLAVE = 749347;
+
+VectorExchangePlan::
+VectorExchangePlan(const IndexLayout& masterLayout,
+                   const IndexLayout& slaveLayout, size_t revision)
+	: m_revision(revision)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	flatten(m_master, masterLayout);
+	flatten(m_slave, slaveLayout);
+
+//	collect the interface indices
+	m_vInterfaceIndex = m_master.vIndex;
+	m_vInterfaceIndex.insert(m_vInterfaceIndex.end(),
+	                         m_slave.vIndex.begin(), m_slave.vIndex.end());
+	std::sort(m_vInterfaceIndex.begin(), m_vInterfaceIndex.end());
+	m_vInterfaceIndex.erase(std::unique(m_vInterfaceIndex.begin(),
+	                                    m_vInterfaceIndex.end()),
+	                        m_vInterfaceIndex.end());
+
+	if(!m_vInterfaceIndex.empty())
+		m_vIsInterface.resize(m_vInterfaceIndex.back() + 1, false);
+	for(size_t i = 0; i < m_vInterfaceIndex.size(); ++i)
+		m_vIsInterface[m_vInterfaceIndex[i]] = true;
+}
+
+VectorExchangePlan::
+~VectorExchangePlan()
+{
+	for(std::map<size_t, Channel>::iterator it = m_mChannel.begin();
+		it != m_mChannel.end(); ++it)
+	{
+		Channel& ch = it->second;
+		if(ch.pPending) wait(ch, *ch.pPending);
+		free_requests(ch);
+	}
+}
+
+void VectorExchangePlan::
+flatten(FlatLayout& flat, const IndexLayout& layout)
+{
+	flat.vProc.clear();
+	flat.vOffset.assign(1, 0);
+	flat.vIndex.clear();
+
+	for(IndexLayout::const_iterator iiter = layout.begin();
+		iiter != layout.end(); ++iiter)
+	{
+		const IndexLayout::Interface& interface = layout.interface(iiter);
+
+		flat.vProc.push_back(layout.proc_id(iiter));
+		for(IndexLayout::Interface::const_iterator iter = interface.begin();
+			iter != interface.end(); ++iter)
+			flat.vIndex.push_back(interface.get_element(iter));
+		flat.vOffset.push_back(flat.vIndex.size());
+	}
+}
+
+bool VectorExchangePlan::
+pending() const
+{
+	for(std::map<size_t, Channel>::const_iterator it = m_mChannel.begin();
+		it != m_mChannel.end(); ++it)
+		if(it->second.pPending) return true;
+	return false;
+}
+
+VectorExchangePlan::Channel& VectorExchangePlan::
+channel(size_t entrySize)
+{
+	Channel& ch = m_mChannel[entrySize];
+	if(ch.entrySize == entrySize) return ch;
+
+	ch.entrySize = entrySize;
+	ch.vMasterBuffer.resize(m_master.vIndex.size() * entrySize);
+	ch.vSlaveBuffer.resize(m_slave.vIndex.size() * entrySize);
+
+	const int tagSlaveToMaster = TAG_SLAVE_TO_MASTER + 2 * (int)entrySize;
+	const int tagMasterToSlave = TAG_MASTER_TO_SLAVE + 2 * (int)entrySize;
+
+//	receives are listed first, such that they are started before the sends
+	const size_t numMaster = m_master.vProc.size();
+	const size_t numSlave = m_slave.vProc.size();
+	ch.vSlaveToMaster.resize(numMaster + numSlave);
+	ch.vMasterToSlave.resize(numSlave + numMaster);
+
+	for(size_t i = 0; i < numMaster; ++i)
+	{
+		char* buf = ch.master_buffer() + m_master.vOffset[i] * entrySize;
+		const int size = (int)((m_master.vOffset[i+1] - m_master.vOffset[i]) * entrySize);
+
+		MPI_Recv_init(buf, size, MPI_UNSIGNED_CHAR, m_master.vProc[i],
+		              tagSlaveToMaster, PCL_COMM_WORLD, &ch.vSlaveToMaster[i]);
+		MPI_Send_init(buf, size, MPI_UNSIGNED_CHAR, m_master.vProc[i],
+		              tagMasterToSlave, PCL_COMM_WORLD, &ch.vMasterToSlave[numSlave + i]);
+	}
+
+	for(size_t i = 0; i < numSlave; ++i)
+	{
+		char* buf = ch.slave_buffer() + m_slave.vOffset[i] * entrySize;
+		const int size = (int)((m_slave.vOffset[i+1] - m_slave.vOffset[i]) * entrySize);
+
+		MPI_Send_init(buf, size, MPI_UNSIGNED_CHAR, m_slave.vProc[i],
+		              tagSlaveToMaster, PCL_COMM_WORLD, &ch.vSlaveToMaster[numMaster + i]);
+		MPI_Recv_init(buf, size, MPI_UNSIGNED_CHAR, m_slave.vProc[i],
+		              tagMasterToSlave, PCL_COMM_WORLD, &ch.vMasterToSlave[i]);
+	}
+
+	return ch;
+}
+
+void VectorExchangePlan::
+free_requests(Channel& ch)
+{
+//	requests must not be freed after MPI has been finalized
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+
+	if(!finalized){
+		for(size_t i = 0; i < ch.vSlaveToMaster.size(); ++i)
+			MPI_Request_free(&ch.vSlaveToMaster[i]);
+		for(size_t i = 0; i < ch.vMasterToSlave.size(); ++i)
+			MPI_Request_free(&ch.vMasterToSlave[i]);
+	}
+	ch.vSlaveToMaster.clear();
+	ch.vMasterToSlave.clear();
+}
+
+void VectorExchangePlan::
+start(Channel& ch, std::vector<MPI_Request>& vRequest)
+{
+	if(!vRequest.empty())
+		MPI_Startall((int)vRequest.size(), &vRequest[0]);
+	ch.pPending = &vRequest;
+}
+
+void VectorExchangePlan::
+wait(Channel& ch, std::vector<MPI_Request>& vRequest)
+{
+	UG_COND_THROW(ch.pPending != &vRequest, "VectorExchangePlan: Waiting for "
+	              "an exchange that has not been started.");
+	pcl::Waitall(vRequest);
+	ch.pPending = NULL;
+}
+
+} // end namespace ug
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG4__LIB_ALGEBRA__PARALLELIZATION__VECTOR_EXCHANGE_PLAN__
+#define __H__UG4__LIB_ALGEBRA__PARALLELIZATION__VECTOR_EXCHANGE_PLAN__
+
+#ifdef UG_PARALLEL
+
+#include <map>
+#include <vector>
+#include "pcl/pcl_methods.h"
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+#include "lib_algebra/parallelization/parallel_index_layout.h"
+#include "lib_algebra/small_algebra/blocks.h"
+
+namespace ug{
+
+///	Precomputed communication pattern for the master and slave layouts of a vector
+/**
+ * The storage type changes of a ParallelVector exchange the values of the
+ * master and slave interfaces. Using the generic communication policies
+ * together with the InterfaceCommunicator, the interfaces are traversed via
+ * the layouts, new send buffers are filled and the receive buffers are
+ * (re-)allocated in each call.
+ *
+ * The plan flattens the interfaces of the master and the slave layout into
+ * contiguous index arrays (grouped per neighbor process) and holds
+ * preallocated buffers for them. The messages are sent and received using
+ * persistent MPI requests, which are set up once for the layouts and the
+ * size of the vector entries and reused for every exchange.
+ *
+ * The plan can only be used for vectors with entries of static size
+ * (see applicable()). The values are copied into the buffers by their
+ * copy-assignment and sent byte-wise, exactly as done by the communication
+ * policies.
+ *
+ * Vectors of different value types (e.g. the float vectors of a mixed
+ * precision solver) share the layouts and thus the plan. Buffers and
+ * requests are therefore kept per entry size, and an exchange of one
+ * entry size may be pending while vectors of another entry size are
+ * exchanged.
+ *
+ * Note: The plan does not observe the layouts. It has to be rebuilt if the
+ * layouts change (see HorizontalAlgebraLayouts::exchange_plan()).
+ */
+class VectorExchangePlan
+{
+	public:
+	///	creates the plan for the given layouts
+		VectorExchangePlan(const IndexLayout& masterLayout,
+		                   const IndexLayout& slaveLayout, size_t revision);
+
+	///	frees the persistent requests
+		~VectorExchangePlan();
+
+	///	revision of the layouts, the plan has been created for
+		size_t revision() const {return m_revision;}
+
+	///	returns if the plan can be used for a vector type
+		template <typename TVector>
+		static bool applicable()
+		{
+			return block_traits<typename TVector::value_type>::is_static;
+		}
+
+	///	adds the slave values to the master values
+	/**
+	 * The values of all slave interfaces are sent to the corresponding
+	 * masters and added there. This is the communication of
+	 * AdditiveToConsistent (first step) and of AdditiveToUnique.
+	 *
+	 * \param[in,out]	v				vector (process-local part)
+	 * \param[in]		bSetSlavesZero	if true, the slave values are set to zero
+	 */
+		template <typename TVector>
+		void add_slave_to_master(TVector& v, bool bSetSlavesZero)
+		{
+			begin_add_slave_to_master(v, bSetSlavesZero);
+			end_add_slave_to_master(v);
+		}
+
+	///	copies the master values to the slaves
+	/**
+	 * The values of all master interfaces are sent to the corresponding
+	 * slaves and replace the values there. This is the communication of
+	 * UniqueToConsistent and of AdditiveToConsistent (second step).
+	 *
+	 * \param[in,out]	v		vector (process-local part)
+	 */
+		template <typename TVector>
+		void copy_master_to_slave(TVector& v)
+		{
+			begin_copy_master_to_slave(v);
+			end_copy_master_to_slave(v);
+		}
+
+	///	split-phase version of add_slave_to_master
+	/**
+	 * begin_* collects the slave values and starts the messages, end_* waits
+	 * for the messages and adds the received values to the masters. In between,
+	 * the values of the vector at non-interface indices can be computed and the
+	 * interface values can be read, but the interface values must not be
+	 * modified. Only one exchange per entry size can be pending at a time.
+	 */
+	/// \{
+		template <typename TVector>
+		void begin_add_slave_to_master(TVector& v, bool bSetSlavesZero);
+
+		template <typename TVector>
+		void end_add_slave_to_master(TVector& v);
+	/// \}
+
+	///	split-phase version of copy_master_to_slave (see begin_add_slave_to_master)
+	/// \{
+		template <typename TVector>
+		void begin_copy_master_to_slave(TVector& v);
+
+		template <typename TVector>
+		void end_copy_master_to_slave(TVector& v);
+	/// \}
+
+	///	returns if an exchange has been started but not finished
+		bool pending() const;
+
+	///	sorted indices of all master and slave interfaces (without duplicates)
+		const std::vector<size_t>& interface_indices() const {return m_vInterfaceIndex;}
+
+	///	returns if an index is part of a master or slave interface
+		bool is_interface(size_t i) const
+		{
+			return i < m_vIsInterface.size() && m_vIsInterface[i];
+		}
+
+	protected:
+	///	flat interfaces of a layout
+		struct FlatLayout
+		{
+		///	neighbor processes
+			std::vector<int> vProc;
+
+		///	indices of the interface to vProc[i] are vIndex[vOffset[i]...vOffset[i+1]-1]
+			std::vector<size_t> vOffset;
+
+		///	indices of all interfaces
+			std::vector<size_t> vIndex;
+		};
+
+	///	buffers and persistent requests for one entry size
+		struct Channel
+		{
+			Channel() : entrySize(0), pPending(NULL) {}
+
+		///	entry size (in bytes)
+			size_t entrySize;
+
+		///	buffers for the values of all master and slave interfaces
+			std::vector<char> vMasterBuffer, vSlaveBuffer;
+
+		///	persistent requests for slave -> master and master -> slave
+			std::vector<MPI_Request> vSlaveToMaster, vMasterToSlave;
+
+		///	requests of the pending exchange (or NULL)
+			std::vector<MPI_Request>* pPending;
+
+			char* master_buffer()	{return vMasterBuffer.empty() ? NULL : &vMasterBuffer[0];}
+			char* slave_buffer()	{return vSlaveBuffer.empty() ? NULL : &vSlaveBuffer[0];}
+		};
+
+	///	fills the flat layout
+		static void flatten(FlatLayout& flat, const IndexLayout& layout);
+
+	///	returns the channel for an entry size (created on first use)
+		Channel& channel(size_t entrySize);
+
+	///	frees the persistent requests of a channel
+		static void free_requests(Channel& ch);
+
+	///	starts the requests
+		static void start(Channel& ch, std::vector<MPI_Request>& vRequest);
+
+	///	waits for the completion of the started requests
+		static void wait(Channel& ch, std::vector<MPI_Request>& vRequest);
+
+	protected:
+	///	revision of the layouts
+		size_t m_revision;
+
+	///	master and slave interfaces
+		FlatLayout m_master, m_slave;
+
+	///	buffers and requests per entry size
+		std::map<size_t, Channel> m_mChannel;
+
+	///	interface indices and flag per index
+		std::vector<size_t> m_vInterfaceIndex;
+		std::vector<bool> m_vIsInterface;
+
+	private:
+		VectorExchangePlan(const VectorExchangePlan&);
+		VectorExchangePlan& operator=(const VectorExchangePlan&);
+};
+
+
+template <typename TVector>
+void VectorExchangePlan::begin_add_slave_to_master(TVector& v, bool bSetSlavesZero)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	typedef typename TVector::value_type value_type;
+	Channel& ch = channel(sizeof(value_type));
+	UG_COND_THROW(ch.pPending, "VectorExchangePlan: Cannot start an exchange "
+	              "while another exchange is pending.");
+
+//	gather slave values
+	value_type* sendBuf = reinterpret_cast<value_type*>(ch.slave_buffer());
+	for(size_t i = 0; i < m_slave.vIndex.size(); ++i)
+	{
+		value_type& val = v[m_slave.vIndex[i]];
+		sendBuf[i] = val;
+		if(bSetSlavesZero) val *= 0;
+	}
+
+	start(ch, ch.vSlaveToMaster);
+}
+
+template <typename TVector>
+void VectorExchangePlan::end_add_slave_to_master(TVector& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	typedef typename TVector::value_type value_type;
+	Channel& ch = channel(sizeof(value_type));
+	wait(ch, ch.vSlaveToMaster);
+
+//	add received values to masters
+	const value_type* recvBuf = reinterpret_cast<const value_type*>(ch.master_buffer());
+	for(size_t i = 0; i < m_master.vIndex.size(); ++i)
+		v[m_master.vIndex[i]] += recvBuf[i];
+}
+
+template <typename TVector>
+void VectorExchangePlan::begin_copy_master_to_slave(TVector& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	typedef typename TVector::value_type value_type;
+	Channel& ch = channel(sizeof(value_type));
+	UG_COND_THROW(ch.pPending, "VectorExchangePlan: Cannot start an exchange "
+	              "while another exchange is pending.");
+
+//	gather master values
+	value_type* sendBuf = reinterpret_cast<value_type*>(ch.master_buffer());
+	for(size_t i = 0; i < m_master.vIndex.size(); ++i)
+		sendBuf[i] = v[m_master.vIndex[i]];
+
+	start(ch, ch.vMasterToSlave);
+}
+
+template <typename TVector>
+void VectorExchangePlan::end_copy_master_to_slave(TVector& v)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	typedef typename TVector::value_type value_type;
+	Channel& ch = channel(sizeof(value_type));
+	wait(ch, ch.vMasterToSlave);
+
+//	copy received values to slaves
+	const value_type* recvBuf = reinterpret_cast<const value_type*>(ch.slave_buffer());
+	for(size_t i = 0; i < m_slave.vIndex.size(); ++i)
+		v[m_slave.vIndex[i]] = recvBuf[i];
+}
+
+} // end namespace ug
+
+#endif /* UG_PARALLEL */
+
+#endif /* __H__UG4__LIB_ALGEBRA__PARALLELIZATION__VECTOR_EXCHANGE_PLAN__ */
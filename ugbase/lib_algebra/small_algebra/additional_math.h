@@ -146,6 +146,11 @@ inline void GetDiag(double &a, double b)
 	a = b;
 }
 
+inline void GetDiag(float &a, float b)
+{
+	a = b;
+}
+
 template<typename T1, typename T2>
 inline void GetDiag(T1 &m1, const T2 &m)
 {
@@ -170,6 +175,11 @@ inline void GetDiagSqrt(double &a, double b)
 	a = sqrt(b);
 }
 
+inline void GetDiagSqrt(float &a, float b)
+{
+	a = sqrt(b);
+}
+
 inline double EnergyProd(double v1, double M, double v2)
 {
 	return v1 * M * v2;
@@ -71,7 +71,8 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_RevCnt(this)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -1441,6 +1442,9 @@ void DoFDistribution::reinit()
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
+
+//	increase revision counter
+	++m_RevCnt;
 }
 
 
@@ -1470,6 +1474,7 @@ void DoFDistribution::reinit_layouts_and_communicator()
 
 	reinit_index_layout(layouts()->master(), INT_H_MASTER);
 	reinit_index_layout(layouts()->slave(), INT_H_SLAVE);
+	layouts()->layouts_changed();
 	reinit_index_layout(layouts()->vertical_slave(), INT_V_SLAVE);
 
 //	vertical layouts for ghosts
@@ -1762,6 +1767,9 @@ void DoFDistribution::permute_indices(const std::vector<size_t>& vNewInd)
 	reinit_layouts_and_communicator();
 #endif
 
+//	increase revision counter
+	++m_RevCnt;
+
 //	permute indices in associated vectors
 	permute_values(vNewInd);
 }
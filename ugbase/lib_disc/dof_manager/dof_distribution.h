@@ -36,6 +36,7 @@
 #include "lib_grid/tools/surface_view.h"
 #include "lib_disc/domain_traits.h"
 #include "lib_disc/common/local_algebra.h"
+#include "lib_disc/common/revision_counter.h"
 #include "dof_index_storage.h"
 #include "dof_count.h"
 
@@ -73,6 +74,14 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		///	returns grid level
 		const GridLevel& grid_level() const {return m_gridLevel;}
 
+		///	returns the revision of the index distribution
+		/**
+		 * The revision is increased whenever the indices are redistributed or
+		 * permuted. Structures depending on the indices (e.g. cached matrix
+		 * patterns) can use it to detect that they are outdated.
+		 */
+		const RevisionCounter& revision() const {return m_RevCnt;}
+
 	public:
 		template <typename TElem>
 		struct traits
@@ -485,6 +494,9 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// number of distributed indices on each subset
 		std::vector<size_t> m_vNumIndexOnSubset;
 
+		///	revision of the index distribution
+		RevisionCounter m_RevCnt;
+
 	public:
 		/// returns the connections
 		void get_connections(std::vector<std::vector<size_t> >& vvConnection) const;
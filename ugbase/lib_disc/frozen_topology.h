@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__FROZEN_TOPOLOGY__
+#define __H__UG__LIB_DISC__FROZEN_TOPOLOGY__
+
+#include <vector>
+
+#include "common/common.h"
+#include "lib_disc/domain.h"
+#include "lib_disc/domain_traits.h"
+#include "lib_disc/common/revision_counter.h"
+#include "lib_disc/dof_manager/dof_distribution.h"
+
+namespace ug{
+
+/// Read-only snapshot of the element topology of a grid level or surface view
+/**
+ * Neighborhood queries in lib_grid use the associated-element containers of
+ * the grid and virtual calls on the elements. This class copies the topology
+ * of the full-dimensional elements of a DoFDistribution (i.e. of a GridLevel,
+ * which may be a level or a SurfaceView) into flat arrays:
+ *
+ * - element -> vertex (CSR, vertex order of the reference element),
+ * - vertex -> element (CSR),
+ * - element -> neighbor element across each side of the reference element,
+ * - the vertex coordinates and, aligned with element -> vertex, the corner
+ * 	 coordinates of each element, so that corner_coords(e) can be used where
+ * 	 FillCornerCoordinates would be called.
+ *
+ * Elements are numbered subset by subset. Vertices are numbered in the order
+ * they are first met. Sides are only matched if the neighbor shares all
+ * corners of the side, i.e. across non-conforming (hanging) sides no
+ * neighbor is reported.
+ *
+ * The index of an element in the snapshot is stored in an attachment of the
+ * grid, so that index(elem) finds the element in constant time. Elements
+ * created after the snapshot has been taken have the index -1.
+ *
+ * The snapshot belongs to one revision of the DoFDistribution. update()
+ * rebuilds it if the revision has changed (e.g. after refinement or
+ * redistribution). If only the coordinates change (moving mesh),
+ * update_coordinates() is sufficient.
+ *
+ * \tparam TDomain		domain type
+ */
+template <typename TDomain>
+class FrozenTopology
+{
+	public:
+	///	dimension of the elements
+		static const int dim = TDomain::dim;
+
+	///	element type
+		typedef typename domain_traits<dim>::grid_base_object elem_type;
+
+	///	position type
+		typedef typename TDomain::position_type position_type;
+
+	public:
+	///	constructor (builds the snapshot)
+		FrozenTopology(SmartPtr<TDomain> spDomain, ConstSmartPtr<DoFDistribution> spDD);
+
+	///	destructor (detaches the element indices from the grid)
+		~FrozenTopology();
+
+	///	returns if the snapshot matches the current revision of the DoFDistribution
+		bool is_up_to_date() const {return m_revision == m_spDD->revision();}
+
+	///	rebuilds the snapshot if the DoFDistribution has changed
+	/// \returns true if the snapshot has been rebuilt
+		bool update() {if(is_up_to_date()) return false; rebuild(); return true;}
+
+	///	rebuilds the snapshot
+		void rebuild();
+
+	///	copies the current vertex coordinates into the snapshot
+		void update_coordinates();
+
+	///	the DoFDistribution the snapshot has been taken from
+		ConstSmartPtr<DoFDistribution> dof_distribution() const {return m_spDD;}
+
+	///////////////////////////////
+	//	elements
+	///////////////////////////////
+
+	///	number of elements
+		size_t num_elements() const {return m_vElem.size();}
+
+	///	number of subsets
+		int num_subsets() const {return (int)m_vSubsetOffset.size() - 1;}
+
+	///	index of the first element in subset si
+		size_t subset_begin(int si) const {return m_vSubsetOffset[si];}
+
+	///	index after the last element in subset si
+		size_t subset_end(int si) const {return m_vSubsetOffset[si+1];}
+
+	///	element with index e
+		elem_type* element(size_t e) const {return m_vElem[e];}
+
+	///	index of an element in the snapshot (-1 if not contained)
+	/// \{
+		int index(elem_type* elem) const {return m_aaElemIndex[elem];}
+		int index(GridObject* elem) const {return -1;}
+	/// \}
+
+	///	reference object id of element e
+		ReferenceObjectID roid(size_t e) const {return m_vROID[e];}
+
+	///	number of corners of element e
+		size_t num_corners(size_t e) const {return m_vElemVrtOffset[e+1] - m_vElemVrtOffset[e];}
+
+	///	vertex indices of the corners of element e
+		const size_t* corners(size_t e) const {return &m_vElemVrt[0] + m_vElemVrtOffset[e];}
+
+	///	corner coordinates of element e
+		const position_type* corner_coords(size_t e) const {return &m_vCornerCoord[0] + m_vElemVrtOffset[e];}
+
+	///	number of sides of element e
+		size_t num_sides(size_t e) const {return m_vElemSideOffset[e+1] - m_vElemSideOffset[e];}
+
+	///	neighbor elements of element e (one per side, -1 if none)
+		const int* neighbors(size_t e) const {return &m_vNeighbor[0] + m_vElemSideOffset[e];}
+
+	///////////////////////////////
+	//	vertices
+	///////////////////////////////
+
+	///	number of vertices
+		size_t num_vertices() const {return m_vVrt.size();}
+
+	///	vertex with index v
+		Vertex* vertex(size_t v) const {return m_vVrt[v];}
+
+	///	coordinates of vertex v
+		const position_type& coord(size_t v) const {return m_vCoord[v];}
+
+	///	number of elements containing vertex v
+		size_t num_vertex_elements(size_t v) const {return m_vVrtElemOffset[v+1] - m_vVrtElemOffset[v];}
+
+	///	indices of the elements containing vertex v
+		const size_t* vertex_elements(size_t v) const {return &m_vVrtElem[0] + m_vVrtElemOffset[v];}
+
+	protected:
+	///	computes vertex -> element from element -> vertex
+		void build_vertex_elements();
+
+	///	computes the neighbors across the sides of the elements
+		void build_neighbors();
+
+	protected:
+	///	domain and DoFDistribution
+		SmartPtr<TDomain> m_spDomain;
+		ConstSmartPtr<DoFDistribution> m_spDD;
+
+	///	revision of the DoFDistribution the snapshot belongs to
+		RevisionCounter m_revision;
+
+	///	index of the elements in the snapshot
+		AInt m_aElemIndex;
+		Grid::AttachmentAccessor<elem_type, AInt> m_aaElemIndex;
+
+	///	elements, their reference object ids and the first element per subset
+		std::vector<elem_type*> m_vElem;
+		std::vector<ReferenceObjectID> m_vROID;
+		std::vector<size_t> m_vSubsetOffset;
+
+	///	element -> vertex (CSR) and corner coordinates aligned to it
+		std::vector<size_t> m_vElemVrtOffset;
+		std::vector<size_t> m_vElemVrt;
+		std::vector<position_type> m_vCornerCoord;
+
+	///	element -> neighbor across side (CSR)
+		std::vector<size_t> m_vElemSideOffset;
+		std::vector<int> m_vNeighbor;
+
+	///	vertices and their coordinates
+		std::vector<Vertex*> m_vVrt;
+		std::vector<position_type> m_vCoord;
+
+	///	vertex -> element (CSR)
+		std::vector<size_t> m_vVrtElemOffset;
+		std::vector<size_t> m_vVrtElem;
+};
+
+} // end namespace ug
+
+#include "frozen_topology_impl.h"
+
+#endif /* __H__UG__LIB_DISC__FROZEN_TOPOLOGY__ */
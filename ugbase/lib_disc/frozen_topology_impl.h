@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__FROZEN_TOPOLOGY_IMPL__
+#define __H__UG__LIB_DISC__FROZEN_TOPOLOGY_IMPL__
+
+#include "frozen_topology.h"
+#include "lib_disc/reference_element/reference_element.h"
+#include "lib_grid/algorithms/attachment_util.h"
+
+namespace ug{
+
+template <typename TDomain>
+FrozenTopology<TDomain>::
+FrozenTopology(SmartPtr<TDomain> spDomain, ConstSmartPtr<DoFDistribution> spDD)
+	: m_spDomain(spDomain), m_spDD(spDD)
+{
+	UG_COND_THROW(spDomain.invalid() || spDD.invalid(),
+	              "FrozenTopology: Domain and DoFDistribution required.");
+
+//	new elements (e.g. children created by refinement) are not contained
+	MultiGrid& mg = *m_spDomain->grid();
+	mg.template attach_to_dv<elem_type>(m_aElemIndex, -1, false);
+	m_aaElemIndex.access(mg, m_aElemIndex);
+
+	rebuild();
+}
+
+template <typename TDomain>
+FrozenTopology<TDomain>::~FrozenTopology()
+{
+	m_spDomain->grid()->template detach_from<elem_type>(m_aElemIndex);
+}
+
+template <typename TDomain>
+void FrozenTopology<TDomain>::rebuild()
+{
+	PROFILE_FUNC_GROUP("discretization");
+
+	m_vElem.clear(); m_vROID.clear(); m_vElemVrt.clear(); m_vVrt.clear();
+	m_vElemVrtOffset.assign(1, 0);
+
+	const DoFDistribution& dd = *m_spDD;
+	MultiGrid& mg = *m_spDomain->grid();
+
+//	remove the elements of the previous snapshot (some may have been erased)
+	SetAttachmentValues(m_aaElemIndex, mg.template begin<elem_type>(),
+	                    mg.template end<elem_type>(), -1);
+
+//	temporary vertex numbering
+	AInt aInd;
+	mg.attach_to_vertices_dv(aInd, -1);
+	Grid::VertexAttachmentAccessor<AInt> aaInd(mg, aInd);
+
+	const int numSubset = dd.num_subsets();
+	m_vSubsetOffset.resize(numSubset + 1);
+	for(int si = 0; si < numSubset; ++si)
+	{
+		m_vSubsetOffset[si] = m_vElem.size();
+
+		typename DoFDistribution::traits<elem_type>::const_iterator iter, iterEnd;
+		iter = dd.begin<elem_type>(si);
+		iterEnd = dd.end<elem_type>(si);
+		for(; iter != iterEnd; ++iter)
+		{
+			elem_type* elem = *iter;
+			m_aaElemIndex[elem] = (int)m_vElem.size();
+			m_vElem.push_back(elem);
+			m_vROID.push_back(elem->reference_object_id());
+
+			for(size_t i = 0; i < elem->num_vertices(); ++i)
+			{
+				Vertex* vrt = elem->vertex(i);
+				int& ind = aaInd[vrt];
+				if(ind < 0){
+					ind = (int)m_vVrt.size();
+					m_vVrt.push_back(vrt);
+				}
+				m_vElemVrt.push_back(ind);
+			}
+			m_vElemVrtOffset.push_back(m_vElemVrt.size());
+		}
+	}
+	m_vSubsetOffset[numSubset] = m_vElem.size();
+
+	mg.detach_from_vertices(aInd);
+
+	build_vertex_elements();
+	build_neighbors();
+	update_coordinates();
+
+	m_revision = dd.revision();
+}
+
+template <typename TDomain>
+void FrozenTopology<TDomain>::update_coordinates()
+{
+	const typename TDomain::position_accessor_type& aaPos = m_spDomain->position_accessor();
+
+	m_vCoord.resize(m_vVrt.size());
+	for(size_t v = 0; v < m_vVrt.size(); ++v)
+		m_vCoord[v] = aaPos[m_vVrt[v]];
+
+	m_vCornerCoord.resize(m_vElemVrt.size());
+	for(size_t k = 0; k < m_vElemVrt.size(); ++k)
+		m_vCornerCoord[k] = m_vCoord[m_vElemVrt[k]];
+}
+
+template <typename TDomain>
+void FrozenTopology<TDomain>::build_vertex_elements()
+{
+//	count elements per vertex
+	m_vVrtElemOffset.assign(m_vVrt.size() + 1, 0);
+	for(size_t k = 0; k < m_vElemVrt.size(); ++k)
+		++m_vVrtElemOffset[m_vElemVrt[k] + 1];
+	for(size_t v = 0; v < m_vVrt.size(); ++v)
+		m_vVrtElemOffset[v+1] += m_vVrtElemOffset[v];
+
+//	fill (elements are ascending per vertex)
+	std::vector<size_t> vPos(m_vVrtElemOffset.begin(), m_vVrtElemOffset.end() - 1);
+	m_vVrtElem.resize(m_vElemVrt.size());
+	for(size_t e = 0; e < m_vElem.size(); ++e)
+		for(size_t k = m_vElemVrtOffset[e]; k < m_vElemVrtOffset[e+1]; ++k)
+			m_vVrtElem[vPos[m_vElemVrt[k]]++] = e;
+}
+
+template <typename TDomain>
+void FrozenTopology<TDomain>::build_neighbors()
+{
+	m_vElemSideOffset.resize(m_vElem.size() + 1);
+	m_vElemSideOffset[0] = 0;
+	for(size_t e = 0; e < m_vElem.size(); ++e)
+		m_vElemSideOffset[e+1] = m_vElemSideOffset[e]
+			+ ReferenceElementProvider::get(m_vROID[e]).num(dim-1);
+	m_vNeighbor.assign(m_vElemSideOffset.back(), -1);
+
+//	a neighbor across a side contains all corners of the side, thus it is
+//	found among the elements of the first corner
+	for(size_t e = 0; e < m_vElem.size(); ++e)
+	{
+		const ReferenceElement& rRefElem = ReferenceElementProvider::get(m_vROID[e]);
+		const size_t* vCorner = corners(e);
+
+		for(size_t s = 0; s < num_sides(e); ++s)
+		{
+			const size_t numSideCo = rRefElem.num(dim-1, s, 0);
+			const size_t v0 = vCorner[rRefElem.id(dim-1, s, 0, 0)];
+
+			for(size_t i = m_vVrtElemOffset[v0]; i < m_vVrtElemOffset[v0+1]; ++i)
+			{
+				const size_t f = m_vVrtElem[i];
+				if(f == e) continue;
+
+				const size_t* vCornerF = corners(f);
+				const size_t numCoF = num_corners(f);
+				size_t co = 1;
+				for(; co < numSideCo; ++co)
+				{
+					const size_t v = vCorner[rRefElem.id(dim-1, s, 0, co)];
+					size_t j = 0;
+					while(j < numCoF && vCornerF[j] != v) ++j;
+					if(j == numCoF) break;
+				}
+
+				if(co == numSideCo){
+					m_vNeighbor[m_vElemSideOffset[e] + s] = (int)f;
+					break;
+				}
+			}
+		}
+	}
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__FROZEN_TOPOLOGY_IMPL__ */
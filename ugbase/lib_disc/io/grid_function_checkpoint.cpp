@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "grid_function_checkpoint.h"
+
+#include <cstring>
+#include <fstream>
+
+#include "common/util/binary_buffer.h"
+#include "common/serialization.h"
+#include "common/util/vector_util.h"
+#include "common/profiler/profiler.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+	#include "pcl/parallel_file.h"
+#endif
+
+using namespace std;
+
+namespace ug{
+
+static const char CHECKPOINT_MAGIC[8] = {'U','G','C','H','K','P','T','1'};
+
+///	size of a record in the file
+static size_t CheckpointRecordSize(int dim)
+{
+	return dim * sizeof(double) + sizeof(uint32) + sizeof(double);
+}
+
+static void PackCheckpointRecord(char* p, const CheckpointRecord& rec, int dim)
+{
+	for(int d = 0; d < dim; ++d){
+		const double x = rec.x[d];
+		memcpy(p, &x, sizeof(double)); p += sizeof(double);
+	}
+	memcpy(p, &rec.id, sizeof(uint32)); p += sizeof(uint32);
+	const double value = rec.value;
+	memcpy(p, &value, sizeof(double));
+}
+
+static void UnpackCheckpointRecord(const char* p, CheckpointRecord& rec, int dim)
+{
+	for(int d = 0; d < 3; ++d) rec.x[d] = 0.0;
+	for(int d = 0; d < dim; ++d){
+		double x;
+		memcpy(&x, p, sizeof(double)); p += sizeof(double);
+		rec.x[d] = x;
+	}
+	memcpy(&rec.id, p, sizeof(uint32)); p += sizeof(uint32);
+	double value;
+	memcpy(&value, p, sizeof(double));
+	rec.value = value;
+}
+
+///	writes the header of a checkpoint file to a buffer
+static void CheckpointHeader(vector<char>& header, int dim,
+                             const vector<string>& vFctName, uint64 numRecords)
+{
+	BinaryBuffer buf;
+	buf.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+	Serialize(buf, (int) dim);
+	Serialize(buf, (int) vFctName.size());
+	for(size_t i = 0; i < vFctName.size(); ++i)
+		Serialize(buf, vFctName[i]);
+	Serialize(buf, numRecords);
+	header.assign(buf.buffer(), buf.buffer() + buf.write_pos());
+}
+
+///	reads the header of a checkpoint file
+/**	In parallel, the header is read by the first process and broadcasted.*/
+static void ReadCheckpointHeader(const string& filename, int& dim,
+                                 vector<string>& vFctName, uint64& numRecords,
+                                 size_t& headerSize)
+{
+	BinaryBuffer buf;
+	bool bRead = true;
+#ifdef UG_PARALLEL
+	bRead = (pcl::ProcRank() == 0);
+#endif
+	if(bRead){
+	//	the header is small, read the beginning of the file
+		ifstream in(filename.c_str(), ios::binary);
+		UG_COND_THROW(!in, "Checkpoint: Cannot open file '" << filename << "'.");
+		vector<char> vData(1 << 16);
+		in.read(&vData[0], vData.size());
+		buf.write(&vData[0], in.gcount());
+	}
+#ifdef UG_PARALLEL
+	pcl::ProcessCommunicator().broadcast(buf, 0);
+#endif
+
+	char magic[sizeof(CHECKPOINT_MAGIC)];
+	UG_COND_THROW(buf.write_pos() < sizeof(magic), "Checkpoint: '" << filename
+				  << "' is not a checkpoint file.");
+	buf.read(magic, sizeof(magic));
+	UG_COND_THROW(memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0,
+				  "Checkpoint: '" << filename << "' is not a checkpoint file.");
+
+	int numFct;
+	Deserialize(buf, dim);
+	Deserialize(buf, numFct);
+	vFctName.resize(numFct);
+	for(int i = 0; i < numFct; ++i)
+		Deserialize(buf, vFctName[i]);
+	Deserialize(buf, numRecords);
+	headerSize = buf.read_pos();
+}
+
+void ReadCheckpointHeader(const std::string& filename, int& dim,
+                          std::vector<std::string>& vFctName)
+{
+	uint64 numRecords;
+	size_t headerSize;
+	ReadCheckpointHeader(filename, dim, vFctName, numRecords, headerSize);
+}
+
+#ifdef UG_PARALLEL
+///	returns the write of the last (asynchronous) checkpoint
+/**	The object is never destroyed, since completing a write requires MPI.*/
+static pcl::OrderedParallelFileWrite& CheckpointWrite()
+{
+	static pcl::OrderedParallelFileWrite* pWrite = new pcl::OrderedParallelFileWrite;
+	return *pWrite;
+}
+#endif
+
+void WaitForCheckpoint()
+{
+#ifdef UG_PARALLEL
+	CheckpointWrite().wait();
+#endif
+}
+
+void WriteCheckpointFile(const std::string& filename, int dim,
+                         const std::vector<std::string>& vFctName,
+                         std::vector<CheckpointRecord>& vRecord, bool bAsync)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+
+	uint64 numRecords = vRecord.size();
+#ifdef UG_PARALLEL
+	numRecords = pcl::ProcessCommunicator().allreduce((size_t) numRecords, PCL_RO_SUM);
+#endif
+
+	vector<char> header;
+	CheckpointHeader(header, dim, vFctName, numRecords);
+
+	const size_t recSize = CheckpointRecordSize(dim);
+	vector<char> data(vRecord.size() * recSize);
+	for(size_t i = 0; i < vRecord.size(); ++i)
+		PackCheckpointRecord(&data[i * recSize], vRecord[i], dim);
+
+#ifdef UG_PARALLEL
+	pcl::OrderedParallelFileWrite& write = CheckpointWrite();
+	write.wait();
+	write.start(header, data, filename);
+	if(!bAsync) write.wait();
+#else
+//	in serial, the file is always written directly
+	ofstream out(filename.c_str(), ios::binary | ios::trunc);
+	UG_COND_THROW(!out, "Checkpoint: Cannot open file '" << filename << "'.");
+	out.write(&header[0], header.size());
+	if(!data.empty()) out.write(&data[0], data.size());
+	UG_COND_THROW(!out, "Checkpoint: Cannot write to file '" << filename << "'.");
+#endif
+}
+
+///	marks a key that has not been found in the checkpoint
+static const uint32 CHECKPOINT_MISSING = 0xFFFFFFFF;
+
+///	looks up the values of the requested keys in sorted records
+static void MatchCheckpointRecords(const vector<CheckpointRecord>& vSorted,
+                                   vector<CheckpointRecord>& vRequest)
+{
+	for(size_t i = 0; i < vRequest.size(); ++i)
+	{
+		vector<CheckpointRecord>::const_iterator it
+			= lower_bound(vSorted.begin(), vSorted.end(), vRequest[i]);
+		if(it != vSorted.end() && it->same_key(vRequest[i]))
+			vRequest[i].value = it->value;
+		else
+			vRequest[i].id = CHECKPOINT_MISSING;
+	}
+}
+
+#ifdef UG_PARALLEL
+///	returns the process responsible for a key
+static int CheckpointDirectoryProc(const CheckpointRecord& rec, int numProcs)
+{
+	uint64 h = rec.id;
+	for(int d = 0; d < 3; ++d){
+		uint64 bits;
+		const double x = rec.x[d];
+		memcpy(&bits, &x, sizeof(uint64));
+		h ^= bits + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+	}
+	h ^= h >> 33; h *= 0xff51afd7ed558ccdULL; h ^= h >> 33;
+	return (int)(h % numProcs);
+}
+
+///	sends the i'th vector of records to process i
+/**	The received records are concatenated in the order of the sending
+ *	processes, the number of records received from each process is written
+ *	to vRecvCnt.*/
+static void ExchangeCheckpointRecords(const vector<vector<CheckpointRecord> >& vvSend,
+                                      vector<CheckpointRecord>& vRecv,
+                                      vector<int>& vRecvCnt)
+{
+	pcl::ProcessCommunicator pc;
+	const int numProcs = pcl::NumProcs();
+	const int recSize = sizeof(CheckpointRecord);
+
+	vector<int> vSendCnt(numProcs);
+	for(int p = 0; p < numProcs; ++p)
+		vSendCnt[p] = (int) vvSend[p].size();
+	vRecvCnt.resize(numProcs);
+	pc.alltoall(&vSendCnt[0], 1, PCL_DT_INT, &vRecvCnt[0], 1, PCL_DT_INT);
+
+	vector<int> vSendTo, vSendSize, vRecvFrom, vRecvSize;
+	vector<CheckpointRecord> vSend;
+	size_t numRecv = 0;
+	for(int p = 0; p < numProcs; ++p){
+		if(vSendCnt[p] > 0){
+			vSendTo.push_back(p);
+			vSendSize.push_back(vSendCnt[p] * recSize);
+			vSend.insert(vSend.end(), vvSend[p].begin(), vvSend[p].end());
+		}
+		if(vRecvCnt[p] > 0){
+			vRecvFrom.push_back(p);
+			vRecvSize.push_back(vRecvCnt[p] * recSize);
+			numRecv += vRecvCnt[p];
+		}
+	}
+
+	vRecv.resize(numRecv);
+	pc.distribute_data(GetDataPtr(vRecv), GetDataPtr(vRecvSize),
+	                   GetDataPtr(vRecvFrom), (int) vRecvFrom.size(),
+	                   GetDataPtr(vSend), GetDataPtr(vSendSize),
+	                   GetDataPtr(vSendTo), (int) vSendTo.size(), 5471);
+}
+#endif
+
+void ReadCheckpointFile(const std::string& filename,
+                        std::vector<CheckpointRecord>& vRequest)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+
+//	the file may still be written
+	WaitForCheckpoint();
+
+	int dim;
+	vector<string> vFctName;
+	uint64 numRecords;
+	size_t headerSize;
+	ReadCheckpointHeader(filename, dim, vFctName, numRecords, headerSize);
+	const size_t recSize = CheckpointRecordSize(dim);
+
+//	part of the file read by this process
+	uint64 first = 0, last = numRecords;
+#ifdef UG_PARALLEL
+	const int rank = pcl::ProcRank(), numProcs = pcl::NumProcs();
+	first = numRecords * rank / numProcs;
+	last = numRecords * (rank + 1) / numProcs;
+#endif
+
+	vector<char> data;
+#ifdef UG_PARALLEL
+	pcl::ReadParallelFileRange(data, headerSize + first * recSize,
+	                           (last - first) * recSize, filename);
+#else
+	{
+		ifstream in(filename.c_str(), ios::binary);
+		UG_COND_THROW(!in, "Checkpoint: Cannot open file '" << filename << "'.");
+		in.seekg(headerSize);
+		data.resize(numRecords * recSize);
+		if(!data.empty()) in.read(&data[0], data.size());
+		UG_COND_THROW(!in, "Checkpoint: Cannot read file '" << filename << "'.");
+	}
+#endif
+
+	vector<CheckpointRecord> vRecord(last - first);
+	for(size_t i = 0; i < vRecord.size(); ++i)
+		UnpackCheckpointRecord(&data[i * recSize], vRecord[i], dim);
+	vector<char>().swap(data);
+
+#ifdef UG_PARALLEL
+//	send the records to the process responsible for their keys
+	vector<int> vRecvCnt;
+	{
+		vector<vector<CheckpointRecord> > vvSend(numProcs);
+		for(size_t i = 0; i < vRecord.size(); ++i)
+			vvSend[CheckpointDirectoryProc(vRecord[i], numProcs)].push_back(vRecord[i]);
+		vector<CheckpointRecord>().swap(vRecord);
+		ExchangeCheckpointRecords(vvSend, vRecord, vRecvCnt);
+	}
+	sort(vRecord.begin(), vRecord.end());
+
+//	send the requests to the same processes
+	vector<vector<CheckpointRecord> > vvRequest(numProcs);
+	vector<vector<size_t> > vvRequestPos(numProcs);
+	for(size_t i = 0; i < vRequest.size(); ++i){
+		const int p = CheckpointDirectoryProc(vRequest[i], numProcs);
+		vvRequest[p].push_back(vRequest[i]);
+		vvRequestPos[p].push_back(i);
+	}
+	vector<CheckpointRecord> vRecvRequest;
+	ExchangeCheckpointRecords(vvRequest, vRecvRequest, vRecvCnt);
+
+//	answer the requests in the order they have been received
+	MatchCheckpointRecords(vRecord, vRecvRequest);
+	vector<vector<CheckpointRecord> > vvAnswer(numProcs);
+	for(int p = 0, pos = 0; p < numProcs; ++p){
+		vvAnswer[p].assign(vRecvRequest.begin() + pos,
+		                   vRecvRequest.begin() + pos + vRecvCnt[p]);
+		pos += vRecvCnt[p];
+	}
+	vector<CheckpointRecord> vAnswer;
+	ExchangeCheckpointRecords(vvAnswer, vAnswer, vRecvCnt);
+
+	for(int p = 0, pos = 0; p < numProcs; ++p)
+		for(size_t j = 0; j < vvRequestPos[p].size(); ++j, ++pos)
+			vRequest[vvRequestPos[p][j]] = vAnswer[pos];
+#else
+	sort(vRecord.begin(), vRecord.end());
+	MatchCheckpointRecords(vRecord, vRequest);
+#endif
+
+//	check that all DoFs have been found
+	size_t numMissing = 0;
+	for(size_t i = 0; i < vRequest.size(); ++i)
+		if(vRequest[i].id == CHECKPOINT_MISSING) ++numMissing;
+#ifdef UG_PARALLEL
+	numMissing = pcl::ProcessCommunicator().allreduce(numMissing, PCL_RO_SUM);
+#endif
+	UG_COND_THROW(numMissing > 0, "Checkpoint: " << numMissing << " DoFs not found in '"
+				  << filename << "'. The checkpoint must be written on the same grid.");
+}
+
+} // end namespace ug
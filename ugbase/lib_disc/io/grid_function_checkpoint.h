@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__GRID_FUNCTION_CHECKPOINT__
+#define __H__UG__LIB_DISC__IO__GRID_FUNCTION_CHECKPOINT__
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "common/common.h"
+#include "common/util/string_util.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/common/function_group.h"
+#include "lib_disc/common/multi_index.h"
+#include "lib_disc/dof_manager/dof_distribution.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	a degree of freedom in a checkpoint file
+/**
+ * DoFs are identified independently of the partition of the grid: The key
+ * of a DoF consists of the center of the geometric object it is located on
+ * (computed from the lexicographically sorted corners, thus independent of
+ * the order of the corners), the base object type, the function and the
+ * number of the DoF among the inner DoFs of the function on the object.
+ */
+struct CheckpointRecord
+{
+	number x[3];		///< center of the geometric object
+	uint32 id;			///< fct << 16 | base object id << 12 | dof on object
+	number value;		///< value of the DoF
+
+	static uint32 make_id(size_t fct, int gbo, size_t dof)
+	{
+		UG_COND_THROW(fct >= (1 << 16) || dof >= (1 << 12),
+					  "Checkpoint: too many functions or DoFs per object.");
+		return (uint32)((fct << 16) | (gbo << 12) | dof);
+	}
+	size_t fct() const {return id >> 16;}
+
+	bool operator<(const CheckpointRecord& r) const
+	{
+		for(int d = 0; d < 3; ++d){
+			if(x[d] < r.x[d]) return true;
+			if(r.x[d] < x[d]) return false;
+		}
+		return id < r.id;
+	}
+	bool same_key(const CheckpointRecord& r) const
+	{
+		return x[0] == r.x[0] && x[1] == r.x[1] && x[2] == r.x[2] && id == r.id;
+	}
+};
+
+///	writes the records of all processes into one checkpoint file (collective)
+/**
+ * The file consists of a header (dimension and function names) followed by
+ * the records of all processes, written collectively by MPI-IO in parallel.
+ * If bAsync is true, the write is only started and completed by the next
+ * checkpoint operation or WaitForCheckpoint().
+ */
+void WriteCheckpointFile(const std::string& filename, int dim,
+                         const std::vector<std::string>& vFctName,
+                         std::vector<CheckpointRecord>& vRecord, bool bAsync);
+
+///	returns the function names stored in a checkpoint file
+void ReadCheckpointHeader(const std::string& filename, int& dim,
+                          std::vector<std::string>& vFctName);
+
+///	reads the values of the requested DoFs from a checkpoint file (collective)
+/**
+ * In parallel, each process reads an equal part of the file and sends the
+ * records to the process responsible for the hash of their key, to which
+ * all processes send their requested keys as well. Thus, the file can be
+ * read on any number of processes.
+ *
+ * \param[in,out]	vRequest	keys of the requested DoFs, the value is set
+ */
+void ReadCheckpointFile(const std::string& filename,
+                        std::vector<CheckpointRecord>& vRequest);
+
+///	waits until the last asynchronously written checkpoint is completed (collective)
+void WaitForCheckpoint();
+
+///	collects the keys (and values) of the DoFs of some functions of a grid function
+/**
+ * \param[in]	u			grid function
+ * \param[in]	vFct		functions of u to collect
+ * \param[in]	vFileFct	index of the functions in the file
+ * \param[in]	vOwned		flags for owned indices, others are skipped (empty: all)
+ * \param[out]	vRecord		records (with values)
+ * \param[out]	vIndex		DoF index of the records
+ */
+template <typename TGridFunction, typename TBaseElem>
+void CollectCheckpointRecords(const TGridFunction& u,
+                              const std::vector<size_t>& vFct,
+                              const std::vector<size_t>& vFileFct,
+                              const std::vector<bool>& vOwned,
+                              std::vector<CheckpointRecord>& vRecord,
+                              std::vector<DoFIndex>& vIndex)
+{
+	typedef typename TGridFunction::domain_type domain_type;
+	static const int dim = domain_type::dim;
+
+	ConstSmartPtr<DoFDistribution> dd = u.dd();
+	const domain_type& domain = *u.domain();
+
+	std::vector<MathVector<dim> > vCorner;
+	std::vector<DoFIndex> vInd;
+	CheckpointRecord rec;
+
+	for(int si = 0; si < dd->num_subsets(); ++si)
+	{
+		typename DoFDistribution::traits<TBaseElem>::const_iterator iter, iterEnd;
+		iter = dd->template begin<TBaseElem>(si);
+		iterEnd = dd->template end<TBaseElem>(si);
+
+		for(; iter != iterEnd; ++iter)
+		{
+			TBaseElem* elem = *iter;
+			bool bCenter = false;
+
+			for(size_t i = 0; i < vFct.size(); ++i)
+			{
+				if(!dd->is_def_in_subset(vFct[i], si)) continue;
+				dd->inner_dof_indices(elem, vFct[i], vInd);
+				if(vInd.empty()) continue;
+
+			//	center, independent of the order of the corners
+				if(!bCenter){
+					CollectCornerCoordinates(vCorner, *elem, domain);
+					std::sort(vCorner.begin(), vCorner.end(),
+						[](const MathVector<dim>& a, const MathVector<dim>& b){
+							for(int d = 0; d < dim; ++d){
+								if(a[d] < b[d]) return true;
+								if(b[d] < a[d]) return false;
+							}
+							return false;
+						});
+					for(int d = 0; d < 3; ++d) rec.x[d] = 0.0;
+					for(size_t c = 0; c < vCorner.size(); ++c)
+						for(int d = 0; d < dim; ++d)
+							rec.x[d] += vCorner[c][d];
+					for(int d = 0; d < dim; ++d) rec.x[d] /= vCorner.size();
+					bCenter = true;
+				}
+
+				for(size_t k = 0; k < vInd.size(); ++k)
+				{
+					if(!vOwned.empty() && !vOwned[vInd[k][0]]) continue;
+					rec.id = CheckpointRecord::make_id(vFileFct[i],
+									geometry_traits<TBaseElem>::BASE_OBJECT_ID, k);
+					rec.value = DoFRef(u, vInd[k]);
+					vRecord.push_back(rec);
+					vIndex.push_back(vInd[k]);
+				}
+			}
+		}
+	}
+}
+
+///	collects the records for all base object types
+template <typename TGridFunction>
+void CollectCheckpointRecords(const TGridFunction& u,
+                              const std::vector<size_t>& vFct,
+                              const std::vector<size_t>& vFileFct,
+                              const std::vector<bool>& vOwned,
+                              std::vector<CheckpointRecord>& vRecord,
+                              std::vector<DoFIndex>& vIndex)
+{
+	static const int dim = TGridFunction::domain_type::dim;
+	ConstSmartPtr<DoFDistribution> dd = u.dd();
+
+	if(dd->max_dofs(VERTEX))
+		CollectCheckpointRecords<TGridFunction, Vertex>(u, vFct, vFileFct, vOwned, vRecord, vIndex);
+	if(dd->max_dofs(EDGE))
+		CollectCheckpointRecords<TGridFunction, Edge>(u, vFct, vFileFct, vOwned, vRecord, vIndex);
+	if(dim >= 2 && dd->max_dofs(FACE))
+		CollectCheckpointRecords<TGridFunction, Face>(u, vFct, vFileFct, vOwned, vRecord, vIndex);
+	if(dim >= 3 && dd->max_dofs(VOLUME))
+		CollectCheckpointRecords<TGridFunction, Volume>(u, vFct, vFileFct, vOwned, vRecord, vIndex);
+}
+
+///	saves (some functions of) a grid function to a checkpoint file
+/**
+ * All processes write into one binary file. The DoFs are identified by
+ * their location (see CheckpointRecord), so the checkpoint can be loaded
+ * on a different number of processes and a different partition of the
+ * same grid.
+ *
+ * Incremental checkpoints: If only some fields changed since the last
+ * checkpoint, pass these functions in 'fcts'. LoadCheckpoint only overwrites
+ * the functions stored in a file, so loading the full checkpoint followed
+ * by the incremental ones restores the state.
+ *
+ * \param[in]	u			grid function (changed to consistent storage in parallel)
+ * \param[in]	filename	file name
+ * \param[in]	fcts		functions to save (comma separated, empty: all)
+ * \param[in]	bAsync		return before the data is written
+ */
+template <typename TGridFunction>
+void SaveCheckpoint(TGridFunction& u, const char* filename,
+                    const char* fcts = "", bool bAsync = false)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+
+	FunctionGroup fctGrp(u.function_pattern());
+	if(std::string(fcts).empty()) fctGrp.add_all();
+	else fctGrp = u.fct_grp_by_name(fcts);
+
+	std::vector<size_t> vFct, vFileFct;
+	std::vector<std::string> vFctName;
+	for(size_t i = 0; i < fctGrp.size(); ++i){
+		vFct.push_back(fctGrp[i]);
+		vFileFct.push_back(i);
+		vFctName.push_back(u.name(fctGrp[i]));
+	}
+
+	std::vector<bool> vOwned;
+#ifdef UG_PARALLEL
+	if(!u.has_storage_type(PST_CONSISTENT))
+		UG_COND_THROW(!u.change_storage_type(PST_CONSISTENT),
+					  "SaveCheckpoint: Cannot change storage type to consistent.");
+
+	vOwned.resize(u.size(), true);
+	const IndexLayout& slaveLayout = u.layouts()->slave();
+	for(IndexLayout::const_iterator iter = slaveLayout.begin();
+			iter != slaveLayout.end(); ++iter)
+	{
+		const IndexLayout::Interface& itfc = slaveLayout.interface(iter);
+		for(IndexLayout::Interface::const_iterator iiter = itfc.begin();
+				iiter != itfc.end(); ++iiter)
+			vOwned[itfc.get_element(iiter)] = false;
+	}
+#endif
+
+	std::vector<CheckpointRecord> vRecord;
+	std::vector<DoFIndex> vIndex;
+	CollectCheckpointRecords(u, vFct, vFileFct, vOwned, vRecord, vIndex);
+
+	WriteCheckpointFile(filename, TGridFunction::domain_type::dim, vFctName, vRecord, bAsync);
+}
+
+///	loads the functions stored in a checkpoint file into a grid function
+/**
+ * Only the functions contained in the file are overwritten (matched by name).
+ * The grid must be the same as when the checkpoint was written, but may be
+ * distributed differently.
+ */
+template <typename TGridFunction>
+void LoadCheckpoint(TGridFunction& u, const char* filename)
+{
+	PROFILE_FUNC_GROUP("checkpoint");
+
+	int dim;
+	std::vector<std::string> vFctName;
+	ReadCheckpointHeader(filename, dim, vFctName);
+	UG_COND_THROW(dim != TGridFunction::domain_type::dim,
+				  "LoadCheckpoint: Checkpoint '" << filename << "' has dimension "
+				  << dim << ", but grid function has dimension "
+				  << TGridFunction::domain_type::dim);
+
+	std::vector<size_t> vFct, vFileFct;
+	for(size_t i = 0; i < vFctName.size(); ++i){
+		vFct.push_back(u.fct_id_by_name(vFctName[i].c_str()));
+		vFileFct.push_back(i);
+	}
+
+#ifdef UG_PARALLEL
+//	a partial load keeps the other functions, which must be consistent
+	if(vFct.size() < u.num_fct() && !u.has_storage_type(PST_CONSISTENT))
+		UG_COND_THROW(!u.change_storage_type(PST_CONSISTENT),
+					  "LoadCheckpoint: Cannot change storage type to consistent.");
+#endif
+
+	std::vector<CheckpointRecord> vRecord;
+	std::vector<DoFIndex> vIndex;
+	CollectCheckpointRecords(u, vFct, vFileFct, std::vector<bool>(), vRecord, vIndex);
+
+	ReadCheckpointFile(filename, vRecord);
+
+	for(size_t i = 0; i < vRecord.size(); ++i)
+		DoFRef(u, vIndex[i]) = vRecord[i].value;
+
+#ifdef UG_PARALLEL
+	u.set_storage_type(PST_CONSISTENT);
+#endif
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__GRID_FUNCTION_CHECKPOINT__ */
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "vtk_file_writer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef UG_ZLIB
+	#include <zlib.h>
+#endif
+#ifdef UG_LZ4
+	#include <lz4.h>
+#endif
+
+#include "common/error.h"
+#include "common/log.h"
+#include "common/types.h"
+#include "common/util/string_util.h"
+#include "common/profiler/profiler.h"
+#include "common/serialization.h"
+#include "common/util/vector_util.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl.h"
+#endif
+
+using namespace std;
+
+namespace ug{
+
+VTKCompression GetVTKCompression(const std::string& name)
+{
+	const string lname = ToLower(name);
+	if(lname == "none" || lname.empty()) return VTK_COMPRESSION_NONE;
+	if(lname == "zlib"){
+	#ifndef UG_ZLIB
+		UG_THROW("VTK: zlib compression requested, but ug4 has been compiled "
+				 "without zlib. Use 'cmake -DUSE_ZLIB=ON'.");
+	#endif
+		return VTK_COMPRESSION_ZLIB;
+	}
+	if(lname == "lz4"){
+	#ifndef UG_LZ4
+		UG_THROW("VTK: lz4 compression requested, but ug4 has been compiled "
+				 "without lz4. Use 'cmake -DUSE_LZ4=ON'.");
+	#endif
+		return VTK_COMPRESSION_LZ4;
+	}
+	UG_THROW("VTK: Unknown compression '" << name << "'. Use 'none', 'zlib' or 'lz4'.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Encoding of appended data
+////////////////////////////////////////////////////////////////////////////////
+
+///	appends the bytes of a value to a buffer
+template <typename T>
+static inline void AppendBytes(vector<char>& buf, const T& value)
+{
+	const char* p = reinterpret_cast<const char*>(&value);
+	buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+///	compresses a single block, returns the compressed size
+static size_t CompressVTKBlock(vector<char>& out, const char* src, size_t size,
+                               const VTKFileSettings& settings)
+{
+	switch(settings.compression)
+	{
+		case VTK_COMPRESSION_ZLIB:
+		{
+		#ifdef UG_ZLIB
+			const size_t pos = out.size();
+			uLongf destLen = compressBound((uLong) size);
+			out.resize(pos + destLen);
+			const int level = (settings.compressionLevel < 0) ?
+								Z_DEFAULT_COMPRESSION : settings.compressionLevel;
+			if(compress2((Bytef*)&out[pos], &destLen, (const Bytef*)src,
+						 (uLong)size, level) != Z_OK)
+				UG_THROW("VTK: zlib compression failed.");
+			out.resize(pos + destLen);
+			return destLen;
+		#else
+			UG_THROW("VTK: ug4 has been compiled without zlib.");
+		#endif
+		}
+		case VTK_COMPRESSION_LZ4:
+		{
+		#ifdef UG_LZ4
+			const size_t pos = out.size();
+			const int bound = LZ4_compressBound((int) size);
+			out.resize(pos + bound);
+			const int destLen = LZ4_compress_default(src, &out[pos], (int) size, bound);
+			UG_COND_THROW(destLen <= 0, "VTK: lz4 compression failed.");
+			out.resize(pos + destLen);
+			return destLen;
+		#else
+			UG_THROW("VTK: ug4 has been compiled without lz4.");
+		#endif
+		}
+		default:
+			UG_THROW("VTK: Compression not supported.");
+	}
+}
+
+///	encodes a data block as required for raw appended data
+/**
+ * Uncompressed: UInt32 number of bytes, followed by the data.
+ * Compressed:	UInt32 header [number of blocks, block size, size of last
+ * 				partial block (0 if the last block is full), compressed sizes],
+ * 				followed by the compressed blocks.
+ */
+static void EncodeVTKBlock(vector<char>& out, const vector<char>& data,
+                           const VTKFileSettings& settings)
+{
+	const size_t size = data.size();
+	if(settings.compression == VTK_COMPRESSION_NONE){
+		AppendBytes(out, (uint32) size);
+		out.insert(out.end(), data.begin(), data.end());
+		return;
+	}
+
+	const size_t blockSize = settings.blockSize;
+	const size_t lastBlockSize = size % blockSize;
+	const size_t numBlocks = size / blockSize + (lastBlockSize ? 1 : 0);
+
+	const size_t headerPos = out.size();
+	AppendBytes(out, (uint32) numBlocks);
+	AppendBytes(out, (uint32) blockSize);
+	AppendBytes(out, (uint32) lastBlockSize);
+	out.resize(out.size() + numBlocks * sizeof(uint32));
+
+	for(size_t b = 0; b < numBlocks; ++b)
+	{
+		const size_t first = b * blockSize;
+		const size_t num = min(blockSize, size - first);
+		const uint32 compSize = (uint32) CompressVTKBlock(out, &data[first], num, settings);
+		memcpy(&out[headerPos + (3 + b) * sizeof(uint32)], &compSize, sizeof(uint32));
+	}
+}
+
+void VTKFileWriter::AppendedFile::write() const
+{
+	PROFILE_FUNC_GROUP("vtk");
+
+//	encode the blocks
+	vector<char> appended;
+	vector<size_t> vOffset(vBlock.size());
+	for(size_t i = 0; i < vBlock.size(); ++i){
+		vOffset[i] = appended.size();
+		EncodeVTKBlock(appended, vBlock[i].data, settings);
+	}
+
+	ofstream out(filename.c_str(), ios::binary | ios::trunc);
+	UG_COND_THROW(!out, "Could not open output file: " << filename);
+
+	static const string binaryFormat = "format=\"binary\"";
+	const size_t rootPos = xml.find("<VTKFile ");
+	const size_t endPos = xml.rfind("</VTKFile>");
+	UG_COND_THROW(rootPos == string::npos || endPos == string::npos,
+				  "VTK: No VTKFile element found in " << filename);
+
+//	write xml, announce compressor and replace the inline formats by offsets
+	size_t pos = 0;
+	out.write(xml.data(), rootPos + 8);
+	pos = rootPos + 8;
+	if(!vBlock.empty()){
+		if(settings.compression == VTK_COMPRESSION_ZLIB)
+			out << " compressor=\"vtkZLibDataCompressor\"";
+		else if(settings.compression == VTK_COMPRESSION_LZ4)
+			out << " compressor=\"vtkLZ4DataCompressor\"";
+	}
+
+	for(size_t i = 0; i < vBlock.size(); ++i){
+		out.write(xml.data() + pos, vBlock[i].xmlPos - pos);
+		out << "format=\"appended\" offset=\"" << vOffset[i] << "\"";
+		pos = vBlock[i].xmlPos + binaryFormat.size();
+	}
+	out.write(xml.data() + pos, endPos - pos);
+
+//	write the appended data
+	if(!vBlock.empty()){
+		out << "  <AppendedData encoding=\"raw\">\n   _";
+		out.write(&appended[0], appended.size());
+		out << "\n  </AppendedData>\n";
+	}
+	out.write(xml.data() + endPos, xml.size() - endPos);
+
+	UG_COND_THROW(!out, "Can not write to output file: " << filename);
+}
+
+///	returns the position of the beginning of the line containing pos
+static size_t LineBegin(const string& str, size_t pos)
+{
+	const size_t nl = str.rfind('\n', pos);
+	return (nl == string::npos) ? 0 : nl + 1;
+}
+
+void VTKFileWriter::AppendedFile::append_pieces(const AppendedFile& other)
+{
+	static const string beginTag = "<UnstructuredGrid>";
+	static const string endTag = "</UnstructuredGrid>";
+
+//	the pieces of the other file are the lines between the grid tags
+	size_t first = other.xml.find(beginTag);
+	const size_t last = other.xml.rfind(endTag);
+	UG_COND_THROW(first == string::npos || last == string::npos || last < first,
+				  "VTK: No UnstructuredGrid found in pieces of " << other.filename);
+	first = other.xml.find('\n', first) + 1;
+	const size_t end = max(first, LineBegin(other.xml, last));
+
+//	insert them in front of the closing grid tag of this file
+	const size_t ownLast = xml.rfind(endTag);
+	UG_COND_THROW(ownLast == string::npos,
+				  "VTK: No UnstructuredGrid found in " << filename);
+	const size_t insPos = LineBegin(xml, ownLast);
+	xml.insert(insPos, other.xml, first, end - first);
+
+//	the blocks of the other file follow the own blocks
+	for(size_t i = 0; i < other.vBlock.size(); ++i){
+		vBlock.push_back(other.vBlock[i]);
+		vBlock.back().xmlPos = other.vBlock[i].xmlPos - first + insPos;
+	}
+}
+
+void VTKFileWriter::AppendedFile::serialize(BinaryBuffer& buf) const
+{
+	Serialize(buf, xml);
+	Serialize(buf, vBlock.size());
+	for(size_t i = 0; i < vBlock.size(); ++i){
+		Serialize(buf, vBlock[i].xmlPos);
+		Serialize(buf, vBlock[i].data.size());
+		if(!vBlock[i].data.empty())
+			buf.write(&vBlock[i].data[0], vBlock[i].data.size());
+	}
+}
+
+void VTKFileWriter::AppendedFile::deserialize(BinaryBuffer& buf)
+{
+	Deserialize(buf, xml);
+	size_t numBlocks;
+	Deserialize(buf, numBlocks);
+	vBlock.resize(numBlocks);
+	for(size_t i = 0; i < numBlocks; ++i){
+		size_t size;
+		Deserialize(buf, vBlock[i].xmlPos);
+		Deserialize(buf, size);
+		vBlock[i].data.resize(size);
+		if(size > 0)
+			buf.read(&vBlock[i].data[0], size);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Background writing
+////////////////////////////////////////////////////////////////////////////////
+
+///	writes assembled files in a background thread
+class VTKAsyncWriter
+{
+	public:
+		static VTKAsyncWriter& inst()
+		{
+			static VTKAsyncWriter writer;
+			return writer;
+		}
+
+	///	adds a file to the queue (waits if too many files are pending)
+		void push(SmartPtr<VTKFileWriter::AppendedFile> spFile)
+		{
+			unique_lock<mutex> lock(m_mutex);
+			if(!m_thread.joinable())
+				m_thread = thread(&VTKAsyncWriter::run, this);
+
+			m_cvDone.wait(lock, [this]{return m_queue.size() < m_maxPending;});
+			m_queue.push_back(spFile);
+			m_cvWork.notify_one();
+		}
+
+	///	waits until all files are written
+	/**	If writing a file failed in the background, the error is rethrown.*/
+		void wait()
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_cvDone.wait(lock, [this]{return m_queue.empty() && !m_bBusy;});
+
+			if(m_exception){
+				exception_ptr e = m_exception;
+				m_exception = nullptr;
+				rethrow_exception(e);
+			}
+		}
+
+		~VTKAsyncWriter()
+		{
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_bStop = true;
+			}
+			m_cvWork.notify_one();
+			if(m_thread.joinable())
+				m_thread.join();
+		}
+
+	protected:
+		VTKAsyncWriter() : m_bBusy(false), m_bStop(false), m_maxPending(2) {}
+
+		void run()
+		{
+			unique_lock<mutex> lock(m_mutex);
+			while(true)
+			{
+				m_cvWork.wait(lock, [this]{return !m_queue.empty() || m_bStop;});
+				if(m_queue.empty())
+					return;
+
+				SmartPtr<VTKFileWriter::AppendedFile> spFile = m_queue.front();
+				m_queue.pop_front();
+				m_bBusy = true;
+				lock.unlock();
+
+			//	errors are kept and rethrown in the next wait()
+				exception_ptr e;
+				try{
+					spFile->write();
+				}
+				catch(...){
+					e = current_exception();
+				}
+
+				lock.lock();
+				if(e && !m_exception) m_exception = e;
+				m_bBusy = false;
+				m_cvDone.notify_all();
+			}
+		}
+
+	protected:
+		thread m_thread;
+		mutex m_mutex;
+		condition_variable m_cvWork;
+		condition_variable m_cvDone;
+		deque<SmartPtr<VTKFileWriter::AppendedFile> > m_queue;
+		bool m_bBusy;
+		bool m_bStop;
+		size_t m_maxPending;
+		exception_ptr m_exception;
+};
+
+void VTKFileWriter::wait_for_async_output()
+{
+	VTKAsyncWriter::inst().wait();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// VTKFileWriter
+////////////////////////////////////////////////////////////////////////////////
+
+VTKFileWriter::VTKFileWriter(const char* filename, const VTKFileSettings& settings) :
+	m_format(base64_ascii), m_blockBytes(0), m_bClosed(false), m_bAggregate(false)
+{
+	int rank = 0;
+#ifdef UG_PARALLEL
+	rank = pcl::ProcRank();
+	m_bAggregate = (settings.aggregation > 1) && (pcl::NumProcs() > 1);
+#endif
+
+	if(!settings.bAppended && !m_bAggregate){
+		m_base64.open(filename, ios_base::out | ios_base::trunc);
+		return;
+	}
+
+	UG_COND_THROW(settings.blockSize == 0, "VTK: Block size must be positive.");
+
+//	check early that the file can be written
+	if(is_writer(rank, m_bAggregate ? settings.aggregation : 1))
+	{
+		ofstream test(filename, ios::binary | ios::trunc);
+		UG_COND_THROW(!test, "Could not open output file: " << filename);
+	}
+
+	m_spFile = make_sp(new AppendedFile);
+	m_spFile->filename = filename;
+	m_spFile->settings = settings;
+}
+
+VTKFileWriter::~VTKFileWriter()
+{
+	if(m_bClosed) return;
+	try{
+		close();
+	}
+	catch(UGError& err){
+		UG_LOG("ERROR in VTKFileWriter: " << err.get_msg() << "\n");
+	}
+}
+
+void VTKFileWriter::close()
+{
+	if(m_bClosed) return;
+	m_bClosed = true;
+
+	if(m_spFile.invalid()){
+		m_base64.close();
+		return;
+	}
+
+	if(m_format == base64_binary)
+		end_block();
+
+	if(m_bAggregate){
+		aggregate();
+		if(m_spFile.invalid()) return;
+	}
+
+	if(m_spFile->settings.bAsync)
+		VTKAsyncWriter::inst().push(m_spFile);
+	else
+		m_spFile->write();
+	m_spFile = SPNULL;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const fmtflag format)
+{
+	if(m_spFile.invalid()){
+		m_base64 << (Base64FileWriter::fmtflag) format;
+		m_format = format;
+		return *this;
+	}
+
+	if(format == m_format) return *this;
+	if(m_format == base64_binary) end_block();
+	m_format = format;
+	if(m_format == base64_binary) begin_block();
+	return *this;
+}
+
+void VTKFileWriter::aggregate()
+{
+#ifdef UG_PARALLEL
+	PROFILE_FUNC_GROUP("vtk");
+
+	const int tag = 749;
+	const int rank = pcl::ProcRank();
+	const int numProcs = pcl::NumProcs();
+	const int aggregation = m_spFile->settings.aggregation;
+	const int writer = rank - rank % aggregation;
+	pcl::ProcessCommunicator pc;
+
+//	send the pieces to the writer
+	if(rank != writer){
+		BinaryBuffer buf;
+		m_spFile->serialize(buf);
+		int destProc = writer;
+		pc.distribute_data(NULL, NULL, 0, &buf, &destProc, 1, tag);
+		m_spFile = SPNULL;
+		return;
+	}
+
+//	receive the pieces of the group
+	vector<int> vSrcProc;
+	for(int p = writer + 1; p < min(writer + aggregation, numProcs); ++p)
+		vSrcProc.push_back(p);
+
+	vector<BinaryBuffer> vBuf(vSrcProc.size());
+	pc.distribute_data(GetDataPtr(vBuf), GetDataPtr(vSrcProc), (int)vSrcProc.size(),
+	                   NULL, NULL, 0, tag);
+
+	for(size_t i = 0; i < vBuf.size(); ++i){
+		AppendedFile file;
+		file.deserialize(vBuf[i]);
+		m_spFile->append_pieces(file);
+	}
+#endif
+}
+
+void VTKFileWriter::begin_block()
+{
+	static const string binaryFormat = "format=\"binary\"";
+	const size_t searchFrom = m_spFile->vBlock.empty() ? 0
+			: m_spFile->vBlock.back().xmlPos + binaryFormat.size();
+
+	const size_t pos = m_spFile->xml.rfind(binaryFormat);
+	UG_COND_THROW(pos == string::npos || pos < searchFrom,
+				  "VTKFileWriter: Binary data without preceding 'format=\"binary\"'.");
+
+	m_spFile->vBlock.push_back(AppendedFile::Block());
+	m_spFile->vBlock.back().xmlPos = pos;
+	m_blockBytes = 0;
+}
+
+void VTKFileWriter::end_block()
+{
+	UG_COND_THROW(m_blockBytes < sizeof(int),
+				  "VTKFileWriter: Binary block without leading size.");
+}
+
+template <typename T>
+void VTKFileWriter::dispatch(const T& value)
+{
+	if(m_spFile.invalid()){
+		m_base64 << value;
+		return;
+	}
+
+	if(m_format == base64_binary){
+	//	the leading size of the block is replaced by the header of the encoding
+		const char* p = reinterpret_cast<const char*>(&value);
+		size_t skip = 0;
+		if(m_blockBytes < sizeof(int))
+			skip = min(sizeof(T), sizeof(int) - m_blockBytes);
+		vector<char>& data = m_spFile->vBlock.back().data;
+		data.insert(data.end(), p + skip, p + sizeof(T));
+		m_blockBytes += sizeof(T);
+	}
+	else{
+		stringstream ss;
+		ss << value;
+		m_spFile->xml += ss.str();
+	}
+}
+
+void VTKFileWriter::dispatch_text(const std::string& str)
+{
+	if(m_format == base64_binary){
+		vector<char>& data = m_spFile->vBlock.back().data;
+		data.insert(data.end(), str.begin(), str.end());
+		m_blockBytes += str.size();
+	}
+	else
+		m_spFile->xml += str;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(int i)		{dispatch(i); return *this;}
+VTKFileWriter& VTKFileWriter::operator<<(char c)	{dispatch(c); return *this;}
+VTKFileWriter& VTKFileWriter::operator<<(float f)	{dispatch(f); return *this;}
+VTKFileWriter& VTKFileWriter::operator<<(double d)	{dispatch(d); return *this;}
+VTKFileWriter& VTKFileWriter::operator<<(long l)	{dispatch(l); return *this;}
+VTKFileWriter& VTKFileWriter::operator<<(size_t s)	{dispatch(s); return *this;}
+
+VTKFileWriter& VTKFileWriter::operator<<(const char* cstr)
+{
+	if(m_spFile.invalid()) m_base64 << cstr;
+	else dispatch_text(cstr);
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const std::string& str)
+{
+	if(m_spFile.invalid()) m_base64 << str;
+	else dispatch_text(str);
+	return *this;
+}
+
+} // end namespace ug
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+#define __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+
+#include <string>
+#include <vector>
+
+#include "common/util/base64_file_writer.h"
+#include "common/util/binary_buffer.h"
+#include "common/util/smart_pointer.h"
+
+namespace ug{
+
+///	compression of the binary data blocks of vtk files
+enum VTKCompression
+{
+	VTK_COMPRESSION_NONE,
+	VTK_COMPRESSION_ZLIB,	///< vtkZLibDataCompressor (requires UG_ZLIB)
+	VTK_COMPRESSION_LZ4		///< vtkLZ4DataCompressor (requires UG_LZ4)
+};
+
+///	returns the compression for a name ("none", "zlib" or "lz4")
+VTKCompression GetVTKCompression(const std::string& name);
+
+///	settings used to write a vtk file
+struct VTKFileSettings
+{
+	VTKFileSettings() :
+		bAppended(false), compression(VTK_COMPRESSION_NONE),
+		compressionLevel(-1), blockSize(32768), bAsync(false),
+		aggregation(1)
+	{}
+
+///	write binary data as raw appended data instead of inline base64
+	bool bAppended;
+
+///	compression of the appended data blocks
+	VTKCompression compression;
+
+///	compression level (-1: default level of the compressor)
+	int compressionLevel;
+
+///	size of the (uncompressed) compression blocks in bytes
+	size_t blockSize;
+
+///	encode and write the file in a background thread
+	bool bAsync;
+
+///	number of processes writing their pieces into one file (1: one file per process)
+	int aggregation;
+};
+
+///	file writer for the vtk xml file format
+/**
+ * The writer has the same stream interface as the Base64FileWriter, i.e.
+ * text is written in the 'normal' format, while the values of a binary
+ * DataArray are written in the 'base64_binary' format. Each binary block
+ * has to start with the number of bytes of the block (as int), as the
+ * inline base64 format of vtk requires.
+ *
+ * By default, binary blocks are written inline, base64 encoded.
+ *
+ * If appended data is enabled in the settings, the file is assembled in
+ * memory: For each binary block, the preceding 'format="binary"' attribute
+ * of the DataArray is replaced by 'format="appended"' and the offset of the
+ * block in the raw AppendedData section. The blocks are optionally
+ * compressed in the block format of the vtk compressors
+ * (header: number of blocks, block size, size of last block, compressed
+ * sizes; all UInt32), which is announced in the VTKFile element.
+ *
+ * In asynchronous mode, close() hands the assembled data over to a
+ * background thread which compresses and writes the file, while the caller
+ * continues. Use wait_for_async_output() to wait for pending files.
+ *
+ * If an aggregation factor > 1 is set in parallel, the file is assembled in
+ * memory as well, and each group of 'aggregation' consecutive processes sends
+ * its pieces to the first process of the group (the writer), which writes
+ * all pieces of the group into its own file. The files of the other
+ * processes are not written, i.e. all processes must call close() for
+ * the same output.
+ */
+class VTKFileWriter
+{
+	public:
+	///	format flags, see Base64FileWriter
+		enum fmtflag
+		{
+			base64_ascii,
+			base64_binary,
+			normal
+		};
+
+	public:
+	///	opens the file with the given name
+		VTKFileWriter(const char* filename,
+		              const VTKFileSettings& settings = VTKFileSettings());
+
+	///	closes the file (if not yet closed)
+		~VTKFileWriter();
+
+	///	finishes the file, i.e. writes it or hands it over to the background thread
+		void close();
+
+	///	switches between text and binary output
+		VTKFileWriter& operator<<(const fmtflag format);
+
+	//	insert plain standard types
+		VTKFileWriter& operator<<(int i);
+		VTKFileWriter& operator<<(char c);
+		VTKFileWriter& operator<<(const char* cstr);
+		VTKFileWriter& operator<<(const std::string& str);
+		VTKFileWriter& operator<<(float f);
+		VTKFileWriter& operator<<(double d);
+		VTKFileWriter& operator<<(long l);
+		VTKFileWriter& operator<<(size_t s);
+
+	///	waits until all files of the background thread have been written
+	/**	An error that occurred while writing in the background is rethrown.*/
+		static void wait_for_async_output();
+
+	///	returns if a process writes a file for the given aggregation factor
+		static bool is_writer(int rank, int aggregation)
+		{
+			return aggregation <= 1 || rank % aggregation == 0;
+		}
+
+	///	a file assembled in memory (appended data)
+		struct AppendedFile
+		{
+			struct Block
+			{
+			///	position of the 'format="binary"' attribute in the xml text
+				size_t xmlPos;
+			///	raw data of the block (without the leading size)
+				std::vector<char> data;
+			};
+
+			std::string filename;
+			VTKFileSettings settings;
+			std::string xml;
+			std::vector<Block> vBlock;
+
+		///	encodes the blocks and writes the file
+			void write() const;
+
+		///	appends the pieces of another file to the pieces of this file
+			void append_pieces(const AppendedFile& other);
+
+		///	(de)serialization of xml and blocks for the aggregation
+			void serialize(BinaryBuffer& buf) const;
+			void deserialize(BinaryBuffer& buf);
+		};
+
+	protected:
+	///	writes a value in the current format
+		template <typename T>
+		void dispatch(const T& value);
+
+	///	writes a string in the current format
+		void dispatch_text(const std::string& str);
+
+		void begin_block();
+		void end_block();
+
+	///	collects the pieces of the group at the writer
+		void aggregate();
+
+	protected:
+	///	writer for the inline base64 format
+		Base64FileWriter m_base64;
+
+	///	current format
+		fmtflag m_format;
+
+	///	file assembled in memory (only used for appended data)
+		SmartPtr<AppendedFile> m_spFile;
+
+	///	number of bytes of the current binary block
+		size_t m_blockBytes;
+
+	///	flag if the file has been closed
+		bool m_bClosed;
+
+	///	flag if the pieces are collected by a writer process
+		bool m_bAggregate;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__ */
@@ -76,7 +76,7 @@ print(const char* filename, Domain<TDim>& domain)
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+		VTKFileWriter File(name.c_str(), file_settings());
 
 	//	header
 		File << VTKFileWriter::normal;
@@ -117,8 +117,10 @@ print(const char* filename, Domain<TDim>& domain)
 		}
 
 	//	write closing xml tags
+		File << VTKFileWriter::normal;
 		File << "  </UnstructuredGrid>\n";
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
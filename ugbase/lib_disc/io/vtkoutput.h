@@ -42,14 +42,12 @@
 
 // other ug modules
 #include "common/util/string_util.h"
-#include "common/util/base64_file_writer.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/domain.h"
 #include "lib_disc/spatial_disc/user_data/user_data.h"
+#include "vtk_file_writer.h"
 
 namespace ug{
-// todo this should avoid refactoring all the signatures of VTKOutput, remove it later
-typedef Base64FileWriter VTKFileWriter;
 
 template <typename T>
 struct IteratorProvider
@@ -883,6 +881,49 @@ protected:
 
 		void set_write_proc_ranks(bool b) {m_bWriteProcRanks = b;};
 
+	///	write binary data as raw appended data instead of inline base64 (binary output only)
+		void set_appended(bool b) {m_fileSettings.bAppended = b;}
+
+	///	compression of the appended data ("none", "zlib" or "lz4"), enables appended data
+		void set_compression(const char* name)
+		{
+			m_fileSettings.compression = GetVTKCompression(name);
+			if(m_fileSettings.compression != VTK_COMPRESSION_NONE)
+				m_fileSettings.bAppended = true;
+		}
+
+	///	compression level (-1: default of the compressor)
+		void set_compression_level(int level) {m_fileSettings.compressionLevel = level;}
+
+	///	compress and write the files in a background thread, enables appended data
+	/**
+	 * The data of a time step is copied into memory and the simulation
+	 * continues while the file is written. Call wait_for_output() before
+	 * the files are read (e.g. at the end of a script).
+	 */
+		void set_async(bool b)
+		{
+			m_fileSettings.bAsync = b;
+			if(b) m_fileSettings.bAppended = true;
+		}
+
+	///	number of processes whose pieces are written into one vtu file
+	/**
+	 * In parallel, each group of 'numProcs' consecutive processes sends its
+	 * pieces to the first process of the group, which writes one vtu file
+	 * with all pieces of the group. The pvtu file only references these
+	 * files, reducing the number of files by the aggregation factor.
+	 */
+		void set_aggregation(int numProcs)
+		{
+			UG_COND_THROW(numProcs < 1, "VTKOutput: Aggregation factor must be positive.");
+			m_fileSettings.aggregation = numProcs;
+		}
+
+	///	waits until all files written in the background are completed
+	/**	Errors of the background writing are thrown here.*/
+		static void wait_for_output() {VTKFileWriter::wait_for_async_output();}
+
 	protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
@@ -950,6 +991,20 @@ protected:
 
 		bool m_bWriteSubsetIndices;
 		bool m_bWriteProcRanks;
+
+	///	settings for the vtu files (appended data, compression, async)
+		VTKFileSettings m_fileSettings;
+
+	///	returns the settings for the vtu files
+		VTKFileSettings file_settings() const
+		{
+			VTKFileSettings settings = m_fileSettings;
+			if(!m_bBinary){
+				settings.bAppended = false;
+				settings.compression = VTK_COMPRESSION_NONE;
+			}
+			return settings;
+		}
 };
 
 } // namespace ug
@@ -283,7 +283,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+		VTKFileWriter File(name.c_str(), file_settings());
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -339,6 +339,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 		File << VTKFileWriter::normal;
 		File << "  </UnstructuredGrid>\n";
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
@@ -416,7 +417,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 //	open the file
 	try
 	{
-		VTKFileWriter File(name.c_str());
+		VTKFileWriter File(name.c_str(), file_settings());
 
 	//	bool if time point should be written to *.vtu file
 	//	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -472,6 +473,7 @@ print_subsets(const char* filename, TFunction& u, const SubsetGroup& ssGrp, int
 		File << VTKFileWriter::normal;
 		File << "  </UnstructuredGrid>\n";
 		File << "</VTKFile>\n";
+		File.close();
 
 	// 	detach help indices
 		grid.detach_from_vertices(aVrtIndex);
@@ -2417,8 +2419,9 @@ write_pvtu(TFunction& u, const std::string& filename,
 			fprintf(file, "    </PCellData>\n");
 		}
 
-	// 	include files from all procs
+	// 	include files from all procs (only the writers if aggregated)
 		for (int i = 0; i < numProcs; i++) {
+			if(!VTKFileWriter::is_writer(i, m_fileSettings.aggregation)) continue;
 			vtu_filename(name, filename, i, si, maxSi, step);
 			name = FilenameWithoutPath(name);
 			fprintf(file, "    <Piece Source=\"%s\"/>\n", name.c_str());
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+
+#include "lagrange_sum_factorization.h"
+#include "lagrange.h"
+#include "lib_disc/quadrature/gauss_legendre/gauss_legendre.h"
+
+namespace ug{
+
+namespace{
+
+///	tensor-product reference element for a dimension
+template <int dim> struct TensorProductRefElem;
+template <> struct TensorProductRefElem<1> {typedef ReferenceEdge type;};
+template <> struct TensorProductRefElem<2> {typedef ReferenceQuadrilateral type;};
+template <> struct TensorProductRefElem<3> {typedef ReferenceHexahedron type;};
+
+}
+
+template <int dim>
+LagrangeSumFactorization<dim>::
+LagrangeSumFactorization(size_t order, size_t quadOrder)
+{
+	UG_COND_THROW(order < 1, "LagrangeSumFactorization: Order must be positive.");
+
+	m_p = order;
+	const size_t np = m_p + 1;
+
+//	1d quadrature
+	GaussLegendre quadRule(quadOrder);
+	m_n = quadRule.size();
+
+//	1d shape functions and derivatives at 1d integration points
+	m_B.resize(m_n * np); m_D.resize(m_n * np);
+	m_Bt.resize(m_n * np); m_Dt.resize(m_n * np);
+	for(size_t i = 0; i < np; ++i)
+	{
+		const EquidistantLagrange1D polynom(i, m_p);
+		const Polynomial1D dPolynom = polynom.derivative();
+		for(size_t q = 0; q < m_n; ++q)
+		{
+			const number x = quadRule.point(q)[0];
+			m_B[q * np + i] = m_Bt[i * m_n + q] = polynom.value(x);
+			m_D[q * np + i] = m_Dt[i * m_n + q] = dPolynom.value(x);
+		}
+	}
+
+//	shape function index -> tensor index (first direction slowest)
+	FlexLagrangeLSFS<typename TensorProductRefElem<dim>::type> lsfs(m_p);
+	m_nsh = lsfs.num_sh();
+	m_vTensorIndex.resize(m_nsh);
+	for(size_t sh = 0; sh < m_nsh; ++sh)
+	{
+		const MathVector<dim,int>& ind = lsfs.multi_index(sh);
+		size_t t = 0;
+		for(int d = 0; d < dim; ++d)
+			t = t * np + ind[d];
+		m_vTensorIndex[sh] = t;
+	}
+
+//	integration points and weights (first direction slowest, as in the
+//	tensor-product Gauss rules)
+	size_t numIP = 1;
+	for(int d = 0; d < dim; ++d) numIP *= m_n;
+	m_vIP.resize(numIP);
+	m_vWeight.resize(numIP);
+	for(size_t ip = 0; ip < numIP; ++ip)
+	{
+		size_t rest = ip;
+		m_vWeight[ip] = 1.0;
+		for(int d = dim-1; d >= 0; --d)
+		{
+			const size_t q = rest % m_n; rest /= m_n;
+			m_vIP[ip][d] = quadRule.point(q)[0];
+			m_vWeight[ip] *= quadRule.weight(q);
+		}
+	}
+
+//	buffers
+	const size_t maxSize = std::max(m_nsh, numIP);
+	m_vTensor.resize(m_nsh);
+	m_vQuad.resize(numIP);
+	m_vBuffer1.resize(maxSize);
+	m_vBuffer2.resize(maxSize);
+}
+
+template <int dim>
+void LagrangeSumFactorization<dim>::
+apply_1d(number* out, const number* in, const number* M,
+         size_t numRow, size_t numCol, const size_t* vSize, int d)
+{
+	size_t pre = 1, post = 1;
+	for(int d2 = 0; d2 < d; ++d2) pre *= vSize[d2];
+	for(int d2 = d+1; d2 < dim; ++d2) post *= vSize[d2];
+
+	for(size_t a = 0; a < pre; ++a)
+		for(size_t r = 0; r < numRow; ++r)
+		{
+			number* pOut = out + (a * numRow + r) * post;
+			for(size_t b = 0; b < post; ++b) pOut[b] = 0.0;
+
+			for(size_t c = 0; c < numCol; ++c)
+			{
+				const number m = M[r * numCol + c];
+				const number* pIn = in + (a * numCol + c) * post;
+				for(size_t b = 0; b < post; ++b)
+					pOut[b] += m * pIn[b];
+			}
+		}
+}
+
+template <int dim>
+const number* LagrangeSumFactorization<dim>::
+apply(const number* in, const number* const* vM,
+      size_t numRow, size_t numCol) const
+{
+	size_t vSize[dim];
+	for(int d = 0; d < dim; ++d) vSize[d] = numCol;
+
+	const number* pIn = in;
+	number* pOut = &m_vBuffer1[0];
+	for(int d = 0; d < dim; ++d)
+	{
+		apply_1d(pOut, pIn, vM[d], numRow, numCol, vSize, d);
+		vSize[d] = numRow;
+
+		pIn = pOut;
+		pOut = (pOut == &m_vBuffer1[0]) ? &m_vBuffer2[0] : &m_vBuffer1[0];
+	}
+	return pIn;
+}
+
+template <int dim>
+void LagrangeSumFactorization<dim>::
+values(number* vValue, const number* vCoeff) const
+{
+	for(size_t sh = 0; sh < m_nsh; ++sh)
+		m_vTensor[m_vTensorIndex[sh]] = vCoeff[sh];
+
+	const number* vM[dim];
+	for(int d = 0; d < dim; ++d) vM[d] = &m_B[0];
+
+	const number* res = apply(&m_vTensor[0], vM, m_n, m_p+1);
+	for(size_t ip = 0; ip < m_vIP.size(); ++ip)
+		vValue[ip] = res[ip];
+}
+
+template <int dim>
+void LagrangeSumFactorization<dim>::
+grads(MathVector<dim>* vGrad, const number* vCoeff) const
+{
+	for(size_t sh = 0; sh < m_nsh; ++sh)
+		m_vTensor[m_vTensorIndex[sh]] = vCoeff[sh];
+
+	for(int k = 0; k < dim; ++k)
+	{
+		const number* vM[dim];
+		for(int d = 0; d < dim; ++d) vM[d] = (d == k) ? &m_D[0] : &m_B[0];
+
+		const number* res = apply(&m_vTensor[0], vM, m_n, m_p+1);
+		for(size_t ip = 0; ip < m_vIP.size(); ++ip)
+			vGrad[ip][k] = res[ip];
+	}
+}
+
+template <int dim>
+void LagrangeSumFactorization<dim>::
+integrate(number* vRes, const number* vValue, const MathVector<dim>* vGrad) const
+{
+	const size_t numIP = m_vIP.size();
+	for(size_t t = 0; t < m_nsh; ++t) m_vTensor[t] = 0.0;
+
+//	values against shape functions
+	if(vValue != NULL)
+	{
+		for(size_t ip = 0; ip < numIP; ++ip)
+			m_vQuad[ip] = m_vWeight[ip] * vValue[ip];
+
+		const number* vM[dim];
+		for(int d = 0; d < dim; ++d) vM[d] = &m_Bt[0];
+
+		const number* res = apply(&m_vQuad[0], vM, m_p+1, m_n);
+		for(size_t t = 0; t < m_nsh; ++t) m_vTensor[t] += res[t];
+	}
+
+//	vectors against gradients
+	if(vGrad != NULL)
+	{
+		for(int k = 0; k < dim; ++k)
+		{
+			for(size_t ip = 0; ip < numIP; ++ip)
+				m_vQuad[ip] = m_vWeight[ip] * vGrad[ip][k];
+
+			const number* vM[dim];
+			for(int d = 0; d < dim; ++d) vM[d] = (d == k) ? &m_Dt[0] : &m_Bt[0];
+
+			const number* res = apply(&m_vQuad[0], vM, m_p+1, m_n);
+			for(size_t t = 0; t < m_nsh; ++t) m_vTensor[t] += res[t];
+		}
+	}
+
+	for(size_t sh = 0; sh < m_nsh; ++sh)
+		vRes[sh] += m_vTensor[m_vTensorIndex[sh]];
+}
+
+template class LagrangeSumFactorization<1>;
+template class LagrangeSumFactorization<2>;
+template class LagrangeSumFactorization<3>;
+
+} // end namespace ug
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__LOCAL_SHAPE_FUNCTION_SET__LAGRANGE__LAGRANGE_SUM_FACTORIZATION__
+#define __H__UG__LIB_DISC__LOCAL_SHAPE_FUNCTION_SET__LAGRANGE__LAGRANGE_SUM_FACTORIZATION__
+
+#include <vector>
+
+#include "common/math/ugmath.h"
+
+namespace ug{
+
+/// sum-factorized evaluation of tensor-product Lagrange elements
+/**
+ * For the Lagrange elements of order p on edges, quadrilaterals and
+ * hexahedra (Q_p) the shape functions are products of 1d polynomials. At the
+ * points of a tensor-product Gauss-Legendre quadrature with n points per
+ * direction, the interpolation of values and gradients and the integration
+ * against the shape functions (and their gradients) can therefore be
+ * computed by applying the 1d matrices B_qi = phi_i(x_q) and D_qi = phi_i'(x_q)
+ * direction by direction. This costs O(dim * (p+1)^dim * n) operations
+ * instead of O((p+1)^dim * n^dim) for the evaluation of all shape functions
+ * at all integration points.
+ *
+ * The integration points and weights coincide with the rules of type
+ * GAUSS_LEGENDRE provided by the QuadratureRuleProvider for the same order
+ * (GaussQuadratureQuadrilateral, GaussQuadratureHexahedron). The local
+ * coefficients are expected in the ordering of the shape functions of
+ * LagrangeLSFS and FlexLagrangeLSFS. Gradients are computed w.r.t. the
+ * reference element coordinates.
+ *
+ * The class uses internal buffers and an instance must therefore not be
+ * used by several threads concurrently.
+ *
+ * \tparam	dim		dimension of the reference element (1: edge,
+ * 					2: quadrilateral, 3: hexahedron)
+ */
+template <int dim>
+class LagrangeSumFactorization
+{
+	public:
+	///	constructor
+	/**
+	 * \param[in]	order		order p of the Lagrange shape functions
+	 * \param[in]	quadOrder	order of the Gauss-Legendre quadrature
+	 */
+		LagrangeSumFactorization(size_t order, size_t quadOrder);
+
+	///	order of shape functions
+		size_t order() const {return m_p;}
+
+	///	number of shape functions
+		size_t num_sh() const {return m_nsh;}
+
+	///	number of integration points
+		size_t num_ip() const {return m_vIP.size();}
+
+	///	integration points
+		const MathVector<dim>* ips() const {return &m_vIP[0];}
+
+	///	integration weights
+		const number* weights() const {return &m_vWeight[0];}
+
+	///	interpolates values at the integration points
+	/**
+	 * \param[out]	vValue		values at integration points (num_ip())
+	 * \param[in]	vCoeff		coefficients of the shape functions (num_sh())
+	 */
+		void values(number* vValue, const number* vCoeff) const;
+
+	///	interpolates reference gradients at the integration points
+	/**
+	 * \param[out]	vGrad		gradients at integration points (num_ip())
+	 * \param[in]	vCoeff		coefficients of the shape functions (num_sh())
+	 */
+		void grads(MathVector<dim>* vGrad, const number* vCoeff) const;
+
+	///	integrates against the shape functions and their gradients
+	/**
+	 * Computes for all shape functions i
+	 *
+	 * 		vRes[i] += sum_q w_q * ( vValue[q] * phi_i(x_q)
+	 * 		                         + vGrad[q] * grad phi_i(x_q) ),
+	 *
+	 * where the values already contain all other factors (e.g. the
+	 * determinant of the jacobian or the transformation of the gradients).
+	 * One of vValue and vGrad may be NULL.
+	 *
+	 * \param[in,out]	vRes		residual (num_sh())
+	 * \param[in]		vValue		values at integration points (or NULL)
+	 * \param[in]		vGrad		vectors at integration points (or NULL)
+	 */
+		void integrate(number* vRes, const number* vValue,
+		               const MathVector<dim>* vGrad) const;
+
+	protected:
+	///	applies a 1d matrix (numRow x numCol) in direction d
+	/**
+	 * The input is a tensor of sizes vSize with vSize[d] == numCol, the
+	 * output is a tensor where vSize[d] is replaced by numRow.
+	 */
+		static void apply_1d(number* out, const number* in,
+		                     const number* M, size_t numRow, size_t numCol,
+		                     const size_t* vSize, int d);
+
+	///	applies the given 1d matrices in all directions, returns the result
+		const number* apply(const number* in, const number* const* vM,
+		                    size_t numRow, size_t numCol) const;
+
+	protected:
+	///	order
+		size_t m_p;
+
+	///	number of shape functions
+		size_t m_nsh;
+
+	///	number of 1d integration points
+		size_t m_n;
+
+	///	1d values B_qi, derivatives D_qi (n x (p+1)) and transposed
+		std::vector<number> m_B, m_D, m_Bt, m_Dt;
+
+	///	shape function index -> tensor index
+		std::vector<size_t> m_vTensorIndex;
+
+	///	integration points and weights
+		std::vector<MathVector<dim> > m_vIP;
+		std::vector<number> m_vWeight;
+
+	///	buffers
+		mutable std::vector<number> m_vTensor, m_vQuad, m_vBuffer1, m_vBuffer2;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__LOCAL_SHAPE_FUNCTION_SET__LAGRANGE__LAGRANGE_SUM_FACTORIZATION__ */
@@ -705,9 +705,17 @@ LocalFiniteElementProvider::
 ~LocalFiniteElementProvider()
 {};
 
+std::recursive_mutex& LocalFiniteElementProvider::mutex()
+{
+	static std::recursive_mutex m;
+	return m;
+}
+
 const LocalDoFSet& LocalFiniteElementProvider::
 get_dofs(ReferenceObjectID roid, const LFEID& id, bool bCreate)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	init provider and search for identifier
 	typedef std::map<LFEID, LocalDoFSets> Map;
 	Map::const_iterator iter = inst().m_mLocalDoFSets.find(id);
@@ -729,6 +737,8 @@ get_dofs(ReferenceObjectID roid, const LFEID& id, bool bCreate)
 const CommonLocalDoFSet& LocalFiniteElementProvider::
 get_dofs(const LFEID& id, bool bCreate)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	init provider and search for identifier
 	typedef std::map<LFEID, CommonLocalDoFSet> Map;
 	Map::const_iterator iter = inst().m_mCommonDoFSet.find(id);
@@ -748,6 +758,8 @@ get_dofs(const LFEID& id, bool bCreate)
 
 bool LocalFiniteElementProvider::continuous(const LFEID& id, bool bCreate)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 	std::map<LFEID, bool>::iterator iter = m_mContSpace.find(id);
 	if(iter == m_mContSpace.end())
 	{
@@ -766,6 +778,8 @@ bool LocalFiniteElementProvider::continuous(const LFEID& id, bool bCreate)
 
 void LocalFiniteElementProvider::register_set(const LFEID& id, ConstSmartPtr<LocalDoFSet> set)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	reference object id
 	const ReferenceObjectID roid = set->roid();
 
@@ -36,6 +36,8 @@
 // extern libraries
 #include <cassert>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 // other ug4 modules
 #include "common/math/ugmath.h"
@@ -56,6 +58,13 @@ namespace ug {
  *
  *	This class provides references to Local Shape functions and Local DoF Sets.
  *	It is implemented as a Singleton.
+ *
+ *	The provider can be used by several threads concurrently: The creation and
+ *	lookup of sets is serialized by a mutex. Shape function sets of order up to
+ *	maxTableOrder requested via get() are additionally published in a table,
+ *	that is read without locking once a set has been created. Note, that the
+ *	SmartPtr returned by getptr() is not thread-safe to copy; threaded code
+ *	should use the references returned by get().
  */
 class LocalFiniteElementProvider {
 	private:
@@ -136,6 +145,17 @@ class LocalFiniteElementProvider {
 		static std::map<LFEID, LocalShapeFunctionSets<dim, TShape, TGrad> >&
 		lsfs_map();
 
+	///	maximal order of shape function sets published in the lock-free table
+		static const int maxTableOrder = 8;
+
+	///	returns the table entry for a set (NULL if id is not stored in the table)
+		template <int dim, typename TShape, typename TGrad>
+		static std::atomic<const LocalShapeFunctionSet<dim, TShape, TGrad>*>*
+		lsfs_table_entry(ReferenceObjectID roid, const LFEID& id);
+
+	///	mutex serializing the lookup and creation of sets
+		static std::recursive_mutex& mutex();
+
 	//	returns the continuous information
 		static std::map<LFEID, bool> m_mContSpace;
 
@@ -51,6 +51,23 @@ LocalFiniteElementProvider::lsfs_map()
 	return map;
 };
 
+template <int dim, typename TShape, typename TGrad>
+std::atomic<const LocalShapeFunctionSet<dim, TShape, TGrad>*>*
+LocalFiniteElementProvider::lsfs_table_entry(ReferenceObjectID roid, const LFEID& id)
+{
+	typedef std::atomic<const LocalShapeFunctionSet<dim, TShape, TGrad>*> Entry;
+	static const int numDim = 4;
+	static const int numOrder = maxTableOrder + 1;
+	static Entry table[LFEID::NUM_SPACE_TYPES][numDim][numOrder][NUM_REFERENCE_OBJECTS];
+
+	if(id.type() < 0 || id.type() >= LFEID::NUM_SPACE_TYPES) return NULL;
+	if(id.dim() < 0 || id.dim() >= numDim) return NULL;
+	if(id.order() < 0 || id.order() >= numOrder) return NULL;
+	if(roid < 0 || roid >= NUM_REFERENCE_OBJECTS) return NULL;
+
+	return &table[id.type()][id.dim()][id.order()][roid];
+}
+
 template <int dim>
 std::map<LFEID, LocalFiniteElementProvider::DimLocalDoFSets<dim> >&
 LocalFiniteElementProvider::lds_map()
@@ -65,6 +82,8 @@ void LocalFiniteElementProvider::
 register_set(const LFEID& id,
              ConstSmartPtr<LocalShapeFunctionSet<dim, TShape, TGrad> > set)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	get type of map
 	typedef std::map<LFEID, LocalShapeFunctionSets<dim, TShape, TGrad> > Map;
 	Map& map = inst().lsfs_map<dim, TShape, TGrad>();
@@ -97,6 +116,8 @@ void LocalFiniteElementProvider::
 register_set(const LFEID& id,
              ConstSmartPtr<DimLocalDoFSet<dim> > set)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	get type of map
 	typedef std::map<LFEID, DimLocalDoFSets<dim> > Map;
 	Map& map = inst().lds_map<dim>();
@@ -122,6 +143,8 @@ ConstSmartPtr<LocalShapeFunctionSet<dim, TShape, TGrad> >
 LocalFiniteElementProvider::
 getptr(ReferenceObjectID roid, const LFEID& id, bool bCreate)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	init provider and get map
 	typedef std::map<LFEID, LocalShapeFunctionSets<dim, TShape, TGrad> > Map;
 	Map& map = inst().lsfs_map<dim, TShape, TGrad>();
@@ -147,10 +170,23 @@ const LocalShapeFunctionSet<dim, TShape, TGrad>&
 LocalFiniteElementProvider::
 get(ReferenceObjectID roid, const LFEID& id, bool bCreate)
 {
+//	sets in the table are never removed and can be returned without locking
+	std::atomic<const LocalShapeFunctionSet<dim, TShape, TGrad>*>* entry =
+			lsfs_table_entry<dim,TShape,TGrad>(roid, id);
+	if(entry != NULL){
+		const LocalShapeFunctionSet<dim, TShape, TGrad>* set =
+				entry->load(std::memory_order_acquire);
+		if(set != NULL) return *set;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(mutex());
 	ConstSmartPtr<LocalShapeFunctionSet<dim, TShape, TGrad> > ptr =
 			getptr<dim,TShape,TGrad>(roid, id, bCreate);
 
-	if(ptr.valid()) return *ptr;
+	if(ptr.valid()){
+		if(entry != NULL) entry->store(ptr.get(), std::memory_order_release);
+		return *ptr;
+	}
 	else
 		UG_THROW("LocalFiniteElementProvider: Local Shape Function Set not "
 				 "found for "<<roid<<" (world dim: "<<dim<<") and type = "<<id<<
@@ -166,6 +202,8 @@ ConstSmartPtr<DimLocalDoFSet<dim> >
 LocalFiniteElementProvider::
 get_dof_ptr(ReferenceObjectID roid, const LFEID& id, bool bCreate)
 {
+	std::lock_guard<std::recursive_mutex> lock(mutex());
+
 //	init provider and get map
 	typedef std::map<LFEID, DimLocalDoFSets<dim> > Map;
 	Map& map = inst().lds_map<dim>();
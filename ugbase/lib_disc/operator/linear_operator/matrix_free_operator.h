@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__
+
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_disc/assemble_interface.h"
+#include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
+
+namespace ug{
+
+///	local to global mapping adding only the diagonal of the local matrices
+/**
+ * Only couplings of a global index with itself are added to the global
+ * matrix, i.e. the assembled matrix is the (block-)diagonal of the operator.
+ */
+template <typename TAlgebra>
+class DiagonalLocalToGlobalMapper : public ILocalToGlobalMapper<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Type of algebra matrix
+		typedef typename algebra_type::matrix_type matrix_type;
+
+	///	Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	public:
+	///	adds a local vector to the global one
+		void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
+				ConstSmartPtr<DoFDistribution> dd)
+			{AddLocalVector(vec, lvec);}
+
+	///	adds the diagonal of a local matrix to the global matrix
+		void add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+				ConstSmartPtr<DoFDistribution> dd);
+
+	///	modifies local solution vector for adapted defect computation
+		void modify_LocalSol(LocalVector& vecMod, const LocalVector& lvec,
+				ConstSmartPtr<DoFDistribution> dd) {}
+
+	///	destructor
+		~DiagonalLocalToGlobalMapper() {};
+};
+
+///	linear operator applying a discretization without assembling a matrix
+/**
+ * This operator computes f = A*u by assembling the defect of the
+ * discretization element by element: Since the defect of a linear
+ * discretization is d(u) = A*u - b, the operator computes f = d(u) - d(0),
+ * where the offset d(0) is computed once on initialization. Thus, no matrix
+ * is stored and the application only costs an element loop. If the geometry
+ * cache is enabled for the domain (EnableGeometryCache), the element
+ * geometries are not recomputed in each application.
+ *
+ * The discretization must be linear (affine) in u. On Dirichlet rows the
+ * defect is zero and so is the result of the operator, i.e. the operator
+ * coincides with the assembled matrix for vectors that vanish on Dirichlet
+ * DoFs (as corrections and defects do).
+ *
+ * Smoothers need the diagonal of the operator: On initialization the
+ * diagonal is assembled element-wise into a matrix operator (that does not
+ * store any off-diagonal couplings), which can be used as approximation of
+ * an IPreconditioner (e.g. Jacobi).
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class MatrixFreeOperator
+	: public virtual ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of matrix operator
+		typedef MatrixOperator<matrix_type, vector_type> matrix_operator_type;
+
+	public:
+	///	Constructor
+		MatrixFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass)
+			: m_spAss(ass), m_bForceRegGrid(false) {};
+
+	///	Constructor
+		MatrixFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass, const GridLevel& gl)
+			: m_spAss(ass), m_gridLevel(gl), m_bForceRegGrid(false) {};
+
+	///	sets the discretization to be used
+		void set_discretization(SmartPtr<IAssemble<TAlgebra> > ass) {m_spAss = ass;}
+
+	///	returns the discretization to be used
+		SmartPtr<IAssemble<TAlgebra> > discretization() {return m_spAss;}
+
+	///	sets the level used for assembling
+		void set_level(const GridLevel& gl) {m_gridLevel = gl;}
+
+	///	returns the level
+		const GridLevel& level() const {return m_gridLevel;}
+
+	///	sets if a regular grid is forced when assembling (e.g. on level grids)
+		void set_force_regular_grid(bool bForce) {m_bForceRegGrid = bForce;}
+
+	///	computes the offset d(0) and assembles the diagonal at u
+		virtual void init(const vector_type& u);
+
+	///	resets the offset, that is computed on the next application
+		virtual void init();
+
+	///	compute f = A*u
+		virtual void apply(vector_type& f, const vector_type& u);
+
+	///	compute f := f - A*u
+		virtual void apply_sub(vector_type& f, const vector_type& u);
+
+	///	returns the diagonal of the operator (assembled in init(u))
+		SmartPtr<matrix_operator_type> diagonal();
+
+	///	assembles the diagonal of the operator at u into a matrix
+		void assemble_diagonal(matrix_type& D, const vector_type& u);
+
+	///	Destructor
+		virtual ~MatrixFreeOperator() {};
+
+	protected:
+	///	computes the offset d(0) for vectors of the layout of u
+		void compute_offset(const vector_type& u);
+
+	// 	assembling procedure
+		SmartPtr<IAssemble<TAlgebra> > m_spAss;
+
+	// 	grid level used
+		GridLevel m_gridLevel;
+
+	//	flag if regular grid is forced while assembling
+		bool m_bForceRegGrid;
+
+	//	defect of the zero vector
+		SmartPtr<vector_type> m_spOffset;
+
+	//	temporary vector for apply_sub
+		SmartPtr<vector_type> m_spTmp;
+
+	//	diagonal of the operator
+		SmartPtr<matrix_operator_type> m_spDiag;
+};
+
+} // namespace ug
+
+// include implementation
+#include "matrix_free_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR__ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__
+
+#include "matrix_free_operator.h"
+#include "lib_disc/common/local_algebra.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+void DiagonalLocalToGlobalMapper<TAlgebra>::
+add_local_mat_to_global(matrix_type& mat, const LocalMatrix& lmat,
+                        ConstSmartPtr<DoFDistribution> dd)
+{
+	const LocalIndices& rowInd = lmat.get_row_indices();
+	const LocalIndices& colInd = lmat.get_col_indices();
+
+	for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+		for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+		{
+			const size_t rowIndex = rowInd.index(fct1,dof1);
+			const size_t rowComp = rowInd.comp(fct1,dof1);
+
+			for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+				for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+				{
+					if(colInd.index(fct2,dof2) != rowIndex) continue;
+
+					const size_t colComp = colInd.comp(fct2,dof2);
+					BlockRef(mat(rowIndex, rowIndex), rowComp, colComp)
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+		}
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::init(const vector_type& u)
+{
+	PROFILE_FUNC_GROUP("discretization");
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeOperator: Assembling routine not set.");
+
+	try{
+		compute_offset(u);
+
+		if(m_spDiag.invalid())
+			m_spDiag = make_sp(new matrix_operator_type);
+		assemble_diagonal(*m_spDiag, u);
+	}
+	UG_CATCH_THROW("MatrixFreeOperator::init: Cannot initialize operator.");
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::init()
+{
+	m_spOffset = SPNULL;
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::compute_offset(const vector_type& u)
+{
+	SmartPtr<vector_type> spZero = u.clone_without_values();
+	spZero->set(0.0);
+
+	m_spOffset = u.clone_without_values();
+
+	m_spAss->ass_tuner()->set_force_regular_grid(m_bForceRegGrid);
+	try{
+		m_spAss->assemble_defect(*m_spOffset, *spZero, m_gridLevel);
+	}
+	catch(...){
+		m_spAss->ass_tuner()->set_force_regular_grid(false);
+		m_spOffset = SPNULL;
+		throw;
+	}
+	m_spAss->ass_tuner()->set_force_regular_grid(false);
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::
+assemble_diagonal(matrix_type& D, const vector_type& u)
+{
+	PROFILE_FUNC_GROUP("discretization");
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeOperator: Assembling routine not set.");
+
+	SmartPtr<AssemblingTuner<TAlgebra> > spAssTuner = m_spAss->ass_tuner();
+	if(!spAssTuner->default_mapping_used())
+		UG_THROW("MatrixFreeOperator: Cannot assemble diagonal, since a local "
+				"to global mapping is already set in the assembling tuner.");
+
+	DiagonalLocalToGlobalMapper<TAlgebra> diagMapper;
+	spAssTuner->set_mapping(&diagMapper);
+	spAssTuner->set_force_regular_grid(m_bForceRegGrid);
+	try{
+		m_spAss->assemble_jacobian(D, u, m_gridLevel);
+	}
+	catch(...){
+		spAssTuner->set_mapping(NULL);
+		spAssTuner->set_force_regular_grid(false);
+		throw;
+	}
+	spAssTuner->set_mapping(NULL);
+	spAssTuner->set_force_regular_grid(false);
+}
+
+template <typename TAlgebra>
+SmartPtr<typename MatrixFreeOperator<TAlgebra>::matrix_operator_type>
+MatrixFreeOperator<TAlgebra>::diagonal()
+{
+	if(m_spDiag.invalid())
+		UG_THROW("MatrixFreeOperator: Diagonal not assembled. Call init(u) first.");
+	return m_spDiag;
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::apply(vector_type& f, const vector_type& u)
+{
+	PROFILE_FUNC_GROUP("discretization");
+#ifdef UG_PARALLEL
+	if(!u.has_storage_type(PST_CONSISTENT))
+		UG_THROW("MatrixFreeOperator::apply: Inadequate storage format of Vector u.");
+#endif
+	if(m_spAss.invalid())
+		UG_THROW("MatrixFreeOperator: Assembling routine not set.");
+
+	if(m_spOffset.invalid() || m_spOffset->size() != u.size())
+		compute_offset(u);
+
+//	f = d(u) - d(0) = A*u
+	m_spAss->ass_tuner()->set_force_regular_grid(m_bForceRegGrid);
+	try{
+		m_spAss->assemble_defect(f, u, m_gridLevel);
+	}
+	catch(...){
+		m_spAss->ass_tuner()->set_force_regular_grid(false);
+		throw;
+	}
+	m_spAss->ass_tuner()->set_force_regular_grid(false);
+
+	VecScaleAdd(f, 1.0, f, -1.0, *m_spOffset);
+}
+
+template <typename TAlgebra>
+void MatrixFreeOperator<TAlgebra>::apply_sub(vector_type& f, const vector_type& u)
+{
+#ifdef UG_PARALLEL
+	if(!f.has_storage_type(PST_ADDITIVE))
+		UG_THROW("MatrixFreeOperator::apply_sub: Inadequate storage format of Vector f.");
+#endif
+
+	if(m_spTmp.invalid() || m_spTmp->size() != f.size())
+		m_spTmp = f.clone_without_values();
+
+	apply(*m_spTmp, u);
+	VecScaleAdd(f, 1.0, f, -1.0, *m_spTmp);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__MATRIX_FREE_OPERATOR_IMPL__ */
@@ -56,6 +56,8 @@
 // library intern headers
 #include "lib_disc/function_spaces/grid_function_util.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/matrix_free_operator.h"
+#include "lib_algebra/operator/preconditioner/mixed_precision.h"
 
 #include "mg_stats.h"
 
@@ -148,6 +150,32 @@ class AssembledMultiGridCycle :
 	///	sets if RAP - Product used to build coarse grid matrices
 		void set_rap(bool bRAP) {m_bUseRAP = bRAP;}
 
+	///	sets the lowest level using a matrix-free level operator (-1 = none)
+	/**
+	 * On the levels lev >= matrixFreeLev the level operator is applied
+	 * element-wise by a MatrixFreeOperator instead of an assembled matrix.
+	 * Only the diagonal of these levels is assembled, that is used by the
+	 * smoothers, which must be IPreconditioner-based and only use the
+	 * diagonal of the approximation (e.g. Jacobi). The base level and the
+	 * levels of the adaptive (not fully refined) part of the hierarchy are
+	 * always assembled. The discretization must be linear and cannot be
+	 * combined with RAP.
+	 */
+		void set_matrix_free_level(int matrixFreeLev) {m_matrixFreeLev = matrixFreeLev;}
+
+	///	sets the lowest level using a single precision level operator (-1 = none)
+	/**
+	 * On the levels lev >= floatLev the assembled level matrix is converted
+	 * to single precision (FloatMatrixOperator) and the double precision
+	 * matrix is released, halving the memory of the level matrices. The
+	 * smoothers on these levels must be MixedPrecision preconditioners, that
+	 * use the single precision matrix directly. Defect updates multiply the
+	 * single precision matrix with the double precision vectors. As for
+	 * matrix-free levels, the base level and the adaptive part of the
+	 * hierarchy are excluded. Only available for the scalar CPU algebra.
+	 */
+		void set_float_level(int floatLev) {m_floatLev = floatLev;}
+
 	///	sets if smoothing is performed on surface rim
 		void set_smooth_on_surface_rim(bool bSmooth) {m_bSmoothOnSurfaceRim = bSmooth;}
 
@@ -294,6 +322,15 @@ class AssembledMultiGridCycle :
 	///	initializes the smoother and base solver
 		void init_smoother();
 
+	///	initializes a smoother for a level
+		bool init_level_smoother(ILinearIterator<vector_type>& smoother, int lev);
+
+	///	returns if a level uses a matrix-free level operator
+		bool matrix_free_level(int lev) const;
+
+	///	returns if a level uses a single precision level operator
+		bool float_level(int lev) const;
+
 	///	initializes the coarse grid matrices
 		void assemble_level_operator();
 		void init_rap_operator();
@@ -355,6 +392,12 @@ class AssembledMultiGridCycle :
 	///	using RAP-Product (assemble coarse-grid matrices otherwise)
 		bool m_bUseRAP;
 
+	///	lowest level using a matrix-free level operator (-1 if none)
+		int m_matrixFreeLev;
+
+	///	lowest level using a single precision level operator (-1 if none)
+		int m_floatLev;
+
 	///	flag if smoothing on surface rim
 		bool m_bSmoothOnSurfaceRim;
 
@@ -416,9 +459,12 @@ class AssembledMultiGridCycle :
 
 		struct LevData
 		{
-		///	Level matrix operator
+		///	Level matrix operator (only the diagonal for matrix-free levels, empty for single precision levels)
 			SmartPtr<MatrixOperator<matrix_type, vector_type> > A;
 
+		///	Level operator used for defect updates (A, matrix-free or single precision)
+			SmartPtr<ILinearOperator<vector_type> > Op;
+
 		///	Smoother
 			SmartPtr<ILinearIterator<vector_type> > PreSmoother;
 			SmartPtr<ILinearIterator<vector_type> > PostSmoother;
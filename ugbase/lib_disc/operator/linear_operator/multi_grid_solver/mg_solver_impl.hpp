@@ -82,7 +82,7 @@ AssembledMultiGridCycle() :
 	m_baseLev(0), m_cycleType(_V_),
 	m_numPreSmooth(2), m_numPostSmooth(2),
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
-	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
+	m_bUseRAP(false), m_matrixFreeLev(-1), m_floatLev(-1), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
@@ -107,7 +107,7 @@ AssembledMultiGridCycle(SmartPtr<ApproximationSpace<TDomain> > approxSpace) :
 	m_baseLev(0), m_cycleType(_V_),
 	m_numPreSmooth(2), m_numPostSmooth(2),
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
-	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
+	m_bUseRAP(false), m_matrixFreeLev(-1), m_floatLev(-1), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
@@ -152,6 +152,8 @@ clone()
 	clone->set_presmoother(m_spPreSmootherPrototype);
 	clone->set_postsmoother(m_spPostSmootherPrototype);
 	clone->set_surface_level(m_surfaceLev);
+	clone->set_matrix_free_level(m_matrixFreeLev);
+	clone->set_float_level(m_floatLev);
 
 	for(size_t i = 0; i < m_vspProlongationPostProcess.size(); ++i)
 		clone->add_prolongation_post_process(m_vspProlongationPostProcess[i]);
@@ -414,6 +416,12 @@ init()
 	if(m_spRestrictionPrototype.invalid())
 		UG_THROW("GMG::init: Restriction not set.");
 
+	if(m_bUseRAP && m_matrixFreeLev >= 0)
+		UG_THROW("GMG::init: Matrix-free level operators cannot be used with RAP.");
+
+	if(m_bUseRAP && m_floatLev >= 0)
+		UG_THROW("GMG::init: Single precision level operators cannot be used with RAP.");
+
 //	get current toplevel
 	const GF* pSol = dynamic_cast<const GF*>(m_pSurfaceSol);
 	if(pSol){
@@ -604,8 +612,31 @@ assemble_level_operator()
 
 	//	In Full-Ref case we can copy the Matrix from the surface
 		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel));
-		if(!bCpyFromSurface)
+		if(matrix_free_level(lev))
 		{
+			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: matrix-free on lev "<<lev<<"\n");
+			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_MatrixFree);
+			try{
+				const GridLevel gl(lev, m_GridLevelType, false);
+				SmartPtr<MatrixFreeOperator<TAlgebra> > spOp =
+						ld.Op.template cast_dynamic<MatrixFreeOperator<TAlgebra> >();
+				if(spOp.invalid())
+					spOp = make_sp(new MatrixFreeOperator<TAlgebra>(m_spAss, gl));
+				spOp->set_discretization(m_spAss);
+				spOp->set_level(gl);
+				spOp->set_force_regular_grid(m_GridLevelType == GridLevel::LEVEL);
+				spOp->init(*ld.st);
+
+				ld.Op = spOp;
+				ld.A = spOp->diagonal();
+			}
+			UG_CATCH_THROW("GMG:init: Cannot init matrix-free operator for level "<<lev);
+			GMG_PROFILE_END();
+			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  end   assemble_level_operator: matrix-free on lev "<<lev<<"\n");
+		}
+		else if(!bCpyFromSurface)
+		{
+			ld.Op = ld.A;
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: assemble on lev "<<lev<<"\n");
 			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_AssembleOnLevel);
 			try{
@@ -621,6 +652,7 @@ assemble_level_operator()
 		else
 		{
 		//	in case of full refinement we simply copy the matrix (with correct numbering)
+			ld.Op = ld.A;
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: copy mat on lev "<<lev<<"\n");
 			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_CopyFromTopSurface);
 
@@ -628,7 +660,7 @@ assemble_level_operator()
 			UG_ASSERT(m_spSurfaceMat->num_rows() == m_vSurfToLevelMap.size(),
 			          "Surface Matrix rows != Surf Level Indices")
 
-			if (m_bMatrixStructureIsConst)
+			if (m_bMatrixStructureIsConst && !float_level(lev))
 				ld.A->clear_retain_structure();
 			else
 				ld.A->resize_and_clear(m_spSurfaceMat->num_rows(), m_spSurfaceMat->num_cols());
@@ -663,6 +695,19 @@ assemble_level_operator()
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  end   assemble_level_operator: copy mat on lev "<<lev<<"\n");
 		}
 
+	//	convert to single precision and release the double precision matrix
+		if(float_level(lev))
+		{
+			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_ConvertToFloat);
+			try{
+				write_debug(*ld.A, "LevelMatrix", *ld.st, *ld.st);
+				ld.Op = CreateFloatMatrixOperator<TAlgebra>(*ld.A);
+				ld.A = make_sp(new MatrixOperator<matrix_type, vector_type>());
+			}
+			UG_CATCH_THROW("GMG:init: Cannot create single precision operator for level "<<lev);
+			GMG_PROFILE_END();
+		}
+
 		if(m_pSurfaceSol && lev > m_baseLev)
 		{
 			#ifdef UG_PARALLEL
@@ -691,6 +736,7 @@ assemble_level_operator()
 
 //	write computed level matrices for debug purpose
 	for(int lev = m_baseLev; lev <= m_topLev; ++lev){
+		if(float_level(lev)) continue;
 		LevData& ld = *m_vLevData[lev];
 		write_debug(*ld.A, "LevelMatrix", *ld.st, *ld.st);
 	}
@@ -965,6 +1011,7 @@ init_rap_operator()
 
 //	write computed level matrices for debug purpose
 	for(int lev = m_baseLev; lev <= m_topLev; ++lev){
+		if(float_level(lev)) continue;
 		LevData& ld = *m_vLevData[lev];
 		write_debug(*ld.A, "LevelMatrix", *ld.st, *ld.st);
 	}
@@ -1147,7 +1194,7 @@ init_smoother()
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  init_smoother: initializing pre-smoother on lev "<<lev<<"\n");
 		bool success;
 		GridLevel gw_gl; enter_debug_writer_section(gw_gl, "PreSmootherInit", lev);
-		try {success = ld.PreSmoother->init(ld.A, *ld.sc);}
+		try {success = init_level_smoother(*ld.PreSmoother, lev);}
 		UG_CATCH_THROW("GMG::init: Cannot init pre-smoother for level "<<lev);
 		leave_debug_writer_section(gw_gl);
 		if (!success)
@@ -1157,7 +1204,7 @@ init_smoother()
 		if(ld.PreSmoother != ld.PostSmoother)
 		{
 			GridLevel gw_gl; enter_debug_writer_section(gw_gl, "PostSmootherInit", lev);
-			try {success = ld.PostSmoother->init(ld.A, *ld.sc);}
+			try {success = init_level_smoother(*ld.PostSmoother, lev);}
 			UG_CATCH_THROW("GMG::init: Cannot init post-smoother for level "<<lev);
 			leave_debug_writer_section(gw_gl);
 			if (!success)
@@ -1168,6 +1215,47 @@ init_smoother()
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-stop init_smoother\n");
 }
 
+template <typename TDomain, typename TAlgebra>
+bool AssembledMultiGridCycle<TDomain, TAlgebra>::
+matrix_free_level(int lev) const
+{
+	return !m_bUseRAP && m_matrixFreeLev >= 0 && lev >= m_matrixFreeLev
+			&& lev > m_baseLev && lev <= m_LocalFullRefLevel;
+}
+
+template <typename TDomain, typename TAlgebra>
+bool AssembledMultiGridCycle<TDomain, TAlgebra>::
+float_level(int lev) const
+{
+	return !matrix_free_level(lev) && !m_bUseRAP && m_floatLev >= 0
+			&& lev >= m_floatLev && lev > m_baseLev && lev <= m_LocalFullRefLevel;
+}
+
+template <typename TDomain, typename TAlgebra>
+bool AssembledMultiGridCycle<TDomain, TAlgebra>::
+init_level_smoother(ILinearIterator<vector_type>& smoother, int lev)
+{
+	LevData& ld = *m_vLevData[lev];
+
+//	on single precision levels the smoother gets the single precision operator
+	if(float_level(lev))
+		return smoother.init(ld.Op, *ld.sc);
+
+	if(!matrix_free_level(lev))
+		return smoother.init(ld.A, *ld.sc);
+
+//	on matrix-free levels the smoother uses the diagonal as approximation and
+//	the matrix-free operator for its own defect updates
+	IPreconditioner<TAlgebra>* pPrecond = dynamic_cast<IPreconditioner<TAlgebra>*>(&smoother);
+	if(!pPrecond)
+		UG_THROW("GMG::init: Smoother "<<smoother.name()<<" cannot be used with "
+				"a matrix-free level operator on level "<<lev<<". Use a "
+				"smoother based on the diagonal (e.g. Jacobi).");
+
+	pPrecond->set_approximation(ld.A);
+	return pPrecond->init(ld.Op);
+}
+
 template <typename TDomain, typename TAlgebra>
 void AssembledMultiGridCycle<TDomain, TAlgebra>::
 init_base_solver()
@@ -1557,6 +1645,7 @@ init_level_memory(int baseLev, int topLev)
 
 		ld.A = SmartPtr<MatrixOperator<matrix_type, vector_type> >(
 				new MatrixOperator<matrix_type, vector_type>);
+		ld.Op = ld.A;
 
 		ld.PreSmoother = m_spPreSmootherPrototype->clone();
 		if(m_spPreSmootherPrototype == m_spPostSmootherPrototype)
@@ -1723,7 +1812,7 @@ presmooth_and_restriction(int lev)
 			}
 
 		//	c) update the defect with this correction ...
-			lf.A->apply_sub(*lf.sd, *lf.st);
+			lf.Op->apply_sub(*lf.sd, *lf.st);
 
 		//	d) ... and add the correction to the overall correction
 			if(nu < m_numPreSmooth-1)
@@ -1916,7 +2005,7 @@ prolongation_and_postsmooth(int lev)
 		for(int nu = 0; nu < m_numPostSmooth; ++nu)
 		{
 		//	update defect
-			lf.A->apply_sub(*lf.sd, *lf.st);
+			lf.Op->apply_sub(*lf.sd, *lf.st);
 
 			if(nu == 0){
 				log_debug_data(lev, lf.n_prolong_calls, "BeforePostSmooth");
@@ -1953,7 +2042,7 @@ prolongation_and_postsmooth(int lev)
 //	We also need it if we want to write stats or debug data
 	if(lev >= m_LocalFullRefLevel || m_mgstats.valid() || m_spDebugWriter.valid()){
 		GMG_PROFILE_BEGIN(GMG_UpdateDefectAfterPostSmooth);
-		lf.A->apply_sub(*lf.sd, *lf.st);
+		lf.Op->apply_sub(*lf.sd, *lf.st);
 		GMG_PROFILE_END();
 	}
 
@@ -2322,6 +2411,10 @@ config_string() const
 		ss << " Postsmoother ( " << m_numPostSmooth << "x): " << ConfigShift(m_spPostSmootherPrototype->config_string());
 	}
 	ss << "\n";
+	if(m_matrixFreeLev >= 0)
+		ss << " Matrix-free level operators from level " << m_matrixFreeLev << "\n";
+	if(m_floatLev >= 0)
+		ss << " Single precision level operators from level " << m_floatLev << "\n";
 	ss << " Basesolver ( Baselevel = " << m_baseLev << ", gathered base = " << (m_bGatheredBaseIfAmbiguous ? "true" : "false") << "): ";
 	ss << ConfigShift(m_spBaseSolver->config_string());
 	return ss.str();
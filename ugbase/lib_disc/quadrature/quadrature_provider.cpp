@@ -40,8 +40,10 @@
 #include "gauss_jacobi/gauss_jacobi20.h"
 #include "gauss_tensor_prod/gauss_tensor_prod.h"
 #include "lib_disc/reference_element/reference_element.h"
+#include "lib_disc/reference_element/reference_element_util.h"
 #include <algorithm>
 #include <locale>
+#include <mutex>
 
 namespace ug{
 
@@ -197,12 +199,31 @@ QuadratureRuleProvider<TDim>::create_newton_cotes_rule(ReferenceObjectID roid, s
 // general
 ////////////////////////////////////////////////////////////////////////////////
 
+///	mutex serializing the creation of rules that are not prepared in advance
+static std::mutex& QuadratureRuleCreationMutex()
+{
+	static std::mutex m;
+	return m;
+}
+
 template <int TDim>
 QuadratureRuleProvider<TDim>::QuadratureRuleProvider()
 {
 	for(int type = 0; type < NUM_QUADRATURE_TYPES; ++type)
 		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
 			m_vRule[type][roid].clear();
+
+//	create all rules of low order in advance
+	for(int type = 0; type < NUM_QUADRATURE_TYPES; ++type)
+		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+			for(size_t order = 0; order <= maxPreparedOrder; ++order)
+			{
+				if(ReferenceElementDimension((ReferenceObjectID)roid) != dim)
+					m_vPreparedRule[type][roid][order] = NULL;
+				else
+					m_vPreparedRule[type][roid][order] =
+						create_rule_of_type((ReferenceObjectID)roid, order, (QuadType)type);
+			}
 }
 
 template <int TDim>
@@ -210,9 +231,15 @@ QuadratureRuleProvider<TDim>::~QuadratureRuleProvider()
 {
 	for(int type = 0; type < NUM_QUADRATURE_TYPES; ++type)
 		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+		{
 			for(size_t order = 0; order < m_vRule[type][roid].size(); ++order)
 				if(m_vRule[type][roid][order] != NULL)
 					delete m_vRule[type][roid][order];
+
+			for(size_t order = 0; order <= maxPreparedOrder; ++order)
+				if(m_vPreparedRule[type][roid][order] != NULL)
+					delete m_vPreparedRule[type][roid][order];
+		}
 }
 
 template <int TDim>
@@ -221,6 +248,18 @@ QuadratureRuleProvider<TDim>::get_quad_rule(ReferenceObjectID roid,
                                             size_t order,
                                             QuadType type)
 {
+	//	prepared rules are read-only and need no locking
+	if(order <= maxPreparedOrder)
+	{
+		const QuadratureRule<TDim>* rule = m_vPreparedRule[type][roid][order];
+		if(rule == NULL)
+			UG_THROW("QuadratureRuleProvider<"<<dim<<">: Cannot create rule for "
+					                  <<roid<<", order "<<order<<" and type "<<type);
+		return *rule;
+	}
+
+	std::lock_guard<std::mutex> lock(QuadratureRuleCreationMutex());
+
 	//	check if order present, else resize and create
 	if(order >= m_vRule[type][roid].size() ||
 			m_vRule[type][roid][order] == NULL)
@@ -231,43 +270,51 @@ QuadratureRuleProvider<TDim>::get_quad_rule(ReferenceObjectID roid,
 }
 
 template <int TDim>
-void
-QuadratureRuleProvider<TDim>::create_rule(ReferenceObjectID roid,
-                                          size_t order,
-                                          QuadType type)
+const QuadratureRule<TDim>*
+QuadratureRuleProvider<TDim>::create_rule_of_type(ReferenceObjectID roid,
+                                                  size_t order,
+                                                  QuadType type)
 {
-//	resize vector if needed
-	if(m_vRule[type][roid].size() <= order) m_vRule[type][roid].resize(order+1, NULL);
-	if(m_vRule[type][roid][order] != NULL)
-		delete m_vRule[type][roid][order];
-	m_vRule[type][roid][order] = NULL;
-
+	const QuadratureRule<TDim>* rule = NULL;
 	switch(type){
 		case BEST: {
 			// 1. Try GaussQuad
-			m_vRule[type][roid][order] = create_gauss_rule(roid, order);
-			if(m_vRule[type][roid][order] != NULL) break;
+			rule = create_gauss_rule(roid, order);
+			if(rule != NULL) break;
 
 			// 2. Try Newton-Cotes
-				m_vRule[type][roid][order] = create_newton_cotes_rule(roid, order);
-			if(m_vRule[type][roid][order] != NULL) break;
+			rule = create_newton_cotes_rule(roid, order);
+			if(rule != NULL) break;
 
 			// 3. Try Gauss-Legendre
-				m_vRule[type][roid][order] = create_gauss_legendre_rule(roid, order);
-			if(m_vRule[type][roid][order] != NULL) break;
+			rule = create_gauss_legendre_rule(roid, order);
 		}break;
 		case GAUSS: {
-			m_vRule[type][roid][order] = create_gauss_rule(roid, order);
+			rule = create_gauss_rule(roid, order);
 		}break;
 		case GAUSS_LEGENDRE: {
-			m_vRule[type][roid][order] = create_gauss_legendre_rule(roid, order);
+			rule = create_gauss_legendre_rule(roid, order);
 		}break;
 		case NEWTON_COTES: {
-			m_vRule[type][roid][order] = create_newton_cotes_rule(roid, order);
+			rule = create_newton_cotes_rule(roid, order);
 		}break;
-		default: UG_THROW("QuadratureRuleProvider<"<<dim<<">: Cannot create rule for "
-		                  <<roid<<", order "<<order<<" and type "<<type);
+		default: rule = NULL;
 	}
+	return rule;
+}
+
+template <int TDim>
+void
+QuadratureRuleProvider<TDim>::create_rule(ReferenceObjectID roid,
+                                          size_t order,
+                                          QuadType type)
+{
+//	resize vector if needed
+	if(m_vRule[type][roid].size() <= order) m_vRule[type][roid].resize(order+1, NULL);
+	if(m_vRule[type][roid][order] != NULL)
+		delete m_vRule[type][roid][order];
+
+	m_vRule[type][roid][order] = create_rule_of_type(roid, order, type);
 
 	if(m_vRule[type][roid][order] == NULL)
 		UG_THROW("QuadratureRuleProvider<"<<dim<<">: Cannot create rule for "
@@ -53,6 +53,11 @@ namespace ug{
  * This class serves as a provider for quadrature rules. It is templated for a
  * reference element dimension.
  *
+ * All rules up to order maxPreparedOrder are created when the provider is
+ * constructed (on first use). These are returned without any locking, so that
+ * the provider can be used concurrently by several threads. Rules of higher
+ * order are created on request, which is serialized by a mutex.
+ *
  * \tparam 	TDim	Reference Element Dimension
  */
 template <int TDim>
@@ -62,6 +67,9 @@ class QuadratureRuleProvider
 	///	dimension of reference element
 		static const int dim = TDim;
 
+	///	maximal order of the rules created in advance
+		static const size_t maxPreparedOrder = 12;
+
 	private:
 	///	private constructor performing standard registering
 		QuadratureRuleProvider();
@@ -85,6 +93,9 @@ class QuadratureRuleProvider
 	///	Vector, holding all registered rules
 		static std::vector<const QuadratureRule<TDim>*> m_vRule[NUM_QUADRATURE_TYPES][NUM_REFERENCE_OBJECTS];
 
+	///	rules created in advance (NULL if not available), read-only after construction
+		static const QuadratureRule<TDim>* m_vPreparedRule[NUM_QUADRATURE_TYPES][NUM_REFERENCE_OBJECTS][maxPreparedOrder+1];
+
 	///	provide rule, try to create it if not already present
 		static const QuadratureRule<TDim>&
 		get_quad_rule(ReferenceObjectID roid, size_t order, QuadType type);
@@ -92,6 +103,9 @@ class QuadratureRuleProvider
 	///	creates rule at this provider
 		static void create_rule(ReferenceObjectID roid, size_t order, QuadType type);
 
+	///	creates rule for a type, returns NULL if unavailable
+		static const QuadratureRule<TDim>* create_rule_of_type(ReferenceObjectID roid, size_t order, QuadType type);
+
 	///	rule creation, returns NULL if unavailable
 	/// \{
 		static const QuadratureRule<TDim>* create_gauss_rule(ReferenceObjectID roid, size_t order);
@@ -130,6 +144,9 @@ class QuadratureRuleProvider
 template <int dim>
 std::vector<const QuadratureRule<dim>*> QuadratureRuleProvider<dim>::m_vRule[NUM_QUADRATURE_TYPES][NUM_REFERENCE_OBJECTS];
 
+template <int dim>
+const QuadratureRule<dim>* QuadratureRuleProvider<dim>::m_vPreparedRule[NUM_QUADRATURE_TYPES][NUM_REFERENCE_OBJECTS][maxPreparedOrder+1];
+
 /// writes the Identifier to the output stream
 std::ostream& operator<<(std::ostream& out,	const QuadType& v);
 
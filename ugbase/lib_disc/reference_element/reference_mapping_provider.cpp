@@ -30,7 +30,6 @@
  * GNU Lesser General Public License for more details.
  */
 
-#include "common/util/provider.h"
 #include "reference_mapping_provider.h"
 #include "reference_mapping.h"
 
@@ -218,6 +217,23 @@ class DimReferenceMappingWrapper
 };
 
 
+/// mappings owned by a ReferenceMappingProvider
+struct ReferenceMappingProvider::Mappings
+{
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 1> > edge1;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 2> > edge2;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 3> > edge3;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 2> > triangle2;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 3> > triangle3;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 2> > quadrilateral2;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 3> > quadrilateral3;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceTetrahedron, 3> > tetrahedron;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferencePrism, 3> > prism;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferencePyramid, 3> > pyramid;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceHexahedron, 3> > hexahedron;
+	DimReferenceMappingWrapper<ReferenceMapping<ReferenceOctahedron, 3> > octahedron;
+};
+
 ReferenceMappingProvider::
 ReferenceMappingProvider()
 {
@@ -227,27 +243,37 @@ ReferenceMappingProvider()
 			for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
 				m_vvvMapping[d][rd][roid] = NULL;
 
+//	create the mappings of this provider
+	m_pMappings = new Mappings;
+	Mappings& m = *m_pMappings;
+
 //	set mappings
 
 //	edge
-	set_mapping<1,1>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 1> > >::get());
-	set_mapping<1,2>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 2> > >::get());
-	set_mapping<1,3>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 3> > >::get());
+	set_mapping<1,1>(ROID_EDGE, m.edge1);
+	set_mapping<1,2>(ROID_EDGE, m.edge2);
+	set_mapping<1,3>(ROID_EDGE, m.edge3);
 
 //	triangle
-	set_mapping<2,2>(ROID_TRIANGLE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 2> > >::get());
-	set_mapping<2,3>(ROID_TRIANGLE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 3> > >::get());
+	set_mapping<2,2>(ROID_TRIANGLE, m.triangle2);
+	set_mapping<2,3>(ROID_TRIANGLE, m.triangle3);
 
 //	quadrilateral
-	set_mapping<2,2>(ROID_QUADRILATERAL, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 2> > >::get());
-	set_mapping<2,3>(ROID_QUADRILATERAL, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 3> > >::get());
+	set_mapping<2,2>(ROID_QUADRILATERAL, m.quadrilateral2);
+	set_mapping<2,3>(ROID_QUADRILATERAL, m.quadrilateral3);
 
 //	3d elements
-	set_mapping<3,3>(ROID_TETRAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTetrahedron, 3> > >::get());
-	set_mapping<3,3>(ROID_PRISM, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePrism, 3> > >::get());
-	set_mapping<3,3>(ROID_PYRAMID, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePyramid, 3> > >::get());
-	set_mapping<3,3>(ROID_HEXAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceHexahedron, 3> > >::get());
-	set_mapping<3,3>(ROID_OCTAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceOctahedron, 3> > >::get());
+	set_mapping<3,3>(ROID_TETRAHEDRON, m.tetrahedron);
+	set_mapping<3,3>(ROID_PRISM, m.prism);
+	set_mapping<3,3>(ROID_PYRAMID, m.pyramid);
+	set_mapping<3,3>(ROID_HEXAHEDRON, m.hexahedron);
+	set_mapping<3,3>(ROID_OCTAHEDRON, m.octahedron);
+}
+
+ReferenceMappingProvider::
+~ReferenceMappingProvider()
+{
+	delete m_pMappings;
 }
 
 
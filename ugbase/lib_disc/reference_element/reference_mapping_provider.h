@@ -36,6 +36,7 @@
 
 #include "common/common.h"
 #include "common/math/ugmath.h"
+#include "common/util/openmp_util.h"
 #include "lib_grid/grid/grid_base_objects.h"
 
 namespace ug{
@@ -164,6 +165,10 @@ class DimReferenceMapping
 /// class to provide reference mappings
 /**
  *	This class provides references mappings. It is implemented as a Singleton.
+ *
+ *	The mappings hold the corners of the element they have been updated for.
+ *	If ug4 is compiled with OpenMP, each thread therefore has its own provider
+ *	and mappings.
  */
 class ReferenceMappingProvider {
 	private:
@@ -175,15 +180,19 @@ class ReferenceMappingProvider {
 		ReferenceMappingProvider& operator=(const ReferenceMappingProvider&);
 
 	// 	private destructor
-		~ReferenceMappingProvider(){};
+		~ReferenceMappingProvider();
 
-	// 	Singleton provider
+	// 	Singleton provider (one per thread)
 		static ReferenceMappingProvider& inst()
 		{
-			static ReferenceMappingProvider myInst;
+			static UG_THREAD_LOCAL ReferenceMappingProvider myInst;
 			return myInst;
 		};
 
+	//	storage of the mappings of this provider
+		struct Mappings;
+		Mappings* m_pMappings;
+
 	//	This is very dirty implementation, since casting to void. But, it is
 	//	efficient, easy and typesafe. Maybe it should be changed to something
 	//	inherent typesafe (not using casts) some day
@@ -36,6 +36,7 @@
 #include "lib_grid/tools/bool_marker.h"
 #include "lib_grid/tools/selector_grid.h"
 #include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
+#include "lib_disc/spatial_disc/local_to_global/matrix_scatter_map.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
 
 namespace ug{
@@ -107,7 +108,9 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true) {}
+		m_bMatrixIsConst(false), m_bMatrixStructureIsConst(false), m_bClearOnResize(true),
+		m_bThreadedAssembling(false), m_AssemblingChunkSize(1024),
+		m_bMatrixScatterCache(false) {}
 
 	/// destructor
 		virtual ~AssemblingTuner() {}
@@ -118,6 +121,9 @@ class AssemblingTuner
 			m_pMapper = pMapper;
 		}
 
+	///	returns if the default local to global mapping is used
+		bool default_mapping_used() const {return m_pMapper == NULL;}
+
 	/// LocalToGlobalMapper-function calls
 		void add_local_vec_to_global(vector_type& vec, const LocalVector& lvec,
 		                 ConstSmartPtr<DoFDistribution> dd) const
@@ -133,6 +139,8 @@ class AssemblingTuner
 		{
 			if (m_pMapper)
 				m_pMapper->add_local_mat_to_global(mat, lmat, dd);
+			else if (matrix_scatter_cache_used())
+				m_scatterMap.add(mat, lmat);
 			else
 				m_defaultMapper.add_local_mat_to_global(mat, lmat);
 		}
@@ -259,6 +267,66 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	///	returns if the matrix structure is kept from the last call
+		bool matrix_structure_is_const() const {return m_bMatrixStructureIsConst;}
+
+	///	enables the threaded element assembling
+	/**
+	 * If enabled, the elements are processed in chunks: corner coordinates,
+	 * indices and local solutions of a chunk are gathered in parallel, the
+	 * element discretizations are evaluated in parallel (if all of them
+	 * allow it, see IElemDiscBase::thread_safe_elem_evaluation) and the local
+	 * contributions are added to the global vector (and, if the matrix
+	 * structure is const, to the global matrix) in parallel using a coloring
+	 * of the chunk. Threads are only used if ug4 is compiled with OpenMP.
+	 */
+		void set_threaded_assembling(bool bEnable) {m_bThreadedAssembling = bEnable;}
+
+	///	returns if threaded element assembling is enabled
+		bool threaded_assembling_enabled() const {return m_bThreadedAssembling;}
+
+	///	sets the number of elements processed in one chunk by the threaded assembling
+		void set_assembling_chunk_size(size_t size)
+		{
+			UG_COND_THROW(size == 0, "Assembling chunk size must be positive.");
+			m_AssemblingChunkSize = size;
+		}
+
+	///	returns the number of elements processed in one chunk by the threaded assembling
+		size_t assembling_chunk_size() const {return m_AssemblingChunkSize;}
+
+	///	enables caching of the positions of local matrix entries in the global matrix
+	/**
+	 * If enabled, the positions of the entries of all local matrices in the
+	 * global matrix are recorded and reused as long as the DoFDistribution is
+	 * not changed, such that the local matrices are added without searching
+	 * the rows of the global matrix. The structure of the matrix is kept
+	 * between the assemblings. The positions are recorded in the second
+	 * assembling and used from the third one on (see MatrixScatterMap).
+	 * The cache is only used with the default local-to-global mapping.
+	 */
+		void set_matrix_scatter_cache(bool bEnable) {m_bMatrixScatterCache = bEnable;}
+
+	///	returns if the caching of matrix positions is enabled
+		bool matrix_scatter_cache_enabled() const {return m_bMatrixScatterCache;}
+
+	///	returns if the cached positions are used in the current matrix assembling
+		bool matrix_scatter_cache_replayed() const
+		{
+			return matrix_scatter_cache_used() && m_scatterMap.replaying();
+		}
+
+	///	returns the cache of matrix positions
+		MatrixScatterMap<matrix_type>& matrix_scatter_map() const {return m_scatterMap;}
+
+	protected:
+	///	returns if the cache of matrix positions is used for the assembling
+		bool matrix_scatter_cache_used() const
+		{
+			return m_bMatrixScatterCache && m_pMapper == NULL
+					&& !m_bSingleAssIndex && m_bClearOnResize;
+		}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_defaultMapper;
@@ -297,6 +365,18 @@ class AssemblingTuner
 
 	/// disables clearing of vector/matrix on resize
 		bool m_bClearOnResize;
+
+	/// enables threaded element assembling
+		bool m_bThreadedAssembling;
+
+	/// number of elements per chunk for threaded element assembling
+		size_t m_AssemblingChunkSize;
+
+	/// enables caching of matrix positions
+		bool m_bMatrixScatterCache;
+
+	/// cached positions of local matrix entries in the global matrix
+		mutable MatrixScatterMap<matrix_type> m_scatterMap;
 };
 
 } // end namespace ug
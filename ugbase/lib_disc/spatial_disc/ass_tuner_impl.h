@@ -63,7 +63,9 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 	else
 	{
 		const size_t numIndex = dd->num_indices();
-		if (m_bClearOnResize)
+		if (matrix_scatter_cache_used())
+			m_scatterMap.begin(*dd, mat);
+		else if (m_bClearOnResize)
 		{
 			if (m_bMatrixStructureIsConst)
 			{
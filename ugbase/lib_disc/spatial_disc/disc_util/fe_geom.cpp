@@ -68,6 +68,10 @@ void
 DimFEGeometry<TWorldDim,TRefDim>::
 update_local(ReferenceObjectID roid, const LFEID& lfeID, size_t orderQuad)
 {
+//	cached element data is only valid for the same integration points and
+//	shape functions
+	if((int)orderQuad != m_quadOrder || lfeID != m_lfeID) m_geomCache.clear();
+
 //	remember current setting
 	m_roid = roid;
 	m_lfeID = lfeID;
@@ -137,6 +141,30 @@ update(GridObject* pElem, const MathVector<worldDim>* vCorner,
 	if(roid != m_roid || lfeID != m_lfeID || (int)orderQuad != m_quadOrder)
 		update_local(roid, lfeID, orderQuad);
 
+//	restore the element data from the geometry cache if present
+	const number* vCoord = &vCorner[0][0];
+	const size_t numCoord = ReferenceElementProvider::get(roid).num(0) * worldDim;
+	const size_t dataSize = m_nip * (sizeof(MathVector<worldDim>)
+						+ sizeof(MathMatrix<worldDim,dim>)) / sizeof(number) + m_nip;
+	if(ElemGeomCache::enabled())
+	{
+		const number* p = m_geomCache.find(pElem, vCoord, numCoord, dataSize);
+		if(p != NULL)
+		{
+			for(size_t ip = 0; ip < m_nip; ++ip){
+				ReadFromGeomCache(m_vIPGlobal[ip], p);
+				ReadFromGeomCache(m_vJTInv[ip], p);
+				ReadFromGeomCache(m_vDetJ[ip], p);
+			}
+
+			for(size_t ip = 0; ip < m_nip; ++ip)
+				for(size_t sh = 0; sh < m_nsh; ++sh)
+					MatVecMult(m_vvGradGlobal[ip][sh],
+					           m_vJTInv[ip], m_vvGradLocal[ip][sh]);
+			return;
+		}
+	}
+
 //	get reference element mapping
 	try{
 	DimReferenceMapping<dim, worldDim>& map
@@ -156,6 +184,17 @@ update(GridObject* pElem, const MathVector<worldDim>* vCorner,
 			           m_vJTInv[ip], m_vvGradLocal[ip][sh]);
 
 	}UG_CATCH_THROW("FEGeometry::update: Reference Mapping error.");
+
+//	store the element data in the geometry cache
+	if(ElemGeomCache::enabled())
+	{
+		number* p = m_geomCache.insert(pElem, vCoord, numCoord, dataSize);
+		for(size_t ip = 0; ip < m_nip; ++ip){
+			WriteToGeomCache(p, m_vIPGlobal[ip]);
+			WriteToGeomCache(p, m_vJTInv[ip]);
+			WriteToGeomCache(p, m_vDetJ[ip]);
+		}
+	}
 }
 
 template <int TWorldDim, int TRefDim>
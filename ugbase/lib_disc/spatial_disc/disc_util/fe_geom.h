@@ -39,6 +39,7 @@
 #include "lib_disc/reference_element/reference_mapping_provider.h"
 #include "lib_disc/reference_element/reference_mapping.h"
 #include "common/util/provider.h"
+#include "geom_cache.h"
 
 #include <cmath>
 
@@ -174,6 +175,9 @@ class FEGeometry
 
 	///	determinate of transformation at ip
 		number m_vDetJ[nip];
+
+	///	cache of the element dependent data
+		ElemGeomCache m_geomCache;
 };
 
 
@@ -465,6 +469,9 @@ class DimFEGeometry
 
 	///	local gradient evaluated at ip (size = nip x nsh)
 		std::vector<std::vector<MathVector<worldDim> > > m_vvGradGlobal;
+
+	///	cache of the element dependent data
+		ElemGeomCache m_geomCache;
 };
 
 } // end namespace ug
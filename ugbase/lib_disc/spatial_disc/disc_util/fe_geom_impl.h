@@ -91,12 +91,39 @@ update(GridObject* elem, const MathVector<worldDim>* vCorner,
 //	update the mapping for the new corners
 	m_mapping.update(vCorner);
 
-//	compute global integration points
-	m_mapping.local_to_global(&m_vIPGlobal[0], local_ips(), nip);
+//	restore the element data from the geometry cache if present
+	const number* vCoord = &vCorner[0][0];
+	const size_t numCoord = ref_elem_type::numCorners * worldDim;
+	const size_t dataSize
+		= (sizeof(m_vIPGlobal) + sizeof(m_vJTInv) + sizeof(m_vDetJ)) / sizeof(number);
+	const number* pCached = NULL;
+	if(ElemGeomCache::enabled())
+		pCached = m_geomCache.find(pElem, vCoord, numCoord, dataSize);
 
-//	evaluate global data
-	m_mapping.jacobian_transposed_inverse(&m_vJTInv[0], &m_vDetJ[0],
-	                                      local_ips(), nip);
+	if(pCached != NULL)
+	{
+		ReadFromGeomCache(m_vIPGlobal, pCached);
+		ReadFromGeomCache(m_vJTInv, pCached);
+		ReadFromGeomCache(m_vDetJ, pCached);
+	}
+	else
+	{
+	//	compute global integration points
+		m_mapping.local_to_global(&m_vIPGlobal[0], local_ips(), nip);
+
+	//	evaluate global data
+		m_mapping.jacobian_transposed_inverse(&m_vJTInv[0], &m_vDetJ[0],
+		                                      local_ips(), nip);
+
+	//	store the element data in the geometry cache
+		if(ElemGeomCache::enabled())
+		{
+			number* p = m_geomCache.insert(pElem, vCoord, numCoord, dataSize);
+			WriteToGeomCache(p, m_vIPGlobal);
+			WriteToGeomCache(p, m_vJTInv);
+			WriteToGeomCache(p, m_vDetJ);
+		}
+	}
 
 // 	compute global gradients
 	for(size_t ip = 0; ip < nip; ++ip)
@@ -336,6 +336,24 @@ update(GridObject* elem, const MathVector<worldDim>* vCornerCoords, const ISubse
 // 	if already update for this element, do nothing
 	if(m_pElem == pElem) return; else m_pElem = pElem;
 
+//	restore the element data from the geometry cache if present
+	const number* vCoord = &vCornerCoords[0][0];
+	const size_t numCoord = ref_elem_type::numCorners * worldDim;
+	if(ElemGeomCache::enabled())
+	{
+		const number* pData = m_geomCache.find(pElem, vCoord, numCoord,
+		                                       cache_data_size());
+		if(pData != NULL)
+		{
+			read_from_cache(pData);
+			m_mapping.update(vCornerCoords);
+
+			if(num_boundary_subsets() != 0 && ish != NULL)
+				update_boundary_faces(pElem, vCornerCoords, ish);
+			return;
+		}
+	}
+
 // 	remember global position of nodes
 	for(size_t i = 0; i < m_rRefElem.num(0); ++i)
 		m_vvGloMid[0][i] = vCornerCoords[i];
@@ -458,11 +476,133 @@ update(GridObject* elem, const MathVector<worldDim>* vCornerCoords, const ISubse
 		for(size_t i = 0; i < num_scv(); ++i)
 			m_vGlobSCV_IP[i] = scv(i).global_ip();
 
+//	store the element data in the geometry cache
+	if(ElemGeomCache::enabled())
+		write_to_cache(m_geomCache.insert(pElem, vCoord, numCoord, cache_data_size()));
+
 //	if no boundary subsets required, return
 	if(num_boundary_subsets() == 0 || ish == NULL) return;
 	else update_boundary_faces(pElem, vCornerCoords, ish);
 }
 
+/*
+ * The cached data of an element consists of the global midpoints, the scvf
+ * normals, the scv volumes and the jacobians (only once for linear mappings).
+ * All other element dependent data is copied from the midpoints or is a
+ * single matrix-vector product with the cached jacobians.
+ */
+template <typename TElem, int TWorldDim, bool TCondensed>
+size_t FV1Geometry_gen<TElem, TWorldDim, TCondensed>::
+cache_data_size() const
+{
+	const size_t numJac = ReferenceMapping<ref_elem_type, worldDim>::isLinear
+							? 1 : (numSCVF + numSCV);
+	return (sizeof(m_vvGloMid) + numSCVF * sizeof(MathVector<worldDim>)
+			+ numJac * sizeof(MathMatrix<worldDim,dim>)) / sizeof(number)
+			+ numSCV + numJac;
+}
+
+template <typename TElem, int TWorldDim, bool TCondensed>
+void FV1Geometry_gen<TElem, TWorldDim, TCondensed>::
+write_to_cache(number* p) const
+{
+	WriteToGeomCache(p, m_vvGloMid);
+
+	for(size_t i = 0; i < numSCVF; ++i)
+		WriteToGeomCache(p, m_vSCVF[i].Normal);
+
+	for(size_t i = 0; i < numSCV; ++i)
+		WriteToGeomCache(p, m_vSCV[i].Vol);
+
+	if(ReferenceMapping<ref_elem_type, worldDim>::isLinear)
+	{
+		WriteToGeomCache(p, m_vSCVF[0].JtInv);
+		WriteToGeomCache(p, m_vSCVF[0].detj);
+	}
+	else
+	{
+		for(size_t i = 0; i < numSCVF; ++i){
+			WriteToGeomCache(p, m_vSCVF[i].JtInv);
+			WriteToGeomCache(p, m_vSCVF[i].detj);
+		}
+		for(size_t i = 0; i < numSCV; ++i){
+			WriteToGeomCache(p, m_vSCV[i].JtInv);
+			WriteToGeomCache(p, m_vSCV[i].detj);
+		}
+	}
+}
+
+template <typename TElem, int TWorldDim, bool TCondensed>
+void FV1Geometry_gen<TElem, TWorldDim, TCondensed>::
+read_from_cache(const number* p)
+{
+	ReadFromGeomCache(m_vvGloMid, p);
+
+	for(size_t i = 0; i < numSCVF; ++i)
+		ReadFromGeomCache(m_vSCVF[i].Normal, p);
+
+	for(size_t i = 0; i < numSCV; ++i)
+		ReadFromGeomCache(m_vSCV[i].Vol, p);
+
+	if(ReferenceMapping<ref_elem_type, worldDim>::isLinear)
+	{
+		MathMatrix<worldDim,dim> JtInv;
+		number detJ;
+		ReadFromGeomCache(JtInv, p);
+		ReadFromGeomCache(detJ, p);
+
+		for(size_t i = 0; i < numSCVF; ++i){
+			m_vSCVF[i].JtInv = JtInv;
+			m_vSCVF[i].detj = detJ;
+		}
+		for(size_t i = 0; i < numSCV; ++i){
+			m_vSCV[i].JtInv = JtInv;
+			m_vSCV[i].detj = detJ;
+		}
+	}
+	else
+	{
+		for(size_t i = 0; i < numSCVF; ++i){
+			ReadFromGeomCache(m_vSCVF[i].JtInv, p);
+			ReadFromGeomCache(m_vSCVF[i].detj, p);
+		}
+		for(size_t i = 0; i < numSCV; ++i){
+			ReadFromGeomCache(m_vSCV[i].JtInv, p);
+			ReadFromGeomCache(m_vSCV[i].detj, p);
+		}
+	}
+
+//	corners and integration points of scvf
+	for(size_t i = 0; i < numSCVF; ++i)
+	{
+		CopyCornerByMidID<worldDim, maxMid>(m_vSCVF[i].vGloPos, m_vSCVF[i].vMidID, m_vvGloMid, SCVF::numCo);
+
+		if (! condensed_scvf_ips)
+			AveragePositions(m_vSCVF[i].globalIP, m_vSCVF[i].vGloPos, SCVF::numCo);
+		else
+			m_vSCVF[i].globalIP = m_vSCVF[i].vGloPos[0];
+
+		m_vGlobSCVF_IP[i] = m_vSCVF[i].globalIP;
+	}
+
+//	corners of scv
+	for(size_t i = 0; i < numSCV; ++i)
+		CopyCornerByMidID<worldDim, maxMid>(m_vSCV[i].vGloPos, m_vSCV[i].midId, m_vvGloMid, m_vSCV[i].num_corners());
+
+	if(ref_elem_type::REFERENCE_OBJECT_ID == ROID_PYRAMID || ref_elem_type::REFERENCE_OBJECT_ID == ROID_OCTAHEDRON)
+		for(size_t i = 0; i < numSCV; ++i)
+			m_vGlobSCV_IP[i] = m_vSCV[i].global_ip();
+
+//	global gradients
+	for(size_t i = 0; i < numSCVF; ++i)
+		for(size_t sh = 0 ; sh < nsh; ++sh)
+			MatVecMult(m_vSCVF[i].vGlobalGrad[sh], m_vSCVF[i].JtInv, m_vSCVF[i].vLocalGrad[sh]);
+
+	for(size_t i = 0; i < numSCV; ++i)
+		for(size_t sh = 0 ; sh < nsh; ++sh)
+			MatVecMult(m_vSCV[i].vGlobalGrad[sh], m_vSCV[i].JtInv, m_vSCV[i].vLocalGrad[sh]);
+}
+
 template <typename TElem, int TWorldDim, bool TCondensed>
 void FV1Geometry_gen<TElem, TWorldDim, TCondensed>::
 update_boundary_faces(GridObject* elem, const MathVector<worldDim>* vCornerCoords, const ISubsetHandler* ish)
@@ -52,6 +52,7 @@
 #include "lib_disc/quadrature/gauss/gauss_quad.h"
 #include "fv_util.h"
 #include "fv_geom_base.h"
+#include "geom_cache.h"
 
 namespace ug{
 
@@ -623,6 +624,19 @@ class FV1Geometry_gen : public FVGeometryBase
 		std::map<int, std::vector<BF> > m_mapVectorBF;
 		std::vector<BF> m_vEmptyVectorBF;
 
+	protected:
+	///	number of values stored per element in the geometry cache
+		size_t cache_data_size() const;
+
+	///	writes the element dependent data to the geometry cache
+		void write_to_cache(number* p) const;
+
+	///	restores the element dependent data from the geometry cache
+		void read_from_cache(const number* p);
+
+	///	cache of the element dependent data
+		ElemGeomCache m_geomCache;
+
 	private:
 	///	pointer to current element
 		TElem* m_pElem;
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include "geom_cache.h"
+
+namespace ug{
+
+bool ElemGeomCache::s_bEnabled = false;
+size_t ElemGeomCache::s_revision = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+//	grid observer
+////////////////////////////////////////////////////////////////////////////////
+
+///	invalidates the geometry caches if elements of a grid are erased
+class GeomCacheGridObserver : public GridObserver
+{
+	public:
+		GeomCacheGridObserver(Grid& grid) : m_pGrid(&grid)
+		{
+			grid.register_observer(this, OT_GRID_OBSERVER | OT_EDGE_OBSERVER
+			                             | OT_FACE_OBSERVER | OT_VOLUME_OBSERVER);
+		}
+
+		virtual ~GeomCacheGridObserver()
+		{
+			if(m_pGrid) m_pGrid->unregister_observer(this);
+		}
+
+		Grid* grid() const {return m_pGrid;}
+
+		virtual void grid_to_be_destroyed(Grid* grid)
+		{
+		//	the grid unregisters all observers itself
+			ElemGeomCache::invalidate();
+			m_pGrid = NULL;
+		}
+
+		virtual void elements_to_be_cleared(Grid* grid)
+			{ElemGeomCache::invalidate();}
+
+		virtual void edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy)
+			{ElemGeomCache::invalidate();}
+
+		virtual void face_to_be_erased(Grid* grid, Face* f, Face* replacedBy)
+			{ElemGeomCache::invalidate();}
+
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy)
+			{ElemGeomCache::invalidate();}
+
+	private:
+		Grid* m_pGrid;
+};
+
+///	observers of all grids the caches are enabled for
+static std::vector<GeomCacheGridObserver*>& GeomCacheObservers()
+{
+	static std::vector<GeomCacheGridObserver*> vObserver;
+	return vObserver;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	ElemGeomCache
+////////////////////////////////////////////////////////////////////////////////
+
+void ElemGeomCache::clear()
+{
+	m_hash = Hash<const GridObject*, Slot>(1);
+	std::vector<number>().swap(m_vData);
+	m_revision = s_revision;
+}
+
+void ElemGeomCache::enable(Grid& grid)
+{
+	std::vector<GeomCacheGridObserver*>& vObserver = GeomCacheObservers();
+
+	bool bObserved = false;
+	for(size_t i = 0; i < vObserver.size(); ++i)
+		if(vObserver[i]->grid() == &grid) bObserved = true;
+
+	if(!bObserved)
+		vObserver.push_back(new GeomCacheGridObserver(grid));
+
+	s_bEnabled = true;
+}
+
+void ElemGeomCache::disable()
+{
+	std::vector<GeomCacheGridObserver*>& vObserver = GeomCacheObservers();
+	for(size_t i = 0; i < vObserver.size(); ++i)
+		delete vObserver[i];
+	vObserver.clear();
+
+	s_bEnabled = false;
+	invalidate();
+}
+
+} // end namespace ug
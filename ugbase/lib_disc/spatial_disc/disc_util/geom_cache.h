@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_CACHE__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_CACHE__
+
+#include <vector>
+#include <cstring>
+#include "common/types.h"
+#include "common/util/hash.h"
+#include "lib_grid/grid/grid.h"
+
+namespace ug{
+
+///	hash key of an element used by the geometry cache (the address)
+template <>
+inline size_t hash_key<const GridObject*>(const GridObject* const& key)
+{
+	return reinterpret_cast<size_t>(key) >> 3;
+}
+
+/// Persistent per-element storage of geometry data
+/**
+ * The finite element and finite volume geometries recompute jacobians,
+ * normals, volumes and global gradients whenever they are updated for an
+ * element. On static meshes these values do not change between the
+ * assemblings (Newton steps, time steps), so that the geometries can store
+ * the element dependent part of their data in an ElemGeomCache and restore it
+ * on subsequent updates for the same element.
+ *
+ * Each geometry instance owns one cache. The data of an element is stored
+ * as a flat array of numbers, whose layout is defined by the geometry. The
+ * cache does not know the local finite element or the quadrature order the
+ * data has been computed for: a geometry must clear its cache whenever those
+ * change. As a safeguard, the size of the stored data is compared on every
+ * lookup.
+ *
+ * Caching is disabled by default and must be enabled explicitly by
+ * ElemGeomCache::enable. The stored data is dropped whenever the revision of
+ * the caches changes, which happens if elements of an observed grid are
+ * erased, if the grid is destroyed or if ElemGeomCache::invalidate is called.
+ * In addition, the corner coordinates of an element are stored with its data
+ * and compared on every lookup. Moved vertices thus never lead to outdated
+ * geometry data, but the storage of the old data is only released on the next
+ * revision change.
+ *
+ * The cache is not thread-safe.
+ */
+class ElemGeomCache
+{
+	public:
+	///	constructor
+		ElemGeomCache() : m_hash(1), m_revision(s_revision) {}
+
+	///	returns the cached data of an element or NULL if not present
+	/**
+	 * The data is only returned if the element has been inserted with the
+	 * same corner coordinates and the same size of data.
+	 *
+	 * \param[in]	elem		element
+	 * \param[in]	vCoord		corner coordinates of the element (flat)
+	 * \param[in]	numCoord	number of coordinate entries
+	 * \param[in]	dataSize	expected number of data entries
+	 * \returns		pointer to the cached data or NULL
+	 */
+		const number* find(const GridObject* elem, const number* vCoord,
+		                   size_t numCoord, size_t dataSize)
+		{
+			if(m_revision != s_revision) clear();
+
+			Slot slot;
+			if(!m_hash.get_entry(slot, elem)) return NULL;
+			if(slot.numCoord != numCoord || slot.dataSize != dataSize) return NULL;
+
+			const number* p = &m_vData[slot.offset];
+			for(size_t i = 0; i < numCoord; ++i)
+				if(p[i] != vCoord[i]) return NULL;
+
+			return p + numCoord;
+		}
+
+	///	returns storage for the data of an element
+	/**
+	 * The corner coordinates are copied to the cache and a pointer to the
+	 * storage of dataSize numbers is returned, that has to be filled by the
+	 * caller.
+	 */
+		number* insert(const GridObject* elem, const number* vCoord,
+		               size_t numCoord, size_t dataSize)
+		{
+			if(m_revision != s_revision) clear();
+
+		//	reuse the old storage of the element, if sizes match
+			Slot slot;
+			if(m_hash.get_entry(slot, elem)){
+				if(slot.numCoord != numCoord || slot.dataSize != dataSize){
+					slot.offset = m_vData.size();
+					m_vData.resize(m_vData.size() + numCoord + dataSize);
+				}
+				slot.numCoord = numCoord; slot.dataSize = dataSize;
+				m_hash.get_entry(elem) = slot;
+			}
+			else{
+				slot.offset = m_vData.size();
+				slot.numCoord = numCoord; slot.dataSize = dataSize;
+				m_vData.resize(m_vData.size() + numCoord + dataSize);
+
+				if(m_hash.size() >= 2 * m_hash.hash_size())
+					m_hash.resize_hash(4 * m_hash.hash_size());
+				m_hash.insert(elem, slot);
+			}
+
+			number* p = &m_vData[slot.offset];
+			memcpy(p, vCoord, numCoord * sizeof(number));
+			return p + numCoord;
+		}
+
+	///	removes all stored data and releases the memory
+		void clear();
+
+	///	number of elements stored
+		size_t num_elements() const {return m_hash.size();}
+
+	///	number of bytes used for the stored data
+		size_t data_size() const {return m_vData.capacity() * sizeof(number);}
+
+	public:
+	///	enables the caching for all geometries
+		static void enable()	{s_bEnabled = true;}
+
+	///	enables the caching and drops the cached data whenever elements of the grid are erased
+		static void enable(Grid& grid);
+
+	///	disables the caching and releases all observed grids
+	/**	Note, that the memory of the caches is released on their next use.*/
+		static void disable();
+
+	///	returns if caching is enabled
+		static bool enabled()	{return s_bEnabled;}
+
+	///	invalidates the data of all caches
+	/**	This must be called if the geometry of a mesh changes and old data
+	 * should be released immediately.*/
+		static void invalidate()	{++s_revision;}
+
+	protected:
+	///	position of the data of an element
+		struct Slot
+		{
+			size_t offset;
+			size_t numCoord;
+			size_t dataSize;
+		};
+
+	///	element -> position of its data
+		Hash<const GridObject*, Slot> m_hash;
+
+	///	cached data (coordinates followed by geometry data, per element)
+		std::vector<number> m_vData;
+
+	///	revision the cached data belongs to
+		size_t m_revision;
+
+	protected:
+	///	flag if caching is enabled
+		static bool s_bEnabled;
+
+	///	current revision
+		static size_t s_revision;
+};
+
+///	copies a value to the data of a geometry cache and advances the pointer
+template <typename T>
+inline void WriteToGeomCache(number*& p, const T& val)
+{
+	const size_t numBytes = sizeof(T);
+	memcpy(p, &val, numBytes);
+	p += numBytes / sizeof(number);
+}
+
+///	reads a value from the data of a geometry cache and advances the pointer
+template <typename T>
+inline void ReadFromGeomCache(T& val, const number*& p)
+{
+	const size_t numBytes = sizeof(T);
+	memcpy(static_cast<void*>(&val), p, numBytes);
+	p += numBytes / sizeof(number);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_CACHE__ */
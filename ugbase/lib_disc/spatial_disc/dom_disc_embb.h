@@ -201,6 +201,8 @@ public:
 
 public:
 
+//	Note: The snapshot of the topology (pTopo) is not used by this assembler.
+
 	template <typename TElem, typename TIterator>
 	void
 	AssembleStiffnessMatrix(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
@@ -211,7 +213,8 @@ public:
 								int si, bool bNonRegularGrid,
 								matrix_type& A,
 								const vector_type& u,
-								ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+								ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+								const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -223,7 +226,8 @@ public:
 						int si, bool bNonRegularGrid,
 						matrix_type& M,
 						const vector_type& u,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -235,7 +239,8 @@ public:
 						int si, bool bNonRegularGrid,
 						matrix_type& J,
 						const vector_type& u,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -248,7 +253,8 @@ public:
 						matrix_type& J,
 						ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 						number s_a0,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -260,7 +266,8 @@ public:
 					int si, bool bNonRegularGrid,
 					vector_type& d,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -274,7 +281,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -286,7 +294,8 @@ public:
 					int si, bool bNonRegularGrid,
 					matrix_type& A,
 					vector_type& rhs,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL);
 
 	template <typename TElem, typename TIterator>
 	void
@@ -301,7 +310,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner);
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Assemble Rhs: it cannot be done for the ghost-fluid method independently of the matrix
@@ -319,7 +329,8 @@ public:
 					int si, bool bNonRegularGrid,
 					vector_type& rhs,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 		UG_THROW ("LSGFGlobAssembler::AssembleRhs: Cannot assemble the RHS in GF independently of the matrix");
 	}
@@ -336,7 +347,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 		UG_THROW ("LSGFGlobAssembler::AssembleRhs: Cannot assemble the RHS in GF independently of the matrix");
 	}
@@ -65,7 +65,8 @@ AssembleStiffnessMatrix(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 							int si, bool bNonRegularGrid,
 							matrix_type& A,
 							const vector_type& u,
-							ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+							ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+							const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -223,7 +224,8 @@ AssembleMassMatrix( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 					int si, bool bNonRegularGrid,
 					matrix_type& M,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -381,7 +383,8 @@ AssembleJacobian(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 					int si, bool bNonRegularGrid,
 					matrix_type& J,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -547,7 +550,8 @@ AssembleJacobian(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 					matrix_type& J,
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					number s_a0,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -752,7 +756,8 @@ AssembleDefect( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 				int si, bool bNonRegularGrid,
 				vector_type& d,
 				const vector_type& u,
-				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+				const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -965,7 +970,8 @@ AssembleDefect( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 				ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 				const std::vector<number>& vScaleMass,
 				const std::vector<number>& vScaleStiff,
-				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+				const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -1269,7 +1275,8 @@ AssembleLinear( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 				int si, bool bNonRegularGrid,
 				matrix_type& A,
 				vector_type& rhs,
-				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+				const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
@@ -1406,7 +1413,8 @@ AssembleLinear( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 				ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 				const std::vector<number>& vScaleMass,
 				const std::vector<number>& vScaleStiff,
-				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+				ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+				const FrozenTopology<domain_type>* pTopo)
 {
 //	check the dof distribution for the ghost-fluid method
 	m_extrapol.check_dd (dd);
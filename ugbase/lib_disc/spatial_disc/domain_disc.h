@@ -43,6 +43,7 @@
 #include "lib_algebra/cpu_algebra_types.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_assemble_util.h"
+#include "lib_disc/frozen_topology.h"
 #include "lib_disc/spatial_disc/constraints/constraint_interface.h"
 #include "disc_item.h"
 #include "lib_disc/spatial_disc/domain_disc_interface.h"
@@ -108,7 +109,8 @@ class DomainDiscretizationBase
 	///	default Constructor
 		DomainDiscretizationBase(SmartPtr<approx_space_type> pApproxSpace) :
 			m_bErrorCalculated(false),
-			m_spApproxSpace(pApproxSpace), m_spAssTuner(new AssemblingTuner<TAlgebra>)
+			m_spApproxSpace(pApproxSpace), m_spAssTuner(new AssemblingTuner<TAlgebra>),
+			m_bFrozenTopology(false)
 		{};
 
 	/// virtual destructor
@@ -319,6 +321,28 @@ public:
 		virtual ConstSmartPtr<AssemblingTuner<TAlgebra> > ass_tuner() const {return m_spAssTuner;}
 	/// \}
 
+	///	enables a snapshot of the topology for the threaded element assembling
+	/**
+	 * If enabled, a FrozenTopology is kept for every DoFDistribution the
+	 * threaded (chunk-wise) element assembling is used on, and the corner
+	 * coordinates of the elements are copied from it. The snapshot is rebuilt
+	 * when the revision of the DoFDistribution changes. The coordinates are
+	 * not refreshed otherwise, thus for moving meshes
+	 * update_frozen_topology_coordinates() must be called after each move.
+	 */
+		void set_frozen_topology(bool bEnable)
+		{
+			m_bFrozenTopology = bEnable;
+			if(!bEnable) m_vspFrozenTopology.clear();
+		}
+
+	///	copies the current vertex coordinates into the snapshots of the topology
+		void update_frozen_topology_coordinates()
+		{
+			for(size_t i = 0; i < m_vspFrozenTopology.size(); ++i)
+				m_vspFrozenTopology[i]->update_coordinates();
+		}
+
 	public:
 	/// adds an element discretization to the assembling process
 	/**
@@ -500,6 +524,9 @@ public:
 	///	returns the level dof distribution
 		ConstSmartPtr<DoFDistribution> dd(const GridLevel& gl) const{return m_spApproxSpace->dof_distribution(gl);}
 
+	///	returns the up-to-date snapshot of the topology for a dof distribution (or NULL if not used)
+		const FrozenTopology<TDomain>* frozen_topology(ConstSmartPtr<DoFDistribution> dd);
+
 	protected:
 	///	vector holding all registered elem discs
 		std::vector<SmartPtr<IElemDisc<TDomain> > > m_vDomainElemDisc;
@@ -521,6 +548,10 @@ public:
 		
 	///	this object provides tools to adapt the assemble routine
 		SmartPtr<AssemblingTuner<TAlgebra> > m_spAssTuner;
+
+	///	snapshots of the topology (one per dof distribution)
+		bool m_bFrozenTopology;
+		std::vector<SmartPtr<FrozenTopology<TDomain> > > m_vspFrozenTopology;
 	
 	private:
 	//---- Auxiliary function templates for the assembling ----//
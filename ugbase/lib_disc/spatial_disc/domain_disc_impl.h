@@ -123,6 +123,25 @@ void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::update_constra
 		m_vConstraint[i]->set_approximation_space(m_spApproxSpace);
 }
 
+template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
+const FrozenTopology<TDomain>* DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::
+frozen_topology(ConstSmartPtr<DoFDistribution> dd)
+{
+//	the snapshot is only used by the chunk-wise element assembling
+	if(!m_bFrozenTopology || !m_spAssTuner->threaded_assembling_enabled())
+		return NULL;
+
+	for(size_t i = 0; i < m_vspFrozenTopology.size(); ++i)
+	{
+		if(m_vspFrozenTopology[i]->dof_distribution().get() != dd.get()) continue;
+		m_vspFrozenTopology[i]->update();
+		return m_vspFrozenTopology[i].get();
+	}
+
+	m_vspFrozenTopology.push_back(make_sp(new FrozenTopology<TDomain>(m_spApproxSpace->domain(), dd)));
+	return m_vspFrozenTopology.back().get();
+}
+
 template <typename TDomain, typename TAlgebra, typename TGlobAssembler>
 void DomainDiscretizationBase<TDomain, TAlgebra, TGlobAssembler>::update_disc_items()
 {
@@ -292,7 +311,7 @@ AssembleMassMatrix( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleMassMatrix<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, M, u, m_spAssTuner);
+					bNonRegularGrid, M, u, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -452,7 +471,7 @@ AssembleStiffnessMatrix(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleStiffnessMatrix<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, A, u, m_spAssTuner);
+					bNonRegularGrid, A, u, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -636,7 +655,7 @@ AssembleJacobian(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleJacobian<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, J, u, m_spAssTuner);
+					bNonRegularGrid, J, u, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -825,7 +844,7 @@ AssembleDefect( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleDefect<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, d, u, m_spAssTuner);
+					bNonRegularGrid, d, u, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -986,7 +1005,7 @@ AssembleLinear( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleLinear<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, A, rhs, m_spAssTuner);
+					bNonRegularGrid, A, rhs, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -1144,7 +1163,7 @@ AssembleRhs(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		//	general case: assembling over all elements in subset si
 		gass_type::template AssembleRhs<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd, dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, rhs, u, m_spAssTuner);
+					bNonRegularGrid, rhs, u, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -1548,7 +1567,7 @@ AssembleJacobian(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleJacobian<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, J, vSol, s_a0, m_spAssTuner);
+					bNonRegularGrid, J, vSol, s_a0, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -1728,7 +1747,7 @@ AssembleDefect( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleDefect<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, d, vSol, vScaleMass, vScaleStiff, m_spAssTuner);
+					bNonRegularGrid, d, vSol, vScaleMass, vScaleStiff, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -1898,7 +1917,7 @@ AssembleLinear( const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleLinear<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, A, rhs, vSol, vScaleMass, vScaleStiff, m_spAssTuner);
+					bNonRegularGrid, A, rhs, vSol, vScaleMass, vScaleStiff, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -2061,7 +2080,7 @@ AssembleRhs(	const std::vector<IElemDisc<domain_type>*>& vElemDisc,
 		gass_type::template AssembleRhs<TElem>
 			(vElemDisc, m_spApproxSpace->domain(), dd,
 				dd->template begin<TElem>(si), dd->template end<TElem>(si), si,
-					bNonRegularGrid, rhs, vSol, vScaleMass, vScaleStiff, m_spAssTuner);
+					bNonRegularGrid, rhs, vSol, vScaleMass, vScaleStiff, m_spAssTuner, frozen_topology(dd));
 	}
 }
 
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_DISC_ASSEMBLE_CHUNK__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_DISC_ASSEMBLE_CHUNK__
+
+#include <vector>
+#include <string>
+
+#include "common/common.h"
+#include "common/util/openmp_util.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/frozen_topology.h"
+#include "lib_disc/dof_manager/dof_distribution.h"
+#include "lib_disc/spatial_disc/ass_tuner.h"
+
+namespace ug {
+
+/// Chunk of elements prepared for the (threaded) element assembling
+/**
+ * A chunk of elements is collected, the corner coordinates, the global
+ * indices and the local solution values are gathered for all elements of the
+ * chunk in parallel, and the local contributions computed for the chunk are
+ * added to the global matrix/vector in parallel as well. The local
+ * contributions themselves are computed by the caller, either in parallel
+ * with one DataEvaluator per thread or sequentially. For the latter, the elements of a chunk are
+ * greedily colored such that elements of the same color do not share a
+ * (block-)index and thus write to disjoint rows.
+ *
+ * The buffers are allocated once for the chunk size and are never resized
+ * afterwards, since LocalVector and LocalMatrix keep pointers to the
+ * LocalIndices they have been resized with.
+ *
+ * If ug4 is not compiled with OpenMP, all loops are executed sequentially.
+ *
+ * \tparam TDomain		domain type
+ * \tparam TElem		element type
+ */
+template <typename TDomain, typename TElem>
+class ElemAssembleChunk
+{
+	public:
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	number of corners of the element
+		static const size_t numCorner = TElem::NUM_VERTICES;
+
+	///	maximal number of colors used for the parallel scattering
+		static const size_t maxColor = 64;
+
+	public:
+	///	constructor allocating all buffers for the given chunk size
+		ElemAssembleChunk(size_t chunkSize)
+			: m_vElem(chunkSize), m_vInd(chunkSize), m_vLocU(chunkSize),
+			  m_vCornerCoords(chunkSize * numCorner), m_vColor(chunkSize),
+			  m_vMismatch(chunkSize), m_numElem(0)
+		{
+			UG_COND_THROW(chunkSize == 0, "ElemAssembleChunk: chunk size must be positive.");
+		}
+
+	///	returns the maximal number of elements in a chunk
+		size_t capacity() const {return m_vElem.size();}
+
+	///	returns the number of elements in the current chunk
+		size_t size() const {return m_numElem;}
+
+	///	element of the chunk
+		TElem* elem(size_t i) const {return m_vElem[i];}
+
+	///	global indices of an element of the chunk
+		const LocalIndices& ind(size_t i) const {return m_vInd[i];}
+		LocalIndices& ind(size_t i) {return m_vInd[i];}
+
+	///	local solution of an element of the chunk
+		LocalVector& loc_u(size_t i) {return m_vLocU[i];}
+
+	///	corner coordinates of an element of the chunk
+		MathVector<dim>* corner_coords(size_t i) {return &m_vCornerCoords[i * numCorner];}
+
+	///	collects the next used elements starting at iter
+	/**
+	 * Fills the chunk with the next elements of [iter, iterEnd) that are used
+	 * for assembling. The iterator is advanced past the collected elements.
+	 *
+	 * \returns false if no element has been collected
+	 */
+		template <typename TIterator, typename TAlgebra>
+		bool collect(TIterator& iter, TIterator iterEnd,
+		             const AssemblingTuner<TAlgebra>& assTuner)
+		{
+			m_numElem = 0;
+			for(; iter != iterEnd && m_numElem < capacity(); ++iter)
+			{
+				TElem* elem = *iter;
+				if(!assTuner.element_used(elem)) continue;
+				m_vElem[m_numElem++] = elem;
+			}
+			return m_numElem > 0;
+		}
+
+	///	gathers corner coordinates, global indices and local solution (threaded)
+	/**
+	 * If pU is NULL, the local solutions are only resized and set to zero.
+	 * If an up-to-date snapshot of the topology is passed, the corner
+	 * coordinates of the elements contained in it are copied from the
+	 * snapshot.
+	 */
+		template <typename TVector>
+		void load(const TDomain& domain, const DoFDistribution& dd,
+		          const TVector* pU, bool bHang,
+		          const FrozenTopology<TDomain>* pTopo = NULL)
+		{
+			const int numElem = (int) m_numElem;
+			std::string errMsg;
+
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(dynamic, 16) if(numElem > 1)
+#endif
+			for(int i = 0; i < numElem; ++i)
+			{
+				try
+				{
+					TElem* elem = m_vElem[i];
+					const int e = (pTopo != NULL) ? pTopo->index(elem) : -1;
+					if(e >= 0){
+						const MathVector<dim>* vCoord = pTopo->corner_coords(e);
+						for(size_t co = 0; co < numCorner; ++co)
+							corner_coords(i)[co] = vCoord[co];
+					}
+					else
+						FillCornerCoordinates(corner_coords(i), *elem, domain);
+					dd.indices(elem, m_vInd[i], bHang);
+					m_vLocU[i].resize(m_vInd[i]);
+					if(pU != NULL) GetLocalVector(m_vLocU[i], *pU);
+					else m_vLocU[i] = 0.0;
+				}
+				catch(UGError& err)
+				{
+#ifdef UG_OPENMP
+					#pragma omp critical (ElemAssembleChunk_load)
+#endif
+					if(errMsg.empty()) errMsg = err.get_msg();
+				}
+			}
+
+			if(!errMsg.empty())
+				UG_THROW("ElemAssembleChunk: Cannot load element data: " << errMsg);
+		}
+
+	///	adds the local matrices of the chunk to the global matrix
+	/**
+	 * The scattering is executed in parallel if the default local-to-global
+	 * mapping is used and the matrix structure is kept constant by the
+	 * assembling tuner, i.e., all connections already exist and no entry is
+	 * created during the scattering. If the assembling tuner replays cached
+	 * matrix positions, these are used by the threads. Local matrices that do
+	 * not fit to the cached positions are added sequentially after all
+	 * colors, since they may create new connections, and the replay is
+	 * stopped for the rest of the assembling. Otherwise the local matrices
+	 * are added sequentially via the assembling tuner.
+	 */
+		template <typename TAlgebra>
+		void add_local_to_global(typename TAlgebra::matrix_type& mat,
+		                              const std::vector<LocalMatrix>& vLocMat,
+		                              const AssemblingTuner<TAlgebra>& assTuner,
+		                              ConstSmartPtr<DoFDistribution> dd)
+		{
+			const bool bReplay = assTuner.matrix_scatter_cache_replayed();
+			if(!parallel_scatter_possible(assTuner)
+				|| !(assTuner.matrix_structure_is_const() || bReplay)){
+				for(size_t i = 0; i < m_numElem; ++i)
+					assTuner.add_local_mat_to_global(mat, vLocMat[i], dd);
+				return;
+			}
+
+			MatrixScatterMap<typename TAlgebra::matrix_type>& scatterMap = assTuner.matrix_scatter_map();
+			const size_t firstCall = bReplay ? scatterMap.reserve_calls(m_numElem) : 0;
+
+			color(dd->num_indices());
+			for(size_t c = 0; c < m_vvColorElem.size(); ++c)
+			{
+				const std::vector<size_t>& vElem = m_vvColorElem[c];
+				const int numElem = (int) vElem.size();
+#ifdef UG_OPENMP
+				#pragma omp parallel for schedule(static) if(c < maxColor && numElem > 1)
+#endif
+				for(int i = 0; i < numElem; ++i)
+				{
+					const size_t e = vElem[i];
+					if(bReplay) m_vMismatch[e] = !scatterMap.add(mat, vLocMat[e], firstCall + e);
+					else AddLocalMatrixToGlobal(mat, vLocMat[e]);
+				}
+			}
+
+		//	local matrices not fitting to the cached positions
+			if(bReplay)
+				for(size_t i = 0; i < m_numElem; ++i)
+					if(m_vMismatch[i])
+					{
+						if(scatterMap.replaying()) scatterMap.stop_replaying();
+						AddLocalMatrixToGlobal(mat, vLocMat[i]);
+					}
+		}
+
+	///	adds the local vectors of the chunk to the global vector
+		template <typename TAlgebra>
+		void add_local_to_global(typename TAlgebra::vector_type& vec,
+		                              const std::vector<LocalVector>& vLocVec,
+		                              const AssemblingTuner<TAlgebra>& assTuner,
+		                              ConstSmartPtr<DoFDistribution> dd)
+		{
+			if(!parallel_scatter_possible(assTuner)){
+				for(size_t i = 0; i < m_numElem; ++i)
+					assTuner.add_local_vec_to_global(vec, vLocVec[i], dd);
+				return;
+			}
+
+			color(dd->num_indices());
+			for(size_t c = 0; c < m_vvColorElem.size(); ++c)
+			{
+				const std::vector<size_t>& vElem = m_vvColorElem[c];
+				const int numElem = (int) vElem.size();
+#ifdef UG_OPENMP
+				#pragma omp parallel for schedule(static) if(c < maxColor && numElem > 1)
+#endif
+				for(int i = 0; i < numElem; ++i)
+					AddLocalVector(vec, vLocVec[vElem[i]]);
+			}
+		}
+
+	protected:
+	///	returns if the local contributions can be added in parallel
+		template <typename TAlgebra>
+		bool parallel_scatter_possible(const AssemblingTuner<TAlgebra>& assTuner) const
+		{
+			return assTuner.default_mapping_used()
+					&& !assTuner.single_index_assembling_enabled()
+					&& NumOMPThreads() > 1;
+		}
+
+	///	colors the elements of the chunk
+	/**
+	 * Greedy coloring: every element gets the smallest color that is not used
+	 * by any other element of the chunk sharing one of its (block-)indices.
+	 * The used colors are stored as a bit mask per index. Elements that
+	 * cannot be colored with maxColor colors are put into an additional
+	 * last group that is scattered sequentially.
+	 */
+		void color(size_t numIndex)
+		{
+			if(m_vMask.size() != numIndex) m_vMask.assign(numIndex, 0);
+
+			m_vvColorElem.clear();
+			for(size_t i = 0; i < m_numElem; ++i)
+			{
+				const LocalIndices& ind = m_vInd[i];
+
+			//	collect colors used by neighbors
+				uint64 used = 0;
+				for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+					for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+						used |= m_vMask[ind.index(fct, dof)];
+
+			//	find the smallest free color
+				size_t c = 0;
+				while(c < maxColor && (used & ((uint64)1 << c))) ++c;
+				m_vColor[i] = c;
+
+				if(c < maxColor)
+					for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+						for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+							m_vMask[ind.index(fct, dof)] |= ((uint64)1 << c);
+
+				if(m_vvColorElem.size() <= c) m_vvColorElem.resize(c+1);
+				m_vvColorElem[c].push_back(i);
+			}
+
+		//	reset the touched masks
+			for(size_t i = 0; i < m_numElem; ++i)
+			{
+				const LocalIndices& ind = m_vInd[i];
+				for(size_t fct = 0; fct < ind.num_fct(); ++fct)
+					for(size_t dof = 0; dof < ind.num_dof(fct); ++dof)
+						m_vMask[ind.index(fct, dof)] = 0;
+			}
+		}
+
+	protected:
+	///	elements of the chunk
+		std::vector<TElem*> m_vElem;
+
+	///	global indices per element
+		std::vector<LocalIndices> m_vInd;
+
+	///	local solution per element
+		std::vector<LocalVector> m_vLocU;
+
+	///	corner coordinates (numCorner per element)
+		std::vector<MathVector<dim> > m_vCornerCoords;
+
+	///	color per element
+		std::vector<size_t> m_vColor;
+
+	///	elements grouped by color
+		std::vector<std::vector<size_t> > m_vvColorElem;
+
+	///	used colors per global (block-)index
+		std::vector<uint64> m_vMask;
+
+	///	flags elements whose local matrix does not fit to the cached positions
+		std::vector<char> m_vMismatch;
+
+	///	number of elements in the current chunk
+		size_t m_numElem;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__ELEM_DISC__ELEM_DISC_ASSEMBLE_CHUNK__ */
@@ -46,6 +46,7 @@
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/common/local_algebra.h"
 #include "lib_disc/spatial_disc/user_data/data_evaluator.h"
+#include "./elem_disc_assemble_chunk.h"
 #include "bridge/util_algebra_dependent.h"
 
 #define PROFILE_ELEM_LOOP
@@ -88,6 +89,863 @@ class StdGlobAssembler
 	///	Matrix type in the algebra
 	typedef typename algebra_type::matrix_type matrix_type;
 	
+////////////////////////////////////////////////////////////////////////////////
+// Threaded assembling
+////////////////////////////////////////////////////////////////////////////////
+
+protected:
+	///	chunk of elements of type TElem
+	template <typename TElem>
+	struct chunk_type {typedef ElemAssembleChunk<domain_type, TElem> type;};
+
+	///	base of the element functors of stationary problems
+	struct StatElemFunc
+	{
+	///	creates the DataEvaluator used by thread tid
+		SmartPtr<DataEvaluator<domain_type> >
+		create_eval(int discPart, const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+		            ConstSmartPtr<FunctionPattern> fctPat, bool bNonRegularGrid, int tid)
+		{
+			return make_sp(new DataEvaluator<domain_type>
+						(discPart, vElemDisc, fctPat, bNonRegularGrid));
+		}
+	};
+
+	///	base of the element functors of time-dependent problems
+	/**
+	 * Every thread reads the local time series of its elements into a series
+	 * of its own, which is passed to the DataEvaluator of the thread.
+	 */
+	struct InstElemFunc
+	{
+		InstElemFunc(ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		             const std::vector<number>* pvScaleMass = NULL,
+		             const std::vector<number>* pvScaleStiff = NULL)
+			: m_vSol(vSol), m_pvScaleMass(pvScaleMass), m_pvScaleStiff(pvScaleStiff),
+			  m_vLocTimeSeries(NumOMPThreads())
+		{
+			for(size_t t = 0; t < m_vLocTimeSeries.size(); ++t)
+				m_vLocTimeSeries[t].read_times(vSol);
+		}
+
+	///	creates the DataEvaluator used by thread tid
+		SmartPtr<DataEvaluator<domain_type> >
+		create_eval(int discPart, const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+		            ConstSmartPtr<FunctionPattern> fctPat, bool bNonRegularGrid, int tid)
+		{
+			SmartPtr<DataEvaluator<domain_type> > spEval(new DataEvaluator<domain_type>
+						(discPart, vElemDisc, fctPat, bNonRegularGrid,
+						 &m_vLocTimeSeries[tid], m_pvScaleMass, m_pvScaleStiff));
+			spEval->set_time_point(0);
+			return spEval;
+		}
+
+		ConstSmartPtr<VectorTimeSeries<vector_type> > m_vSol;
+		const std::vector<number>* m_pvScaleMass;
+		const std::vector<number>* m_pvScaleStiff;
+		std::vector<LocalVectorTimeSeries> m_vLocTimeSeries;
+	};
+
+	///	computes the local stiffness matrix (or stationary Jacobian) of an element
+	struct JacAElemFunc : public StatElemFunc
+	{
+		JacAElemFunc(matrix_type& A) : m_A(A) {}
+
+		void resize(size_t n) {m_vLocA.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locU = chunk.loc_u(i);
+			LocalMatrix& locA = m_vLocA[i];
+			locA.resize(chunk.ind(i));
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), true);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			locA = 0.0;
+			try
+			{
+				Eval.add_jac_A_elem(locA, locU, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Jacobian (A).");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_A, m_vLocA, assTuner, dd);
+		}
+
+		matrix_type& m_A;
+		std::vector<LocalMatrix> m_vLocA;
+	};
+
+	///	computes the local mass matrix of an element
+	struct JacMElemFunc : public StatElemFunc
+	{
+		JacMElemFunc(matrix_type& M) : m_M(M) {}
+
+		void resize(size_t n) {m_vLocM.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locU = chunk.loc_u(i);
+			LocalMatrix& locM = m_vLocM[i];
+			locM.resize(chunk.ind(i));
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), true);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			locM = 0.0;
+			try
+			{
+				Eval.add_jac_M_elem(locM, locU, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Jacobian (M).");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_M, m_vLocM, assTuner, dd);
+		}
+
+		matrix_type& m_M;
+		std::vector<LocalMatrix> m_vLocM;
+	};
+
+	///	computes the local (stationary) defect of an element
+	struct DefectElemFunc : public StatElemFunc
+	{
+		DefectElemFunc(vector_type& d,
+		               ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+		               ConstSmartPtr<DoFDistribution> dd)
+			: m_d(d), m_spAssTuner(spAssTuner), m_dd(dd), m_vTmpLocD(NumOMPThreads())
+		{}
+
+		void resize(size_t n) {m_vLocD.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locU = chunk.loc_u(i);
+			LocalVector& locD = m_vLocD[i];
+			LocalVector& tmpLocD = m_vTmpLocD[tid];
+			locD.resize(chunk.ind(i));
+			tmpLocD.resize(chunk.ind(i));
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i));
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+		//	modifies the solution, used for computing the defect
+			if( m_spAssTuner->modify_solution_enabled() )
+			{
+				try{
+					m_spAssTuner->modify_LocalSol(locU, locU, m_dd);
+				} UG_CATCH_THROW("Cannot modify local solution.");
+			}
+
+			locD = 0.0;
+			try
+			{
+				Eval.add_def_A_elem(locD, locU, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Defect (A).");
+
+			try
+			{
+				tmpLocD = 0.0;
+				Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords);
+				locD.scale_append(-1, tmpLocD);
+			}
+			UG_CATCH_THROW("Cannot compute Rhs.");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_d, m_vLocD, assTuner, dd);
+		}
+
+		vector_type& m_d;
+		ConstSmartPtr<AssemblingTuner<TAlgebra> > m_spAssTuner;
+		ConstSmartPtr<DoFDistribution> m_dd;
+		std::vector<LocalVector> m_vLocD;
+		std::vector<LocalVector> m_vTmpLocD;
+	};
+
+	///	computes the local matrix and right-hand side of a (stationary) linear problem
+	struct LinearElemFunc : public StatElemFunc
+	{
+		LinearElemFunc(matrix_type& A, vector_type& rhs) : m_A(A), m_rhs(rhs) {}
+
+		void resize(size_t n) {m_vLocA.resize(n); m_vLocRhs.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalMatrix& locA = m_vLocA[i];
+			LocalVector& locRhs = m_vLocRhs[i];
+			locA.resize(chunk.ind(i));
+			locRhs.resize(chunk.ind(i));
+			locRhs = 0.0;
+
+			try
+			{
+				Eval.prepare_elem(locRhs, elem, id, vCornerCoords, chunk.ind(i), true);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			locA = 0.0;
+			locRhs = 0.0;
+			try
+			{
+				Eval.add_jac_A_elem(locA, locRhs, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Jacobian (A).");
+
+			try
+			{
+				Eval.add_rhs_elem(locRhs, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Rhs.");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_A, m_vLocA, assTuner, dd);
+			chunk.add_local_to_global(m_rhs, m_vLocRhs, assTuner, dd);
+		}
+
+		matrix_type& m_A;
+		vector_type& m_rhs;
+		std::vector<LocalMatrix> m_vLocA;
+		std::vector<LocalVector> m_vLocRhs;
+	};
+
+	///	computes the local right-hand side of a stationary problem
+	struct RhsElemFunc : public StatElemFunc
+	{
+		RhsElemFunc(vector_type& rhs) : m_rhs(rhs) {}
+
+		void resize(size_t n) {m_vLocRhs.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locU = chunk.loc_u(i);
+			LocalVector& locRhs = m_vLocRhs[i];
+			locRhs.resize(chunk.ind(i));
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i));
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			locRhs = 0.0;
+			try
+			{
+				Eval.add_rhs_elem(locRhs, elem, vCornerCoords);
+			}
+			UG_CATCH_THROW("Cannot compute Rhs.");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_rhs, m_vLocRhs, assTuner, dd);
+		}
+
+		vector_type& m_rhs;
+		std::vector<LocalVector> m_vLocRhs;
+	};
+
+	///	computes the local Jacobian of an element in the time-dependent case
+	struct InstJacElemFunc : public InstElemFunc
+	{
+		InstJacElemFunc(matrix_type& J, ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		                number s_a0)
+			: InstElemFunc(vSol), m_J(J), m_s_a0(s_a0) {}
+
+		void resize(size_t n) {m_vLocJ.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locU = chunk.loc_u(i);
+			LocalMatrix& locJ = m_vLocJ[i];
+			locJ.resize(chunk.ind(i));
+
+		//	read local values of time series
+			if(Eval.time_series_needed())
+				this->m_vLocTimeSeries[tid].read_values(this->m_vSol, chunk.ind(i));
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), true);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			locJ = 0.0;
+			try
+			{
+				Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords, PT_INSTATIONARY);
+				locJ *= m_s_a0;
+
+				Eval.add_jac_A_elem(locJ, locU, elem, vCornerCoords, PT_STATIONARY);
+			}
+			UG_CATCH_THROW("Cannot compute Jacobian (A).");
+
+			try
+			{
+				Eval.add_jac_M_elem(locJ, locU, elem, vCornerCoords, PT_INSTATIONARY);
+			}
+			UG_CATCH_THROW("Cannot compute Jacobian (M).");
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_J, m_vLocJ, assTuner, dd);
+		}
+
+		matrix_type& m_J;
+		number m_s_a0;
+		std::vector<LocalMatrix> m_vLocJ;
+	};
+
+	///	computes the local defect of an element in the time-dependent case
+	struct InstDefectElemFunc : public InstElemFunc
+	{
+		InstDefectElemFunc(vector_type& d, ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		                   const std::vector<number>& vScaleMass,
+		                   const std::vector<number>& vScaleStiff)
+			: InstElemFunc(vSol, &vScaleMass, &vScaleStiff), m_d(d),
+			  m_vTmpLocD(NumOMPThreads())
+		{}
+
+		void resize(size_t n) {m_vLocD.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			const std::vector<number>& vScaleMass = *this->m_pvScaleMass;
+			const std::vector<number>& vScaleStiff = *this->m_pvScaleStiff;
+			LocalVectorTimeSeries& locTimeSeries = this->m_vLocTimeSeries[tid];
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locD = m_vLocD[i];
+			LocalVector& tmpLocD = m_vTmpLocD[tid];
+			locD.resize(chunk.ind(i));
+			tmpLocD.resize(chunk.ind(i));
+
+		//	read local values of time series
+			locTimeSeries.read_values(this->m_vSol, chunk.ind(i));
+
+			locD = 0.0;
+
+		//	loop all time points and assemble them
+			for(size_t t = 0; t < vScaleStiff.size(); ++t)
+			{
+				number scale_stiff = vScaleStiff[t];
+
+				LocalVector& locU = locTimeSeries.solution(t);
+				Eval.set_time_point(t);
+
+				try
+				{
+					Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), false);
+				}
+				UG_CATCH_THROW("Cannot prepare element.");
+
+				try
+				{
+					tmpLocD = 0.0;
+					Eval.add_def_M_elem(tmpLocD, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					locD.scale_append(vScaleMass[t], tmpLocD);
+				}
+				UG_CATCH_THROW("Cannot compute Defect (M).");
+
+				try
+				{
+					if(scale_stiff != 0.0)
+					{
+						tmpLocD = 0.0;
+						Eval.add_def_A_elem(tmpLocD, locU, elem, vCornerCoords, PT_INSTATIONARY);
+						locD.scale_append(scale_stiff, tmpLocD);
+					}
+
+					if(t == 0)
+						Eval.add_def_A_elem(locD, locU, elem, vCornerCoords, PT_STATIONARY);
+				}
+				UG_CATCH_THROW("Cannot compute Defect (A).");
+
+			//	explicit reaction_rate, reaction and source (only valid at lowest time disc order)
+				if( t == 1 )
+				{
+					tmpLocD = 0.0;
+					try
+					{
+						Eval.add_def_A_expl_elem(tmpLocD, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					}
+					UG_CATCH_THROW("Cannot compute explicit Defect (A).");
+
+					const number dt = this->m_vSol->time(0) - this->m_vSol->time(1);
+					locD.scale_append(dt, tmpLocD);
+				}
+
+				try
+				{
+					if(scale_stiff != 0.0)
+					{
+						tmpLocD = 0.0;
+						Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords, PT_INSTATIONARY);
+						locD.scale_append( - scale_stiff, tmpLocD);
+					}
+
+					if(t == 0)
+					{
+						tmpLocD = 0.0;
+						Eval.add_rhs_elem(tmpLocD, elem, vCornerCoords, PT_STATIONARY);
+						locD.scale_append( -1.0, tmpLocD);
+					}
+				}
+				UG_CATCH_THROW("Cannot compute Rhs.");
+			}
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_d, m_vLocD, assTuner, dd);
+		}
+
+		vector_type& m_d;
+		std::vector<LocalVector> m_vLocD;
+		std::vector<LocalVector> m_vTmpLocD;
+	};
+
+	///	computes the local matrix and right-hand side of a linear problem in the time-dependent case
+	struct InstLinearElemFunc : public InstElemFunc
+	{
+		InstLinearElemFunc(matrix_type& A, vector_type& rhs,
+		                   ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		                   const std::vector<number>& vScaleMass,
+		                   const std::vector<number>& vScaleStiff,
+		                   bool bAssembleMatrix)
+			: InstElemFunc(vSol, &vScaleMass, &vScaleStiff), m_A(A), m_rhs(rhs),
+			  m_bAssembleMatrix(bAssembleMatrix),
+			  m_vTmpLocA(NumOMPThreads()), m_vTmpLocRhs(NumOMPThreads())
+		{}
+
+		void resize(size_t n) {m_vLocA.resize(n); m_vLocRhs.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			const std::vector<number>& vScaleMass = *this->m_pvScaleMass;
+			const std::vector<number>& vScaleStiff = *this->m_pvScaleStiff;
+			LocalVectorTimeSeries& locTimeSeries = this->m_vLocTimeSeries[tid];
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalMatrix& locA = m_vLocA[i];
+			LocalVector& locRhs = m_vLocRhs[i];
+			LocalMatrix& tmpLocA = m_vTmpLocA[tid];
+			LocalVector& tmpLocRhs = m_vTmpLocRhs[tid];
+			locA.resize(chunk.ind(i)); tmpLocA.resize(chunk.ind(i));
+			locRhs.resize(chunk.ind(i)); tmpLocRhs.resize(chunk.ind(i));
+
+		//	read local values of time series
+			locTimeSeries.read_values(this->m_vSol, chunk.ind(i));
+			Eval.set_time_point(0);
+
+			locA = 0.0; locRhs = 0.0;
+
+		//	current time step
+			LocalVector& locU = locTimeSeries.solution(0);
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), true);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			if(m_bAssembleMatrix)
+			{
+				try
+				{
+					tmpLocA = 0.0;
+					Eval.add_jac_M_elem(tmpLocA, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					locA.scale_append(vScaleMass[0], tmpLocA);
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (M).");
+
+				try
+				{
+					if (vScaleStiff[0] != 0.0)
+					{
+						tmpLocA = 0.0;
+						Eval.add_jac_A_elem(tmpLocA, locU, elem, vCornerCoords, PT_INSTATIONARY);
+						locA.scale_append(vScaleStiff[0], tmpLocA);
+					}
+					Eval.add_jac_A_elem(locA, locU, elem, vCornerCoords, PT_STATIONARY);
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (A).");
+			}
+
+			try
+			{
+				if (vScaleStiff[0] != 0.0)
+				{
+					tmpLocRhs = 0.0;
+					Eval.add_rhs_elem(tmpLocRhs, elem, vCornerCoords, PT_INSTATIONARY);
+					locRhs.scale_append(vScaleStiff[0], tmpLocRhs);
+				}
+				Eval.add_rhs_elem(locRhs, elem, vCornerCoords, PT_STATIONARY);
+			}
+			UG_CATCH_THROW("Cannot compute Rhs.");
+
+		//	old time steps
+			for(size_t t = 1; t < vScaleStiff.size(); ++t)
+			{
+				LocalVector& locU = locTimeSeries.solution(t);
+				Eval.set_time_point(t);
+				number scaleStiff = vScaleStiff[t];
+
+				try
+				{
+					Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), false);
+				}
+				UG_CATCH_THROW("Cannot prepare element.");
+
+				try
+				{
+					tmpLocRhs = 0.0;
+					Eval.add_def_M_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					locRhs.scale_append(-vScaleMass[t], tmpLocRhs);
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (M).");
+
+				try
+				{
+					if (scaleStiff != 0.0)
+					{
+						tmpLocRhs = 0.0;
+						Eval.add_def_A_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
+						locRhs.scale_append(-scaleStiff, tmpLocRhs);
+					}
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (A).");
+
+				try
+				{
+					if (scaleStiff != 0.0)
+					{
+						tmpLocRhs = 0.0;
+						Eval.add_rhs_elem(tmpLocRhs, elem, vCornerCoords, PT_INSTATIONARY);
+						locRhs.scale_append(scaleStiff, tmpLocRhs);
+					}
+				}
+				UG_CATCH_THROW("Cannot compute Rhs.");
+			}
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			if(m_bAssembleMatrix)
+				chunk.add_local_to_global(m_A, m_vLocA, assTuner, dd);
+			chunk.add_local_to_global(m_rhs, m_vLocRhs, assTuner, dd);
+		}
+
+		matrix_type& m_A;
+		vector_type& m_rhs;
+		bool m_bAssembleMatrix;
+		std::vector<LocalMatrix> m_vLocA;
+		std::vector<LocalVector> m_vLocRhs;
+		std::vector<LocalMatrix> m_vTmpLocA;
+		std::vector<LocalVector> m_vTmpLocRhs;
+	};
+
+	///	computes the local right-hand side of an element in the time-dependent case
+	struct InstRhsElemFunc : public InstElemFunc
+	{
+		InstRhsElemFunc(vector_type& rhs, ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
+		                const std::vector<number>& vScaleMass,
+		                const std::vector<number>& vScaleStiff)
+			: InstElemFunc(vSol, &vScaleMass, &vScaleStiff), m_rhs(rhs),
+			  m_vTmpLocRhs(NumOMPThreads())
+		{}
+
+		void resize(size_t n) {m_vLocRhs.resize(n);}
+
+		template <typename TElem>
+		void operator()(DataEvaluator<domain_type>& Eval,
+		                typename chunk_type<TElem>::type& chunk, size_t i, int tid)
+		{
+			static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+			const std::vector<number>& vScaleMass = *this->m_pvScaleMass;
+			const std::vector<number>& vScaleStiff = *this->m_pvScaleStiff;
+			LocalVectorTimeSeries& locTimeSeries = this->m_vLocTimeSeries[tid];
+			TElem* elem = chunk.elem(i);
+			const MathVector<domain_type::dim>* vCornerCoords = chunk.corner_coords(i);
+			LocalVector& locRhs = m_vLocRhs[i];
+			LocalVector& tmpLocRhs = m_vTmpLocRhs[tid];
+			locRhs.resize(chunk.ind(i)); tmpLocRhs.resize(chunk.ind(i));
+
+		//	read local values of time series
+			locTimeSeries.read_values(this->m_vSol, chunk.ind(i));
+			Eval.set_time_point(0);
+
+			locRhs = 0.0;
+
+		//	current time step
+			LocalVector& locU = locTimeSeries.solution(0);
+
+			try
+			{
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), false);
+			}
+			UG_CATCH_THROW("Cannot prepare element.");
+
+			try
+			{
+				tmpLocRhs = 0.0;
+				Eval.add_rhs_elem(tmpLocRhs, elem, vCornerCoords, PT_INSTATIONARY);
+				locRhs.scale_append(vScaleStiff[0], tmpLocRhs);
+
+				Eval.add_rhs_elem(locRhs, elem, vCornerCoords, PT_STATIONARY);
+			}
+			UG_CATCH_THROW("Cannot compute Rhs.");
+
+		//	old time steps
+			for(size_t t = 1; t < vScaleStiff.size(); ++t)
+			{
+				LocalVector& locU = locTimeSeries.solution(t);
+				Eval.set_time_point(t);
+
+				try
+				{
+					Eval.prepare_elem(locU, elem, id, vCornerCoords, chunk.ind(i), false);
+				}
+				UG_CATCH_THROW("Cannot prepare element.");
+
+				try
+				{
+					tmpLocRhs = 0.0;
+					Eval.add_def_M_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					locRhs.scale_append(-vScaleMass[t], tmpLocRhs);
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (M).");
+
+				try
+				{
+					tmpLocRhs = 0.0;
+					Eval.add_def_A_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
+					locRhs.scale_append(-vScaleStiff[t], tmpLocRhs);
+				}
+				UG_CATCH_THROW("Cannot compute Jacobian (A).");
+
+				try
+				{
+					tmpLocRhs = 0.0;
+					Eval.add_rhs_elem(tmpLocRhs, elem, vCornerCoords, PT_INSTATIONARY);
+					locRhs.scale_append(vScaleStiff[t], tmpLocRhs);
+				}
+				UG_CATCH_THROW("Cannot compute Rhs.");
+			}
+		}
+
+		template <typename TElem>
+		void add_to_global(typename chunk_type<TElem>::type& chunk,
+		                   const AssemblingTuner<TAlgebra>& assTuner,
+		                   ConstSmartPtr<DoFDistribution> dd)
+		{
+			chunk.add_local_to_global(m_rhs, m_vLocRhs, assTuner, dd);
+		}
+
+		vector_type& m_rhs;
+		std::vector<LocalVector> m_vLocRhs;
+		std::vector<LocalVector> m_vTmpLocRhs;
+	};
+
+	/**
+	 * This function assembles the local contributions of the elements in
+	 * chunks (see ElemAssembleChunk) and adds them to the global matrices or
+	 * vectors. If all element discretizations allow a concurrent evaluation
+	 * (see IElemDiscBase::thread_safe_elem_evaluation), every thread uses a
+	 * DataEvaluator of its own and the elements of a chunk are evaluated in
+	 * parallel. Otherwise, a single DataEvaluator evaluates them one after
+	 * the other.
+	 *
+	 * The element functor creates the DataEvaluators (create_eval), stores
+	 * the local contributions of a chunk (resize), computes the contribution
+	 * of one element of the chunk (operator()) and adds the contributions of
+	 * the chunk to the global matrices or vectors (add_to_global).
+	 *
+	 * \param[in]	pU			solution read into the local solution of the
+	 * 							elements, may be NULL if not needed
+	 * \param[in]	pTopo		snapshot of the topology used for the corner
+	 * 							coordinates, may be NULL
+	 * \tparam		TElemFunc	element functor
+	 */
+	template <typename TElem, typename TIterator, typename TElemFunc>
+	static void
+	AssembleElemChunks(const char* name, int discPart,
+	                   const std::vector<IElemDisc<domain_type>*>& vElemDisc,
+	                   ConstSmartPtr<domain_type> spDomain,
+	                   ConstSmartPtr<DoFDistribution> dd,
+	                   TIterator iterBegin, TIterator iterEnd,
+	                   int si, bool bNonRegularGrid,
+	                   const vector_type* pU,
+	                   ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+	                   TElemFunc& elemFunc,
+	                   const FrozenTopology<domain_type>* pTopo)
+	{
+	//	reference object id
+		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
+
+	//	one evaluator per thread, if all element discs allow it
+		bool bThreaded = true;
+		for(size_t i = 0; i < vElemDisc.size(); ++i)
+			bThreaded = bThreaded && vElemDisc[i]->thread_safe_elem_evaluation();
+		const int numEval = bThreaded ? NumOMPThreads() : 1;
+
+	//	every evaluator is created and prepared by the thread using it, such
+	//	that the thread-local data of the element discs is set up for it
+		std::vector<SmartPtr<DataEvaluator<domain_type> > > vEval(numEval);
+		std::string errMsg;
+#ifdef UG_OPENMP
+		#pragma omp parallel num_threads(numEval)
+#endif
+		{
+#ifdef UG_OPENMP
+			#pragma omp critical (StdGlobAssembler_elem_loop)
+#endif
+			try
+			{
+				const int tid = OMPThreadID();
+				SmartPtr<DataEvaluator<domain_type> > spEval = elemFunc.create_eval
+						(discPart, vElemDisc, dd->function_pattern(), bNonRegularGrid, tid);
+				spEval->prepare_elem_loop(id, si);
+				vEval[tid] = spEval;
+			}
+			catch(UGError& err) {if(errMsg.empty()) errMsg = err.get_msg();}
+		}
+		if(!errMsg.empty())
+			UG_THROW(name << ": Cannot prepare element loop: " << errMsg);
+
+		typename chunk_type<TElem>::type chunk(spAssTuner->assembling_chunk_size());
+		elemFunc.resize(chunk.capacity());
+
+		for(TIterator iter = iterBegin; chunk.collect(iter, iterEnd, *spAssTuner);)
+		{
+		//	get corner coordinates, global indices and local values of u
+			chunk.load(*spDomain, *dd, pU, vEval[0]->use_hanging(), pTopo);
+
+		//	compute the local contributions
+			const int numElem = (int) chunk.size();
+			UG_OMP_PARALLEL_FOR_IF(numEval > 1 && numElem > 1)
+			for(int i = 0; i < numElem; ++i)
+			{
+				try
+				{
+					const int tid = OMPThreadID();
+					elemFunc.template operator()<TElem>(*vEval[tid], chunk, i, tid);
+				}
+				catch(UGError& err)
+				{
+#ifdef UG_OPENMP
+					#pragma omp critical (StdGlobAssembler_elem_loop)
+#endif
+					if(errMsg.empty()) errMsg = err.get_msg();
+				}
+			}
+			if(!errMsg.empty())
+				UG_THROW(name << ": Cannot assemble element: " << errMsg);
+
+		//	send local to global matrix/vector
+			try{
+				elemFunc.template add_to_global<TElem>(chunk, *spAssTuner, dd);
+			}
+			UG_CATCH_THROW(name << ": Cannot add local contributions.");
+		}
+
+	//	finish element loop (by the thread that has prepared it)
+#ifdef UG_OPENMP
+		#pragma omp parallel num_threads(numEval)
+#endif
+		{
+#ifdef UG_OPENMP
+			#pragma omp critical (StdGlobAssembler_elem_loop)
+#endif
+			try
+			{
+				vEval[OMPThreadID()]->finish_elem_loop();
+			}
+			catch(UGError& err) {if(errMsg.empty()) errMsg = err.get_msg();}
+		}
+		if(!errMsg.empty())
+			UG_THROW(name << ": Cannot finish element loop: " << errMsg);
+	}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Assemble Stiffness Matrix
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +966,7 @@ public:
 	 * \param[in,out]	A				Stiffness matrix
 	 * \param[in]		u				solution
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -119,11 +978,21 @@ public:
 								int si, bool bNonRegularGrid,
 								matrix_type& A,
 								const vector_type& u,
-								ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+								ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+								const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			JacAElemFunc elemFunc(A);
+			AssembleElemChunks<TElem>("AssembleStiffnessMatrix", STIFF, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &u, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -215,6 +1084,7 @@ public:
 	 * \param[in,out]	M				Mass matrix
 	 * \param[in]		u				solution
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -226,11 +1096,21 @@ public:
 						int si, bool bNonRegularGrid,
 						matrix_type& M,
 						const vector_type& u,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			JacMElemFunc elemFunc(M);
+			AssembleElemChunks<TElem>("AssembleMassMatrix", MASS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &u, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -322,6 +1202,7 @@ public:
 	 * \param[in,out]	J				jacobian
 	 * \param[in]		u				solution
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -333,11 +1214,21 @@ public:
 						int si, bool bNonRegularGrid,
 						matrix_type& J,
 						const vector_type& u,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			JacAElemFunc elemFunc(J);
+			AssembleElemChunks<TElem>("(stationary) AssembleJacobian", STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &u, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -434,6 +1325,7 @@ public:
 	 * \param[in]		vSol			current and previous solutions
 	 * \param[in]		s_a0			scaling factor for stiffness part
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -446,11 +1338,21 @@ public:
 						matrix_type& J,
 						ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 						number s_a0,
-						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+						ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+						const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			InstJacElemFunc elemFunc(J, vSol, s_a0);
+			AssembleElemChunks<TElem>("(instationary) AssembleJacobian", MASS | STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, vSol->solution(0).get(), spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -573,6 +1475,7 @@ public:
 	 * \param[in,out]	d				defect
 	 * \param[in]		u				solution
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -584,11 +1487,21 @@ public:
 					int si, bool bNonRegularGrid,
 					vector_type& d,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if at least one element exists, else return
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			DefectElemFunc elemFunc(d, spAssTuner, dd);
+			AssembleElemChunks<TElem>("(stationary) AssembleDefect", STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &u, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -708,6 +1621,7 @@ public:
 	 * \param[in]		vScaleMass		scaling factors for mass part
 	 * \param[in]		vScaleStiff		scaling factors for stiffness part
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -721,7 +1635,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
@@ -741,6 +1656,15 @@ public:
 					"least "<<vScaleStiff.size()<<" time steps, but only "<<
 					vSol->size() << " passed.");
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			InstDefectElemFunc elemFunc(d, vSol, vScaleMass, vScaleStiff);
+			AssembleElemChunks<TElem>("(instationary) AssembleDefect", MASS | STIFF | RHS | EXPL, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, NULL, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	create local time series
 		LocalVectorTimeSeries locTimeSeries;
 		locTimeSeries.read_times(vSol);
@@ -898,6 +1822,7 @@ public:
 	 * \param[in,out]	A				Matrix
 	 * \param[in,out]	rhs				Right-hand side
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -909,11 +1834,21 @@ public:
 					int si, bool bNonRegularGrid,
 					matrix_type& A,
 					vector_type& rhs,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			LinearElemFunc elemFunc(A, rhs);
+			AssembleElemChunks<TElem>("(stationary) AssembleLinear", STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, NULL, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -1026,6 +1961,7 @@ public:
 	 * \param[in]		vScaleMass		scaling factors for mass part
 	 * \param[in]		vScaleStiff		scaling factors for stiffness part
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -1040,7 +1976,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
@@ -1060,6 +1997,16 @@ public:
 					"least "<<vScaleStiff.size()<<" time steps, but only "<<
 					vSol->size() << " passed.");
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			InstLinearElemFunc elemFunc(A, rhs, vSol, vScaleMass, vScaleStiff,
+			                            !spAssTuner->matrix_is_const());
+			AssembleElemChunks<TElem>("(instationary) AssembleLinear", MASS | STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, NULL, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	create local time solution
 		LocalVectorTimeSeries locTimeSeries;
 		locTimeSeries.read_times(vSol);
@@ -1245,6 +2192,7 @@ public:
 	 * \param[in,out]	rhs				Right-hand side
 	 * \param[in]		u				solution
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -1256,11 +2204,21 @@ public:
 					int si, bool bNonRegularGrid,
 					vector_type& rhs,
 					const vector_type& u,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			RhsElemFunc elemFunc(rhs);
+			AssembleElemChunks<TElem>("AssembleRhs", RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, &u, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	reference object id
 		static const ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
@@ -1357,6 +2315,7 @@ public:
 	 * \param[in]		vScaleMass		scaling factors for mass part
 	 * \param[in]		vScaleStiff		scaling factors for stiffness part
 	 * \param[in]		spAssTuner		assemble adapter
+	 * \param[in]		pTopo			snapshot of the topology (may be NULL)
 	 */
 	template <typename TElem, typename TIterator>
 	static void
@@ -1370,7 +2329,8 @@ public:
 					ConstSmartPtr<VectorTimeSeries<vector_type> > vSol,
 					const std::vector<number>& vScaleMass,
 					const std::vector<number>& vScaleStiff,
-					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner)
+					ConstSmartPtr<AssemblingTuner<TAlgebra> > spAssTuner,
+					const FrozenTopology<domain_type>* pTopo = NULL)
 	{
 	//	check if there are any elements at all, otherwise return immediately
 		if(iterBegin == iterEnd) return;
@@ -1390,6 +2350,15 @@ public:
 					"least "<<vScaleStiff.size()<<" time steps, but only "<<
 					vSol->size() << " passed.");
 
+	//	threaded assembling: process the elements in chunks
+		if(spAssTuner->threaded_assembling_enabled())
+		{
+			InstRhsElemFunc elemFunc(rhs, vSol, vScaleMass, vScaleStiff);
+			AssembleElemChunks<TElem>("(instationary) AssembleRhs", MASS | STIFF | RHS, vElemDisc, spDomain, dd,
+					iterBegin, iterEnd, si, bNonRegularGrid, NULL, spAssTuner, elemFunc, pTopo);
+			return;
+		}
+
 	//	get current time
 		LocalVectorTimeSeries locTimeSeries;
 		locTimeSeries.read_times(vSol);
@@ -45,6 +45,7 @@
 #include "lib_disc/reference_element/reference_element_traits.h"
 #include "lib_disc/spatial_disc/user_data/data_import.h"
 #include "common/util/provider.h"
+#include "common/util/openmp_util.h"
 #include "lib_disc/domain_util.h"
 #include "lib_disc/domain_traits.h"
 #include "elem_modifier.h"
@@ -648,7 +649,7 @@ class IElemDiscBase
 		void set_time_independent();
 
 	///	returns if assembling is time-dependent
-		bool is_time_dependent() const {return (m_pLocalVectorTimeSeries != NULL) && !m_bStationaryForced;}
+		bool is_time_dependent() const {return (time_state().pLocTimeSeries != NULL) && !m_bStationaryForced;}
 
 	///	sets that the assembling is always stationary (even in instationary case)
 		void set_stationary(bool bStationaryForced = true) {m_bStationaryForced = bStationaryForced;}
@@ -668,15 +669,16 @@ class IElemDiscBase
 		bool local_time_series_needed() {return is_time_dependent() && requests_local_time_series();}
 
 	///	sets the current time point
-		void set_time_point(const size_t timePoint) {m_timePoint = timePoint;}
+		void set_time_point(const size_t timePoint) {time_state().timePoint = timePoint;}
 
 	///	returns the currently considered time point of the time-disc scheme
-		size_t time_point() const {return m_timePoint;}
+		size_t time_point() const {return time_state().timePoint;}
 
 	///	returns currently set timepoint
 		number time() const
 		{
-			if(m_pLocalVectorTimeSeries) return m_pLocalVectorTimeSeries->time(m_timePoint);
+			const TimeState& ts = time_state();
+			if(ts.pLocTimeSeries) return ts.pLocTimeSeries->time(ts.timePoint);
 			else return 0.0;
 		}
 
@@ -691,7 +693,7 @@ class IElemDiscBase
 	 * \returns vLocalTimeSol		vector of local time Solutions
 	 */
 		const LocalVectorTimeSeries* local_time_solutions() const
-		{return m_pLocalVectorTimeSeries;}
+		{return time_state().pLocTimeSeries;}
 
 	///	returns the weight factors of the time-disc scheme
 	///	\{
@@ -701,16 +703,49 @@ class IElemDiscBase
 		number mass_scale(const size_t timePoint) const {return m_vScaleMass[timePoint];}
 		number stiff_scale(const size_t timePoint) const {return m_vScaleStiff[timePoint];}
 
-		number mass_scale() const {return m_vScaleMass[m_timePoint];}
-		number stiff_scale() const {return m_vScaleStiff[m_timePoint];}
+		number mass_scale() const {return m_vScaleMass[time_point()];}
+		number stiff_scale() const {return m_vScaleStiff[time_point()];}
 	///	\}
 
 	protected:
-	///	time point
-		size_t m_timePoint;
+	///	time point and local time series set by a DataEvaluator
+		struct TimeState
+		{
+			TimeState() : timePoint(0), pLocTimeSeries(NULL) {}
+
+		///	time point
+			size_t timePoint;
 
-	///	list of local vectors for all solutions of the time series
-		LocalVectorTimeSeries* m_pLocalVectorTimeSeries;
+		///	list of local vectors for all solutions of the time series
+			LocalVectorTimeSeries* pLocTimeSeries;
+		};
+
+	///	returns the time state of the calling thread
+	/**
+	 * The threaded assembling (see thread_safe_elem_evaluation) uses one
+	 * DataEvaluator per thread, each with a local time series of its own and
+	 * possibly at another time point. Therefore every thread has its own time
+	 * state. The states are added when a thread sets its time series, which
+	 * happens before the element loop.
+	 */
+		const TimeState& time_state() const
+		{
+			const size_t tid = OMPThreadID();
+			return (tid < m_vTimeState.size()) ? m_vTimeState[tid] : m_vTimeState[0];
+		}
+
+		TimeState& time_state()
+		{
+			const size_t tid = OMPThreadID();
+			if(tid >= m_vTimeState.size()) m_vTimeState.resize(tid + 1);
+			return m_vTimeState[tid];
+		}
+
+	///	local time series of the calling thread
+		LocalVectorTimeSeries* local_time_series() {return time_state().pLocTimeSeries;}
+
+	///	time state per thread
+		std::vector<TimeState> m_vTimeState;
 
 	///	weight factors for time dependent assembling
 	/// \{
@@ -750,6 +785,19 @@ class IElemDiscBase
 	 * element assemblings but is needed for finite volumes
 	 */
 		virtual bool use_hanging() const {return false;}
+
+	///	returns if the elements may be evaluated by several threads concurrently
+	/**
+	 * If true, the threaded assembling (see AssemblingTuner::set_threaded_assembling)
+	 * evaluates the elements of a subset on several threads. Every thread then
+	 * calls prep_elem_loop and fsh_elem_loop (one thread after the other) and
+	 * afterwards only evaluates elements using the data it has prepared
+	 * itself, e.g. thread-local geometries from the GeomProvider. The time
+	 * point and the local time series are kept per thread by this base class.
+	 * The element functions must not modify other members of the
+	 * discretization and must not use data imports.
+	 */
+		virtual bool thread_safe_elem_evaluation() const {return false;}
 };
 
 
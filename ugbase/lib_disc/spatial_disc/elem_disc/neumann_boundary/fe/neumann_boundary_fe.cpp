@@ -155,10 +155,11 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 
 	ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
-//	set lin defect fct for imports
+//	set lin defect fct for imports (constant data are evaluated directly)
 	for(size_t data = 0; data < m_vNumberData.size(); ++data)
 	{
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		if(m_vNumberData[data].functor->constant()) continue;
 		m_vNumberData[data].import.set_fct(id,
 		                                   &m_vNumberData[data],
 		                                   &NumberData::template lin_def<TElem, TFEGeom>);
@@ -184,7 +185,7 @@ prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid,
 						"Cannot update Finite Element Geometry.");
 
 	for(size_t i = 0; i < m_vNumberData.size(); ++i)
-		if(m_vNumberData[i].InnerSSGrp.contains(m_si))
+		if(m_vNumberData[i].InnerSSGrp.contains(m_si) && !m_vNumberData[i].functor->constant())
 			m_vNumberData[i].template extract_bip<TElem, TFEGeom>(geo);
 }
 
@@ -199,15 +200,19 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 //	Number Data
 	for(size_t data = 0; data < m_vNumberData.size(); ++data){
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		const bool bConst = m_vNumberData[data].functor->constant();
 		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
 			const int si = m_vNumberData[data].BndSSGrp[s];
 			const std::vector<BF>& vBF = geo.bf(si);
 
 			for(size_t b = 0; b < vBF.size(); ++b){
 				for(size_t ip = 0; ip < vBF[b].num_ip(); ++ip){
+					number val;
+					if(bConst) (*m_vNumberData[data].functor)(val, vBF[b].global_ip(ip), this->time(), si);
+					else val = m_vNumberData[data].import[ip];
+
 					for(size_t sh = 0; sh < vBF[b].num_sh(); ++sh){
-						d(_C_, sh) -= m_vNumberData[data].import[ip]
-									 * vBF[b].shape(ip, sh) * vBF[b].weight(ip);
+						d(_C_, sh) -= val * vBF[b].shape(ip, sh) * vBF[b].weight(ip);
 					}
 				}
 			}
@@ -76,7 +76,7 @@ class NeumannBoundaryFE
 			NumberData(SmartPtr<CplUserData<number, dim> > data,
 					   std::string BndSubsets, std::string InnerSubsets,
 					   NeumannBoundaryFE* this_)
-				: base_type::Data(BndSubsets, InnerSubsets), This(this_)
+				: base_type::Data(BndSubsets, InnerSubsets), functor(data), This(this_)
 			{
 				import.set_data(data);
 			}
@@ -89,6 +89,7 @@ class NeumannBoundaryFE
 						 std::vector<std::vector<number> > vvvLinDef[],
 						 const size_t nip);
 
+			SmartPtr<CplUserData<number, dim> > functor;
 			DataImport<number, dim> import;
 			std::vector<MathVector<dim> > vLocIP;
 			std::vector<MathVector<dim> > vGloIP;
@@ -123,6 +124,20 @@ class NeumannBoundaryFE
 		void update_subset_groups();
 
 	public:
+	///	returns if the elements may be evaluated by several threads concurrently
+	/**
+	 * Constant number data are evaluated directly instead of via a data
+	 * import. Thus, the elements can be evaluated concurrently if all data
+	 * are constant. Other data (e.g. Lua callbacks) may not be evaluated by
+	 * several threads.
+	 */
+		virtual bool thread_safe_elem_evaluation() const
+		{
+			return base_type::all_constant(m_vNumberData)
+					&& base_type::all_constant(m_vBNDNumberData)
+					&& base_type::all_constant(m_vVectorData);
+		}
+
 	///	type of trial space for each function used
 		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
 
@@ -160,10 +160,11 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 
 	ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
-//	set lin defect fct for imports
+//	set lin defect fct for imports (constant data are evaluated directly)
 	for(size_t data = 0; data < m_vNumberData.size(); ++data)
 	{
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		if(m_vNumberData[data].functor->constant()) continue;
 		m_vNumberData[data].import.set_fct(id,
 		                                   &m_vNumberData[data],
 		                                   &NumberData::template lin_def<TElem, TFVGeom>);
@@ -187,7 +188,7 @@ prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid,
 						"Cannot update Finite Volume Geometry.");
 
 	for(size_t i = 0; i < m_vNumberData.size(); ++i)
-		if(m_vNumberData[i].InnerSSGrp.contains(m_si))
+		if(m_vNumberData[i].InnerSSGrp.contains(m_si) && !m_vNumberData[i].functor->constant())
 			m_vNumberData[i].template extract_bip<TElem, TFVGeom>(geo);
 }
 
@@ -202,6 +203,7 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 //	Number Data
 	for(size_t data = 0; data < m_vNumberData.size(); ++data){
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		const bool bConst = m_vNumberData[data].functor->constant();
 		size_t ip = 0;
 		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
 			const int si = m_vNumberData[data].BndSSGrp[s];
@@ -211,8 +213,11 @@ add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoor
 				const int co = vBF[b].node_id();
 
 				for(size_t i = 0; i < vBF[b].num_ip(); ++i, ++ip){
-					d(_C_, co) -= m_vNumberData[data].import[ip]
-					             * vBF[b].volume() * vBF[b].weight(i);
+					number val;
+					if(bConst) (*m_vNumberData[data].functor)(val, vBF[b].global_ip(i), this->time(), si);
+					else val = m_vNumberData[data].import[ip];
+
+					d(_C_, co) -= val * vBF[b].volume() * vBF[b].weight(i);
 				}
 			}
 		}
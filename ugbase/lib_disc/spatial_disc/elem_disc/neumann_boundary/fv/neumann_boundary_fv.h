@@ -76,7 +76,7 @@ class NeumannBoundaryFV
 			NumberData(SmartPtr<CplUserData<number, dim> > data,
 					   std::string BndSubsets, std::string InnerSubsets,
 					   NeumannBoundaryFV* this_)
-				: base_type::Data(BndSubsets, InnerSubsets), This(this_)
+				: base_type::Data(BndSubsets, InnerSubsets), functor(data), This(this_)
 			{
 				import.set_data(data);
 			}
@@ -92,6 +92,7 @@ class NeumannBoundaryFV
 			template <int refDim>
 			std::vector<MathVector<refDim> >* local_ips();
 
+			SmartPtr<CplUserData<number, dim> > functor;
 			DataImport<number, dim> import;
 			std::vector<MathVector<3> > vLocIP_dim3;
 			std::vector<MathVector<2> > vLocIP_dim2;	// might have Neumann bnd for lower-dim elements!
@@ -128,6 +129,20 @@ class NeumannBoundaryFV
 		void update_subset_groups();
 
 	public:
+	///	returns if the elements may be evaluated by several threads concurrently
+	/**
+	 * Constant number data are evaluated directly instead of via a data
+	 * import. Thus, the elements can be evaluated concurrently if all data
+	 * are constant. Other data (e.g. Lua callbacks) may not be evaluated by
+	 * several threads.
+	 */
+		virtual bool thread_safe_elem_evaluation() const
+		{
+			return base_type::all_constant(m_vNumberData)
+					&& base_type::all_constant(m_vBNDNumberData)
+					&& base_type::all_constant(m_vVectorData);
+		}
+
 	///	type of trial space for each function used
 		virtual void prepare_setting(const std::vector<LFEID>& vLfeID, bool bNonRegularGrid);
 
@@ -110,7 +110,7 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 	m_si = si;
 
 //	register subsetIndex at Geometry
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = GeomProvider<TFVGeom >::get();
 
 //	request subset indices as boundary subset. This will force the
 //	creation of boundary subsets when calling geo.update
@@ -142,10 +142,11 @@ prep_elem_loop(const ReferenceObjectID roid, const int si)
 
 	ReferenceObjectID id = geometry_traits<TElem>::REFERENCE_OBJECT_ID;
 
-//	set lin defect fct for imports
+//	set lin defect fct for imports (constant data are evaluated directly)
 	for(size_t data = 0; data < m_vNumberData.size(); ++data)
 	{
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		if(m_vNumberData[data].functor->constant()) continue;
 		m_vNumberData[data].import.set_fct(id,
 		                                   &m_vNumberData[data],
 		                                   &NumberData::template lin_def<TElem, TFVGeom>);
@@ -161,7 +162,7 @@ void NeumannBoundaryFV1<TDomain>::
 prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid, const MathVector<dim> vCornerCoords[])
 {
 //  update Geometry for this element
-	static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	TFVGeom& geo = GeomProvider<TFVGeom >::get();
 	try{
 		geo.update(elem, vCornerCoords, &(this->subset_handler()));
 	}
@@ -169,7 +170,7 @@ prep_elem(const LocalVector& u, GridObject* elem, const ReferenceObjectID roid,
 						"Cannot update Finite Volume Geometry.");
 
 	for(size_t i = 0; i < m_vNumberData.size(); ++i)
-		if(m_vNumberData[i].InnerSSGrp.contains(m_si))
+		if(m_vNumberData[i].InnerSSGrp.contains(m_si) && !m_vNumberData[i].functor->constant())
 			m_vNumberData[i].template extract_bip<TElem, TFVGeom>(geo);
 }
 
@@ -178,21 +179,25 @@ template<typename TElem, typename TFVGeom>
 void NeumannBoundaryFV1<TDomain>::
 add_rhs_elem(LocalVector& d, GridObject* elem, const MathVector<dim> vCornerCoords[])
 {
-	const static TFVGeom& geo = GeomProvider<TFVGeom >::get();
+	const TFVGeom& geo = GeomProvider<TFVGeom >::get();
 	typedef typename TFVGeom::BF BF;
 
 //	Number Data
 	for(size_t data = 0; data < m_vNumberData.size(); ++data){
 		if(!m_vNumberData[data].InnerSSGrp.contains(m_si)) continue;
+		const bool bConst = m_vNumberData[data].functor->constant();
 		size_t ip = 0;
 		for(size_t s = 0; s < m_vNumberData[data].BndSSGrp.size(); ++s){
 			const int si = m_vNumberData[data].BndSSGrp[s];
 			const std::vector<BF>& vBF = geo.bf(si);
 
 			for(size_t i = 0; i < vBF.size(); ++i, ++ip){
+				number val;
+				if(bConst) (*m_vNumberData[data].functor)(val, vBF[i].global_ip(), this->time(), si);
+				else val = m_vNumberData[data].import[ip];
+
 				const int co = vBF[i].node_id();
-				d(_C_, co) -= m_vNumberData[data].import[ip]
-				                                    * vBF[i].volume();
+				d(_C_, co) -= val * vBF[i].volume();
 			}
 		}
 	}
@@ -239,7 +244,7 @@ void NeumannBoundaryFV1<TDomain>::
 fsh_elem_loop()
 {
 //	remove subsetIndex from Geometry
-	static TGeom& geo = GeomProvider<TGeom >::get();
+	TGeom& geo = GeomProvider<TGeom >::get();
 
 
 //	unrequest subset indices as boundary subset. This will force the
@@ -510,7 +515,7 @@ lin_def(const LocalVector& u,
             const size_t nip)
 {
 //  get finite volume geometry
-	const static TFVGeom& geo = GeomProvider<TFVGeom>::get();
+	const TFVGeom& geo = GeomProvider<TFVGeom>::get();
 	typedef typename TFVGeom::BF BF;
 
 	for(size_t s = 0; s < this->BndSSGrp.size(); ++s)
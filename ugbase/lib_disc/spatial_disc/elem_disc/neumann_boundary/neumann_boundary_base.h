@@ -99,6 +99,15 @@ class NeumannBoundaryBase
 	///	adds subsets to the looped inner subsets
 		void add_inner_subsets(const char* InnerSubsets);
 
+	///	returns if the user data of all entries are constant
+		template <typename TData>
+		static bool all_constant(const std::vector<TData>& vData)
+		{
+			for(size_t i = 0; i < vData.size(); ++i)
+				if(!vData[i].functor->constant()) return false;
+			return true;
+		}
+
 	public:
 	///	 returns the type of elem disc
 		virtual int type() const {return EDT_BND;}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2013-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Andreas Vogel
+ *
+ * This file is part of UG4.
+ *
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ *
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ *
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_DISC__SPATIAL_DISC__LOCAL_TO_GLOBAL__MATRIX_SCATTER_MAP__
+#define __H__UG__LIB_DISC__SPATIAL_DISC__LOCAL_TO_GLOBAL__MATRIX_SCATTER_MAP__
+
+#include <vector>
+
+#include "common/common.h"
+#include "common/util/openmp_util.h"
+#include "lib_disc/common/local_algebra.h"
+#include "lib_disc/common/revision_counter.h"
+#include "lib_disc/dof_manager/dof_distribution.h"
+
+namespace ug{
+
+/// Cached positions of local matrix entries in the global sparse matrix
+/**
+ * Adding a local matrix to a sparse matrix requires a search for every entry
+ * of the local matrix in the row of the global matrix. If a matrix with the
+ * same sparsity pattern is assembled repeatedly (e.g. the Jacobian in every
+ * Newton step), these searches always give the same result. This class records
+ * the position in the value array of the global matrix for every entry of every
+ * local matrix added during one assembling and replays them in later
+ * assemblings, such that the local values are added without any search.
+ *
+ * The map is used in three stages, each triggered by begin():
+ * - The matrix is resized and cleared and the structure is built by the
+ *   usual scattering.
+ * - If the DoFDistribution has not changed, the matrix is defragmented and
+ *   cleared retaining its structure and the positions are recorded while
+ *   scattering.
+ * - In all further assemblings for the same matrix and DoFDistribution
+ *   revision, the recorded positions are used.
+ *
+ * It is assumed, that the local matrices are added in the same order in every
+ * assembling. Every replayed local matrix is checked against the recorded one
+ * by all its global row and column indices. On the first mismatch the replay
+ * is stopped: this and all further local matrices of the assembling are added
+ * the usual way (which may insert connections and thus move the recorded
+ * positions) and the map is recorded anew in the next assembling. Between two
+ * assemblings the structure of the matrix must not be changed by other code.
+ *
+ * \tparam TMatrix 		type of the global (sparse) matrix
+ */
+template <typename TMatrix>
+class MatrixScatterMap
+{
+	public:
+	///	matrix type
+		typedef TMatrix matrix_type;
+
+	public:
+	///	constructor
+		MatrixScatterMap()
+			: m_pMat(NULL), m_numIndex(0), m_nnz(0),
+			  m_bStructureBuilt(false), m_bValid(false),
+			  m_bRecording(false), m_bReplaying(false),
+			  m_numCall(0), m_numMismatch(0)
+		{}
+
+	///	prepares the matrix for a new assembling and selects the stage
+		void begin(const DoFDistribution& dd, matrix_type& mat)
+		{
+			const size_t numIndex = dd.num_indices();
+			const bool bSame = (m_pMat == &mat) && (m_revision == dd.revision())
+							&& (m_numIndex == numIndex)
+							&& (mat.num_rows() == numIndex) && (mat.num_cols() == numIndex);
+
+		//	check if the last assembling has completed the map
+			if(m_bRecording || m_bReplaying)
+				m_bValid = bSame && (m_numMismatch == 0)
+						&& (m_numCall == num_recorded_calls())
+						&& (mat.total_num_connections() == m_nnz);
+
+			m_bRecording = m_bReplaying = false;
+			m_numCall = 0;
+			m_numMismatch = 0;
+
+			if(bSame && m_bValid)
+			{
+				mat.clear_retain_structure();
+				m_bReplaying = true;
+			}
+			else if(bSame && m_bStructureBuilt)
+			{
+				mat.defragment();
+				mat.clear_retain_structure();
+				m_nnz = mat.total_num_connections();
+				m_vCallStart.assign(1, 0);
+				m_vCallIndStart.assign(1, 0);
+				m_vCallInd.clear();
+				m_vPos.clear();
+				m_bRecording = true;
+			}
+			else
+			{
+				mat.resize_and_clear(numIndex, numIndex);
+				m_pMat = &mat;
+				m_revision = dd.revision();
+				m_numIndex = numIndex;
+				m_bStructureBuilt = true;
+				m_bValid = false;
+			}
+		}
+
+	///	returns if the recorded positions are used in the current assembling
+		bool replaying() const {return m_bReplaying;}
+
+	///	adds a local matrix to the global matrix (call in assembling order)
+		void add(matrix_type& mat, const LocalMatrix& lmat)
+		{
+			if(m_bReplaying && add(mat, lmat, m_numCall++)) return;
+			if(m_bReplaying) stop_replaying();
+
+			if(m_bRecording) record(mat, lmat);
+			else AddLocalMatrixToGlobal(mat, lmat);
+		}
+
+	///	stops the replay of the recorded positions for the current assembling
+	/**
+	 * Must be called after a mismatching call, before the local matrix is
+	 * added the usual way. All further local matrices are added the usual way
+	 * and the map is recorded anew in the next assembling.
+	 */
+		void stop_replaying() {m_bReplaying = false; m_bValid = false;}
+
+	///	reserves n consecutive calls and returns the first one
+	/**
+	 * Used if several local matrices are added concurrently: the i'th of the
+	 * n local matrices (in assembling order) is added by add(mat, lmat, first+i).
+	 */
+		size_t reserve_calls(size_t n)
+		{
+			const size_t first = m_numCall;
+			m_numCall += n;
+			return first;
+		}
+
+	///	adds a local matrix using the recorded positions of a call
+	/**
+	 * Several threads may call this method concurrently, if the local
+	 * matrices do not share rows of the global matrix.
+	 *
+	 * If the local matrix does not fit to the recorded call, nothing is added
+	 * and false is returned. The caller must then call stop_replaying() and
+	 * add the local matrix the usual way (e.g. by AddLocalMatrixToGlobal),
+	 * which may insert new connections and therefore must not run
+	 * concurrently to other additions.
+	 *
+	 * \returns true if the local matrix has been added
+	 */
+		bool add(matrix_type& mat, const LocalMatrix& lmat, size_t call)
+		{
+			UG_ASSERT(m_bReplaying, "MatrixScatterMap: not in replay stage.");
+			const LocalIndices& rowInd = lmat.get_row_indices();
+			const LocalIndices& colInd = lmat.get_col_indices();
+
+			if(!call_matches(lmat, call))
+			{
+				UG_OMP_ATOMIC
+				m_numMismatch++;
+				return false;
+			}
+
+			const size_t* pPos = m_vPos.empty() ? NULL : &m_vPos[0] + m_vCallStart[call];
+			for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+				for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+				{
+					const size_t rowComp = rowInd.comp(fct1,dof1);
+					for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+						for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+							BlockRef(mat.value_at(*pPos++), rowComp, colInd.comp(fct2,dof2))
+								+= lmat.value(fct1,dof1,fct2,dof2);
+				}
+			return true;
+		}
+
+	protected:
+	///	number of local matrices recorded
+		size_t num_recorded_calls() const {return m_vCallStart.empty() ? 0 : m_vCallStart.size() - 1;}
+
+	///	returns the number of entries of a local matrix
+		static size_t num_entries(const LocalMatrix& lmat)
+		{
+			size_t numRow = 0, numCol = 0;
+			for(size_t fct=0; fct < lmat.num_all_row_fct(); ++fct) numRow += lmat.num_all_row_dof(fct);
+			for(size_t fct=0; fct < lmat.num_all_col_fct(); ++fct) numCol += lmat.num_all_col_dof(fct);
+			return numRow * numCol;
+		}
+
+	///	checks if a local matrix fits to the recorded call
+		bool call_matches(const LocalMatrix& lmat, size_t call) const
+		{
+			if(call >= num_recorded_calls()) return false;
+			if(m_vCallStart[call+1] - m_vCallStart[call] != num_entries(lmat)) return false;
+
+		//	compare all global row and column indices
+			const LocalIndices& rowInd = lmat.get_row_indices();
+			const LocalIndices& colInd = lmat.get_col_indices();
+			const size_t* pInd = m_vCallInd.data() + m_vCallIndStart[call];
+			const size_t* pEnd = m_vCallInd.data() + m_vCallIndStart[call+1];
+			for(size_t fct=0; fct < lmat.num_all_row_fct(); ++fct)
+				for(size_t dof=0; dof < lmat.num_all_row_dof(fct); ++dof)
+					if(pInd == pEnd || *pInd++ != rowInd.index(fct, dof)) return false;
+			for(size_t fct=0; fct < lmat.num_all_col_fct(); ++fct)
+				for(size_t dof=0; dof < lmat.num_all_col_dof(fct); ++dof)
+					if(pInd == pEnd || *pInd++ != colInd.index(fct, dof)) return false;
+			return pInd == pEnd;
+		}
+
+	///	adds a local matrix and records the positions of its entries
+		void record(matrix_type& mat, const LocalMatrix& lmat)
+		{
+			const LocalIndices& rowInd = lmat.get_row_indices();
+			const LocalIndices& colInd = lmat.get_col_indices();
+
+			for(size_t fct1=0; fct1 < lmat.num_all_row_fct(); ++fct1)
+				for(size_t dof1=0; dof1 < lmat.num_all_row_dof(fct1); ++dof1)
+				{
+					const size_t rowIndex = rowInd.index(fct1,dof1);
+					const size_t rowComp = rowInd.comp(fct1,dof1);
+					for(size_t fct2=0; fct2 < lmat.num_all_col_fct(); ++fct2)
+						for(size_t dof2=0; dof2 < lmat.num_all_col_dof(fct2); ++dof2)
+						{
+							const size_t colIndex = colInd.index(fct2,dof2);
+							const int pos = mat.get_position(rowIndex, colIndex);
+
+						//	a new connection changes the structure: positions invalid
+							if(pos < 0) {m_numMismatch++; m_vPos.push_back(0);}
+							else m_vPos.push_back(pos);
+
+							BlockRef(mat(rowIndex, colIndex), rowComp, colInd.comp(fct2,dof2))
+								+= lmat.value(fct1,dof1,fct2,dof2);
+						}
+				}
+
+			for(size_t fct=0; fct < lmat.num_all_row_fct(); ++fct)
+				for(size_t dof=0; dof < lmat.num_all_row_dof(fct); ++dof)
+					m_vCallInd.push_back(rowInd.index(fct, dof));
+			for(size_t fct=0; fct < lmat.num_all_col_fct(); ++fct)
+				for(size_t dof=0; dof < lmat.num_all_col_dof(fct); ++dof)
+					m_vCallInd.push_back(colInd.index(fct, dof));
+			m_vCallIndStart.push_back(m_vCallInd.size());
+			m_vCallStart.push_back(m_vPos.size());
+			m_numCall++;
+		}
+
+	protected:
+	///	matrix and DoFDistribution revision the map has been built for
+		const matrix_type* m_pMat;
+		RevisionCounter m_revision;
+		size_t m_numIndex;
+
+	///	number of connections of the matrix when recorded
+		size_t m_nnz;
+
+	///	stages
+		bool m_bStructureBuilt, m_bValid, m_bRecording, m_bReplaying;
+
+	///	start of the positions of each recorded local matrix
+		std::vector<size_t> m_vCallStart;
+
+	///	global row and column indices of each recorded local matrix
+		std::vector<size_t> m_vCallIndStart;
+		std::vector<size_t> m_vCallInd;
+
+	///	positions of the local entries in the value array of the matrix
+		std::vector<size_t> m_vPos;
+
+	///	number of local matrices added in the current assembling
+		size_t m_numCall;
+
+	///	number of local matrices that could not be recorded or replayed
+		size_t m_numMismatch;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__SPATIAL_DISC__LOCAL_TO_GLOBAL__MATRIX_SCATTER_MAP__ */
@@ -34,5 +34,6 @@
 #define __H__LIB_GRID__GRAPH__
 
 #include "dual_graph.h"
+#include "graph_partitioning.h"
 
 #endif
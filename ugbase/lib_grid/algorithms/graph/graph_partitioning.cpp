@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <queue>
+#include <utility>
+#include "graph_partitioning.h"
+#include "common/error.h"
+
+using namespace std;
+
+namespace ug
+{
+
+number WeightedGraph::
+total_weight() const
+{
+	number w = 0;
+	for(size_t i = 0; i < vrtWeight.size(); ++i)
+		w += vrtWeight[i];
+	return w;
+}
+
+
+number GraphEdgeCut(const WeightedGraph& g, const std::vector<int>& part)
+{
+	number cut = 0;
+	for(int v = 0; v < g.num_vertices(); ++v){
+		for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+			if(part[g.adj[e]] != part[v])
+				cut += g.edgeWeight[e];
+		}
+	}
+	return 0.5 * cut;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	helpers
+typedef priority_queue<pair<number, int> >	GainQueue;
+
+///	summed overweight of both sides of a bisection
+static number BisectionImbalance(const number* partWeight, const number* maxWeight)
+{
+	return max<number>(0, partWeight[0] - maxWeight[0])
+		 + max<number>(0, partWeight[1] - maxWeight[1]);
+}
+
+///	extracts the subgraph induced by all vertices with side[i] == s
+static void ExtractSubgraph(WeightedGraph& subOut, std::vector<int>& subIdsOut,
+							const WeightedGraph& g, const std::vector<int>& vrtIds,
+							const std::vector<int>& side, int s)
+{
+	const int n = g.num_vertices();
+	vector<int> newInd(n, -1);
+	subIdsOut.clear();
+	for(int v = 0; v < n; ++v){
+		if(side[v] == s){
+			newInd[v] = (int)subIdsOut.size();
+			subIdsOut.push_back(vrtIds[v]);
+		}
+	}
+
+	subOut.adjStart.assign(1, 0);
+	subOut.adj.clear();
+	subOut.vrtWeight.clear();
+	subOut.edgeWeight.clear();
+	for(int v = 0; v < n; ++v){
+		if(side[v] != s)
+			continue;
+		for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+			const int nbr = newInd[g.adj[e]];
+			if(nbr != -1){
+				subOut.adj.push_back(nbr);
+				subOut.edgeWeight.push_back(g.edgeWeight[e]);
+			}
+		}
+		subOut.adjStart.push_back((int)subOut.adj.size());
+		subOut.vrtWeight.push_back(g.vrtWeight[v]);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	MultilevelGraphPartitioner
+MultilevelGraphPartitioner::
+MultilevelGraphPartitioner() :
+	m_tolerance(0.03),
+	m_bisectionTolerance(0.03),
+	m_coarsestSize(100),
+	m_numRefPasses(8),
+	m_numInitialTrials(4)
+{
+}
+
+number MultilevelGraphPartitioner::
+partition(std::vector<int>& partOut, const WeightedGraph& g, int numParts)
+{
+	UG_COND_THROW(numParts < 1, "MultilevelGraphPartitioner: At least one part is required.");
+	UG_COND_THROW((int)g.adjStart.size() != g.num_vertices() + 1,
+				  "MultilevelGraphPartitioner: Invalid graph structure.");
+
+	const int n = g.num_vertices();
+	partOut.assign(n, 0);
+	if((numParts == 1) || (n == 0))
+		return 0;
+
+	vector<int> vrtIds(n);
+	for(int i = 0; i < n; ++i)
+		vrtIds[i] = i;
+
+//	the tolerance of the single bisections is chosen such that the
+//	tolerance of the final parts is met.
+	int numBisectionLevels = 0;
+	while((1 << numBisectionLevels) < numParts)
+		++numBisectionLevels;
+	m_bisectionTolerance = pow(1. + m_tolerance, 1. / (number)numBisectionLevels) - 1.;
+
+	partition_recursive(partOut, g, vrtIds, numParts, 0);
+	return GraphEdgeCut(g, partOut);
+}
+
+void MultilevelGraphPartitioner::
+partition_recursive(std::vector<int>& partOut, const WeightedGraph& g,
+					const std::vector<int>& vrtIds, int numParts, int firstPart)
+{
+	if(numParts == 1){
+		for(size_t i = 0; i < vrtIds.size(); ++i)
+			partOut[vrtIds[i]] = firstPart;
+		return;
+	}
+
+	const int numLeft = numParts / 2;
+	vector<int> side;
+	bisect(side, g, (number)numLeft / (number)numParts);
+
+	for(int s = 0; s < 2; ++s){
+		WeightedGraph sub;
+		vector<int> subIds;
+		ExtractSubgraph(sub, subIds, g, vrtIds, side, s);
+		if(s == 0)
+			partition_recursive(partOut, sub, subIds, numLeft, firstPart);
+		else
+			partition_recursive(partOut, sub, subIds, numParts - numLeft,
+								firstPart + numLeft);
+	}
+}
+
+void MultilevelGraphPartitioner::
+bisect(std::vector<int>& sideOut, const WeightedGraph& g, number ratio)
+{
+	const int n = g.num_vertices();
+	sideOut.assign(n, 0);
+	if(n < 2)
+		return;
+
+	const number totalWeight = g.total_weight();
+	const number target[2] = {ratio * totalWeight, (1. - ratio) * totalWeight};
+	const number maxWeight[2] = {(1. + m_bisectionTolerance) * target[0],
+								 (1. + m_bisectionTolerance) * target[1]};
+
+//	coarsen. A deque is used, since references to its elements stay valid.
+	deque<WeightedGraph> coarseGraphs;
+	deque<vector<int> > maps;
+	const WeightedGraph* cur = &g;
+	const number maxVrtWeight = 1.5 * totalWeight / (number)max(m_coarsestSize, 1);
+
+	while(cur->num_vertices() > m_coarsestSize){
+		coarseGraphs.push_back(WeightedGraph());
+		maps.push_back(vector<int>());
+		coarsen(coarseGraphs.back(), maps.back(), *cur, maxVrtWeight);
+		if(coarseGraphs.back().num_vertices() > 0.95 * cur->num_vertices()){
+			coarseGraphs.pop_back();
+			maps.pop_back();
+			break;
+		}
+		cur = &coarseGraphs.back();
+	}
+
+//	bisect the coarsest graph
+	initial_bisection(sideOut, *cur, target, maxWeight);
+
+//	project back and refine on each level
+	for(int lvl = (int)coarseGraphs.size() - 1; lvl >= 0; --lvl){
+		const WeightedGraph& fine = (lvl == 0) ? g : coarseGraphs[lvl - 1];
+		const vector<int>& map = maps[lvl];
+		vector<int> fineSide(fine.num_vertices());
+		for(int v = 0; v < fine.num_vertices(); ++v)
+			fineSide[v] = sideOut[map[v]];
+		sideOut.swap(fineSide);
+		refine(sideOut, fine, maxWeight);
+	}
+}
+
+void MultilevelGraphPartitioner::
+coarsen(WeightedGraph& coarseOut, std::vector<int>& mapOut,
+		const WeightedGraph& g, number maxVrtWeight)
+{
+	const int n = g.num_vertices();
+
+//	vertices are visited in a pseudo-random (but deterministic) order
+	vector<int> order(n);
+	for(int i = 0; i < n; ++i)
+		order[i] = i;
+	uint64 state = 0x2545F4914F6CDD1DULL;
+	for(int i = n - 1; i > 0; --i){
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		swap(order[i], order[(state >> 33) % (uint64)(i + 1)]);
+	}
+
+//	match each vertex with the unmatched neighbor connected by the heaviest edge
+	vector<int> match(n, -1);
+	for(int i = 0; i < n; ++i){
+		const int v = order[i];
+		if(match[v] != -1)
+			continue;
+
+		int best = -1;
+		number bestWeight = -1;
+		for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+			const int nbr = g.adj[e];
+			if((nbr == v) || (match[nbr] != -1)
+				|| (g.vrtWeight[v] + g.vrtWeight[nbr] > maxVrtWeight))
+			{
+				continue;
+			}
+			if(g.edgeWeight[e] > bestWeight){
+				best = nbr;
+				bestWeight = g.edgeWeight[e];
+			}
+		}
+
+		if(best == -1)
+			match[v] = v;
+		else{
+			match[v] = best;
+			match[best] = v;
+		}
+	}
+
+//	create coarse vertices
+	mapOut.assign(n, -1);
+	vector<int> fineVrts;
+	fineVrts.reserve(n);
+	int numCoarse = 0;
+	for(int v = 0; v < n; ++v){
+		if(mapOut[v] != -1)
+			continue;
+		mapOut[v] = numCoarse;
+		fineVrts.push_back(v);
+		if(match[v] != v){
+			mapOut[match[v]] = numCoarse;
+			fineVrts.push_back(match[v]);
+		}
+		++numCoarse;
+	}
+
+//	create coarse edges. Parallel edges are merged and their weights summed.
+	coarseOut.adjStart.assign(1, 0);
+	coarseOut.adj.clear();
+	coarseOut.edgeWeight.clear();
+	coarseOut.vrtWeight.assign(numCoarse, 0);
+
+	vector<int> marker(numCoarse, -1);
+	size_t iFine = 0;
+	for(int c = 0; c < numCoarse; ++c){
+		const int start = (int)coarseOut.adj.size();
+		const int numFine = (match[fineVrts[iFine]] == fineVrts[iFine]) ? 1 : 2;
+		for(int i = 0; i < numFine; ++i, ++iFine){
+			const int v = fineVrts[iFine];
+			coarseOut.vrtWeight[c] += g.vrtWeight[v];
+			for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+				const int cNbr = mapOut[g.adj[e]];
+				if(cNbr == c)
+					continue;
+				if(marker[cNbr] >= start)
+					coarseOut.edgeWeight[marker[cNbr]] += g.edgeWeight[e];
+				else{
+					marker[cNbr] = (int)coarseOut.adj.size();
+					coarseOut.adj.push_back(cNbr);
+					coarseOut.edgeWeight.push_back(g.edgeWeight[e]);
+				}
+			}
+		}
+		coarseOut.adjStart.push_back((int)coarseOut.adj.size());
+	}
+}
+
+void MultilevelGraphPartitioner::
+initial_bisection(std::vector<int>& sideOut, const WeightedGraph& g,
+				  const number* target, const number* maxWeight)
+{
+	const int n = g.num_vertices();
+	const int numTrials = max(1, min(m_numInitialTrials, n));
+
+	number bestImbalance = 0, bestCut = 0;
+	vector<int> trial;
+	vector<number> gain(n);
+
+	for(int t = 0; t < numTrials; ++t){
+	//	grow side 0 from a seed vertex. The vertex whose move reduces the
+	//	cut the most is added next.
+		trial.assign(n, 1);
+		for(int v = 0; v < n; ++v){
+			gain[v] = 0;
+			for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e)
+				gain[v] -= g.edgeWeight[e];
+		}
+
+		GainQueue queue;
+		int nextUnassigned = 0;
+		int next = (int)(((long)t * n) / numTrials);
+		number partWeight[2] = {0, g.total_weight()};
+
+		while(partWeight[0] < target[0]){
+			if(next == -1){
+				while(!queue.empty()){
+					const int v = queue.top().second;
+					const number gv = queue.top().first;
+					queue.pop();
+					if((trial[v] == 1) && (gv == gain[v])){
+						next = v;
+						break;
+					}
+				}
+			}
+			if(next == -1){
+			//	the grown region is not connected to further vertices
+				while((nextUnassigned < n) && (trial[nextUnassigned] == 0))
+					++nextUnassigned;
+				if(nextUnassigned == n)
+					break;
+				next = nextUnassigned;
+			}
+
+		//	stop if the additional vertex would overshoot the target more
+		//	than the current weight undershoots it.
+			const number w = g.vrtWeight[next];
+			if((partWeight[0] > 0)
+				&& (partWeight[0] + w - target[0] > target[0] - partWeight[0]))
+			{
+				break;
+			}
+
+			trial[next] = 0;
+			partWeight[0] += w;
+			partWeight[1] -= w;
+			for(int e = g.adjStart[next]; e < g.adjStart[next+1]; ++e){
+				const int nbr = g.adj[e];
+				if(trial[nbr] == 1){
+					gain[nbr] += 2. * g.edgeWeight[e];
+					queue.push(make_pair(gain[nbr], nbr));
+				}
+			}
+			next = -1;
+		}
+
+		refine(trial, g, maxWeight);
+
+		number pw[2] = {0, 0};
+		for(int v = 0; v < n; ++v)
+			pw[trial[v]] += g.vrtWeight[v];
+		const number imbalance = BisectionImbalance(pw, maxWeight);
+		const number cut = GraphEdgeCut(g, trial);
+		if((t == 0) || (imbalance < bestImbalance)
+			|| ((imbalance == bestImbalance) && (cut < bestCut)))
+		{
+			bestImbalance = imbalance;
+			bestCut = cut;
+			sideOut = trial;
+		}
+	}
+}
+
+void MultilevelGraphPartitioner::
+refine(std::vector<int>& side, const WeightedGraph& g, const number* maxWeight)
+{
+	const int n = g.num_vertices();
+	if(n < 2)
+		return;
+
+	const int maxMovesWithoutImprovement = 50 + n / 50;
+	vector<number> gain(n);
+	vector<char> locked(n);
+	vector<int> moves;
+
+	for(int pass = 0; pass < m_numRefPasses; ++pass){
+	//	gain: reduction of the cut if a vertex is moved to the other side
+		number partWeight[2] = {0, 0};
+		number cut = 0;
+		GainQueue queue[2];
+		for(int v = 0; v < n; ++v){
+			partWeight[side[v]] += g.vrtWeight[v];
+			number ext = 0, in = 0;
+			for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+				if(side[g.adj[e]] == side[v])
+					in += g.edgeWeight[e];
+				else
+					ext += g.edgeWeight[e];
+			}
+			gain[v] = ext - in;
+			cut += ext;
+			if(ext > 0)
+				queue[side[v]].push(make_pair(gain[v], v));
+		}
+		cut *= 0.5;
+
+		locked.assign(n, 0);
+		moves.clear();
+
+		number curCut = cut;
+		number bestCut = cut;
+		number bestImbalance = BisectionImbalance(partWeight, maxWeight);
+		size_t bestNumMoves = 0;
+		int numMovesWithoutImprovement = 0;
+
+		while(true){
+		//	remove outdated entries
+			for(int s = 0; s < 2; ++s){
+				while(!queue[s].empty()){
+					const int v = queue[s].top().second;
+					if(locked[v] || (side[v] != s) || (queue[s].top().first != gain[v]))
+						queue[s].pop();
+					else
+						break;
+				}
+			}
+
+		//	vertices are moved away from an overweighted side. Otherwise the
+		//	move with the highest gain which keeps the balance is performed.
+			int from = -1;
+			const bool over0 = partWeight[0] > maxWeight[0];
+			const bool over1 = partWeight[1] > maxWeight[1];
+			if(over0 != over1){
+				from = over0 ? 0 : 1;
+				if(queue[from].empty())
+					from = -1;
+			}
+			else{
+				for(int s = 0; s < 2; ++s){
+					if(queue[s].empty())
+						continue;
+					const int v = queue[s].top().second;
+					if(partWeight[1-s] + g.vrtWeight[v] > maxWeight[1-s])
+						continue;
+					if((from == -1) || (gain[v] > queue[from].top().first))
+						from = s;
+				}
+			}
+
+			if(from == -1)
+				break;
+
+			const int v = queue[from].top().second;
+			const int to = 1 - from;
+			queue[from].pop();
+
+			curCut -= gain[v];
+			partWeight[from] -= g.vrtWeight[v];
+			partWeight[to] += g.vrtWeight[v];
+			side[v] = to;
+			locked[v] = 1;
+			moves.push_back(v);
+
+			for(int e = g.adjStart[v]; e < g.adjStart[v+1]; ++e){
+				const int nbr = g.adj[e];
+				if(locked[nbr])
+					continue;
+				if(side[nbr] == to)
+					gain[nbr] -= 2. * g.edgeWeight[e];
+				else
+					gain[nbr] += 2. * g.edgeWeight[e];
+				queue[side[nbr]].push(make_pair(gain[nbr], nbr));
+			}
+
+			const number imbalance = BisectionImbalance(partWeight, maxWeight);
+			if((imbalance < bestImbalance)
+				|| ((imbalance == bestImbalance) && (curCut < bestCut)))
+			{
+				bestImbalance = imbalance;
+				bestCut = curCut;
+				bestNumMoves = moves.size();
+				numMovesWithoutImprovement = 0;
+			}
+			else if(++numMovesWithoutImprovement > maxMovesWithoutImprovement)
+				break;
+		}
+
+	//	undo all moves after the best state
+		for(size_t i = moves.size(); i > bestNumMoves; --i)
+			side[moves[i-1]] = 1 - side[moves[i-1]];
+
+		if(bestNumMoves == 0)
+			break;
+	}
+}
+
+}//	end of namespace
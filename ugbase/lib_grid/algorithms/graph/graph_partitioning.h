@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__LIB_GRID__GRAPH_PARTITIONING__
+#define __H__LIB_GRID__GRAPH_PARTITIONING__
+
+#include <vector>
+#include "common/types.h"
+
+namespace ug
+{
+
+///	A weighted, undirected graph in compressed-row format
+/**	The neighbors of vertex i are stored in adj[adjStart[i]] to (but not
+ * including) adj[adjStart[i+1]]. edgeWeight holds the weight of each entry
+ * in adj. Each edge has to be stored for both of its vertices.
+ * Vertex weights should be positive.*/
+struct WeightedGraph
+{
+	std::vector<int>	adjStart;
+	std::vector<int>	adj;
+	std::vector<number>	vrtWeight;
+	std::vector<number>	edgeWeight;
+
+	int num_vertices() const	{return (int)vrtWeight.size();}
+	number total_weight() const;
+};
+
+///	returns the summed weight of all edges whose vertices are in different parts
+number GraphEdgeCut(const WeightedGraph& g, const std::vector<int>& part);
+
+
+///	Serial multilevel partitioner for weighted graphs
+/**	The graph is partitioned by recursive bisection. Each bisection is
+ * computed by a multilevel scheme:
+ *	- the graph is coarsened by heavy-edge matching, until it contains
+ *	  only a few vertices or coarsening stagnates,
+ *	- the coarsest graph is bisected by greedy graph growing (starting from
+ *	  several seeds, the best result is kept),
+ *	- the bisection is projected back to the finer graphs and improved on
+ *	  each level by Fiduccia-Mattheyses refinement.
+ *
+ * Parts are balanced with respect to the vertex weights, while the weight
+ * of cut edges is minimized. The results are deterministic.
+ */
+class MultilevelGraphPartitioner
+{
+	public:
+		MultilevelGraphPartitioner();
+
+	///	tolerated relative imbalance of the parts. 0.03 by default.
+		void set_imbalance_tolerance(number tol)	{m_tolerance = tol;}
+		number imbalance_tolerance() const			{return m_tolerance;}
+
+	///	coarsening stops once a graph has at most this number of vertices. 100 by default.
+		void set_coarsest_graph_size(int size)		{m_coarsestSize = size;}
+
+	///	maximal number of refinement passes per level. 8 by default.
+		void set_num_refinement_passes(int num)		{m_numRefPasses = num;}
+
+	///	number of seeds used for the initial bisection. 4 by default.
+		void set_num_initial_trials(int num)		{m_numInitialTrials = num;}
+
+	///	partitions the graph into numParts parts
+	/**	partOut[i] contains the part (0, ..., numParts-1) of vertex i.
+	 * \returns the edge cut of the resulting partition.*/
+		number partition(std::vector<int>& partOut, const WeightedGraph& g,
+						 int numParts);
+
+	private:
+		void partition_recursive(std::vector<int>& partOut, const WeightedGraph& g,
+								 const std::vector<int>& vrtIds, int numParts,
+								 int firstPart);
+
+	///	bisects g such that side 0 receives the fraction 'ratio' of the total weight
+		void bisect(std::vector<int>& sideOut, const WeightedGraph& g, number ratio);
+
+	///	heavy-edge matching. mapOut[i] is the coarse vertex of vertex i.
+		void coarsen(WeightedGraph& coarseOut, std::vector<int>& mapOut,
+					 const WeightedGraph& g, number maxVrtWeight);
+
+		void initial_bisection(std::vector<int>& sideOut, const WeightedGraph& g,
+							   const number* target, const number* maxWeight);
+
+	///	Fiduccia-Mattheyses refinement of a bisection
+		void refine(std::vector<int>& side, const WeightedGraph& g,
+					const number* maxWeight);
+
+		number	m_tolerance;
+		number	m_bisectionTolerance;
+		int		m_coarsestSize;
+		int		m_numRefPasses;
+		int		m_numInitialTrials;
+};
+
+}//	end of namespace
+
+#endif
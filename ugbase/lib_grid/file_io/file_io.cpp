@@ -53,6 +53,7 @@
 #include "file_io_dump.h"
 #include "file_io_ncdf.h"
 #include "file_io_ugx.h"
+#include "file_io_ugb.h"
 #include "file_io_msh.h"
 #include "file_io_stl.h"
 #include "file_io_tikz.h"
@@ -175,6 +176,22 @@ static bool LoadGrid3d(Grid& grid, ISubsetHandler* psh,
 	return LoadGrid3d_IMPL(grid, psh, filename, aPos);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///	returns the process which loads the grid from the given file
+/**	If the file is a ugb file with one partition per process, all processes
+ * load their own partition.*/
+static int LoadingProcess(const char* filename, int procId)
+{
+	#ifdef UG_PARALLEL
+		if((procId != -1) && (ToLower(GetFilenameExtension(string(filename))) == "ugb")){
+			string tfile = FindFileInStandardPaths(filename);
+			if(!tfile.empty() && UGBPartitionsMatchProcesses(tfile.c_str()))
+				return -1;
+		}
+	#endif
+	return procId;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///	This method calls specific load routines or delegates loading to LoadGrid3d
 template <class TAPos>
@@ -185,6 +202,7 @@ static bool LoadGrid(Grid& grid, ISubsetHandler* psh,
 //	For convenience, we support multiple different standard paths, from which
 //	grids may be loaded. We thus first check, where the specified file is
 //	located and load it from that location afterwards.
+	procId = LoadingProcess(filename, procId);
 	bool loadingGrid = true;
 	#ifdef UG_PARALLEL
 		if((procId != -1) && (pcl::ProcRank() != procId))
@@ -208,6 +226,15 @@ static bool LoadGrid(Grid& grid, ISubsetHandler* psh,
 					retVal = LoadGridFromUGX(grid, shTmp, tfile.c_str(), aPos);
 				}
 			}
+			else if(tfile.find(".ugb") != string::npos){
+				if(psh)
+					retVal = LoadGridFromUGB(grid, *psh, tfile.c_str(), aPos);
+				else{
+				//	we have to create a temporary subset handler
+					SubsetHandler shTmp(grid);
+					retVal = LoadGridFromUGB(grid, shTmp, tfile.c_str(), aPos);
+				}
+			}
 			else if(tfile.find(".vtu") != string::npos){
 				if(psh)
 					retVal = LoadGridFromVTU(grid, *psh, tfile.c_str(), aPos);
@@ -250,6 +277,7 @@ static bool LoadGrid(Grid& grid, SPProjectionHandler* ph, size_t& num_ph, ISubse
 //	For convenience, we support multiple different standard paths, from which
 //	grids may be loaded. We thus first check, where the specified file is
 //	located and load it from that location afterwards.
+	procId = LoadingProcess(filename, procId);
 	bool loadingGrid = true;
 	#ifdef UG_PARALLEL
 		if((procId != -1) && (pcl::ProcRank() != procId))
@@ -274,6 +302,15 @@ static bool LoadGrid(Grid& grid, SPProjectionHandler* ph, size_t& num_ph, ISubse
 					retVal = LoadGridFromUGX(grid, *ph, num_ph, shTmp, additionalSHNames, ash, tfile.c_str(), aPos);
 				}
 			}
+			else if(tfile.find(".ugb") != string::npos){
+				if(psh)
+					retVal = LoadGridFromUGB(grid, *ph, num_ph, *psh, tfile.c_str(), aPos);
+				else{
+				//	we have to create a temporary subset handler
+					SubsetHandler shTmp(grid);
+					retVal = LoadGridFromUGB(grid, *ph, num_ph, shTmp, tfile.c_str(), aPos);
+				}
+			}
 
 			else if(tfile.find(".vtu") != string::npos){
 				if(psh)
@@ -42,6 +42,13 @@ namespace ug
 {
 
 class ProjectionHandler;
+class BinaryBuffer;
+
+///	writes the projectors of the given projection handler to a binary buffer
+void SerializeProjectionHandler(BinaryBuffer& out, ProjectionHandler& ph);
+
+///	reads projectors written by SerializeProjectionHandler into the given projection handler
+void DeserializeProjectionHandler(BinaryBuffer& in, ProjectionHandler& ph);
 
 /**
  * Saves a grid to LibGridBinary-format.
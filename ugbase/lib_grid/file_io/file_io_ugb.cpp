@@ -0,0 +1,1010 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <vector>
+
+#ifdef UG_POSIX
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "file_io_ugb.h"
+#include "file_io_lgb.h"
+#include "file_io_ugx.h"
+#include "common/serialization.h"
+#include "common/util/binary_buffer.h"
+#include "lib_grid/algorithms/attachment_util.h"
+#include "lib_grid/algorithms/geom_obj_util/misc_util.h"
+#include "lib_grid/grid/geometry.h"
+#include "lib_grid/grid_objects/grid_objects.h"
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
+#include "lib_grid/tools/subset_handler_grid.h"
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "lib_grid/parallelization/distributed_grid.h"
+#endif
+
+using namespace std;
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+//	file layout
+static const char UGB_MAGIC[8] = {'U', 'G', '4', 'G', 'R', 'I', 'D', 'B'};
+static const uint32 UGB_VERSION = 1;
+
+///	number of corners of the grid objects, in the order of ReferenceObjectID
+static const size_t UGB_NUM_CORNERS[NUM_REFERENCE_OBJECTS] = {1, 2, 3, 4, 4, 8, 6, 5, 6};
+
+///	interfaces are stored for vertices, edges and faces
+static const int UGB_NUM_INTERFACE_TYPES = 3;
+
+struct UGBFileHeader
+{
+	char	magic[8];
+	uint32	version;
+	uint32	endianess;
+	uint32	dim;
+	uint32	numPartitions;
+	uint64	numGlobal[4];
+	uint64	metaOffset;
+	uint64	metaSize;
+	uint64	tableOffset;
+};
+
+struct UGBPartitionEntry
+{
+	uint64	offset;
+	uint64	size;
+};
+
+struct UGBPartitionHeader
+{
+	uint64	num[NUM_REFERENCE_OBJECTS];
+	uint64	numNeighbors;
+};
+
+struct UGBNeighborHeader
+{
+	int32	partition;
+	uint32	unused;
+	uint64	numMaster[UGB_NUM_INTERFACE_TYPES];
+	uint64	numSlave[UGB_NUM_INTERFACE_TYPES];
+};
+
+///	all arrays in a ugb file start at 8-byte boundaries
+static inline uint64 UGBPadded(uint64 size)
+{
+	return (size + 7) & ~((uint64)7);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	Provides read access to a range of a ugb file
+/**	The range is mapped into memory if possible. Otherwise (or if mapping
+ * fails) it is read into an internal buffer.*/
+class UGBFileRange
+{
+	public:
+		UGBFileRange() : m_pMap(NULL), m_mapSize(0), m_pData(NULL)	{}
+		~UGBFileRange()	{release();}
+
+		void map(const char* filename, uint64 offset, uint64 size)
+		{
+			release();
+			if(size == 0)
+				return;
+
+		#ifdef UG_POSIX
+			int fd = open(filename, O_RDONLY);
+			UG_COND_THROW(fd < 0, "UGB: Couldn't open file " << filename);
+
+			struct stat st;
+			if(fstat(fd, &st) != 0 || (uint64)st.st_size < offset + size){
+				close(fd);
+				UG_THROW("UGB: File " << filename << " is truncated.");
+			}
+
+			const uint64 pageSize = (uint64)sysconf(_SC_PAGESIZE);
+			const uint64 start = offset - offset % pageSize;
+			m_mapSize = (size_t)(offset - start + size);
+			m_pMap = mmap(NULL, m_mapSize, PROT_READ, MAP_PRIVATE, fd, (off_t)start);
+			close(fd);
+
+			if(m_pMap != MAP_FAILED){
+				m_pData = static_cast<const char*>(m_pMap) + (offset - start);
+				return;
+			}
+			m_pMap = NULL;
+			m_mapSize = 0;
+		#endif
+
+		//	fallback: read the range into the buffer
+			ifstream in(filename, ios::binary);
+			UG_COND_THROW(!in, "UGB: Couldn't open file " << filename);
+			m_buf.resize((size_t)size);
+			in.seekg((streamoff)offset);
+			in.read(&m_buf.front(), (streamsize)size);
+			UG_COND_THROW(!in, "UGB: Couldn't read " << size << " bytes at offset "
+						  << offset << " from file " << filename);
+			m_pData = &m_buf.front();
+		}
+
+		void release()
+		{
+		#ifdef UG_POSIX
+			if(m_pMap)
+				munmap(m_pMap, m_mapSize);
+		#endif
+			m_pMap = NULL;
+			m_mapSize = 0;
+			m_pData = NULL;
+			m_buf.clear();
+		}
+
+		const char* data() const	{return m_pData;}
+
+	private:
+		UGBFileRange(const UGBFileRange&);
+		UGBFileRange& operator=(const UGBFileRange&);
+
+		void*			m_pMap;
+		size_t			m_mapSize;
+		const char*		m_pData;
+		vector<char>	m_buf;
+};
+
+///	sequentially hands out the arrays of a partition block
+class UGBBlockReader
+{
+	public:
+		UGBBlockReader(const char* data, uint64 size) :
+			m_pCur(data), m_pEnd(data + size)	{}
+
+		template <class T>
+		const T* take(uint64 num)
+		{
+			const uint64 size = UGBPadded(num * sizeof(T));
+			UG_COND_THROW(size > (uint64)(m_pEnd - m_pCur),
+						  "UGB: Unexpected end of partition block.");
+			const T* p = reinterpret_cast<const T*>(m_pCur);
+			m_pCur += size;
+			return p;
+		}
+
+	private:
+		const char*	m_pCur;
+		const char*	m_pEnd;
+};
+
+///	appends arrays to a partition block
+class UGBBlockWriter
+{
+	public:
+		template <class T>
+		void append(const T* p, uint64 num)
+		{
+			const size_t size = num * sizeof(T);
+			const size_t pos = m_data.size();
+			m_data.resize(pos + UGBPadded(size), 0);
+			if(size > 0)
+				memcpy(&m_data[pos], p, size);
+		}
+
+		template <class T>
+		void append(const vector<T>& v)
+		{
+			append(v.empty() ? NULL : &v.front(), v.size());
+		}
+
+		const vector<char>& data() const	{return m_data;}
+
+	private:
+		vector<char>	m_data;
+};
+
+static bool ReadUGBHeader(const char* filename, UGBFileHeader& header)
+{
+	ifstream in(filename, ios::binary);
+	if(!in){
+		UG_LOG("ERROR in LoadGridFromUGB: couldn't open file: " << filename << endl);
+		return false;
+	}
+
+	in.read((char*)&header, sizeof(UGBFileHeader));
+	if(!in || memcmp(header.magic, UGB_MAGIC, sizeof(UGB_MAGIC)) != 0){
+		UG_LOG("ERROR in LoadGridFromUGB: " << filename << " is not a ugb file.\n");
+		return false;
+	}
+	if(header.endianess != 1){
+		UG_LOG("ERROR in LoadGridFromUGB: wrong endianess.\n");
+		return false;
+	}
+	if(header.version != UGB_VERSION){
+		UG_LOG("ERROR in LoadGridFromUGB: bad file-version: " << header.version
+			   << ". Expected " << UGB_VERSION << ".\n");
+		return false;
+	}
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	writing
+typedef Attachment<vector<int> >	AUGBPartitions;
+
+static inline void AddUGBPartition(vector<int>& parts, int p)
+{
+	vector<int>::iterator iter = lower_bound(parts.begin(), parts.end(), p);
+	if(iter == parts.end() || *iter != p)
+		parts.insert(iter, p);
+}
+
+template <class TElem>
+static void CollectUGBObjects(Grid& grid, vector<TElem*>& vObj,
+							  MultiElementAttachmentAccessor<AInt>& aaGID)
+{
+	vObj.clear();
+	for(typename geometry_traits<TElem>::iterator iter = grid.begin<TElem>();
+		iter != grid.end<TElem>(); ++iter)
+	{
+		TElem* o = *iter;
+		UG_COND_THROW(o->is_constrained() || o->is_constraining(),
+					  "SaveGridToUGB: Constrained objects are not supported.");
+		aaGID[o] = (int)vObj.size();
+		vObj.push_back(o);
+	}
+}
+
+template <class TSide, class TElem>
+static void AddUGBPartitionsToSides(Grid& grid, TElem* e,
+								MultiElementAttachmentAccessor<AUGBPartitions>& aaParts)
+{
+	typename Grid::traits<TSide>::secure_container sides;
+	grid.associated_elements(sides, e);
+	const vector<int>& parts = aaParts[e];
+	for(size_t i = 0; i < sides.size(); ++i)
+		for(size_t j = 0; j < parts.size(); ++j)
+			AddUGBPartition(aaParts[sides[i]], parts[j]);
+}
+
+///	objects without partition are put to partition 0, sides inherit the partitions of their elements
+template <class TElem>
+static void PropagateUGBPartitions(Grid& grid, vector<TElem*>& vElem,
+								MultiElementAttachmentAccessor<AUGBPartitions>& aaParts)
+{
+	for(size_t i = 0; i < vElem.size(); ++i){
+		TElem* e = vElem[i];
+		if(aaParts[e].empty())
+			aaParts[e].push_back(0);
+		if(TElem::dim > 2)
+			AddUGBPartitionsToSides<Face>(grid, e, aaParts);
+		if(TElem::dim > 1)
+			AddUGBPartitionsToSides<Edge>(grid, e, aaParts);
+		if(TElem::dim > 0)
+			AddUGBPartitionsToSides<Vertex>(grid, e, aaParts);
+	}
+}
+
+///	recursive coordinate bisection of the given centers
+template <class vector_t>
+struct UGBCenterCompare
+{
+	UGBCenterCompare(const vector<vector_t>& centers, int axis) :
+		m_centers(centers), m_axis(axis)	{}
+	bool operator()(size_t i, size_t j) const
+	{
+		return m_centers[i][m_axis] < m_centers[j][m_axis];
+	}
+	const vector<vector_t>&	m_centers;
+	int						m_axis;
+};
+
+template <class vector_t>
+static void PartitionUGBCenters(const vector<vector_t>& centers,
+								vector<size_t>::iterator first,
+								vector<size_t>::iterator last,
+								int firstPart, int numParts,
+								vector<int>& partsOut)
+{
+	if(first == last)
+		return;
+
+	if(numParts == 1){
+		for(; first != last; ++first)
+			partsOut[*first] = firstPart;
+		return;
+	}
+
+//	split along the axis with the largest extension
+	vector_t vMin = centers[*first], vMax = centers[*first];
+	for(vector<size_t>::iterator iter = first; iter != last; ++iter){
+		for(size_t d = 0; d < vector_t::Size; ++d){
+			vMin[d] = min(vMin[d], centers[*iter][d]);
+			vMax[d] = max(vMax[d], centers[*iter][d]);
+		}
+	}
+	int axis = 0;
+	for(size_t d = 1; d < vector_t::Size; ++d)
+		if(vMax[d] - vMin[d] > vMax[axis] - vMin[axis])
+			axis = (int)d;
+
+	const int numLeft = numParts / 2;
+	vector<size_t>::iterator mid = first + ((last - first) * numLeft) / numParts;
+	nth_element(first, mid, last, UGBCenterCompare<vector_t>(centers, axis));
+
+	PartitionUGBCenters(centers, first, mid, firstPart, numLeft, partsOut);
+	PartitionUGBCenters(centers, mid, last, firstPart + numLeft,
+						numParts - numLeft, partsOut);
+}
+
+template <class TElem, class TAAPos>
+static void PartitionUGBElements(vector<TElem*>& vElem, TAAPos& aaPos,
+								 int numPartitions,
+								 MultiElementAttachmentAccessor<AUGBPartitions>& aaParts)
+{
+	typedef typename TAAPos::ValueType vector_t;
+	vector<vector_t> centers(vElem.size());
+	vector<size_t> order(vElem.size());
+	for(size_t i = 0; i < vElem.size(); ++i){
+		centers[i] = CalculateGridObjectCenter(vElem[i], aaPos);
+		order[i] = i;
+	}
+
+	vector<int> parts(vElem.size(), 0);
+	PartitionUGBCenters(centers, order.begin(), order.end(), 0, numPartitions, parts);
+
+	for(size_t i = 0; i < vElem.size(); ++i)
+		AddUGBPartition(aaParts[vElem[i]], parts[i]);
+}
+
+///	interface entries of one partition with one neighbor partition
+struct UGBNeighborEntries
+{
+	vector<uint32>	master[UGB_NUM_INTERFACE_TYPES];
+	vector<uint32>	slave[UGB_NUM_INTERFACE_TYPES];
+};
+
+///	collects the objects of the given partition, ordered by reference object id and global id
+template <class TElem>
+static void CollectUGBPartitionObjects(vector<TElem*>& vObj, int p,
+						MultiElementAttachmentAccessor<AUGBPartitions>& aaParts,
+						MultiElementAttachmentAccessor<AInt>& aaLocal,
+						vector<vector<GridObject*> >& vByROID)
+{
+	for(size_t i = 0; i < vObj.size(); ++i){
+		const vector<int>& parts = aaParts[vObj[i]];
+		if(binary_search(parts.begin(), parts.end(), p))
+			vByROID[vObj[i]->reference_object_id()].push_back(vObj[i]);
+	}
+
+//	local indices are given by the order of reference objects ids
+	int localInd = 0;
+	for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid){
+		if(vByROID[roid].empty() || vByROID[roid][0]->base_object_id() != TElem::BASE_OBJECT_ID)
+			continue;
+		for(size_t i = 0; i < vByROID[roid].size(); ++i)
+			aaLocal[vByROID[roid][i]] = localInd++;
+	}
+}
+
+///	adds the interface entries of p for the given objects (which are sorted by global id)
+template <class TElem>
+static void AddUGBInterfaceEntries(vector<TElem*>& vObj, int p,
+						MultiElementAttachmentAccessor<AUGBPartitions>& aaParts,
+						MultiElementAttachmentAccessor<AInt>& aaLocal,
+						map<int, UGBNeighborEntries>& neighbors)
+{
+	const int type = TElem::BASE_OBJECT_ID;
+	for(size_t i = 0; i < vObj.size(); ++i){
+		const vector<int>& parts = aaParts[vObj[i]];
+		if(parts.size() < 2 || !binary_search(parts.begin(), parts.end(), p))
+			continue;
+
+		const uint32 localInd = (uint32)aaLocal[vObj[i]];
+		if(parts[0] == p){
+			for(size_t j = 1; j < parts.size(); ++j)
+				neighbors[parts[j]].master[type].push_back(localInd);
+		}
+		else
+			neighbors[parts[0]].slave[type].push_back(localInd);
+	}
+}
+
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+				   int numPartitions, TAPosition& aPos, ProjectionHandler* pPH)
+{
+	typedef typename TAPosition::ValueType vector_t;
+	const int dim = vector_t::Size;
+
+	UG_COND_THROW(numPartitions < 1, "SaveGridToUGB: At least one partition is required.");
+	if(!grid.has_vertex_attachment(aPos)){
+		UG_LOG("ERROR in SaveGridToUGB: position attachment missing.\n");
+		return false;
+	}
+
+	MultiGrid* pmg = dynamic_cast<MultiGrid*>(&grid);
+	UG_COND_THROW(pmg && pmg->num_levels() > 1,
+				  "SaveGridToUGB: Only grids with a single level are supported.");
+
+	Grid::VertexAttachmentAccessor<TAPosition> aaPos(grid, aPos);
+
+//	global ids are given by the order of the objects in the grid
+	AInt aGID;
+	grid.attach_to_all(aGID);
+	MultiElementAttachmentAccessor<AInt> aaGID(grid, aGID);
+
+	vector<Vertex*> vrts;
+	vector<Edge*> edges;
+	vector<Face*> faces;
+	vector<Volume*> vols;
+	CollectUGBObjects(grid, vrts, aaGID);
+	CollectUGBObjects(grid, edges, aaGID);
+	CollectUGBObjects(grid, faces, aaGID);
+	CollectUGBObjects(grid, vols, aaGID);
+
+//	partition the elements of highest dimension and pass the partitions to their sides
+	AUGBPartitions aParts;
+	grid.attach_to_all(aParts);
+	MultiElementAttachmentAccessor<AUGBPartitions> aaParts(grid, aParts);
+
+	if(!vols.empty())
+		PartitionUGBElements(vols, aaPos, numPartitions, aaParts);
+	else if(!faces.empty())
+		PartitionUGBElements(faces, aaPos, numPartitions, aaParts);
+	else if(!edges.empty())
+		PartitionUGBElements(edges, aaPos, numPartitions, aaParts);
+	else
+		PartitionUGBElements(vrts, aaPos, numPartitions, aaParts);
+
+	PropagateUGBPartitions(grid, vols, aaParts);
+	PropagateUGBPartitions(grid, faces, aaParts);
+	PropagateUGBPartitions(grid, edges, aaParts);
+	PropagateUGBPartitions(grid, vrts, aaParts);
+
+//	meta data: subset infos and projection handler
+	BinaryBuffer meta;
+	int numSubsets = sh.num_subsets();
+	Serialize(meta, numSubsets);
+	for(int i = 0; i < numSubsets; ++i){
+		const SubsetInfo& si = sh.subset_info(i);
+		Serialize(meta, si.name);
+		Serialize(meta, si.materialIndex);
+		Serialize(meta, si.color);
+		Serialize(meta, si.subsetState);
+		Serialize(meta, si.m_propertyMap);
+	}
+	byte hasPH = pPH ? 1 : 0;
+	Serialize(meta, hasPH);
+	if(pPH)
+		SerializeProjectionHandler(meta, *pPH);
+
+	UGBFileHeader header;
+	memset(&header, 0, sizeof(UGBFileHeader));
+	memcpy(header.magic, UGB_MAGIC, sizeof(UGB_MAGIC));
+	header.version = UGB_VERSION;
+	header.endianess = 1;
+	header.dim = dim;
+	header.numPartitions = numPartitions;
+	header.numGlobal[VERTEX] = vrts.size();
+	header.numGlobal[EDGE] = edges.size();
+	header.numGlobal[FACE] = faces.size();
+	header.numGlobal[VOLUME] = vols.size();
+	header.metaOffset = UGBPadded(sizeof(UGBFileHeader));
+	header.metaSize = meta.write_pos();
+	header.tableOffset = UGBPadded(header.metaOffset + header.metaSize);
+
+	ofstream out(filename, ios::binary);
+	if(!out){
+		UG_LOG("ERROR in SaveGridToUGB: couldn't open file: " << filename << endl);
+		grid.detach_from_all(aParts);
+		grid.detach_from_all(aGID);
+		return false;
+	}
+
+	vector<UGBPartitionEntry> table(numPartitions);
+	const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	out.write((const char*)&header, sizeof(UGBFileHeader));
+	out.write(zeros, header.metaOffset - sizeof(UGBFileHeader));
+	if(header.metaSize > 0)
+		out.write(meta.buffer(), header.metaSize);
+	out.write(zeros, header.tableOffset - header.metaOffset - header.metaSize);
+	out.write((const char*)&table.front(), numPartitions * sizeof(UGBPartitionEntry));
+
+//	write the partition blocks
+	AInt aLocal;
+	grid.attach_to_all(aLocal);
+	MultiElementAttachmentAccessor<AInt> aaLocal(grid, aLocal);
+
+	uint64 offset = header.tableOffset + numPartitions * sizeof(UGBPartitionEntry);
+	for(int p = 0; p < numPartitions; ++p)
+	{
+		vector<vector<GridObject*> > vByROID(NUM_REFERENCE_OBJECTS);
+		CollectUGBPartitionObjects(vrts, p, aaParts, aaLocal, vByROID);
+		CollectUGBPartitionObjects(edges, p, aaParts, aaLocal, vByROID);
+		CollectUGBPartitionObjects(faces, p, aaParts, aaLocal, vByROID);
+		CollectUGBPartitionObjects(vols, p, aaParts, aaLocal, vByROID);
+
+		map<int, UGBNeighborEntries> neighbors;
+		AddUGBInterfaceEntries(vrts, p, aaParts, aaLocal, neighbors);
+		AddUGBInterfaceEntries(edges, p, aaParts, aaLocal, neighbors);
+		AddUGBInterfaceEntries(faces, p, aaParts, aaLocal, neighbors);
+
+		UGBPartitionHeader partHeader;
+		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+			partHeader.num[roid] = vByROID[roid].size();
+		partHeader.numNeighbors = neighbors.size();
+
+		UGBBlockWriter block;
+		block.append(&partHeader, 1);
+
+		const vector<GridObject*>& vPartVrts = vByROID[ROID_VERTEX];
+		vector<double> coords(vPartVrts.size() * dim);
+		for(size_t i = 0; i < vPartVrts.size(); ++i){
+			const vector_t& pos = aaPos[static_cast<Vertex*>(vPartVrts[i])];
+			for(int d = 0; d < dim; ++d)
+				coords[i * dim + d] = pos[d];
+		}
+		block.append(coords);
+
+		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid){
+			vector<uint64> gids(vByROID[roid].size());
+			for(size_t i = 0; i < gids.size(); ++i)
+				gids[i] = (uint64)aaGID[vByROID[roid][i]];
+			block.append(gids);
+		}
+
+		for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid){
+			vector<int32> subsets(vByROID[roid].size());
+			for(size_t i = 0; i < subsets.size(); ++i)
+				subsets[i] = (int32)sh.get_subset_index(vByROID[roid][i]);
+			block.append(subsets);
+		}
+
+		for(int roid = ROID_EDGE; roid < NUM_REFERENCE_OBJECTS; ++roid){
+			const size_t numCorners = UGB_NUM_CORNERS[roid];
+			vector<uint32> corners(vByROID[roid].size() * numCorners);
+			for(size_t i = 0; i < vByROID[roid].size(); ++i){
+				IVertexGroup* vg = dynamic_cast<IVertexGroup*>(vByROID[roid][i]);
+				for(size_t j = 0; j < numCorners; ++j)
+					corners[i * numCorners + j] = (uint32)aaLocal[vg->vertex(j)];
+			}
+			block.append(corners);
+		}
+
+		for(map<int, UGBNeighborEntries>::iterator iter = neighbors.begin();
+			iter != neighbors.end(); ++iter)
+		{
+			UGBNeighborHeader nbrHeader;
+			nbrHeader.partition = iter->first;
+			nbrHeader.unused = 0;
+			for(int t = 0; t < UGB_NUM_INTERFACE_TYPES; ++t){
+				nbrHeader.numMaster[t] = iter->second.master[t].size();
+				nbrHeader.numSlave[t] = iter->second.slave[t].size();
+			}
+			block.append(&nbrHeader, 1);
+		}
+
+		for(map<int, UGBNeighborEntries>::iterator iter = neighbors.begin();
+			iter != neighbors.end(); ++iter)
+		{
+			for(int t = 0; t < UGB_NUM_INTERFACE_TYPES; ++t){
+				block.append(iter->second.master[t]);
+				block.append(iter->second.slave[t]);
+			}
+		}
+
+		table[p].offset = offset;
+		table[p].size = block.data().size();
+		out.write(&block.data().front(), block.data().size());
+		offset += block.data().size();
+	}
+
+//	now that the blocks are written, the partition table is known
+	out.seekp((streamoff)header.tableOffset);
+	out.write((const char*)&table.front(), numPartitions * sizeof(UGBPartitionEntry));
+
+	grid.detach_from_all(aLocal);
+	grid.detach_from_all(aParts);
+	grid.detach_from_all(aGID);
+
+	if(!out){
+		UG_LOG("ERROR in SaveGridToUGB: couldn't write file: " << filename << endl);
+		return false;
+	}
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	reading
+static GridObject* CreateUGBObject(Grid& grid, int roid, Vertex** v)
+{
+	switch(roid){
+		case ROID_EDGE:
+			return *grid.create<RegularEdge>(EdgeDescriptor(v[0], v[1]));
+		case ROID_TRIANGLE:
+			return *grid.create<Triangle>(TriangleDescriptor(v[0], v[1], v[2]));
+		case ROID_QUADRILATERAL:
+			return *grid.create<Quadrilateral>(QuadrilateralDescriptor(v[0], v[1], v[2], v[3]));
+		case ROID_TETRAHEDRON:
+			return *grid.create<Tetrahedron>(TetrahedronDescriptor(v[0], v[1], v[2], v[3]));
+		case ROID_HEXAHEDRON:
+			return *grid.create<Hexahedron>(HexahedronDescriptor(v[0], v[1], v[2], v[3],
+																 v[4], v[5], v[6], v[7]));
+		case ROID_PRISM:
+			return *grid.create<Prism>(PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]));
+		case ROID_PYRAMID:
+			return *grid.create<Pyramid>(PyramidDescriptor(v[0], v[1], v[2], v[3], v[4]));
+		case ROID_OCTAHEDRON:
+			return *grid.create<Octahedron>(OctahedronDescriptor(v[0], v[1], v[2],
+																 v[3], v[4], v[5]));
+		default:
+			UG_THROW("UGB: Unsupported reference object id: " << roid);
+	}
+}
+
+static int UGBBaseObjectID(int roid)
+{
+	if(roid == ROID_VERTEX) return VERTEX;
+	if(roid == ROID_EDGE) return EDGE;
+	if(roid <= ROID_QUADRILATERAL) return FACE;
+	return VOLUME;
+}
+
+#ifdef UG_PARALLEL
+template <class TElem>
+static void AddUGBInterfaceEntries(GridLayoutMap& glm, int interfaceType, int proc,
+								   const uint32* entries, uint64 num,
+								   const vector<GridObject*>& vLocal)
+{
+	if(num == 0)
+		return;
+	typename GridLayoutMap::Types<TElem>::Interface& itfc =
+		glm.get_layout<TElem>(interfaceType).interface(proc, 0);
+	for(uint64 i = 0; i < num; ++i){
+		UG_COND_THROW(entries[i] >= vLocal.size(), "UGB: Invalid interface entry.");
+		itfc.push_back(static_cast<TElem*>(vLocal[entries[i]]));
+	}
+}
+#endif
+
+///	creates the objects of one partition block
+/**	If vGlobal is specified, objects that have already been created by other
+ * blocks are reused (identified by their global ids).
+ * If bCreateInterfaces is set, the interfaces to the other partitions are
+ * added to the layouts of the DistributedGridManager of the grid.*/
+template <class TAPosition>
+static void ReadUGBPartition(Grid& grid, ISubsetHandler& sh,
+							 Grid::VertexAttachmentAccessor<TAPosition>& aaPos,
+							 int dim, const char* data, uint64 size,
+							 vector<vector<GridObject*> >* vGlobal,
+							 bool bCreateInterfaces)
+{
+	typedef typename TAPosition::ValueType vector_t;
+
+	UGBBlockReader in(data, size);
+	const UGBPartitionHeader& header = *in.take<UGBPartitionHeader>(1);
+	const double* coords = in.take<double>(header.num[ROID_VERTEX] * dim);
+
+	const uint64* gids[NUM_REFERENCE_OBJECTS];
+	for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+		gids[roid] = in.take<uint64>(header.num[roid]);
+
+	const int32* subsets[NUM_REFERENCE_OBJECTS];
+	for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+		subsets[roid] = in.take<int32>(header.num[roid]);
+
+	const uint32* corners[NUM_REFERENCE_OBJECTS];
+	corners[ROID_VERTEX] = NULL;
+	for(int roid = ROID_EDGE; roid < NUM_REFERENCE_OBJECTS; ++roid)
+		corners[roid] = in.take<uint32>(header.num[roid] * UGB_NUM_CORNERS[roid]);
+
+//	objects of the block by base object id and local index
+	vector<GridObject*> vLocal[4];
+
+	Vertex* v[8];
+	for(int roid = 0; roid < NUM_REFERENCE_OBJECTS; ++roid)
+	{
+		const int baseType = UGBBaseObjectID(roid);
+		const size_t numCorners = UGB_NUM_CORNERS[roid];
+		vector<GridObject*>& local = vLocal[baseType];
+
+		for(uint64 i = 0; i < header.num[roid]; ++i)
+		{
+			const uint64 gid = gids[roid][i];
+			GridObject* o = NULL;
+			if(vGlobal){
+				UG_COND_THROW(gid >= (*vGlobal)[baseType].size(), "UGB: Invalid global id.");
+				o = (*vGlobal)[baseType][gid];
+			}
+
+			if(!o){
+				if(roid == ROID_VERTEX){
+					Vertex* vrt = *grid.create<RegularVertex>();
+					vector_t& pos = aaPos[vrt];
+					for(int d = 0; d < (int)vector_t::Size; ++d)
+						pos[d] = (d < dim) ? coords[i * dim + d] : 0;
+					o = vrt;
+				}
+				else{
+					for(size_t j = 0; j < numCorners; ++j){
+						const uint32 ind = corners[roid][i * numCorners + j];
+						UG_COND_THROW(ind >= vLocal[VERTEX].size(), "UGB: Invalid corner index.");
+						v[j] = static_cast<Vertex*>(vLocal[VERTEX][ind]);
+					}
+					o = CreateUGBObject(grid, roid, v);
+				}
+
+				if(subsets[roid][i] >= 0)
+					sh.assign_subset(o, subsets[roid][i]);
+
+				if(vGlobal)
+					(*vGlobal)[baseType][gid] = o;
+			}
+			local.push_back(o);
+		}
+	}
+
+	if(!bCreateInterfaces)
+		return;
+
+#ifdef UG_PARALLEL
+	GridLayoutMap& glm = grid.distributed_grid_manager()->grid_layout_map();
+	const UGBNeighborHeader* nbrHeaders = in.take<UGBNeighborHeader>(header.numNeighbors);
+	for(uint64 i = 0; i < header.numNeighbors; ++i)
+	{
+		const UGBNeighborHeader& nbr = nbrHeaders[i];
+		for(int t = 0; t < UGB_NUM_INTERFACE_TYPES; ++t)
+		{
+			const uint32* master = in.take<uint32>(nbr.numMaster[t]);
+			const uint32* slave = in.take<uint32>(nbr.numSlave[t]);
+			switch(t){
+				case VERTEX:
+					AddUGBInterfaceEntries<Vertex>(glm, INT_H_MASTER, nbr.partition, master, nbr.numMaster[t], vLocal[t]);
+					AddUGBInterfaceEntries<Vertex>(glm, INT_H_SLAVE, nbr.partition, slave, nbr.numSlave[t], vLocal[t]);
+					break;
+				case EDGE:
+					AddUGBInterfaceEntries<Edge>(glm, INT_H_MASTER, nbr.partition, master, nbr.numMaster[t], vLocal[t]);
+					AddUGBInterfaceEntries<Edge>(glm, INT_H_SLAVE, nbr.partition, slave, nbr.numSlave[t], vLocal[t]);
+					break;
+				case FACE:
+					AddUGBInterfaceEntries<Face>(glm, INT_H_MASTER, nbr.partition, master, nbr.numMaster[t], vLocal[t]);
+					AddUGBInterfaceEntries<Face>(glm, INT_H_SLAVE, nbr.partition, slave, nbr.numSlave[t], vLocal[t]);
+					break;
+			}
+		}
+	}
+#endif
+}
+
+template <class TAPosition>
+static bool LoadGridFromUGB_IMPL(Grid& grid, ISubsetHandler& sh, const char* filename,
+								 TAPosition& aPos, ProjectionHandler* pPH, size_t* pNumPH)
+{
+	UGBFileHeader header;
+	if(!ReadUGBHeader(filename, header))
+		return false;
+
+	grid.clear_geometry();
+
+	if(!grid.has_vertex_attachment(aPos))
+		grid.attach_to_vertices(aPos);
+	Grid::VertexAttachmentAccessor<TAPosition> aaPos(grid, aPos);
+
+//	subset infos and projection handler
+	UGBFileRange metaRange;
+	metaRange.map(filename, header.metaOffset, header.metaSize);
+	BinaryBuffer meta;
+	if(header.metaSize > 0)
+		meta.write(metaRange.data(), header.metaSize);
+	metaRange.release();
+
+	int numSubsets;
+	Deserialize(meta, numSubsets);
+	for(int i = 0; i < numSubsets; ++i){
+		SubsetInfo& si = sh.subset_info(i);
+		Deserialize(meta, si.name);
+		Deserialize(meta, si.materialIndex);
+		Deserialize(meta, si.color);
+		Deserialize(meta, si.subsetState);
+		Deserialize(meta, si.m_propertyMap);
+	}
+
+	byte hasPH;
+	Deserialize(meta, hasPH);
+	if(hasPH){
+		if(pPH){
+			DeserializeProjectionHandler(meta, *pPH);
+			if(pNumPH)
+				*pNumPH = 1;
+		}
+	}
+	else if(pPH)
+		pPH->clear();
+
+//	decide which partitions are read by this process
+	int firstPart = 0;
+	int numParts = (int)header.numPartitions;
+	bool bCreateInterfaces = false;
+
+#ifdef UG_PARALLEL
+	DistributedGridManager* pDGM = grid.distributed_grid_manager();
+	if(pDGM && UGBPartitionsMatchProcesses(filename)){
+		firstPart = pcl::ProcRank();
+		numParts = 1;
+		bCreateInterfaces = true;
+		pDGM->enable_interface_management(false);
+	}
+#endif
+
+	UGBFileRange tableRange;
+	tableRange.map(filename, header.tableOffset,
+				   header.numPartitions * sizeof(UGBPartitionEntry));
+	const UGBPartitionEntry* table =
+		reinterpret_cast<const UGBPartitionEntry*>(tableRange.data());
+
+//	to avoid problems with autogenerated elements we'll deactivate
+//	all options and reactivate them later on
+	uint gridOptions = grid.get_options();
+	grid.set_options(GRIDOPT_NONE);
+
+	vector<vector<GridObject*> > vGlobal;
+	if(numParts > 1){
+		vGlobal.resize(4);
+		for(int i = 0; i < 4; ++i)
+			vGlobal[i].resize(header.numGlobal[i], NULL);
+	}
+
+	for(int p = firstPart; p < firstPart + numParts; ++p){
+		UGBFileRange blockRange;
+		blockRange.map(filename, table[p].offset, table[p].size);
+		ReadUGBPartition(grid, sh, aaPos, (int)header.dim, blockRange.data(),
+						 table[p].size, numParts > 1 ? &vGlobal : NULL, bCreateInterfaces);
+	}
+
+	grid.set_options(gridOptions);
+
+#ifdef UG_PARALLEL
+	if(bCreateInterfaces){
+		pDGM->grid_layout_map().remove_empty_interfaces();
+		pDGM->enable_interface_management(true);
+		pDGM->grid_layouts_changed(false);
+	}
+#endif
+
+	return true;
+}
+
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+					 TAPosition& aPos, ProjectionHandler* pPH)
+{
+	return LoadGridFromUGB_IMPL(grid, sh, filename, aPos, pPH, NULL);
+}
+
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					 ISubsetHandler& sh, const char* filename, TAPosition& aPos)
+{
+	return LoadGridFromUGB_IMPL(grid, sh, filename, aPos, ph.get(), &num_ph);
+}
+
+int GetNumUGBPartitions(const char* filename)
+{
+	UGBFileHeader header;
+	if(!ReadUGBHeader(filename, header))
+		return -1;
+	return (int)header.numPartitions;
+}
+
+bool UGBPartitionsMatchProcesses(const char* filename)
+{
+#ifdef UG_PARALLEL
+	return (pcl::NumProcs() > 1) && (GetNumUGBPartitions(filename) == pcl::NumProcs());
+#else
+	return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////
+template <class TAPosition>
+static bool SaveConvertedUGB(Grid& grid, SubsetHandler& sh, const char* filename,
+							 int numPartitions, ProjectionHandler* pPH)
+{
+	TAPosition aPos;
+	grid.attach_to_vertices(aPos);
+	ConvertMathVectorAttachmentValues<Vertex>(grid, aPosition, aPos);
+	bool retVal = SaveGridToUGB(grid, sh, filename, numPartitions, aPos, pPH);
+	grid.detach_from_vertices(aPos);
+	return retVal;
+}
+
+bool ConvertUGXToUGB(const char* ugxFilename, const char* ugbFilename,
+					 int numPartitions)
+{
+	UGXFileInfo info;
+	if(!info.parse_file(ugxFilename) || info.num_grids() < 1){
+		UG_LOG("ERROR in ConvertUGXToUGB: couldn't read grid from " << ugxFilename << endl);
+		return false;
+	}
+	const size_t dim = info.grid_world_dimension(0);
+
+	Grid grid;
+	SubsetHandler sh(grid);
+	grid.attach_to_vertices(aPosition);
+	SPProjectionHandler ph = make_sp(new ProjectionHandler(MakeGeometry3d(grid, aPosition), &sh));
+	size_t num_ph = 0;
+
+	if(!LoadGridFromUGX(grid, ph, num_ph, sh, vector<string>(),
+						vector<SmartPtr<ISubsetHandler> >(), ugxFilename, aPosition))
+	{
+		UG_LOG("ERROR in ConvertUGXToUGB: couldn't load " << ugxFilename << endl);
+		return false;
+	}
+
+	ProjectionHandler* pPH = (ph->num_projectors() > 0) ? ph.get() : NULL;
+	switch(dim){
+		case 0:
+		case 1:	return SaveConvertedUGB<APosition1>(grid, sh, ugbFilename, numPartitions, pPH);
+		case 2:	return SaveConvertedUGB<APosition2>(grid, sh, ugbFilename, numPartitions, pPH);
+		default:return SaveGridToUGB(grid, sh, ugbFilename, numPartitions, aPosition, pPH);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	explicit instantiation
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, int, AVector1&, ProjectionHandler*);
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, int, AVector2&, ProjectionHandler*);
+template bool SaveGridToUGB(Grid&, ISubsetHandler&, const char*, int, AVector3&, ProjectionHandler*);
+
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, AVector1&, ProjectionHandler*);
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, AVector2&, ProjectionHandler*);
+template bool LoadGridFromUGB(Grid&, ISubsetHandler&, const char*, AVector3&, ProjectionHandler*);
+
+template bool LoadGridFromUGB(Grid&, SPProjectionHandler&, size_t&, ISubsetHandler&, const char*, AVector1&);
+template bool LoadGridFromUGB(Grid&, SPProjectionHandler&, size_t&, ISubsetHandler&, const char*, AVector2&);
+template bool LoadGridFromUGB(Grid&, SPProjectionHandler&, size_t&, ISubsetHandler&, const char*, AVector3&);
+
+}//	end of namespace
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2010-2015:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__LIB_GRID__FILE_IO_UGB__
+#define __H__LIB_GRID__FILE_IO_UGB__
+
+#include "lib_grid/grid/grid.h"
+#include "lib_grid/tools/subset_handler_interface.h"
+#include "lib_grid/common_attachments.h"
+#include "lib_grid/refinement/projectors/projection_handler.h"
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+/**	\page pageUGB UGB - binary partitioned grid format
+ *
+ * The ugb format is a binary, memory-mappable container for a base grid,
+ * which has been split into a fixed number of partitions. It stores
+ * - a file header with the world dimension, the number of partitions and
+ *   the global number of vertices, edges, faces and volumes,
+ * - a meta-data block containing the subset infos and an optional
+ *   ProjectionHandler,
+ * - a table with the offset and size of each partition block,
+ * - one block per partition. A block contains the coordinates of the
+ *   partition's vertices, the corners, subset indices and global ids of its
+ *   elements and the horizontal interfaces to neighboring partitions.
+ *
+ * All arrays of a block are stored in the native binary representation and
+ * are 8-byte aligned, so that a block can be used directly from a memory
+ * mapped file. A process thus only maps the header, the meta-data and its own
+ * partition block.
+ *
+ * Each object of the grid belongs to all partitions which contain an element
+ * that has the object as side. The partition with the lowest index holds the
+ * master copy, all others hold slave copies. Interface entries are sorted by
+ * global ids, so that the interfaces of two partitions match without
+ * communication.
+ *
+ * Only regular (i.e. non-constrained) objects on a single grid level are
+ * supported. Use ConvertUGXToUGB to create ugb files from ugx files.
+ */
+
+////////////////////////////////////////////////////////////////////////
+///	Writes the grid to a ugb file, split into the given number of partitions.
+/**	The elements of highest dimension are partitioned by recursive coordinate
+ * bisection of their centers.
+ *
+ * \param pPH	(optional) a projection handler associated with sh, which
+ *				is stored in the meta-data of the file.*/
+template <class TAPosition>
+bool SaveGridToUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+				   int numPartitions, TAPosition& aPos,
+				   ProjectionHandler* pPH = NULL);
+
+////////////////////////////////////////////////////////////////////////
+///	Loads a grid from a ugb file.
+/**	If the file contains as many partitions as there are processes and if
+ * grid has a DistributedGridManager (i.e. it is a parallel MultiGrid), each
+ * process only reads its own partition block and the horizontal interfaces
+ * between the partitions are created directly. The grid is thus distributed
+ * after loading.
+ *
+ * Otherwise all partitions are read and merged through their global ids.
+ *
+ * Note that only the first subset handler is stored in ugb files.
+ *
+ * \param pPH	(optional) receives the projection handler stored in the
+ *				file. It is cleared if the file contains none.*/
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, ISubsetHandler& sh, const char* filename,
+					 TAPosition& aPos, ProjectionHandler* pPH = NULL);
+
+///	Loads a grid from a ugb file. num_ph is set to 1 if the file contains a projection handler.
+template <class TAPosition>
+bool LoadGridFromUGB(Grid& grid, SPProjectionHandler& ph, size_t& num_ph,
+					 ISubsetHandler& sh, const char* filename, TAPosition& aPos);
+
+///	returns the number of partitions of the given ugb file (-1 if the file can't be read)
+int GetNumUGBPartitions(const char* filename);
+
+///	returns true if each process can directly load its own partition of the given file
+/**	This is the case if the file contains as many partitions as there are
+ * processes and if there is more than one process.*/
+bool UGBPartitionsMatchProcesses(const char* filename);
+
+///	Converts a ugx file to a ugb file with the given number of partitions.
+/**	The first grid, the first subset handler and the first projection handler
+ * of the ugx file are converted.*/
+bool ConvertUGXToUGB(const char* ugxFilename, const char* ugbFilename,
+					 int numPartitions);
+
+}//	end of namespace
+
+#endif
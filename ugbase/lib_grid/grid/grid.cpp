@@ -47,6 +47,9 @@ using namespace std;
 
 namespace ug
 {
+///	number of elements per chunk of the object pools of a grid
+static const size_t OBJECT_POOL_CHUNK_SIZE = 1024;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 //	implementation of Grid
@@ -61,7 +64,9 @@ Grid::Grid() :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bPooledAllocation(true),
+	m_bBulkRelease(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -79,7 +84,9 @@ Grid::Grid(uint options) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bPooledAllocation(true),
+	m_bBulkRelease(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -97,7 +104,9 @@ Grid::Grid(const Grid& grid) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bPooledAllocation(true),
+	m_bBulkRelease(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -123,6 +132,9 @@ Grid::~Grid()
 	#endif
 
 	if(m_periodicBndMgr)		delete m_periodicBndMgr;
+
+	for(size_t i = 0; i < m_objectPools.size(); ++i)
+		delete m_objectPools[i];
 }
 
 void Grid::notify_and_clear_observers_on_grid_destruction(GridObserver* initiator)
@@ -228,16 +240,89 @@ void Grid::clear_geometry()
 //	disable all options to speed it up
 	uint opts = get_options();
 	set_options(GRIDOPT_NONE);
-	
+
+//	pooled elements are only destroyed here. Their memory is released below.
+	m_bBulkRelease = true;
+
 	clear<Volume>();
 	clear<Face>();
 	clear<Edge>();
 	clear<Vertex>();
+
+	m_bBulkRelease = false;
+
+//	release the memory of the object pools at once. If an observer created
+//	new elements during clearing, the memory is kept until the grid is destroyed.
+	if(num_vertices() + num_edges() + num_faces() + num_volumes() == 0){
+		for(size_t i = 0; i < m_objectPools.size(); ++i)
+			m_objectPools[i]->release_all();
+	}
 	
 //	reset options
 	set_options(opts);
 }
 
+size_t Grid::pooled_memory() const
+{
+	size_t mem = 0;
+	for(size_t i = 0; i < m_objectPools.size(); ++i){
+		mem += m_objectPools[i]->num_chunks() * m_objectPools[i]->block_size()
+				* OBJECT_POOL_CHUNK_SIZE;
+	}
+	return mem;
+}
+
+void* Grid::allocate_object_memory(size_t size, byte& poolIndexOut)
+{
+	if(!m_bPooledAllocation){
+		poolIndexOut = 0;
+		return ::operator new(size);
+	}
+
+//	elements of the same concrete type share one pool. Since the number of
+//	different element types is small, a linear search is sufficient.
+	const size_t blockSize = ObjectArena::aligned_size(size);
+	size_t i = 0;
+	for(; i < m_objectPools.size(); ++i){
+		if(m_objectPools[i]->block_size() == blockSize)
+			break;
+	}
+
+	if(i == m_objectPools.size()){
+		if(i >= 255){
+			poolIndexOut = 0;
+			return ::operator new(size);
+		}
+		m_objectPools.push_back(new ObjectArena(blockSize, OBJECT_POOL_CHUNK_SIZE));
+	}
+
+	poolIndexOut = static_cast<byte>(i + 1);
+	return m_objectPools[i]->allocate();
+}
+
+void* AllocateGridObjectMemory(Grid* pGrid, size_t size, byte& poolIndexOut)
+{
+	if(!pGrid){
+		poolIndexOut = 0;
+		return ::operator new(size);
+	}
+	return pGrid->allocate_object_memory(size, poolIndexOut);
+}
+
+void Grid::free_object(GridObject* obj)
+{
+	if(obj->m_poolIndex == 0){
+		delete obj;
+		return;
+	}
+
+	ObjectArena* pool = m_objectPools[obj->m_poolIndex - 1];
+	void* mem = dynamic_cast<void*>(obj);
+	obj->~GridObject();
+	if(!m_bBulkRelease)
+		pool->deallocate(mem);
+}
+
 template <class TElem>
 void Grid::clear_attachments()
 {
@@ -418,14 +503,14 @@ void Grid::assign_grid(const Grid& grid)
 
 VertexIterator Grid::create_by_cloning(Vertex* pCloneMe, GridObject* pParent)
 {
-	Vertex* pNew = reinterpret_cast<Vertex*>(pCloneMe->create_empty_instance());
+	Vertex* pNew = reinterpret_cast<Vertex*>(pCloneMe->create_empty_instance(this));
 	register_vertex(pNew, pParent);
 	return iterator_cast<VertexIterator>(get_iterator(pNew));
 }
 
 EdgeIterator Grid::create_by_cloning(Edge* pCloneMe, const IVertexGroup& ev, GridObject* pParent)
 {
-	Edge* pNew = reinterpret_cast<Edge*>(pCloneMe->create_empty_instance());
+	Edge* pNew = reinterpret_cast<Edge*>(pCloneMe->create_empty_instance(this));
 	pNew->set_vertex(0, ev.vertex(0));
 	pNew->set_vertex(1, ev.vertex(1));
 	register_edge(pNew, pParent);
@@ -434,7 +519,7 @@ EdgeIterator Grid::create_by_cloning(Edge* pCloneMe, const IVertexGroup& ev, Gri
 
 FaceIterator Grid::create_by_cloning(Face* pCloneMe, const IVertexGroup& fv, GridObject* pParent)
 {
-	Face* pNew = reinterpret_cast<Face*>(pCloneMe->create_empty_instance());
+	Face* pNew = reinterpret_cast<Face*>(pCloneMe->create_empty_instance(this));
 	uint numVrts = fv.num_vertices();
 	Face::ConstVertexArray vrts = fv.vertices();
 	for(uint i = 0; i < numVrts; ++i)
@@ -445,7 +530,7 @@ FaceIterator Grid::create_by_cloning(Face* pCloneMe, const IVertexGroup& fv, Gri
 
 VolumeIterator Grid::create_by_cloning(Volume* pCloneMe, const IVertexGroup& vv, GridObject* pParent)
 {
-	Volume* pNew = reinterpret_cast<Volume*>(pCloneMe->create_empty_instance());
+	Volume* pNew = reinterpret_cast<Volume*>(pCloneMe->create_empty_instance(this));
 	uint numVrts = vv.num_vertices();
 	Volume::ConstVertexArray vrts = vv.vertices();
 	for(uint i = 0; i < numVrts; ++i)
@@ -487,7 +572,7 @@ void Grid::erase(Vertex* vrt)
 
 	unregister_vertex(vrt);
 
-	delete vrt;
+	free_object(vrt);
 }
 
 void Grid::erase(Edge* edge)
@@ -498,7 +583,7 @@ void Grid::erase(Edge* edge)
 
 	unregister_edge(edge);
 
-	delete edge;
+	free_object(edge);
 }
 
 void Grid::erase(Face* face)
@@ -509,7 +594,7 @@ void Grid::erase(Face* face)
 
 	unregister_face(face);
 
-	delete face;
+	free_object(face);
 }
 
 void Grid::erase(Volume* vol)
@@ -520,7 +605,7 @@ void Grid::erase(Volume* vol)
 
 	unregister_volume(vol);
 
-	delete vol;
+	free_object(vol);
 }
 
 //	the geometric-object-collection:
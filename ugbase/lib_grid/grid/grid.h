@@ -355,6 +355,23 @@ class UG_API Grid
 	///	clears the grids attachments. The geometry remains.
 		void clear_attachments();
 
+	////////////////////////////////////////////////
+	//	memory management
+	///	enables or disables the allocation of elements through object pools
+	/**	If enabled, elements created by the grid are allocated through arenas
+	 * owned by the grid, one for each element size (see ObjectArena).
+	 * The memory of all pooled elements is released at once by clear_geometry
+	 * and on destruction of the grid. Changing the option only affects elements
+	 * created afterwards. This includes the elements created by
+	 * create_by_cloning and the elements created by the refine methods of
+	 * the elements if the grid is passed to them (as done by the refiners).
+	 * Pooled allocation is enabled by default.*/
+		void enable_pooled_allocation(bool enable)	{m_bPooledAllocation = enable;}
+	///	returns true if elements are allocated through object pools
+		bool pooled_allocation_enabled() const		{return m_bPooledAllocation;}
+	///	returns the number of bytes currently held by the object pools
+		size_t pooled_memory() const;
+
 	////////////////////////////////////////////////
 	//	element creation
 	///	create a custom element.
@@ -1148,6 +1165,17 @@ class UG_API Grid
 		template <class TElem>
 		void clear_attachments();
 
+	///	returns memory for an element of the given size.
+	/**	poolIndexOut is set to the value which has to be assigned to
+	 * GridObject::m_poolIndex of the constructed element.
+	 * Elements are allocated through this method by NewGridObject.*/
+		void* allocate_object_memory(size_t size, byte& poolIndexOut);
+
+	///	destroys an element created through NewGridObject or new
+		void free_object(GridObject* obj);
+
+		friend void* AllocateGridObjectMemory(Grid* pGrid, size_t size, byte& poolIndexOut);
+
 	protected:
 		VertexElementStorage	m_vertexElementStorage;
 		EdgeElementStorage		m_edgeElementStorage;
@@ -1198,6 +1226,11 @@ class UG_API Grid
 		SPMessageHub 							m_messageHub;
 		DistributedGridManager*		m_distGridMgr;
 		PeriodicBoundaryManager*	m_periodicBndMgr;
+
+	//	object pools
+		std::vector<ObjectArena*>	m_objectPools;
+		bool						m_bPooledAllocation;
+		bool						m_bBulkRelease;//	memory is released later on by clear_geometry
 };
 
 /** \} */
@@ -34,6 +34,7 @@
 #define __H__LIB_GRID__GEOMETRIC_BASE_OBJECTS__
 
 #include <list>
+#include <new>
 #include <cassert>
 #include <iostream>
 #include <utility>
@@ -160,13 +161,24 @@ class UG_API GridObject/* : public SmallObject<>*/
 	friend class attachment_traits<Edge*, ElementStorage<Edge> >;
 	friend class attachment_traits<Face*, ElementStorage<Face> >;
 	friend class attachment_traits<Volume*, ElementStorage<Volume> >;
+	template <class TElem> friend TElem* NewGridObject(Grid*);
+	template <class TElem, class TDescriptor>
+	friend TElem* NewGridObject(Grid*, const TDescriptor&);
 
 	public:
+		GridObject() : m_poolIndex(0)	{}
+	///	the pool index describes the memory of an object and is thus not copied.
+		GridObject(const GridObject& o) :
+			m_gridDataIndex(o.m_gridDataIndex), m_poolIndex(0)	{}
+		GridObject& operator=(const GridObject& o)
+			{m_gridDataIndex = o.m_gridDataIndex; return *this;}
 		virtual ~GridObject()	{}
 
 	///	create an instance of the derived type
-	/**	Make sure to overload this method in derivates of this class!*/
-		virtual GridObject* create_empty_instance() const {return NULL;}
+	/**	Make sure to overload this method in derivates of this class!
+	 * If a grid is passed, the instance is allocated through its object pools
+	 * and has to be registered at that grid (see NewGridObject).*/
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const {return NULL;}
 
 		virtual int container_section() const = 0;
 		virtual int base_object_id() const = 0;
@@ -213,9 +225,46 @@ class UG_API GridObject/* : public SmallObject<>*/
 
 	protected:
 		uint						m_gridDataIndex;//	index to grid-attached data.
+
+	private:
+	//	index+1 of the object pool of the grid through which the object was
+	//	allocated. 0 if the object was allocated through new. Only used by Grid.
+		byte						m_poolIndex;
 };
 
 
+///	returns memory for a new grid object
+/**	If pGrid is not NULL, the memory is taken from the object pools of the
+ * grid (see Grid::enable_pooled_allocation) and poolIndexOut receives the
+ * index which has to be stored in the object. Otherwise the memory is
+ * allocated through operator new and poolIndexOut is 0.*/
+UG_API void* AllocateGridObjectMemory(Grid* pGrid, size_t size, byte& poolIndexOut);
+
+///	creates a grid object of type TElem
+/**	If pGrid is not NULL, the object is allocated through the object pools of
+ * the grid. Such an object has to be registered at that grid and must not be
+ * deleted through delete. If pGrid is NULL, the object is created through new.
+ * \{ */
+template <class TElem>
+TElem* NewGridObject(Grid* pGrid)
+{
+	byte poolIndex;
+	TElem* elem = ::new(AllocateGridObjectMemory(pGrid, sizeof(TElem), poolIndex)) TElem;
+	static_cast<GridObject*>(elem)->m_poolIndex = poolIndex;
+	return elem;
+}
+
+template <class TElem, class TDescriptor>
+TElem* NewGridObject(Grid* pGrid, const TDescriptor& descriptor)
+{
+	byte poolIndex;
+	TElem* elem = ::new(AllocateGridObjectMemory(pGrid, sizeof(TElem), poolIndex)) TElem(descriptor);
+	static_cast<GridObject*>(elem)->m_poolIndex = poolIndex;
+	return elem;
+}
+/** \} */
+
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 //	Vertex
@@ -440,6 +489,8 @@ class UG_API Edge : public GridObject, public EdgeVertices
 	 * Newly created edges have to be registered at a grid manually by the caller.
 	 * If the caller does not register the edges in vGeomOut at a grid, he is
 	 * responsible to free the associated memory (delete each element in vNewEdgesOut).
+	 * If pGrid is specified, the new edges are allocated through the object
+	 * pools of pGrid (see NewGridObject) and have to be registered at pGrid.
 	 * Please note that refining an edge using this method does not automatically
 	 * refine associated elements.
 	 * Be sure to store the new edges in the right order. vNewEdgesOut should contain
@@ -450,7 +501,8 @@ class UG_API Edge : public GridObject, public EdgeVertices
 	 */
 		virtual bool refine(std::vector<Edge*>& vNewEdgesOut,
 											Vertex* newVertex,
-											Vertex** pSubstituteVrts = NULL)	{return false;}
+											Vertex** pSubstituteVrts = NULL,
+											Grid* pGrid = NULL)	{return false;}
 
 	protected:
 		inline void set_vertex(uint index, Vertex* pVrt)	{m_vertices[index] = pVrt;}
@@ -590,13 +642,17 @@ class UG_API Face : public GridObject, public FaceVertices
 	 *   is specifed, then new inner edges will always be created between new edge vertices
 	 *   and the vertex specified through the snap-point-index. Note that a snap-point
 	 *   must not be a corner of a refined edge.
+	 * - If pGrid is specified, the new faces and the new inner vertex are allocated
+	 *   through the object pools of pGrid (see NewGridObject) and have to be
+	 *   registered at pGrid.
 	 */
 		virtual bool refine(std::vector<Face*>& vNewFacesOut,
 							Vertex** newFaceVertexOut,
 							Vertex** newEdgeVertices,
 							Vertex* newFaceVertex = NULL,
 							Vertex** pSubstituteVertices = NULL,
-							int snapPointIndex = -1)	{return false;}
+							int snapPointIndex = -1,
+							Grid* pGrid = NULL)	{return false;}
 
 
 	///	returns true if the specified edgeMarks would lead to a regular refinement
@@ -869,6 +925,9 @@ class UG_API Volume : public GridObject, public VolumeVertices
 	 *   Each quadrilateral side may contain at most one snap-point. New edges on quadrilateral
 	 *   faces will then connect the snap-point and the newly introduced edge-vertex.
 	 *   Note that a snap-point must not be a corner of a refined edge.
+	 * - If pGrid is specified, the new volumes and the new vertex are allocated
+	 *   through the object pools of pGrid (see NewGridObject) and have to be
+	 *   registered at pGrid.
 	 */
 		virtual bool refine(std::vector<Volume*>& vNewVolumesOut,
 							Vertex** ppNewVertexOut,
@@ -878,7 +937,8 @@ class UG_API Volume : public GridObject, public VolumeVertices
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL)	{return false;}
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL)	{return false;}
 
 		
 	///	returns true if the specified edgeMarks would lead to a regular refinement
@@ -213,7 +213,7 @@ void Grid::register_and_replace_element(Vertex* v, Vertex* pReplaceMe)
 //	remove pReplaceMe
 	m_vertexElementStorage.m_attachmentPipe.unregister_element(pReplaceMe);
 	m_vertexElementStorage.m_sectionContainer.erase(get_iterator(pReplaceMe), pReplaceMe->container_section());
-	delete pReplaceMe;
+	free_object(pReplaceMe);
 }
 
 void Grid::unregister_vertex(Vertex* v)
@@ -672,7 +672,7 @@ void Grid::register_and_replace_element(Edge* e, Edge* pReplaceMe)
 //	remove the element from the storage and delete it.
 	m_edgeElementStorage.m_sectionContainer.erase(get_iterator(pReplaceMe), pReplaceMe->container_section());
 	m_edgeElementStorage.m_attachmentPipe.unregister_element(pReplaceMe);
-	delete pReplaceMe;
+	free_object(pReplaceMe);
 }
 
 void Grid::unregister_edge(Edge* e)
@@ -1122,7 +1122,7 @@ void Grid::register_and_replace_element(Face* f, Face* pReplaceMe)
 //	remove the element from the storage and delete it.
 	m_faceElementStorage.m_sectionContainer.erase(get_iterator(pReplaceMe), pReplaceMe->container_section());
 	m_faceElementStorage.m_attachmentPipe.unregister_element(pReplaceMe);
-	delete pReplaceMe;
+	free_object(pReplaceMe);
 }
 
 void Grid::unregister_face(Face* f)
@@ -1651,7 +1651,7 @@ void Grid::register_and_replace_element(Volume* v, Volume* pReplaceMe)
 //	remove the element from the storage and delete it.
 	m_volumeElementStorage.m_sectionContainer.erase(get_iterator(pReplaceMe), pReplaceMe->container_section());
 	m_volumeElementStorage.m_attachmentPipe.unregister_element(pReplaceMe);
-	delete pReplaceMe;
+	free_object(pReplaceMe);
 }
 
 void Grid::unregister_volume(Volume* v)
@@ -2187,7 +2187,7 @@ bool Grid::replace_vertex(Vertex* vrtOld, Vertex* vrtNew)
 				//	we can now remove e from the storage.
 					m_edgeElementStorage.m_sectionContainer.erase(get_iterator(e), e->container_section());
 					m_edgeElementStorage.m_attachmentPipe.unregister_element(e);
-					delete e;
+					free_object(e);
 				}
 			}
 
@@ -2303,7 +2303,7 @@ bool Grid::replace_vertex(Vertex* vrtOld, Vertex* vrtNew)
 				//	we can now remove f from the storage.
 					m_faceElementStorage.m_sectionContainer.erase(get_iterator(f), f->container_section());
 					m_faceElementStorage.m_attachmentPipe.unregister_element(f);
-					delete f;
+					free_object(f);
 				}
 			}
 
@@ -2444,7 +2444,7 @@ bool Grid::replace_vertex(Vertex* vrtOld, Vertex* vrtNew)
 				//	we can now remove v from the storage.
 					m_volumeElementStorage.m_sectionContainer.erase(get_iterator(v), v->container_section());
 					m_volumeElementStorage.m_attachmentPipe.unregister_element(v);
-					delete v;
+					free_object(v);
 				}
 			}
 
@@ -2528,7 +2528,7 @@ bool Grid::replace_vertex(Vertex* vrtOld, Vertex* vrtNew)
 //	finally erase vrtOld.
 	m_vertexElementStorage.m_sectionContainer.erase(get_iterator(vrtOld), vrtOld->container_section());
 	m_vertexElementStorage.m_attachmentPipe.unregister_element(vrtOld);
-	delete vrtOld;
+	free_object(vrtOld);
 
 	return true;
 }
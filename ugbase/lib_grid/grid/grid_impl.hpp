@@ -72,7 +72,7 @@ Grid::create(GridObject* pParent)
 		&&	geometry_traits<TGeomObj>::BASE_OBJECT_ID != -1,
 		invalid_geometry_type);
 
-	TGeomObj* geomObj = new TGeomObj;
+	TGeomObj* geomObj = NewGridObject<TGeomObj>(this);
 //	int baseObjectType = geometry_traits<GeomObjType>::base_object_type();
 //	geomObj->m_elemHandle = m_elementStorage[baseObjectType].m_sectionContainer.insert_element(geomObj, geometry_traits<GeomObjType>::container_section());
 //	m_elementStorage[baseObjectType].m_attachmentPipe.register_element(geomObj);
@@ -91,7 +91,7 @@ Grid::create(const typename geometry_traits<TGeomObj>::Descriptor& descriptor,
 			&&	geometry_traits<TGeomObj>::BASE_OBJECT_ID != -1,
 			invalid_geometry_type);
 
-	TGeomObj* geomObj = new TGeomObj(descriptor);
+	TGeomObj* geomObj = NewGridObject<TGeomObj>(this, descriptor);
 
 //	int baseObjectType = geometry_traits<TGeomObj>::base_object_type();
 //	geomObj->m_elemHandle = m_elementStorage[baseObjectType].m_sectionContainer.insert_element(geomObj, geometry_traits<GeomObjType>::container_section());
@@ -110,7 +110,7 @@ Grid::create_and_replace(typename geometry_traits<TGeomObj>::grid_base_object* p
 		&&	geometry_traits<TGeomObj>::BASE_OBJECT_ID != -1,
 		invalid_geometry_type);
 
-	TGeomObj* geomObj = new TGeomObj;
+	TGeomObj* geomObj = NewGridObject<TGeomObj>(this);
 
 	if(geomObj->reference_object_id() == pReplaceMe->reference_object_id())
 	{
@@ -121,7 +121,7 @@ Grid::create_and_replace(typename geometry_traits<TGeomObj>::grid_base_object* p
 	{
 		LOG("ERROR in Grid::create_and_replace(...): reference objects do not match!");
 		assert(!"ERROR in Grid::create_and_replace(...): reference objects do not match!");
-		delete geomObj;
+		free_object(geomObj);
 		return end<TGeomObj>();
 	}
 }
@@ -66,7 +66,7 @@ class UG_API RegularVertex : public Vertex
 
 		virtual ~RegularVertex()	{}
 
-		virtual GridObject* create_empty_instance() const	{return new RegularVertex;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<RegularVertex>(pGrid);}
 
 		virtual int container_section() const	{return CSVRT_REGULAR_VERTEX;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_VERTEX;}
@@ -119,7 +119,7 @@ class UG_API ConstrainedVertex : public Vertex
 				m_constrainingObj->remove_constraint_link(this);
 		}
 
-		virtual GridObject* create_empty_instance() const	{return new ConstrainedVertex;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<ConstrainedVertex>(pGrid);}
 
 		virtual int container_section() const	{return CSVRT_CONSTRAINED_VERTEX;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_VERTEX;}
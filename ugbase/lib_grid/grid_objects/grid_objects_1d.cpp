@@ -37,13 +37,13 @@ namespace ug{
 ////////////////////////////////////////////////////////////////////////
 //	RegularEdge
 bool RegularEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVertex,
-				Vertex** pSubstituteVrts)
+				Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	vNewEdgesOut.clear();
 	if(pSubstituteVrts)
 	{
-		vNewEdgesOut.push_back(new RegularEdge(pSubstituteVrts[0], newVertex));
-		vNewEdgesOut.push_back(new RegularEdge(newVertex, pSubstituteVrts[1]));
+		vNewEdgesOut.push_back(NewGridObject<RegularEdge>(pGrid, EdgeDescriptor(pSubstituteVrts[0], newVertex)));
+		vNewEdgesOut.push_back(NewGridObject<RegularEdge>(pGrid, EdgeDescriptor(newVertex, pSubstituteVrts[1])));
 	}
 	else
 	{
@@ -54,22 +54,22 @@ bool RegularEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVertex,
 }
 
 bool RegularEdge::refine(std::vector<RegularEdge*>& vNewEdgesOut, Vertex* newVertex,
-				  Vertex** pSubstituteVrts)
+				  Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	return refine(reinterpret_cast<std::vector<Edge*>&>(vNewEdgesOut),
-					newVertex, pSubstituteVrts);
+					newVertex, pSubstituteVrts, pGrid);
 }
 
 ////////////////////////////////////////////////////////////////////////
 //	ConstrainedEdge
 bool ConstrainedEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVertex,
-				  Vertex** pSubstituteVrts)
+				  Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	vNewEdgesOut.clear();
 	if(pSubstituteVrts)
 	{
-		vNewEdgesOut.push_back(new ConstrainedEdge(pSubstituteVrts[0], newVertex));
-		vNewEdgesOut.push_back(new ConstrainedEdge(newVertex, pSubstituteVrts[1]));
+		vNewEdgesOut.push_back(NewGridObject<ConstrainedEdge>(pGrid, EdgeDescriptor(pSubstituteVrts[0], newVertex)));
+		vNewEdgesOut.push_back(NewGridObject<ConstrainedEdge>(pGrid, EdgeDescriptor(newVertex, pSubstituteVrts[1])));
 	}
 	else
 	{
@@ -80,22 +80,22 @@ bool ConstrainedEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVertex
 }
 
 bool ConstrainedEdge::refine(std::vector<ConstrainedEdge*>& vNewEdgesOut, Vertex* newVertex,
-				  Vertex** pSubstituteVrts)
+				  Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	return refine(reinterpret_cast<std::vector<Edge*>&>(vNewEdgesOut),
-				newVertex, pSubstituteVrts);
+				newVertex, pSubstituteVrts, pGrid);
 }
 
 ////////////////////////////////////////////////////////////////////////
 //	ConstrainingEdge
 bool ConstrainingEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVertex,
-				  Vertex** pSubstituteVrts)
+				  Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	vNewEdgesOut.clear();
 	if(pSubstituteVrts)
 	{
-		vNewEdgesOut.push_back(new ConstrainingEdge(pSubstituteVrts[0], newVertex));
-		vNewEdgesOut.push_back(new ConstrainingEdge(newVertex, pSubstituteVrts[1]));
+		vNewEdgesOut.push_back(NewGridObject<ConstrainingEdge>(pGrid, EdgeDescriptor(pSubstituteVrts[0], newVertex)));
+		vNewEdgesOut.push_back(NewGridObject<ConstrainingEdge>(pGrid, EdgeDescriptor(newVertex, pSubstituteVrts[1])));
 	}
 	else
 	{
@@ -106,10 +106,10 @@ bool ConstrainingEdge::refine(std::vector<Edge*>& vNewEdgesOut, Vertex* newVerte
 }
 
 bool ConstrainingEdge::refine(std::vector<ConstrainingEdge*>& vNewEdgesOut, Vertex* newVertex,
-				  Vertex** pSubstituteVrts)
+				  Vertex** pSubstituteVrts, Grid* pGrid)
 {
 	return refine(reinterpret_cast<std::vector<Edge*>&>(vNewEdgesOut),
-					newVertex, pSubstituteVrts);
+					newVertex, pSubstituteVrts, pGrid);
 }
 
 template <> size_t
@@ -83,7 +83,7 @@ class UG_API RegularEdge : public Edge
 
 		virtual ~RegularEdge()	{}
 
-		virtual GridObject* create_empty_instance() const	{return new RegularEdge;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<RegularEdge>(pGrid);}
 
 		virtual int container_section() const	{return CSEDGE_REGULAR_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -95,7 +95,8 @@ class UG_API RegularEdge : public Edge
 	 */
 		virtual bool refine(std::vector<Edge*>& vNewEdgesOut,
 							Vertex* newVertex,
-							Vertex** pSubstituteVrts = NULL);
+							Vertex** pSubstituteVrts = NULL,
+							Grid* pGrid = NULL);
 
 //TODO:	Think about this method. It is not safe!
 	///	non virtual refine. Returns pointers to RegularEdge.
@@ -105,7 +106,8 @@ class UG_API RegularEdge : public Edge
 	 */
 		bool refine(std::vector<RegularEdge*>& vNewEdgesOut,
 					Vertex* newVertex,
-					Vertex** pSubstituteVrts = NULL);
+					Vertex** pSubstituteVrts = NULL,
+					Grid* pGrid = NULL);
 };
 
 template <>
@@ -171,7 +173,7 @@ class UG_API ConstrainedEdge : public Edge
 				m_pConstrainingObject->remove_constraint_link(this);
 		}
 
-		virtual GridObject* create_empty_instance() const	{return new ConstrainedEdge;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<ConstrainedEdge>(pGrid);}
 
 		virtual int container_section() const	{return CSEDGE_CONSTRAINED_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -201,7 +203,8 @@ class UG_API ConstrainedEdge : public Edge
 	 */
 		virtual bool refine(std::vector<Edge*>& vNewEdgesOut,
 							Vertex* newVertex,
-							Vertex** pSubstituteVrts = NULL);
+							Vertex** pSubstituteVrts = NULL,
+							Grid* pGrid = NULL);
 
 //TODO:	Think about this method. It is not safe!
 	///	non virtual refine. Returns pointers to ConstrainedEdge.
@@ -213,7 +216,8 @@ class UG_API ConstrainedEdge : public Edge
 	 */
 		bool refine(std::vector<ConstrainedEdge*>& vNewEdgesOut,
 					Vertex* newVertex,
-					Vertex** pSubstituteVrts = NULL);
+					Vertex** pSubstituteVrts = NULL,
+					Grid* pGrid = NULL);
 
 		inline void set_constraining_object(GridObject* pObj)
 		{
@@ -309,7 +313,7 @@ class UG_API ConstrainingEdge : public Edge
 			}
 		}
 
-		virtual GridObject* create_empty_instance() const	{return new ConstrainingEdge;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<ConstrainingEdge>(pGrid);}
 
 		virtual int container_section() const	{return CSEDGE_CONSTRAINING_EDGE;}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_EDGE;}
@@ -336,7 +340,8 @@ class UG_API ConstrainingEdge : public Edge
 	 */
 		virtual bool refine(std::vector<Edge*>& vNewEdgesOut,
 							Vertex* newVertex,
-							Vertex** pSubstituteVrts = NULL);
+							Vertex** pSubstituteVrts = NULL,
+							Grid* pGrid = NULL);
 
 //TODO:	Think about this method. It is not safe!
 	///	non virtual refine. Returns pointers to ConstrainingEdge.
@@ -347,7 +352,8 @@ class UG_API ConstrainingEdge : public Edge
 	 */
 		bool refine(std::vector<ConstrainingEdge*>& vNewEdgesOut,
 						Vertex* newVertex,
-						Vertex** pSubstituteVrts = NULL);
+						Vertex** pSubstituteVrts = NULL,
+						Grid* pGrid = NULL);
 
 
 		inline void add_constrained_object(Vertex* pObj)
@@ -123,7 +123,8 @@ refine(std::vector<Face*>& vNewFacesOut,
 		Vertex** newEdgeVertices,
 		Vertex* newFaceVertex,
 		Vertex** pSubstituteVertices,
-		int snapPointIndex)
+		int snapPointIndex,
+		Grid* pGrid)
 {
 //TODO: complete triangle refine
 
@@ -155,9 +156,9 @@ refine(std::vector<Face*>& vNewFacesOut,
 		}
 
 	//	create three new triangles
-		vNewFacesOut.push_back(new RefTriType(vrts[0], vrts[1], newFaceVertex));
-		vNewFacesOut.push_back(new RefTriType(vrts[1], vrts[2], newFaceVertex));
-		vNewFacesOut.push_back(new RefTriType(vrts[2], vrts[0], newFaceVertex));
+		vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[0], vrts[1], newFaceVertex)));
+		vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[1], vrts[2], newFaceVertex)));
+		vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[2], vrts[0], newFaceVertex)));
 		return true;
 	}
 	else
@@ -166,7 +167,7 @@ refine(std::vector<Face*>& vNewFacesOut,
 		{
 			case 0: // this may happen when the triangle belongs to a prism being anisotropically refined
 					// and the volume on the other side is not being refined
-				vNewFacesOut.push_back(new RefTriType(vrts[0], vrts[1], vrts[2]));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[0], vrts[1], vrts[2])));
 				return true;
 
 			case 1:
@@ -188,10 +189,10 @@ refine(std::vector<Face*>& vNewFacesOut,
 				iCorner[2] = (iCorner[1] + 1) % 3;
 					
 			//	create the new triangles.
-				vNewFacesOut.push_back(new RefTriType(vrts[iCorner[0]], vrts[iCorner[1]],
-																newEdgeVertices[iNew]));
-				vNewFacesOut.push_back(new RefTriType(vrts[iCorner[0]], newEdgeVertices[iNew],
-																vrts[iCorner[2]]));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[iCorner[0]], vrts[iCorner[1]],
+																newEdgeVertices[iNew])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[iCorner[0]], newEdgeVertices[iNew],
+																vrts[iCorner[2]])));
 																
 				return true;
 			}
@@ -219,21 +220,21 @@ refine(std::vector<Face*>& vNewFacesOut,
 				iCorner[2] = (iFree + 2) % 3;
 				
 			//	create the faces
-				vNewFacesOut.push_back(new RefTriType(newEdgeVertices[iNew[0]],
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(newEdgeVertices[iNew[0]],
 																vrts[iCorner[2]],
-																newEdgeVertices[iNew[1]]));
-				vNewFacesOut.push_back(new RefQuadType(vrts[iCorner[0]], vrts[iCorner[1]],
-														newEdgeVertices[iNew[0]], newEdgeVertices[iNew[1]]));
+																newEdgeVertices[iNew[1]])));
+				vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[iCorner[0]], vrts[iCorner[1]],
+														newEdgeVertices[iNew[0]], newEdgeVertices[iNew[1]])));
 				return true;
 			}
 
 			case 3:
 			{
 			//	perform regular refine.
-				vNewFacesOut.push_back(new RefTriType(vrts[0], newEdgeVertices[0], newEdgeVertices[2]));
-				vNewFacesOut.push_back(new RefTriType(vrts[1], newEdgeVertices[1], newEdgeVertices[0]));
-				vNewFacesOut.push_back(new RefTriType(vrts[2], newEdgeVertices[2], newEdgeVertices[1]));
-				vNewFacesOut.push_back(new RefTriType(newEdgeVertices[0], newEdgeVertices[1], newEdgeVertices[2]));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[0], newEdgeVertices[0], newEdgeVertices[2])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[1], newEdgeVertices[1], newEdgeVertices[0])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[2], newEdgeVertices[2], newEdgeVertices[1])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(newEdgeVertices[0], newEdgeVertices[1], newEdgeVertices[2])));
 				return true;
 			}
 
@@ -457,7 +458,8 @@ refine(std::vector<Face*>& vNewFacesOut,
 		Vertex** edgeVrts,
 		Vertex* newFaceVertex,
 		Vertex** pSubstituteVertices,
-		int snapPointIndex)
+		int snapPointIndex,
+		Grid* pGrid)
 {
 //TODO: complete quad refine
 	*newFaceVertexOut = newFaceVertex;
@@ -486,17 +488,17 @@ refine(std::vector<Face*>& vNewFacesOut,
 			if (newFaceVertex)
 			{
 			//	create four new triangles
-				vNewFacesOut.push_back(new RefTriType(vrts[0], vrts[1], newFaceVertex));
-				vNewFacesOut.push_back(new RefTriType(vrts[1], vrts[2], newFaceVertex));
-				vNewFacesOut.push_back(new RefTriType(vrts[2], vrts[3], newFaceVertex));
-				vNewFacesOut.push_back(new RefTriType(vrts[3], vrts[0], newFaceVertex));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[0], vrts[1], newFaceVertex)));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[1], vrts[2], newFaceVertex)));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[2], vrts[3], newFaceVertex)));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(vrts[3], vrts[0], newFaceVertex)));
 				return true;
 			}
 
 			// in case the mid point does not exists, we need a simple copy
 			// This may happen when the quad belongs to a hexahedron being anisotropically refined
 			// and the volume on the other side is not being refined.
-			vNewFacesOut.push_back(new RefQuadType(vrts[0], vrts[1], vrts[2], vrts[3]));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[0], vrts[1], vrts[2], vrts[3])));
 			return true;
 			
 		case 1:
@@ -526,19 +528,19 @@ refine(std::vector<Face*>& vNewFacesOut,
 
 		//	create the new elements
 			if(snapPointIndex == -1){
-				vNewFacesOut.push_back(new RefTriType(corner[0], corner[1], edgeVrts[iNew]));
-				vNewFacesOut.push_back(new RefTriType(corner[0], edgeVrts[iNew], corner[3]));
-				vNewFacesOut.push_back(new RefTriType(corner[3], edgeVrts[iNew], corner[2]));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], corner[1], edgeVrts[iNew])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], edgeVrts[iNew], corner[3])));
+				vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[3], edgeVrts[iNew], corner[2])));
 			}
 			else{
 				snapPointIndex = (snapPointIndex + 4 - rot) % 4;
 				if(snapPointIndex == 0){
-					vNewFacesOut.push_back(new RefTriType(corner[0], corner[1], edgeVrts[iNew]));
-					vNewFacesOut.push_back(new RefQuadType(corner[0], edgeVrts[iNew], corner[2], corner[3]));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], corner[1], edgeVrts[iNew])));
+					vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(corner[0], edgeVrts[iNew], corner[2], corner[3])));
 				}
 				else if(snapPointIndex == 3){
-					vNewFacesOut.push_back(new RefQuadType(corner[0], corner[1], edgeVrts[iNew], corner[3]));
-					vNewFacesOut.push_back(new RefTriType(corner[3], edgeVrts[iNew], corner[2]));
+					vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(corner[0], corner[1], edgeVrts[iNew], corner[3])));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[3], edgeVrts[iNew], corner[2])));
 				}
 				else{
 					UG_THROW("Unexpected snap-point index: " << snapPointIndex << ". This is an implementation error!");
@@ -575,11 +577,11 @@ refine(std::vector<Face*>& vNewFacesOut,
 				ReorderCornersCCW(corner, vrts, 4, (iNew[0] + 3) % 4);
 				
 			//	create new faces
-				vNewFacesOut.push_back(new RefQuadType(corner[0], corner[1],
-													edgeVrts[iNew[0]], edgeVrts[iNew[1]]));
+				vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(corner[0], corner[1],
+													edgeVrts[iNew[0]], edgeVrts[iNew[1]])));
 
-				vNewFacesOut.push_back(new RefQuadType(edgeVrts[iNew[1]], edgeVrts[iNew[0]],
-														corner[2], corner[3]));
+				vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(edgeVrts[iNew[1]], edgeVrts[iNew[0]],
+														corner[2], corner[3])));
 			}
 			else{
 			//	edges are adjacent
@@ -599,15 +601,15 @@ refine(std::vector<Face*>& vNewFacesOut,
 
 			//	create new faces
 				if(snapPointIndex == -1){
-					vNewFacesOut.push_back(new RefTriType(corner[0], corner[1], edgeVrts[iNew[0]]));
-					vNewFacesOut.push_back(new RefTriType(edgeVrts[iNew[0]], corner[2], edgeVrts[iNew[1]]));
-					vNewFacesOut.push_back(new RefTriType(corner[3], corner[0], edgeVrts[iNew[1]]));
-					vNewFacesOut.push_back(new RefTriType(corner[0], edgeVrts[iNew[0]], edgeVrts[iNew[1]]));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], corner[1], edgeVrts[iNew[0]])));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(edgeVrts[iNew[0]], corner[2], edgeVrts[iNew[1]])));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[3], corner[0], edgeVrts[iNew[1]])));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], edgeVrts[iNew[0]], edgeVrts[iNew[1]])));
 				}
 				else{
-					vNewFacesOut.push_back(new RefTriType(corner[0], corner[1], edgeVrts[iNew[0]]));
-					vNewFacesOut.push_back(new RefTriType(corner[3], corner[0], edgeVrts[iNew[1]]));
-					vNewFacesOut.push_back(new RefQuadType(corner[0], edgeVrts[iNew[0]], corner[2], edgeVrts[iNew[1]]));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[0], corner[1], edgeVrts[iNew[0]])));
+					vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[3], corner[0], edgeVrts[iNew[1]])));
+					vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(corner[0], edgeVrts[iNew[0]], corner[2], edgeVrts[iNew[1]])));
 				}
 			}
 
@@ -640,10 +642,10 @@ refine(std::vector<Face*>& vNewFacesOut,
 			ReorderCornersCCW(corner, vrts, 4, (iFree + 1) % 4);
 
 		//	create the faces
-			vNewFacesOut.push_back(new RefQuadType(corner[0], nvrts[0], nvrts[2], corner[3]));
-			vNewFacesOut.push_back(new RefTriType(corner[1], nvrts[1], nvrts[0]));
-			vNewFacesOut.push_back(new RefTriType(corner[2], nvrts[2], nvrts[1]));
-			vNewFacesOut.push_back(new RefTriType(nvrts[0], nvrts[1], nvrts[2]));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(corner[0], nvrts[0], nvrts[2], corner[3])));
+			vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[1], nvrts[1], nvrts[0])));
+			vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(corner[2], nvrts[2], nvrts[1])));
+			vNewFacesOut.push_back(NewGridObject<RefTriType>(pGrid, TriangleDescriptor(nvrts[0], nvrts[1], nvrts[2])));
 
 			return true;
 		}
@@ -652,14 +654,14 @@ refine(std::vector<Face*>& vNewFacesOut,
 		{
 		//	we'll create 4 new quads. create a new center if required.
 			if(!newFaceVertex)
-				newFaceVertex = new RegularVertex;
+				newFaceVertex = NewGridObject<RegularVertex>(pGrid);
 
 			*newFaceVertexOut = newFaceVertex;
 		
-			vNewFacesOut.push_back(new RefQuadType(vrts[0], edgeVrts[0], newFaceVertex, edgeVrts[3]));
-			vNewFacesOut.push_back(new RefQuadType(vrts[1], edgeVrts[1], newFaceVertex, edgeVrts[0]));
-			vNewFacesOut.push_back(new RefQuadType(vrts[2], edgeVrts[2], newFaceVertex, edgeVrts[1]));
-			vNewFacesOut.push_back(new RefQuadType(vrts[3], edgeVrts[3], newFaceVertex, edgeVrts[2]));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[0], edgeVrts[0], newFaceVertex, edgeVrts[3])));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[1], edgeVrts[1], newFaceVertex, edgeVrts[0])));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[2], edgeVrts[2], newFaceVertex, edgeVrts[1])));
+			vNewFacesOut.push_back(NewGridObject<RefQuadType>(pGrid, QuadrilateralDescriptor(vrts[3], edgeVrts[3], newFaceVertex, edgeVrts[2])));
 			return true;
 		}
 	}
@@ -114,7 +114,7 @@ class UG_API CustomTriangle : public BaseClass
 		CustomTriangle(const TriangleDescriptor& td);
 		CustomTriangle(Vertex* v1, Vertex* v2, Vertex* v3);
 
-		virtual GridObject* create_empty_instance() const	{return new ConcreteTriangleType;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<ConcreteTriangleType>(pGrid);}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_TRIANGLE;}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
@@ -135,7 +135,8 @@ class UG_API CustomTriangle : public BaseClass
 							Vertex** newEdgeVertices,
 							Vertex* newFaceVertex = NULL,
 							Vertex** pSubstituteVertices = NULL,
-							int snapPointIndex = -1);
+							int snapPointIndex = -1,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -259,7 +260,7 @@ class UG_API CustomQuadrilateral : public BaseClass
 		CustomQuadrilateral(Vertex* v1, Vertex* v2,
 							Vertex* v3, Vertex* v4);
 
-		virtual GridObject* create_empty_instance() const	{return new ConcreteQuadrilateralType;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<ConcreteQuadrilateralType>(pGrid);}
 		virtual ReferenceObjectID reference_object_id() const {return ROID_QUADRILATERAL;}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
@@ -285,7 +286,8 @@ class UG_API CustomQuadrilateral : public BaseClass
 							Vertex** newEdgeVertices,
 							Vertex* newFaceVertex = NULL,
 							Vertex** pSubstituteVertices = NULL,
-							int snapPointIndex = -1);
+							int snapPointIndex = -1,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 		
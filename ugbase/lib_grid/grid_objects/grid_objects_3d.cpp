@@ -130,7 +130,8 @@ void CreateVolumesFromElementIndexList (
 		vector<Volume*>& volsOut,
 		int* elemIndexList,
 		int elemIndexListSize,
-		Vertex** vrts)
+		Vertex** vrts,
+		Grid* pGrid = NULL)
 {
 	VolumeDescriptor vd;
 	volsOut.clear();
@@ -145,11 +146,11 @@ void CreateVolumesFromElementIndexList (
 		}
 
 		switch(gridObjectID){
-			case GOID_TETRAHEDRON:	volsOut.push_back(new Tetrahedron(vd));	break;
-			case GOID_PYRAMID:		volsOut.push_back(new Pyramid(vd));		break;
-			case GOID_PRISM:		volsOut.push_back(new Prism(vd)); 		break;
-			case GOID_HEXAHEDRON:	volsOut.push_back(new Hexahedron(vd));	break;
-			case GOID_OCTAHEDRON:	volsOut.push_back(new Octahedron(vd));	break;
+			case GOID_TETRAHEDRON:	volsOut.push_back(NewGridObject<Tetrahedron>(pGrid, vd));	break;
+			case GOID_PYRAMID:		volsOut.push_back(NewGridObject<Pyramid>(pGrid, vd));		break;
+			case GOID_PRISM:		volsOut.push_back(NewGridObject<Prism>(pGrid, vd)); 		break;
+			case GOID_HEXAHEDRON:	volsOut.push_back(NewGridObject<Hexahedron>(pGrid, vd));	break;
+			case GOID_OCTAHEDRON:	volsOut.push_back(NewGridObject<Octahedron>(pGrid, vd));	break;
 		}
 	}
 }
@@ -168,7 +169,8 @@ static bool Refine(std::vector<Volume*>& vNewVolumesOut,
 					Vertex** vrts,
 					int (*funcRefine)(int*, int*, bool&, vector3*, bool*),
 					vector3* corners = NULL,
-					bool* isSnapPoint = NULL)
+					bool* isSnapPoint = NULL,
+					Grid* pGrid = NULL)
 {
 	vNewVolumesOut.clear();
 	*ppNewVertexOut = NULL;
@@ -216,7 +218,7 @@ static bool Refine(std::vector<Volume*>& vNewVolumesOut,
 	if(centerVrtRequired){
 		if(!newVolumeVertex)
 			newVolumeVertex = static_cast<Vertex*>(
-								prototypeVertex.create_empty_instance());
+								prototypeVertex.create_empty_instance(pGrid));
 		*ppNewVertexOut = newVolumeVertex;
 		allVrts[allVrtsSize - 1] = *ppNewVertexOut;
 	}
@@ -236,7 +238,8 @@ static bool Refine(std::vector<Volume*>& vNewVolumesOut,
 	UG_LOG(endl);
 */
 
-	CreateVolumesFromElementIndexList(vNewVolumesOut, newElemInds, numElemInds, allVrts);
+	CreateVolumesFromElementIndexList(vNewVolumesOut, newElemInds, numElemInds,
+									  allVrts, pGrid);
 	// for(int i = 0; i < numElemInds;){
 	// 	int gridObjectID = newElemInds[i++];
 	// 	size_t num = GridObjectInfo::num_vertices(gridObjectID);
@@ -433,7 +436,8 @@ bool Tetrahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices,
 							vector3* corners,
-							bool* isSnapPoint)
+							bool* isSnapPoint,
+							Grid* pGrid)
 {
 //	handle substitute vertices.
 	Vertex** vrts;
@@ -446,7 +450,7 @@ bool Tetrahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 									newEdgeVertices, newFaceVertices,
 									newVolumeVertex, prototypeVertex,
 									vrts, tet_rules::Refine, corners,
-									isSnapPoint);
+									isSnapPoint, pGrid);
 }
 
 
@@ -680,7 +684,8 @@ bool Hexahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 						const Vertex& prototypeVertex,
 						Vertex** pSubstituteVertices,
 						vector3* corners,
-						bool* isSnapPoint)
+						bool* isSnapPoint,
+						Grid* pGrid)
 {
 //	handle substitute vertices.
 	Vertex** vrts;
@@ -693,7 +698,7 @@ bool Hexahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 								   newEdgeVertices, newFaceVertices,
 								   newVolumeVertex, prototypeVertex,
 								   vrts, hex_rules::Refine, corners,
-								   isSnapPoint);
+								   isSnapPoint, pGrid);
 }
 
 bool Hexahedron::is_regular_ref_rule(int edgeMarks) const
@@ -970,7 +975,8 @@ bool Prism::refine(std::vector<Volume*>& vNewVolumesOut,
 					const Vertex& prototypeVertex,
 					Vertex** pSubstituteVertices,
 					vector3* corners,
-					bool* isSnapPoint)
+					bool* isSnapPoint,
+					Grid* pGrid)
 {
 //	handle substitute vertices.
 	Vertex** vrts;
@@ -983,7 +989,7 @@ bool Prism::refine(std::vector<Volume*>& vNewVolumesOut,
 							  newEdgeVertices, newFaceVertices,
 							  newVolumeVertex, prototypeVertex,
 							  vrts, prism_rules::Refine, corners,
-							  isSnapPoint);
+							  isSnapPoint, pGrid);
 }
 
 bool Prism::is_regular_ref_rule(int edgeMarks) const
@@ -1237,7 +1243,8 @@ bool Pyramid::refine(std::vector<Volume*>& vNewVolumesOut,
 						const Vertex& prototypeVertex,
 						Vertex** pSubstituteVertices,
 						vector3* corners,
-						bool* isSnapPoint)
+						bool* isSnapPoint,
+						Grid* pGrid)
 {
 //	handle substitute vertices.
 	Vertex** vrts;
@@ -1250,7 +1257,7 @@ bool Pyramid::refine(std::vector<Volume*>& vNewVolumesOut,
 									newEdgeVertices, newFaceVertices,
 									newVolumeVertex, prototypeVertex,
 									vrts, pyra_rules::Refine, corners,
-									isSnapPoint);
+									isSnapPoint, pGrid);
 }
 
 bool Pyramid::is_regular_ref_rule(int edgeMarks) const
@@ -1456,7 +1463,8 @@ bool Octahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices,
 							vector3* corners,
-							bool* isSnapPoint)
+							bool* isSnapPoint,
+							Grid* pGrid)
 {
 //	handle substitute vertices.
 	Vertex** vrts;
@@ -1469,7 +1477,7 @@ bool Octahedron::refine(std::vector<Volume*>& vNewVolumesOut,
 									newEdgeVertices, newFaceVertices,
 									newVolumeVertex, prototypeVertex,
 									vrts, oct_rules::Refine, corners,
-									isSnapPoint);
+									isSnapPoint, pGrid);
 }
 
 bool Octahedron::is_regular_ref_rule(int edgeMarks) const
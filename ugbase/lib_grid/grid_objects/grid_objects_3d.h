@@ -101,7 +101,7 @@ class UG_API Tetrahedron : public Volume
 		Tetrahedron(const TetrahedronDescriptor& td);
 		Tetrahedron(Vertex* v1, Vertex* v2, Vertex* v3, Vertex* v4);
 
-		virtual GridObject* create_empty_instance() const	{return new Tetrahedron;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<Tetrahedron>(pGrid);}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -144,7 +144,8 @@ class UG_API Tetrahedron : public Volume
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL);
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -238,7 +239,7 @@ class UG_API Hexahedron : public Volume
 		Hexahedron(Vertex* v1, Vertex* v2, Vertex* v3, Vertex* v4,
 					Vertex* v5, Vertex* v6, Vertex* v7, Vertex* v8);
 
-		virtual GridObject* create_empty_instance() const	{return new Hexahedron;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<Hexahedron>(pGrid);}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -281,7 +282,8 @@ class UG_API Hexahedron : public Volume
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL);
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -371,7 +373,7 @@ class UG_API Prism : public Volume
 		Prism(Vertex* v1, Vertex* v2, Vertex* v3,
 				Vertex* v4, Vertex* v5, Vertex* v6);
 
-		virtual GridObject* create_empty_instance() const	{return new Prism;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<Prism>(pGrid);}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -414,7 +416,8 @@ class UG_API Prism : public Volume
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL);
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -504,7 +507,7 @@ class UG_API Pyramid : public Volume
 		Pyramid(Vertex* v1, Vertex* v2, Vertex* v3,
 				Vertex* v4, Vertex* v5);
 
-		virtual GridObject* create_empty_instance() const	{return new Pyramid;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<Pyramid>(pGrid);}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -545,7 +548,8 @@ class UG_API Pyramid : public Volume
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL);
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -636,7 +640,7 @@ class UG_API Octahedron : public Volume
 		Octahedron(const OctahedronDescriptor& td);
 		Octahedron(Vertex* v1, Vertex* v2, Vertex* v3, Vertex* v4, Vertex* v5, Vertex* v6);
 
-		virtual GridObject* create_empty_instance() const	{return new Octahedron;}
+		virtual GridObject* create_empty_instance(Grid* pGrid = NULL) const	{return NewGridObject<Octahedron>(pGrid);}
 
 		virtual Vertex* vertex(size_t index) const	{return m_vertices[index];}
 		virtual ConstVertexArray vertices() const		{return m_vertices;}
@@ -679,7 +683,8 @@ class UG_API Octahedron : public Volume
 							const Vertex& prototypeVertex,
 							Vertex** pSubstituteVertices = NULL,
 							vector3* corners = NULL,
-							bool* isSnapPoint = NULL);
+							bool* isSnapPoint = NULL,
+							Grid* pGrid = NULL);
 
 		virtual bool is_regular_ref_rule(int edgeMarks) const;
 
@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include "partitioner_multilevel_graph.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/util/parallel_dual_graph_impl.hpp"
+#include "lib_grid/parallelization/parallelization_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_MultilevelGraph<TElem, dim>::
+Partitioner_MultilevelGraph() :
+	m_mg(NULL),
+	m_edgeCut(0)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_MultilevelGraph<TElem, dim>::
+~Partitioner_MultilevelGraph()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> >)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_communication_weights(SPCommunicationWeights commWeights)
+{
+	m_commWeights = commWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_partition_pre_processor(SPPartitionPreProcessor ppp)
+{
+	m_partitionPreProcessor = ppp;
+}
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+set_partition_post_processor(SPPartitionPostProcessor ppp)
+{
+	m_partitionPostProcessor = ppp;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_MultilevelGraph<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_MultilevelGraph<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_MultilevelGraph<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_MultilevelGraph<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_MultilevelGraph<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_MultilevelGraph. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+	ANumber aWeight;
+	mg.attach_to<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_starts(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->init_post_processing(m_mg, m_sh.get());
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+	m_edgeCut = 0;
+
+//	iterate over procHierarchy levels and perform partitioning for all
+//	hierarchy-sections which contain levels higher than baseLvl
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(m_balanceWeights->has_level_offsets()){
+			if(mg.top_level() < procH->grid_base_level(hlevel)){
+			//	see Partitioner_DynamicBisection::partition
+				if((hlevel == 0) ||
+					((int)procH->num_global_procs_involved(hlevel - 1) != numProcs))
+				{
+					UG_LOG("Partitioner_MultilevelGraph: Ignoring hierarchy level "
+						<< hlevel << " since it doesn't contain any elements yet\n");
+					m_problemsOccurred = true;
+				}
+				continue;
+			}
+		}
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com = procH->global_proc_com(hlevel);
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+
+		partition_level(numProcs, minLvl, maxLvl, partitionLvl, aWeight, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	mg.detach_from<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_done(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->partitioning_done();
+
+//	the edge cut is only known on the processes which partitioned a graph
+	pcl::ProcessCommunicator globCom;
+	m_edgeCut = globCom.allreduce(m_edgeCut, PCL_RO_SUM);
+
+	if(verbose()){
+		UG_LOG("Partitioner_MultilevelGraph: weighted edge cut: " << m_edgeCut << "\n");
+	}
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+partition_level(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+				ANumber aWeight, pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	UG_COND_THROW(!pdgm, "Partitioner_MultilevelGraph can only operate on parallel multigrids.");
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	gather_weights(partitionLvl, minLvl, maxLvl, aWeight);
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+
+	if(!com.empty()){
+		ParallelDualGraph<elem_t, int> graph(&mg);
+		graph.generate_graph(partitionLvl, com);
+		pcl::ProcessCommunicator graphCom = graph.process_communicator();
+
+		if(!graphCom.empty()){
+		//	collect the local part of the graph. Adjacent vertices are already
+		//	given by their global indices.
+			const int numVrts = graph.num_graph_vertices();
+			const int numEdges = graph.num_graph_edges();
+			const int* adjStruct = graph.adjacency_map_structure();
+
+			vector<int> degree(numVrts), adj(numEdges);
+			vector<number> vrtWeight(numVrts), edgeWeight(numEdges);
+			for(int i = 0; i < numVrts; ++i){
+				degree[i] = adjStruct[i+1] - adjStruct[i];
+				vrtWeight[i] = aaWeight[graph.get_element(i)];
+			}
+
+			if(numEdges > 0){
+				const int* adjMap = graph.adjacency_map();
+				for(int i = 0; i < numEdges; ++i){
+					adj[i] = adjMap[i];
+					side_t* conn = graph.get_connection(i);
+					if(m_commWeights.valid() && m_commWeights->reweigh(conn))
+						edgeWeight[i] = m_commWeights->get_weight(conn);
+					else
+						edgeWeight[i] = 1;
+				}
+			}
+
+		//	agglomerate the graph on the first process and partition it there
+			const int rootProc = 0;
+			const bool isRoot = (graphCom.get_local_proc_id() == rootProc);
+
+			WeightedGraph g;
+			vector<int> allDegrees;
+			graphCom.gatherv(allDegrees, degree, rootProc);
+			graphCom.gatherv(g.adj, adj, rootProc);
+			graphCom.gatherv(g.vrtWeight, vrtWeight, rootProc);
+			graphCom.gatherv(g.edgeWeight, edgeWeight, rootProc);
+
+			vector<int> parts;
+			if(isRoot){
+				g.adjStart.resize(allDegrees.size() + 1);
+				g.adjStart[0] = 0;
+				for(size_t i = 0; i < allDegrees.size(); ++i)
+					g.adjStart[i+1] = g.adjStart[i] + allDegrees[i];
+
+			//	if no weights are available, all elements are weighted equally
+				if(g.total_weight() <= 0)
+					g.vrtWeight.assign(g.vrtWeight.size(), 1);
+
+				m_edgeCut += m_graphPartitioner.partition(parts, g, numTargetProcs);
+			}
+
+		//	send the partitions back to the processes which hold the elements
+			const int* offsets = graph.parallel_offset_map();
+			vector<int> localParts(numVrts);
+			if(isRoot){
+				for(int i = 0; i < numVrts; ++i)
+					localParts[i] = parts[i];
+
+				const int numSends = (int)graphCom.size() - 1;
+				vector<int> segSizes(numSends), sendTo(numSends);
+				for(int i = 0; i < numSends; ++i){
+					segSizes[i] = (offsets[i+2] - offsets[i+1]) * sizeof(int);
+					sendTo[i] = i + 1;
+				}
+				graphCom.distribute_data(NULL, NULL, NULL, 0,
+										 GetDataPtr(parts) + offsets[1],
+										 GetDataPtr(segSizes), GetDataPtr(sendTo),
+										 numSends, 3917);
+			}
+			else{
+				int recvSize = numVrts * sizeof(int);
+				int recvFrom = rootProc;
+				graphCom.distribute_data(GetDataPtr(localParts), &recvSize,
+										 &recvFrom, 1, NULL, NULL, NULL, 0, 3917);
+			}
+
+			for(int i = 0; i < numVrts; ++i)
+				sh.assign_subset(graph.get_element(i), localParts[i]);
+		}
+	}
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->post_process(partitionLvl);
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		copy_partitions_to_children(sh, partitionLvl);
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else{
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_MultilevelGraph<TElem, dim>::
+gather_weights(int baseLvl, int minLvl, int topLvl, ANumber aWeight)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+	ComPol_CopyAttachment<layout_t, ANumber> compolCopy(mg, aWeight);
+
+	for(int lvl = topLvl; lvl >= baseLvl; --lvl){
+		for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			number w = 0;
+			size_t numChildren = 0;
+			if(lvl < topLvl)
+				numChildren = mg.num_children<elem_t>(e);
+
+			if(numChildren == 0){
+				if((lvl >= minLvl) && ((!pdgm) || (!pdgm->is_ghost(e)))){
+					if(bw.has_level_offsets() && bw.consider_in_level_above(e))
+						w = bw.get_refined_weight(e);
+					else
+						w = bw.get_weight(e);
+				}
+			}
+			else{
+				for(size_t i = 0; i < numChildren; ++i)
+					w += aaWeight[mg.get_child<elem_t>(e, i)];
+			}
+			aaWeight[e] = w;
+		}
+
+	//	copy from v-slaves to vmasters, so that the weights are available
+	//	in the parents on the next lower level
+		if(pdgm && (lvl > baseLvl)){
+			GridLayoutMap& glm = pdgm->grid_layout_map();
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl),
+									 compolCopy);
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl),
+										compolCopy);
+			m_intfcCom.communicate();
+		}
+	}
+}
+
+
+template class Partitioner_MultilevelGraph<Edge, 1>;
+template class Partitioner_MultilevelGraph<Edge, 2>;
+template class Partitioner_MultilevelGraph<Face, 2>;
+template class Partitioner_MultilevelGraph<Edge, 3>;
+template class Partitioner_MultilevelGraph<Face, 3>;
+template class Partitioner_MultilevelGraph<Volume, 3>;
+
+}// end of namespace
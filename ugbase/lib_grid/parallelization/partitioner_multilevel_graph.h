@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__partitioner_multilevel_graph__
+#define __H__UG__partitioner_multilevel_graph__
+
+#include <vector>
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "lib_grid/algorithms/graph/graph_partitioning.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Multilevel graph partitioner operating on the parallel dual graph
+/**	The parallel dual graph of the partition level is created, where elements
+ * are the vertices of the graph and sides are its edges. The graph is gathered
+ * on the first process which holds elements and partitioned there by a
+ * MultilevelGraphPartitioner (heavy-edge coarsening, greedy initial bisection
+ * and Fiduccia-Mattheyses refinement). The resulting partitions are sent back
+ * to the processes which hold the elements.
+ *
+ * Vertex weights are given by the balance weights of the leaf-descendants of
+ * an element. Edge weights are obtained from the communication weights
+ * (if specified), so that the weighted size of the partition interfaces
+ * is minimized. Edges default to weight 1.
+ *
+ * Since the graph is agglomerated on a single process, the partitioner is
+ * intended for moderate numbers of elements on the partition level, e.g.
+ * for the distribution of a coarse grid in a process hierarchy.
+ */
+template <class TElem, int dim>
+class Partitioner_MultilevelGraph : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef typename TElem::side					side_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_MultilevelGraph();
+		virtual ~Partitioner_MultilevelGraph();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		virtual void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	tolerated relative imbalance of the partitions. 0.03 by default.
+		void set_imbalance_tolerance(number tol)	{m_graphPartitioner.set_imbalance_tolerance(tol);}
+		number imbalance_tolerance() const			{return m_graphPartitioner.imbalance_tolerance();}
+
+	///	maximal number of refinement passes per graph level. 8 by default.
+		void set_num_refinement_passes(int num)		{m_graphPartitioner.set_num_refinement_passes(num);}
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+		virtual void set_communication_weights(SPCommunicationWeights commWeights);
+
+		virtual void set_partition_pre_processor(SPPartitionPreProcessor ppp);
+		virtual void set_partition_post_processor(SPPartitionPostProcessor ppp);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_communication_weights() const		{return true;}
+		virtual bool supports_repartitioning() const			{return false;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	///	weight of the cut edges of the last partitioning (summed over all hierarchy levels)
+		number edge_cut() const							{return m_edgeCut;}
+
+	private:
+		void partition_level(int numTargetProcs, int minLvl, int maxLvl,
+							 int partitionLvl, ANumber aWeight,
+							 pcl::ProcessCommunicator com);
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+	///	accumulates the weights of all leaf-descendants in the elements of baseLvl
+	/**	Only descendants in the levels minLvl to topLvl are considered.*/
+		void gather_weights(int baseLvl, int minLvl, int topLvl, ANumber aWeight);
+
+		MultiGrid*								m_mg;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+
+		SPBalanceWeights						m_balanceWeights;
+		SPCommunicationWeights					m_commWeights;
+		SPPartitionPreProcessor					m_partitionPreProcessor;
+		SPPartitionPostProcessor				m_partitionPostProcessor;
+
+		MultilevelGraphPartitioner				m_graphPartitioner;
+		number									m_edgeCut;
+};
+
+///	\}
+
+}// end of namespace
+
+#endif
@@ -0,0 +1,807 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "partitioner_sfc.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_copy_attachment.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_SFC<TElem, dim>::
+Partitioner_SFC() :
+	m_mg(NULL),
+	m_curve(HILBERT),
+	m_tolerance(0.05),
+	m_repartitioning(true),
+	m_migrationWeight(0),
+	m_numMigratingElems(0)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_SFC<TElem, dim>::
+~Partitioner_SFC()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+	m_aPos = aPos;
+	m_aaPos.access(*m_mg, m_aPos);
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_curve(const std::string& name)
+{
+	if(name == "hilbert")
+		m_curve = HILBERT;
+	else if(name == "morton")
+		m_curve = MORTON;
+	else{
+		UG_THROW("Partitioner_SFC: Unknown curve '" << name << "'. "
+				 "Valid curves are 'hilbert' and 'morton'.");
+	}
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_partition_pre_processor(SPPartitionPreProcessor ppp)
+{
+	m_partitionPreProcessor = ppp;
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_partition_post_processor(SPPartitionPostProcessor ppp)
+{
+	m_partitionPostProcessor = ppp;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SFC<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SFC<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_SFC<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_SFC<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_SFC<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_SFC. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+	ANumber aWeight;
+	mg.attach_to<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_starts(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->init_post_processing(m_mg, m_sh.get());
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+	m_migrationWeight = 0;
+	m_numMigratingElems = 0;
+
+//	iterate over procHierarchy levels and perform partitioning for all
+//	hierarchy-sections which contain levels higher than baseLvl
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(m_balanceWeights->has_level_offsets()){
+			if(mg.top_level() < procH->grid_base_level(hlevel)){
+			//	see Partitioner_DynamicBisection::partition
+				if((hlevel == 0) ||
+					((int)procH->num_global_procs_involved(hlevel - 1) != numProcs))
+				{
+					UG_LOG("Partitioner_SFC: Ignoring hierarchy level "
+						<< hlevel << " since it doesn't contain any elements yet\n");
+					m_problemsOccurred = true;
+				}
+				continue;
+			}
+		}
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com = procH->global_proc_com(hlevel);
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+
+		partition_level(numProcs, minLvl, maxLvl, partitionLvl, aWeight, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	mg.detach_from<elem_t>(aWeight);
+
+	if(m_partitionPreProcessor.valid())
+		m_partitionPreProcessor->partitioning_done(m_mg, this);
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->partitioning_done();
+
+	pcl::ProcessCommunicator globCom;
+	m_migrationWeight = globCom.allreduce(m_migrationWeight, PCL_RO_SUM);
+	count_migrating_elements(baseLvl);
+
+	if(verbose()){
+		UG_LOG("Partitioner_SFC: expected migration: " << m_numMigratingElems
+			   << " elements with total weight " << m_migrationWeight << "\n");
+	}
+
+	PCL_DEBUG_BARRIER_ALL();
+
+//	if the current distribution is kept, no redistribution is required
+	if(m_repartitioning)
+		return m_numMigratingElems > 0;
+	return true;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+partition_level(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+				ANumber aWeight, pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	gather_weights(partitionLvl, minLvl, maxLvl, aWeight);
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+
+//	partitioning is only performed on elements which are no ghosts
+	vector<CurveEntry> entries;
+	entries.reserve(mg.num<elem_t>(partitionLvl));
+	for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+		eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+	{
+		elem_t* elem = *eiter;
+		if((!pdgm) || (!pdgm->is_ghost(elem))){
+			CurveEntry e;
+			e.key = 0;
+			e.weight = aaWeight[elem];
+			e.elem = elem;
+			entries.push_back(e);
+		}
+	}
+
+	if(!com.empty()){
+		const int localProc = pcl::ProcRank();
+
+		number localWeight = 0;
+		for(size_t i = 0; i < entries.size(); ++i)
+			localWeight += entries[i].weight;
+		number totalWeight = com.allreduce(localWeight, PCL_RO_SUM);
+
+	//	if no weights are available, all elements are weighted equally
+		if(totalWeight <= 0){
+			for(size_t i = 0; i < entries.size(); ++i)
+				entries[i].weight = 1;
+			localWeight = (number)entries.size();
+			totalWeight = com.allreduce(localWeight, PCL_RO_SUM);
+		}
+
+	//	check whether the current distribution can be kept. This is only
+	//	possible if all elements are located on target processes.
+		bool keepDistribution = false;
+		if(m_repartitioning){
+			int highestOwner = com.allreduce(entries.empty() ? -1 : localProc, PCL_RO_MAX);
+			number maxWeight = com.allreduce(localWeight, PCL_RO_MAX);
+			keepDistribution = (highestOwner < numTargetProcs)
+				&& (maxWeight <= (1. + m_tolerance) * totalWeight / (number)numTargetProcs);
+		}
+
+		vector<int> target(entries.size(), localProc);
+		if(!keepDistribution){
+			sort_along_curve(entries, com);
+
+			vector<int> seg;
+			cut_curve(seg, entries, numTargetProcs, com);
+
+			vector<int> segToProc;
+			if(m_repartitioning)
+				map_segments_to_procs(segToProc, entries, seg, numTargetProcs, com);
+			else{
+				segToProc.resize(numTargetProcs);
+				for(int i = 0; i < numTargetProcs; ++i)
+					segToProc[i] = i;
+			}
+
+			for(size_t i = 0; i < entries.size(); ++i)
+				target[i] = segToProc[seg[i]];
+		}
+
+		for(size_t i = 0; i < entries.size(); ++i){
+			sh.assign_subset(entries[i].elem, target[i]);
+			if(target[i] != localProc)
+				m_migrationWeight += entries[i].weight;
+		}
+	}
+
+	if(m_partitionPostProcessor.valid())
+		m_partitionPostProcessor->post_process(partitionLvl);
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		copy_partitions_to_children(sh, partitionLvl);
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+sort_along_curve(std::vector<CurveEntry>& entries, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+//	global bounding box of the element centers
+	vector<vector_t> centers(entries.size());
+	vector<number> locMin(dim, numeric_limits<number>::max());
+	vector<number> locMax(dim, -numeric_limits<number>::max());
+	for(size_t i = 0; i < entries.size(); ++i){
+		centers[i] = CalculateCenter(entries[i].elem, m_aaPos);
+		for(int d = 0; d < dim; ++d){
+			locMin[d] = min(locMin[d], centers[i][d]);
+			locMax[d] = max(locMax[d], centers[i][d]);
+		}
+	}
+
+	vector<number> boxMin, boxMax;
+	com.allreduce(locMin, boxMin, PCL_RO_MIN);
+	com.allreduce(locMax, boxMax, PCL_RO_MAX);
+
+//	the coordinates are mapped to integers with 'bits' bits, so that the
+//	key of a point fits into 63 bits.
+	const int bits = 63 / dim;
+	const uint64 maxCoord = ((uint64)1 << bits) - 1;
+
+	for(size_t i = 0; i < entries.size(); ++i){
+		uint64 coords[dim];
+		for(int d = 0; d < dim; ++d){
+			number ext = boxMax[d] - boxMin[d];
+			number t = 0;
+			if(ext > 0)
+				t = (centers[i][d] - boxMin[d]) / ext;
+			if(t >= 1)
+				coords[d] = maxCoord;
+			else if(t <= 0)
+				coords[d] = 0;
+			else
+				coords[d] = min(maxCoord, (uint64)(t * (number)maxCoord));
+		}
+		entries[i].key = curve_key(coords, bits);
+	}
+
+	sort(entries.begin(), entries.end());
+}
+
+
+template <class TElem, int dim>
+uint64 Partitioner_SFC<TElem, dim>::
+curve_key(uint64* x, int bits) const
+{
+//	transform the coordinates to the transposed hilbert index
+//	(J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004)
+	if((m_curve == HILBERT) && (dim > 1)){
+		const uint64 m = (uint64)1 << (bits - 1);
+
+	//	inverse undo
+		for(uint64 q = m; q > 1; q >>= 1){
+			const uint64 p = q - 1;
+			for(int i = 0; i < dim; ++i){
+				if(x[i] & q)
+					x[0] ^= p;
+				else{
+					const uint64 t = (x[0] ^ x[i]) & p;
+					x[0] ^= t;
+					x[i] ^= t;
+				}
+			}
+		}
+
+	//	gray encode
+		for(int i = 1; i < dim; ++i)
+			x[i] ^= x[i-1];
+		uint64 t = 0;
+		for(uint64 q = m; q > 1; q >>= 1){
+			if(x[dim-1] & q)
+				t ^= q - 1;
+		}
+		for(int i = 0; i < dim; ++i)
+			x[i] ^= t;
+	}
+
+//	interleave the bits (this directly gives the morton key)
+	uint64 key = 0;
+	for(int b = bits - 1; b >= 0; --b){
+		for(int i = 0; i < dim; ++i)
+			key = (key << 1) | ((x[i] >> b) & 1);
+	}
+	return key;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+cut_curve(std::vector<int>& segOut, const std::vector<CurveEntry>& entries,
+		  int numSegments, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+	segOut.assign(entries.size(), 0);
+	const int numCuts = numSegments - 1;
+	if(numCuts <= 0)
+		return;
+
+//	keys and prefix sums of the weights of the local entries
+	vector<uint64> keys(entries.size());
+	vector<number> prefix(entries.size() + 1, 0);
+	for(size_t i = 0; i < entries.size(); ++i){
+		keys[i] = entries[i].key;
+		prefix[i + 1] = prefix[i] + entries[i].weight;
+	}
+
+	number totalWeight = com.allreduce(prefix.back(), PCL_RO_SUM);
+
+//	cut i is the smallest key k for which the global weight of all entries
+//	with keys <= k reaches (i+1)/numSegments of the total weight. All cuts
+//	are determined simultaneously by a bisection of the key range.
+	const uint64 maxKey = ((uint64)1 << ((63 / dim) * dim)) - 1;
+	vector<uint64> lo(numCuts, 0), hi(numCuts, maxKey);
+	vector<number> targetWeight(numCuts);
+	for(int i = 0; i < numCuts; ++i)
+		targetWeight[i] = totalWeight * (number)(i + 1) / (number)numSegments;
+
+	vector<number> locW(numCuts), globW;
+	vector<uint64> mid(numCuts);
+	while(true){
+		bool done = true;
+		for(int i = 0; i < numCuts; ++i){
+			if(lo[i] < hi[i])
+				done = false;
+			mid[i] = lo[i] + (hi[i] - lo[i]) / 2;
+			locW[i] = prefix[upper_bound(keys.begin(), keys.end(), mid[i]) - keys.begin()];
+		}
+
+		if(done)
+			break;
+
+		com.allreduce(locW, globW, PCL_RO_SUM);
+		for(int i = 0; i < numCuts; ++i){
+			if(lo[i] == hi[i])
+				continue;
+			if(globW[i] >= targetWeight[i])
+				hi[i] = mid[i];
+			else
+				lo[i] = mid[i] + 1;
+		}
+	}
+
+//	the cut may also be placed directly before the found key, if the
+//	resulting weight is closer to the target weight.
+	vector<number> locW2(2 * numCuts);
+	for(int i = 0; i < numCuts; ++i){
+		locW2[2*i] = prefix[upper_bound(keys.begin(), keys.end(), lo[i]) - keys.begin()];
+		locW2[2*i + 1] = prefix[lower_bound(keys.begin(), keys.end(), lo[i]) - keys.begin()];
+	}
+	com.allreduce(locW2, globW, PCL_RO_SUM);
+
+	vector<uint64> cuts(numCuts);
+	for(int i = 0; i < numCuts; ++i){
+		cuts[i] = lo[i];
+		if((lo[i] > 0) && (fabs(globW[2*i + 1] - targetWeight[i])
+							< fabs(globW[2*i] - targetWeight[i])))
+		{
+			cuts[i] = lo[i] - 1;
+		}
+		if((i > 0) && (cuts[i] < cuts[i-1]))
+			cuts[i] = cuts[i-1];
+	}
+
+//	the segment of an entry is the number of cuts in front of its key
+	for(size_t i = 0; i < entries.size(); ++i)
+		segOut[i] = (int)(lower_bound(cuts.begin(), cuts.end(), keys[i]) - cuts.begin());
+}
+
+
+template <class TElem, int dim>
+bool Partitioner_SFC<TElem, dim>::
+cmp_overlap(const Overlap& o1, const Overlap& o2)
+{
+	if(o1.weight != o2.weight)
+		return o1.weight > o2.weight;
+	if(o1.proc != o2.proc)
+		return o1.proc < o2.proc;
+	return o1.seg < o2.seg;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+map_segments_to_procs(std::vector<int>& segToProcOut,
+					  const std::vector<CurveEntry>& entries,
+					  const std::vector<int>& seg, int numSegments,
+					  pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+//	weights of the segments which are currently located on this process.
+//	Since the entries are sorted along the curve, the segments are contiguous.
+	const int localProc = pcl::ProcRank();
+	vector<Overlap> localOverlaps;
+	for(size_t i = 0; i < entries.size(); ++i){
+		if(localOverlaps.empty() || (localOverlaps.back().seg != seg[i])){
+			Overlap o;
+			o.proc = localProc;
+			o.seg = seg[i];
+			o.weight = 0;
+			localOverlaps.push_back(o);
+		}
+		localOverlaps.back().weight += entries[i].weight;
+	}
+
+	vector<Overlap> overlaps;
+	com.allgatherv(overlaps, localOverlaps);
+
+//	greedily assign the segments with the largest overlaps first. This is
+//	done redundantly on all processes, which leads to the same results.
+	sort(overlaps.begin(), overlaps.end(), cmp_overlap);
+
+	segToProcOut.assign(numSegments, -1);
+	vector<int> procToSeg(numSegments, -1);
+	for(size_t i = 0; i < overlaps.size(); ++i){
+		const Overlap& o = overlaps[i];
+		if((o.proc < numSegments) && (segToProcOut[o.seg] == -1)
+			&& (procToSeg[o.proc] == -1))
+		{
+			segToProcOut[o.seg] = o.proc;
+			procToSeg[o.proc] = o.seg;
+		}
+	}
+
+//	remaining segments are assigned to the remaining processes
+	int nextProc = 0;
+	for(int i = 0; i < numSegments; ++i){
+		if(segToProcOut[i] != -1)
+			continue;
+		while(procToSeg[nextProc] != -1)
+			++nextProc;
+		segToProcOut[i] = nextProc;
+		procToSeg[nextProc] = i;
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+gather_weights(int baseLvl, int minLvl, int topLvl, ANumber aWeight)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	Grid::AttachmentAccessor<elem_t, ANumber> aaWeight(mg, aWeight);
+	ComPol_CopyAttachment<layout_t, ANumber> compolCopy(mg, aWeight);
+
+	for(int lvl = topLvl; lvl >= baseLvl; --lvl){
+		for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			number w = 0;
+			size_t numChildren = 0;
+			if(lvl < topLvl)
+				numChildren = mg.num_children<elem_t>(e);
+
+			if(numChildren == 0){
+				if((lvl >= minLvl) && ((!pdgm) || (!pdgm->is_ghost(e)))){
+					if(bw.has_level_offsets() && bw.consider_in_level_above(e))
+						w = bw.get_refined_weight(e);
+					else
+						w = bw.get_weight(e);
+				}
+			}
+			else{
+				for(size_t i = 0; i < numChildren; ++i)
+					w += aaWeight[mg.get_child<elem_t>(e, i)];
+			}
+			aaWeight[e] = w;
+		}
+
+	//	copy from v-slaves to vmasters, so that the weights are available
+	//	in the parents on the next lower level
+		if(pdgm && (lvl > baseLvl)){
+			GridLayoutMap& glm = pdgm->grid_layout_map();
+			if(glm.has_layout<elem_t>(INT_V_SLAVE))
+				m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl),
+									 compolCopy);
+			if(glm.has_layout<elem_t>(INT_V_MASTER))
+				m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl),
+										compolCopy);
+			m_intfcCom.communicate();
+		}
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+count_migrating_elements(size_t baseLvl)
+{
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+
+	MultiGrid& mg = *m_mg;
+	SubsetHandler& sh = *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+	const int localProc = pcl::ProcRank();
+
+	size_t numMigrating = 0;
+	for(size_t lvl = baseLvl; lvl < mg.num_levels(); ++lvl){
+		for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+		{
+			elem_t* e = *iter;
+			if(pdgm && pdgm->is_ghost(e))
+				continue;
+			int si = sh.get_subset_index(e);
+			if((si >= 0) && (si != localProc))
+				++numMigrating;
+		}
+	}
+
+	pcl::ProcessCommunicator globCom;
+	m_numMigratingElems = globCom.allreduce(numMigrating, PCL_RO_SUM);
+}
+
+
+template class Partitioner_SFC<Edge, 1>;
+template class Partitioner_SFC<Edge, 2>;
+template class Partitioner_SFC<Face, 2>;
+template class Partitioner_SFC<Edge, 3>;
+template class Partitioner_SFC<Face, 3>;
+template class Partitioner_SFC<Volume, 3>;
+
+}// end of namespace
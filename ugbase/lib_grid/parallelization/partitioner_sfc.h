@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026:  G-CSC, Goethe University Frankfurt
+ * Author: Sebastian Reiter
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__partitioner_sfc__
+#define __H__UG__partitioner_sfc__
+
+#include <string>
+#include <vector>
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Parallel space-filling-curve partitioner
+/**	The partitioner sorts the elements of the partition level along a Hilbert-
+ * or a Morton-curve through the bounding box of the grid and cuts the curve
+ * into segments of equal weight, one for each target process. The weight of
+ * an element is given by the balance weights of its leaf-descendants (or of
+ * itself, if it has no children). Only a few global reductions are required,
+ * so that the partitioner is well suited for frequent rebalancing of
+ * adaptive grids.
+ *
+ * If repartitioning is enabled (default), the current distribution is
+ * considered:
+ *	- if the load of all processes differs from the average load by not more
+ *	  than the tolerance, all elements are kept on their current process and
+ *	  partition returns false (no redistribution required).
+ *	- otherwise the new curve segments are assigned to the processes in a way
+ *	  that maximizes the weight which stays on its current process.
+ *
+ * The expected migration volume of the last partitioning can be queried
+ * through expected_migration_weight and num_migrating_elements.
+ *
+ * The partitioner can be used inside a LoadBalancer or separately. It can
+ * operate on serial and parallel multigrids.
+ */
+template <class TElem, int dim>
+class Partitioner_SFC : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef MathVector<dim>							vector_t;
+		typedef Attachment<vector_t>					apos_t;
+		typedef Grid::VertexAttachmentAccessor<apos_t>	aapos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+	///	curves which can be used for the ordering of elements
+		enum CurveType{
+			HILBERT,
+			MORTON
+		};
+
+		Partitioner_SFC();
+		virtual ~Partitioner_SFC();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		virtual void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	sets the curve used for the ordering of elements ('hilbert' or 'morton')
+	/**	'hilbert' by default. Hilbert-curves lead to more compact partitions
+	 * while Morton-keys are slightly cheaper to compute.*/
+		void set_curve(const std::string& name);
+		CurveType curve() const							{return m_curve;}
+
+	///	sets the tolerated relative deviation of the process loads from the average
+	/**	If repartitioning is enabled and no process load exceeds (1 + tol)
+	 * times the average load, the current distribution is kept.
+	 * 0.05 by default.*/
+		void set_tolerance(number tol)					{m_tolerance = tol;}
+		number tolerance() const						{return m_tolerance;}
+
+	///	enables consideration of the current distribution during partitioning
+	/**	enabled by default.*/
+		void enable_repartitioning(bool enable)			{m_repartitioning = enable;}
+		bool repartitioning_enabled() const				{return m_repartitioning;}
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+
+		virtual void set_partition_pre_processor(SPPartitionPreProcessor ppp);
+		virtual void set_partition_post_processor(SPPartitionPostProcessor ppp);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_connection_weights() const		{return false;}
+		virtual bool supports_repartitioning() const			{return m_repartitioning;}
+
+	/**	returns false if the current distribution was kept for all elements.
+	 * In this case no redistribution is necessary.*/
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	///	global weight of the elements which are assigned to a different process
+	/**	The weight of an element is the accumulated weight which is used
+	 * for balancing. Updated during partition.*/
+		number expected_migration_weight() const		{return m_migrationWeight;}
+
+	///	global number of elements which are assigned to a different process
+	/**	Updated during partition.*/
+		size_t num_migrating_elements() const			{return m_numMigratingElems;}
+
+	private:
+		struct CurveEntry{
+			uint64	key;
+			number	weight;
+			elem_t*	elem;
+
+			bool operator<(const CurveEntry& e) const	{return key < e.key;}
+		};
+
+	///	weight of the curve segment 'seg' which is currently located on 'proc'
+		struct Overlap{
+			int		proc;
+			int		seg;
+			number	weight;
+		};
+
+		static bool cmp_overlap(const Overlap& o1, const Overlap& o2);
+
+		void partition_level(int numTargetProcs, int minLvl, int maxLvl,
+							 int partitionLvl, ANumber aWeight,
+							 pcl::ProcessCommunicator com);
+
+	///	calculates the keys of the given elements and sorts them along the curve
+		void sort_along_curve(std::vector<CurveEntry>& entries,
+							  pcl::ProcessCommunicator& com);
+
+	///	cuts the sorted curve into numSegments segments of (nearly) equal weight
+	/**	segOut[i] contains the segment of entries[i].*/
+		void cut_curve(std::vector<int>& segOut,
+					   const std::vector<CurveEntry>& entries,
+					   int numSegments, pcl::ProcessCommunicator& com);
+
+	///	assigns the segments to processes such that migration is minimized
+		void map_segments_to_procs(std::vector<int>& segToProcOut,
+								   const std::vector<CurveEntry>& entries,
+								   const std::vector<int>& seg, int numSegments,
+								   pcl::ProcessCommunicator& com);
+
+	///	returns the curve-key of a point with integer coordinates
+		uint64 curve_key(uint64* coords, int bits) const;
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+	///	accumulates the weights of all leaf-descendants in the elements of baseLvl
+	/**	Only descendants in the levels minLvl to topLvl are considered.*/
+		void gather_weights(int baseLvl, int minLvl, int topLvl, ANumber aWeight);
+
+	///	counts the elements in levels baseLvl and above that change their process
+	/**	Levels below baseLvl are not partitioned and therefore not considered.*/
+		void count_migrating_elements(size_t baseLvl);
+
+		MultiGrid*								m_mg;
+		apos_t									m_aPos;
+		aapos_t									m_aaPos;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+
+		SPBalanceWeights						m_balanceWeights;
+		SPPartitionPreProcessor					m_partitionPreProcessor;
+		SPPartitionPostProcessor				m_partitionPostProcessor;
+
+		CurveType	m_curve;
+		number		m_tolerance;
+		bool		m_repartitioning;
+
+		number		m_migrationWeight;
+		size_t		m_numMigratingElems;
+};
+
+///	\}
+
+}// end of namespace
+
+#endif
@@ -319,7 +319,7 @@ void GlobalMultiGridRefiner::perform_refinement()
 		substituteVrts[0] = mg.get_child_vertex(e->vertex(0));
 		substituteVrts[1] = mg.get_child_vertex(e->vertex(1));
 
-		e->refine(vEdges, nVrt, substituteVrts);
+		e->refine(vEdges, nVrt, substituteVrts, &mg);
 		assert((vEdges.size() == 2) && "RegularEdge refine produced wrong number of edges.");
 		mg.register_element(vEdges[0], e);
 		mg.register_element(vEdges[1], e);
@@ -350,7 +350,7 @@ void GlobalMultiGridRefiner::perform_refinement()
 
 		//GMGR_PROFILE(GMGR_Refine_CreatingFaces);
 		Vertex* newVrt;
-		if(f->refine(vFaces, &newVrt, &vEdgeVrts.front(), NULL, &vVrts.front())){
+		if(f->refine(vFaces, &newVrt, &vEdgeVrts.front(), NULL, &vVrts.front(), -1, &mg)){
 		//	if a new vertex was generated, we have to register it
 			if(newVrt){
 				//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
@@ -428,7 +428,7 @@ void GlobalMultiGridRefiner::perform_refinement()
 
 		Vertex* newVrt;
 		if(v->refine(vVols, &newVrt, &vEdgeVrts.front(), &vFaceVrts.front(),
-					NULL, RegularVertex(), &vVrts.front(), pCorners)){
+					NULL, RegularVertex(), &vVrts.front(), pCorners, NULL, &mg)){
 		//	if a new vertex was generated, we have to register it
 			if(newVrt){
 				mg.register_element(newVrt, v);
@@ -1540,7 +1540,7 @@ refine_edge_with_normal_vertex(Edge* e, Vertex** newCornerVrts)
 
 //	split the edge
 	vector<Edge*> vEdges(2);
-	e->refine(vEdges, nVrt, newCornerVrts);
+	e->refine(vEdges, nVrt, newCornerVrts, &grid);
 	assert((vEdges.size() == 2) && "Edge::refine - produced wrong number of edges.");
 	grid.register_element(vEdges[0], e);
 	grid.register_element(vEdges[1], e);
@@ -1649,7 +1649,7 @@ refine_face_with_normal_vertex(Face* f, Vertex** newCornerVrts)
 	Vertex* nVrt = NULL;
 	/*f->refine_regular(vFaces, &nVrt, vNewEdgeVertices, NULL,
 					  RegularVertex(), newCornerVrts);*/
-	f->refine(vFaces, &nVrt, vNewEdgeVertices, NULL, newCornerVrts);
+	f->refine(vFaces, &nVrt, vNewEdgeVertices, NULL, newCornerVrts, -1, &grid);
 
 //	if a new vertex has been created during refine, then register it at the grid.
 	if(nVrt)
@@ -2111,7 +2111,8 @@ refine_volume_with_normal_vertex(Volume* v, Vertex** newCornerVrts)
 //	refine the volume and register new volumes at the grid.
 	Vertex* createdVrt = NULL;
 	v->refine(vVolumes, &createdVrt, &vNewEdgeVertices.front(),
-			  &vNewFaceVertices.front(), NULL, RegularVertex(), newCornerVrts, pCorners);
+			  &vNewFaceVertices.front(), NULL, RegularVertex(), newCornerVrts, pCorners,
+			  NULL, &grid);
 
 	if(createdVrt){
 	//	register the new vertex
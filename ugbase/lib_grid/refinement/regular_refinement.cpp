@@ -245,7 +245,7 @@ bool Refine(Grid& grid, Selector& sel, AInt& aInt,
 	newEdges.reserve(2);
 	for(size_t i = 0; i < edges.size(); ++i){
 		Edge* e = edges[i];
-		if(e->refine(newEdges, edgeVrts[i])){
+		if(e->refine(newEdges, edgeVrts[i], NULL, &grid)){
 			for(size_t j = 0; j < newEdges.size(); ++j)
 				grid.register_element(newEdges[j], e);
 		}
@@ -309,7 +309,8 @@ bool Refine(Grid& grid, Selector& sel, AInt& aInt,
 			}
 		}
 
-		if(f->refine(newFaces, &newVrt, &faceEdgeVrts.front(), NULL, NULL, snapPointIndex)){
+		if(f->refine(newFaces, &newVrt, &faceEdgeVrts.front(), NULL, NULL,
+					 snapPointIndex, &grid)){
 		//	if a new vertex was generated, we have to register it
 			if(newVrt){
 				grid.register_element(newVrt, f);
@@ -422,7 +423,7 @@ bool Refine(Grid& grid, Selector& sel, AInt& aInt,
 
 		if(v->refine(newVols, &newVrt, &volEdgeVrts.front(),
 					&volFaceVrts.front(), NULL, RegularVertex(), NULL,
-					pCorners, pIsSnapPoint))
+					pCorners, pIsSnapPoint, &grid))
 		{
 		//	if a new vertex was generated, we have to register it
 			if(newVrt){
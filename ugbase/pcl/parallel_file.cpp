@@ -30,12 +30,15 @@
  * GNU Lesser General Public License for more details.
  */
 
+#include "parallel_file.h"
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
 #include "common/log.h"
+#include <algorithm>
 #include <map>
 #include <string>
 #include <mpi.h>
+#include "pcl_methods.h"
 
 namespace pcl{
 
@@ -136,4 +139,103 @@ void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename,
 	//	UG_LOG("File read.\n");
 }
 
+
+
+///	maximal number of bytes in a single MPI-IO call (the count is an int)
+static const size_t MAX_MPI_IO_CHUNK = 1 << 30;
+
+OrderedParallelFileWrite::OrderedParallelFileWrite() :
+	m_fh(MPI_FILE_NULL), m_bPending(false)
+{}
+
+OrderedParallelFileWrite::~OrderedParallelFileWrite()
+{
+	if(m_bPending) wait();
+}
+
+long long OrderedParallelFileWrite::
+start(std::vector<char>& header, std::vector<char>& data,
+      std::string strFilename, pcl::ProcessCommunicator pc)
+{
+	UG_COND_THROW(m_bPending, "OrderedParallelFileWrite: write already pending.");
+
+	MPI_Comm comm = pc.get_mpi_communicator();
+	const bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
+
+	m_header.swap(header);
+	m_data.swap(data);
+	if(!bFirst) m_header.clear();
+
+//	offset of the data: header size plus the data of the preceding processes
+	long long headerSize = m_header.size();
+	MPI_Bcast(&headerSize, 1, MPI_LONG_LONG, 0, comm);
+
+	long long mySize = m_data.size();
+	long long myOffset = 0;
+	MPI_Scan(&mySize, &myOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+	myOffset += headerSize - mySize;
+
+	if(MPI_File_open(comm, const_cast<char*>(strFilename.c_str()),
+	                 MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &m_fh))
+		UG_THROW("could not open "<<strFilename);
+	MPI_File_set_size(m_fh, 0);
+
+	m_vRequest.clear();
+	for(size_t pos = 0; pos < m_header.size(); pos += MAX_MPI_IO_CHUNK){
+		m_vRequest.push_back(MPI_REQUEST_NULL);
+		MPI_File_iwrite_at(m_fh, pos, &m_header[pos],
+		                   (int)std::min(MAX_MPI_IO_CHUNK, m_header.size() - pos),
+		                   MPI_BYTE, &m_vRequest.back());
+	}
+	for(size_t pos = 0; pos < m_data.size(); pos += MAX_MPI_IO_CHUNK){
+		m_vRequest.push_back(MPI_REQUEST_NULL);
+		MPI_File_iwrite_at(m_fh, myOffset + pos, &m_data[pos],
+		                   (int)std::min(MAX_MPI_IO_CHUNK, m_data.size() - pos),
+		                   MPI_BYTE, &m_vRequest.back());
+	}
+
+	m_bPending = true;
+	return myOffset;
+}
+
+void OrderedParallelFileWrite::wait()
+{
+	if(!m_bPending) return;
+	Waitall(m_vRequest);
+	m_vRequest.clear();
+	MPI_File_close(&m_fh);
+	m_header.clear();
+	m_data.clear();
+	m_bPending = false;
+}
+
+void WriteOrderedParallelFile(std::vector<char>& header, std::vector<char>& data,
+                              std::string strFilename, pcl::ProcessCommunicator pc)
+{
+	OrderedParallelFileWrite write;
+	write.start(header, data, strFilename, pc);
+	write.wait();
+}
+
+void ReadParallelFileRange(std::vector<char>& buffer, long long offset, size_t size,
+                           std::string strFilename, pcl::ProcessCommunicator pc)
+{
+	MPI_File fh;
+	if(MPI_File_open(pc.get_mpi_communicator(), const_cast<char*>(strFilename.c_str()),
+	                 MPI_MODE_RDONLY, MPI_INFO_NULL, &fh))
+		UG_THROW("could not open "<<strFilename);
+
+	buffer.resize(size);
+	for(size_t pos = 0; pos < size; pos += MAX_MPI_IO_CHUNK){
+		MPI_Status status;
+		const int num = (int)std::min(MAX_MPI_IO_CHUNK, size - pos);
+		MPI_File_read_at(fh, offset + pos, &buffer[pos], num, MPI_BYTE, &status);
+		int count;
+		MPI_Get_count(&status, MPI_BYTE, &count);
+		UG_COND_THROW(count != num, "could not read from "<<strFilename);
+	}
+
+	MPI_File_close(&fh);
+}
+
 }
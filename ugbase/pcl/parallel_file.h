@@ -33,6 +33,7 @@
 #ifndef PARALLEL_FILE_H_
 #define PARALLEL_FILE_H_
 
+#include <vector>
 #include "pcl_process_communicator.h"
 #include "common/util/binary_buffer.h"
 
@@ -89,5 +90,62 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
  */
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
 
+
+/**
+ * Writes the data of all participating cores one after another into one file,
+ * in the order of the processes in pc, preceded by a header which is written
+ * by the first process of pc. In contrast to WriteCombinedParallelFile, the
+ * file contains no offset table, i.e. the data can be read in arbitrary
+ * ranges (e.g. with ReadParallelFileRange) on any number of processes.
+ *
+ * The write can be started non-blocking: start() returns after the data has
+ * been handed over to MPI-IO, wait() completes the write and closes the file.
+ * The buffers are kept by the object until the write has been completed.
+ * Both start() and wait() are collective on pc.
+ */
+class OrderedParallelFileWrite
+{
+	public:
+		OrderedParallelFileWrite();
+
+	///	completes a pending write
+		~OrderedParallelFileWrite();
+
+	///	starts the write. header is only used on the first process of pc.
+	/**	The contents of header and data are swapped into the object.
+	 *	returns the offset of the data of this process in the file.*/
+		long long start(std::vector<char>& header, std::vector<char>& data,
+		                std::string strFilename,
+		                pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+	///	waits until the data is written and closes the file
+		void wait();
+
+	///	returns true if a write is pending
+		bool pending() const	{return m_bPending;}
+
+	private:
+		OrderedParallelFileWrite(const OrderedParallelFileWrite&);
+		OrderedParallelFileWrite& operator=(const OrderedParallelFileWrite&);
+
+		std::vector<char> m_header;
+		std::vector<char> m_data;
+		std::vector<MPI_Request> m_vRequest;
+		MPI_File m_fh;
+		bool m_bPending;
+};
+
+///	writes the data of all processes one after another into one file (blocking)
+/**	See OrderedParallelFileWrite. Collective on pc.*/
+void WriteOrderedParallelFile(std::vector<char>& header, std::vector<char>& data,
+                              std::string strFilename,
+                              pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+///	reads size bytes starting at offset from a file (collective on pc)
+/**	Each process may read a different range.*/
+void ReadParallelFileRange(std::vector<char>& buffer, long long offset, size_t size,
+                           std::string strFilename,
+                           pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
 }
 #endif /* PARALLEL_ARCHIVE_H_ */
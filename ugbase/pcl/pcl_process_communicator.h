@@ -288,6 +288,17 @@ class ProcessCommunicator
 		void allreduce(const void* sendBuf, void* recBuf, int count,
 					   DataType type, ReduceOperation op) const;
 
+	///	starts a non-blocking MPI_Iallreduce on the processes of the communicator.
+	/**	The result is only available in recBuf after the request has been
+	 * completed, e.g. by pcl::MPI_Wait(&request). Until then neither sendBuf
+	 * nor recBuf may be accessed. All processes of the communicator have to
+	 * start their collective operations in the same order.
+	 * If MPI does not support non-blocking collectives (MPI < 3), a blocking
+	 * MPI_Allreduce is performed and request is set to MPI_REQUEST_NULL.*/
+		void iallreduce(const void* sendBuf, void* recBuf, int count,
+						DataType type, ReduceOperation op,
+						MPI_Request& request) const;
+
 	/** simplified allreduce for size=1. calls allreduce for parameter t,
 	 * and then returns the result.
 	 * \param t the input parameter